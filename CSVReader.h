@@ -36,9 +36,16 @@
 #include <exception>
 #include <stdexcept>
 #include <utility>
+#include <tuple>
+#include <vector>
 
 #include "invoke_default.hpp"
 
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#   define CSVREADER_HAS_EXCEPTIONS
+#   include "CSVUtils.h"
+#endif
+
 #ifdef _MSC_VER
 #pragma warning (disable: 4244)
 #pragma warning (disable: 4503)
@@ -68,6 +75,214 @@ namespace CSVReader
             return _field;
         }
     };
+
+    /*!
+     * \brief Result of the non-throwing reading functions.
+     * \see CSVReader::TryReadDataLine()
+     *
+     * Keeps the reason of the failure and the positions of the failed field at
+     * every nested reader (sub-readers, batch readers and iterators), from the
+     * inner-most one up to the reader of the whole line. Nothing is allocated
+     * while the reading succeeds.
+     */
+    class parse_status
+    {
+    public:
+        enum error_code
+        {
+            //! The line was read successfully
+            no_error = 0,
+            //! The line has less fields than expected
+            missing_fields,
+            //! The field can't be converted into the target type
+            conversion_failed,
+            //! The validator function has rejected the field value
+            validation_failed,
+            //! A post-processor or an iterator function has thrown an exception
+            callback_failed
+        };
+
+        struct location
+        {
+            int line;
+            int field;
+        };
+
+        parse_status() : _code(no_error), _causeLine(0), _causeField(0) {}
+
+        inline bool ok() const
+        {
+            return _code == no_error;
+        }
+        explicit operator bool() const
+        {
+            return ok();
+        }
+        inline error_code code() const
+        {
+            return _code;
+        }
+        //! Text of the inner-most failure
+        inline const std::string &reason() const
+        {
+            return _reason;
+        }
+        //! Line number at the reader of the whole line
+        inline int get_line_number() const
+        {
+            return _nesting.empty() ? _causeLine : _nesting.back().line;
+        }
+        //! Field number at the reader of the whole line
+        inline int get_field_number() const
+        {
+            return _nesting.empty() ? _causeField : _nesting.back().field;
+        }
+        //! Positions of the failed field at nested readers, from the inner-most to the outer-most
+        inline const std::vector<location> &nesting() const
+        {
+            return _nesting;
+        }
+
+        void clear()
+        {
+            if(_code == no_error)
+                return;
+            _code = no_error;
+            _reason.clear();
+            _nesting.clear();
+            _causeLine = 0;
+            _causeField = 0;
+#ifdef CSVREADER_HAS_EXCEPTIONS
+            _exception = std::exception_ptr();
+#endif
+        }
+
+        void set_error(error_code code, const std::string &reason, int line, int field)
+        {
+            _code = code;
+            _reason = reason;
+            _causeLine = line;
+            _causeField = field;
+        }
+
+#ifdef CSVREADER_HAS_EXCEPTIONS
+        //! Must be called in the catch block only: keeps the currently handled exception
+        void set_callback_error(int line, int field)
+        {
+            _exception = std::current_exception();
+            set_error(callback_failed, std::string(), line, field);
+            try
+            {
+                std::rethrow_exception(_exception);
+            }
+            catch(const std::exception &e)
+            {
+                _reason = e.what();
+            }
+            catch(...)
+            {
+                _reason = "<Unknown exception>";
+            }
+        }
+#endif
+
+        //! Marks the failure as happened inside the field of an outer reader
+        void add_nesting(int line, int field)
+        {
+            location l = {line, field};
+            _nesting.push_back(l);
+        }
+
+        /*!
+         * \brief Prints the failure in the same way as exception_to_pretty_string() prints the thrown exceptions
+         */
+        std::string pretty_string() const
+        {
+            std::string ret;
+            size_t level = 0;
+
+            for(size_t i = _nesting.size(); i > 0; --i, ++level)
+                ret += std::string(level, ' ') + "exception: " + nesting_message(_nesting[i - 1]) + "\n";
+
+#ifdef CSVREADER_HAS_EXCEPTIONS
+            if(_code == callback_failed && _exception)
+            {
+                try
+                {
+                    std::rethrow_exception(_exception);
+                }
+                catch(const std::exception &e)
+                {
+                    ret += exception_to_pretty_string(e, static_cast<int>(level));
+                    return ret;
+                }
+                catch(...)
+                {}
+            }
+#endif
+
+            ret += std::string(level, ' ') + "exception: " + _reason + "\n";
+            return ret;
+        }
+
+#ifdef CSVREADER_HAS_EXCEPTIONS
+        /*!
+         * \brief Throws the failure as the same nested exceptions as the throwing reading functions do
+         */
+        void rethrow() const
+        {
+            rethrow_nested(_nesting.size());
+        }
+#endif
+
+    private:
+        static std::string nesting_message(const location &l)
+        {
+            return std::string("Failed to parse field ") + std::to_string(l.field) + " at line " + std::to_string(l.line);
+        }
+
+#ifdef CSVREADER_HAS_EXCEPTIONS
+        void rethrow_nested(size_t depth) const
+        {
+            if(depth == 0)
+            {
+                switch(_code)
+                {
+                case missing_fields:
+                    throw parse_error(_reason, _causeLine, _causeField);
+                case conversion_failed:
+                    throw std::invalid_argument(_reason);
+                case callback_failed:
+                    if(_exception)
+                        std::rethrow_exception(_exception);
+                    throw std::runtime_error(_reason);
+                case validation_failed:
+                default:
+                    throw std::logic_error(_reason);
+                }
+            }
+
+            try
+            {
+                rethrow_nested(depth - 1);
+            }
+            catch(...)
+            {
+                const location &l = _nesting[depth - 1];
+                std::throw_with_nested(parse_error(nesting_message(l), l.line, l.field));
+            }
+        }
+#endif
+
+        error_code _code;
+        std::string _reason;
+        int _causeLine;
+        int _causeField;
+        std::vector<location> _nesting;
+#ifdef CSVREADER_HAS_EXCEPTIONS
+        std::exception_ptr _exception;
+#endif
+    };
     // ========= Exceptions END ===========
 
 
@@ -99,6 +314,77 @@ namespace CSVReader
 
     namespace detail
     {
+        /*!
+         * \brief Non-owning reference to a field: a range of the line being read
+         */
+        template<class StrT>
+        struct CSVFieldRef
+        {
+            const StrT *str;
+            size_t pos;
+            size_t count;
+        };
+
+        // Uses the range overload of the converter if it has one: Convert(T* out, const StrT& line, size_t pos, size_t count)
+        template<class StrTUtils, class Converter, class T, class StrT>
+        inline auto ConvertFieldImpl(T *to, const CSVFieldRef<StrT> &field, int)
+            -> decltype(Converter::Convert(to, *field.str, field.pos, field.count))
+        {
+            Converter::Convert(to, *field.str, field.pos, field.count);
+        }
+
+        // Otherwise the field gets materialized as a substring
+        template<class StrTUtils, class Converter, class T, class StrT>
+        inline void ConvertFieldImpl(T *to, const CSVFieldRef<StrT> &field, long)
+        {
+            Converter::Convert(to, StrTUtils::substring(*field.str, field.pos, field.count));
+        }
+
+        template<class StrTUtils, class Converter, class T, class StrT>
+        inline void ConvertField(T *to, const CSVFieldRef<StrT> &field)
+        {
+            ConvertFieldImpl<StrTUtils, Converter>(to, field, 0);
+        }
+
+        // Non-throwing conversion: TryConvert(T* out, const StrT& line, size_t pos, size_t count, std::string& error)
+        template<class StrTUtils, class Converter, class T, class StrT>
+        inline auto TryConvertFieldImpl(T *to, const CSVFieldRef<StrT> &field, std::string &error, int)
+            -> decltype(Converter::TryConvert(to, *field.str, field.pos, field.count, error))
+        {
+            return Converter::TryConvert(to, *field.str, field.pos, field.count, error);
+        }
+
+        // Otherwise the exception of the throwing conversion becomes the error
+        template<class StrTUtils, class Converter, class T, class StrT>
+        inline bool TryConvertFieldImpl(T *to, const CSVFieldRef<StrT> &field, std::string &error, long)
+        {
+#ifdef CSVREADER_HAS_EXCEPTIONS
+            try
+            {
+                ConvertField<StrTUtils, Converter>(to, field);
+            }
+            catch(const std::exception &e)
+            {
+                error = e.what();
+                return false;
+            }
+            catch(...)
+            {
+                error = "<Unknown exception>";
+                return false;
+            }
+#else
+            ConvertField<StrTUtils, Converter>(to, field);
+            (void)error;
+#endif
+            return true;
+        }
+
+        template<class StrTUtils, class Converter, class T, class StrT>
+        inline bool TryConvertField(T *to, const CSVFieldRef<StrT> &field, std::string &error)
+        {
+            return TryConvertFieldImpl<StrTUtils, Converter>(to, field, error, 0);
+        }
 
         template<class StrT,
                  class CharT,
@@ -107,55 +393,101 @@ namespace CSVReader
         class CSVReaderBase
         {
         protected:
+            typedef CSVFieldRef<StrT> FieldRef;
+
             size_t _currentCharIndex;
             CharT _sep;
             StrT _currentLine; // Will be written by the derived class
+            const StrT *_line; // When not null, the fields are read from the range of this line instead of _currentLine
+            size_t _lineEnd;   // End of the range at _line
             int _fieldTracker; // Will be written by the derived class
             int _lineTracker;  // Will be written by the derived class
 
             CSVReaderBase(CharT sep) : _currentCharIndex(0u), _sep(sep),
-                _currentLine(""), _fieldTracker(0), _lineTracker(0) {}
+                _currentLine(""), _line(nullptr), _lineEnd(0u), _fieldTracker(0), _lineTracker(0) {}
+
+            inline const StrT &Line() const
+            {
+                return _line ? *_line : _currentLine;
+            }
+
+            inline size_t LineEnd() const
+            {
+                return _line ? _lineEnd : StrTUtils::length(_currentLine);
+            }
+
+            // Read fields from the own _currentLine
+            inline void BeginLine()
+            {
+                _line = nullptr;
+                _currentCharIndex = 0;
+            }
 
-            inline StrT NextField()
+            // Read fields from the field of an another reader without copying it
+            inline void BeginRange(const FieldRef &range)
+            {
+                _line = range.str;
+                _lineEnd = range.pos + range.count;
+                _currentCharIndex = range.pos;
+            }
+
+            inline size_t FindFieldEnd() const
             {
                 size_t newCharIndex = _currentCharIndex;
-                if(!StrTUtils::find(_currentLine, _sep, newCharIndex))
-                    newCharIndex = StrTUtils::length(_currentLine);
+                size_t lineEnd = LineEnd();
+                if(!StrTUtils::find(Line(), _sep, newCharIndex) || newCharIndex > lineEnd)
+                    newCharIndex = lineEnd;
+                return newCharIndex;
+            }
 
-                StrT next = StrTUtils::substring(_currentLine, _currentCharIndex, newCharIndex - _currentCharIndex);
+            inline FieldRef NextField()
+            {
+                size_t newCharIndex = FindFieldEnd();
+                FieldRef next = {&Line(), _currentCharIndex, newCharIndex - _currentCharIndex};
                 _currentCharIndex = newCharIndex + 1;
                 return next;
             }
 
             inline void SkipField()
             {
-                size_t newCharIndex = _currentCharIndex;
-                if(!StrTUtils::find(_currentLine, _sep, newCharIndex))
-                    newCharIndex = StrTUtils::length(_currentLine);
-                _currentCharIndex = newCharIndex + 1;
+                _currentCharIndex = FindFieldEnd() + 1;
             }
 
             inline bool HasNext()
             {
-                return _currentCharIndex <= StrTUtils::length(_currentLine);
+                return _currentCharIndex <= LineEnd();
             }
 
             template<typename ToType>
-            inline void SafeConvert(ToType *to, const StrT &from)
+            inline bool TryConvert(ToType *to, const FieldRef &from, parse_status &status)
+            {
+                std::string error;
+                if(TryConvertField<StrTUtils, Converter>(to, from, error))
+                    return true;
+                status.set_error(parse_status::conversion_failed, error, _lineTracker, _fieldTracker);
+                status.add_nesting(_lineTracker, _fieldTracker);
+                return false;
+            }
+
+            // Calls the post-processor or the iterator function, which is allowed to throw
+            template<class Func>
+            inline bool TryCallback(const Func &func, parse_status &status)
             {
+#ifdef CSVREADER_HAS_EXCEPTIONS
                 try
                 {
-                    Converter::Convert(to, from);
+                    func();
                 }
                 catch(...)
                 {
-                    ThrowParseErrorInCatchContext();
+                    status.set_callback_error(_lineTracker, _fieldTracker);
+                    return false;
                 }
-            }
-
-            inline void ThrowParseErrorInCatchContext()
-            {
-                std::throw_with_nested(parse_error(std::string("Failed to parse field ") + std::to_string(_fieldTracker) + " at line " + std::to_string(_lineTracker), _lineTracker, _fieldTracker));
+#else
+                func();
+                (void)status;
+#endif
+                return true;
             }
         };
     }
@@ -468,19 +800,42 @@ namespace CSVReader
         CSVBatchReader(CharT sep, Container* container, const PostProcessorFunc &postProcessorFunction) :
             detail::CSVReaderBase<StrT, CharT, StrTUtils, Converter>(sep), _container(container), _postProcessorFunction(postProcessorFunction) {}
 
+#ifdef CSVREADER_HAS_EXCEPTIONS
         inline void ReadDataLine(const StrT &val)
         {
+            parse_status status;
             this->_currentLine = val;
+            this->BeginLine();
+            if(!ReadFields(status))
+                status.rethrow();
+        }
+#endif
+
+        inline bool TryReadDataRange(const detail::CSVFieldRef<StrT> &range, parse_status &status)
+        {
+            this->BeginRange(range);
+            return ReadFields(status);
+        }
+
+    private:
+        inline bool ReadFields(parse_status &status)
+        {
             while(this->HasNext())
             {
-                StrT from = this->NextField();
-                if(from == "")
+                detail::CSVFieldRef<StrT> from = this->NextField();
+                if(from.count == 0)
                     continue;
                 ContainerValueT to;
-                this->SafeConvert(&to, from);
-                idef::invoke_or_noop<void>(_postProcessorFunction, to);
+                if(!this->TryConvert(&to, from, status))
+                    return false;
+                if(!this->TryCallback([&]()
+                    {
+                        idef::invoke_or_noop<void>(_postProcessorFunction, to);
+                    }, status))
+                    return false;
                 ContainerUtils::Add(_container, to);
             }
+            return true;
         }
     };
 
@@ -503,21 +858,44 @@ namespace CSVReader
         CSVIterator(CharT sep, bool isOptional, const IteratorFunc &iteratorFunc) :
             detail::CSVReaderBase<StrT, CharT, StrTUtils, Converter>(sep), _isOptional(isOptional), _iteratorFunc(iteratorFunc) {}
 
+#ifdef CSVREADER_HAS_EXCEPTIONS
         inline void ReadDataLine(const StrT &val)
         {
+            parse_status status;
             this->_currentLine = val;
-            while(this->HasNext())
-            {
-                StrT next = this->NextField();
-                if(!(next == ""))
-                    _iteratorFunc(next);
-            }
+            this->BeginLine();
+            if(!ReadFields(status))
+                status.rethrow();
+        }
+#endif
+
+        inline bool TryReadDataRange(const detail::CSVFieldRef<StrT> &range, parse_status &status)
+        {
+            this->BeginRange(range);
+            return ReadFields(status);
         }
 
         bool IsOptional() const
         {
             return _isOptional;
         }
+
+    private:
+        inline bool ReadFields(parse_status &status)
+        {
+            while(this->HasNext())
+            {
+                detail::CSVFieldRef<StrT> next = this->NextField();
+                if(next.count == 0)
+                    continue;
+                if(!this->TryCallback([&]()
+                    {
+                        _iteratorFunc(StrTUtils::substring(*next.str, next.pos, next.count));
+                    }, status))
+                    return false;
+            }
+            return true;
+        }
     };
 
 
@@ -582,6 +960,25 @@ namespace CSVReader
         {
             *out = field;
         }
+
+        static bool TryConvert(bool *out, const StrType &line, size_t pos, size_t count, std::string &error)
+        {
+            if(count == 0 || (count == 1 && line[pos] == '0'))
+                *out = false;
+            else if((count == 1 && line[pos] == '1') || (count == 2 && line[pos] == '!' && line[pos + 1] == '0'))
+                *out = true;
+            else
+            {
+                error = std::string("Could not convert to bool (must be empty, \"0\", \"!0\" or \"1\"), got \"") + line.substr(pos, count) + std::string("\"");
+                return false;
+            }
+            return true;
+        }
+        static bool TryConvert(StrType *out, const StrType &line, size_t pos, size_t count, std::string &)
+        {
+            out->assign(line, pos, count);
+            return true;
+        }
     };
 
 
@@ -634,6 +1031,7 @@ namespace CSVReader
         Reader *_reader;
         int _currentTotalFields;
         bool _requireReadLine;
+        parse_status _status;
     public:
         CSVReader(Reader *reader, CharT sep) : detail::CSVReaderBase<StrT, CharT, StrTUtils, Converter>(sep), _reader(reader),
             _currentTotalFields(0), _requireReadLine(true) {}
@@ -642,153 +1040,188 @@ namespace CSVReader
         ~CSVReader() = default;
 
     private:
-        inline void ThrowIfOutOfBounds()
+        inline bool CheckBounds()
         {
-            if(this->_currentCharIndex > StrTUtils::length(this->_currentLine))
-                throw parse_error("Expected " + std::to_string(this->_currentTotalFields) + " CSV-Fields, got "
+            if(this->_currentCharIndex > this->LineEnd())
+            {
+                _status.set_error(parse_status::missing_fields,
+                                  "Expected " + std::to_string(this->_currentTotalFields) + " CSV-Fields, got "
                                   + std::to_string(this->_fieldTracker) + " at line "
                                   + std::to_string(this->_lineTracker) + "!", this->_lineTracker, this->_fieldTracker);
+                return false;
+            }
+            return true;
         }
+
+        inline bool ValidationFailed()
+        {
+            _status.set_error(parse_status::validation_failed,
+                              "Validation failed at field " + std::to_string(this->_fieldTracker) + " at line " + std::to_string(this->_lineTracker) + "!",
+                              this->_lineTracker, this->_fieldTracker);
+            return false;
+        }
+
+        // The failure happened inside of the reader of the current field
+        inline bool NestedFailed()
+        {
+            _status.add_nesting(this->_lineTracker, this->_fieldTracker);
+            return false;
+        }
+
         template<class T, class... RestValues>
-        void ReadNext(T nextVal, RestValues &&... restVals)
+        bool ReadNext(T nextVal, RestValues &&... restVals)
         {
             static_assert(std::is_pointer<T>::value, "All values which are unpacked must be pointers (except CSVDiscard, CSVVaildate, CSVDiscard, CSVOptional, CSVSubReader)!");
-            ThrowIfOutOfBounds();
+            if(!CheckBounds())
+                return false;
 
             //Here do conversion code
-            this->SafeConvert(nextVal, this->NextField());
+            if(!this->TryConvert(nextVal, this->NextField(), _status))
+                return false;
 
             this->_fieldTracker++;
-            ReadNext(std::forward<RestValues>(restVals)...);
+            return ReadNext(std::forward<RestValues>(restVals)...);
         }
 
         template<class... RestValues>
-        void ReadNext(CSVDiscard, RestValues &&... restVals)
+        bool ReadNext(CSVDiscard, RestValues &&... restVals)
         {
             this->_fieldTracker++;
             this->SkipField();
-            ReadNext(std::forward<RestValues>(restVals)...);
+            return ReadNext(std::forward<RestValues>(restVals)...);
         }
 
         template<class ValidateT, class ValidatorFunc, class... RestValues>
-        void ReadNext(CSVValidator<ValidateT, ValidatorFunc> nextVal, RestValues &&... restVals)
+        bool ReadNext(CSVValidator<ValidateT, ValidatorFunc> nextVal, RestValues &&... restVals)
         {
-            ThrowIfOutOfBounds();
+            if(!CheckBounds())
+                return false;
 
-            this->SafeConvert(nextVal.Get(), this->NextField());
+            if(!this->TryConvert(nextVal.Get(), this->NextField(), _status))
+                return false;
 
             if(!nextVal.Validate())
-                throw std::logic_error("Validation failed at field " + std::to_string(this->_fieldTracker) + " at line " + std::to_string(this->_lineTracker) + "!");
+                return ValidationFailed();
 
             this->_fieldTracker++;
-            ReadNext(std::forward<RestValues>(restVals)...);
+            return ReadNext(std::forward<RestValues>(restVals)...);
         }
 
         template<class PostProcessorT, class PostProcessorFunc, class ValidatorFunc, class... RestValues>
-        void ReadNext(CSVPostProcessor<PostProcessorT, PostProcessorFunc, ValidatorFunc> nextVal, RestValues &&... restVals)
+        bool ReadNext(CSVPostProcessor<PostProcessorT, PostProcessorFunc, ValidatorFunc> nextVal, RestValues &&... restVals)
         {
-            ThrowIfOutOfBounds();
+            if(!CheckBounds())
+                return false;
 
-            this->SafeConvert(nextVal.Get(), this->NextField());
+            if(!this->TryConvert(nextVal.Get(), this->NextField(), _status))
+                return false;
             if(!nextVal.Validate())
-                throw std::logic_error("Validation failed at field " + std::to_string(this->_fieldTracker) + " at line " + std::to_string(this->_lineTracker) + "!");
-            nextVal.PostProcess();
+                return ValidationFailed();
+            if(!this->TryCallback([&nextVal]()
+                {
+                    nextVal.PostProcess();
+                }, _status))
+                return false;
 
             this->_fieldTracker++;
-            ReadNext(std::forward<RestValues>(restVals)...);
+            return ReadNext(std::forward<RestValues>(restVals)...);
         }
 
         template<class OptionalT, class ValidatorFunc, class PostProcessorFunc, class... RestValues>
-        void ReadNext(CSVOptional<OptionalT, ValidatorFunc, PostProcessorFunc> optionalObj, RestValues &&... restVals)
+        bool ReadNext(CSVOptional<OptionalT, ValidatorFunc, PostProcessorFunc> optionalObj, RestValues &&... restVals)
         {
             // If we already reached the end, then assign default
-            if(this->_currentCharIndex >= StrTUtils::length(this->_currentLine))
+            if(this->_currentCharIndex >= this->LineEnd())
                 optionalObj.AssignDefault();
             else
             {
-                StrT nextField = this->NextField();
-                if(!optionalObj.ShouldAssingDefaultOnEmpty() || StrTUtils::length(nextField) > 0) {
-                    this->SafeConvert(optionalObj.Get(), nextField);
+                detail::CSVFieldRef<StrT> nextField = this->NextField();
+                if(!optionalObj.ShouldAssingDefaultOnEmpty() || nextField.count > 0) {
+                    if(!this->TryConvert(optionalObj.Get(), nextField, _status))
+                        return false;
                     if (!optionalObj.Validate())
-                        throw std::logic_error("Validation failed at field " + std::to_string(this->_fieldTracker) + " at line " + std::to_string(this->_lineTracker) + "!");
-                    optionalObj.PostProcess();
+                        return ValidationFailed();
+                    if(!this->TryCallback([&optionalObj]()
+                        {
+                            optionalObj.PostProcess();
+                        }, _status))
+                        return false;
                 } else {
                     optionalObj.AssignDefault();
                 }
             }
 
             this->_fieldTracker++;
-            ReadNext(std::forward<RestValues>(restVals)...);
+            return ReadNext(std::forward<RestValues>(restVals)...);
         }
 
         template<class SubReader, class SubStrT, class SubCharT, class SubStrTUtils, class SubConverter, class... SubValues, class... RestValues>
-        void ReadNext(CSVSubReader<SubReader, SubStrT, SubCharT, SubStrTUtils, SubConverter, SubValues...> subReaderObj, RestValues &&... restVals)
+        bool ReadNext(CSVSubReader<SubReader, SubStrT, SubCharT, SubStrTUtils, SubConverter, SubValues...> subReaderObj, RestValues &&... restVals)
         {
-            if(!subReaderObj.IsOptional())
-                ThrowIfOutOfBounds();
+            if(!subReaderObj.IsOptional() && !CheckBounds())
+                return false;
 
             // We don't have to check for subReaderObj.IsOptional again, because
-            // ThrowIfOutOfBounds() would have thrown already
-            if(!(this->_currentCharIndex >= StrTUtils::length(this->_currentLine)))
+            // CheckBounds() would have failed already
+            if(!(this->_currentCharIndex >= this->LineEnd()))
             {
-                try
-                {
-                    subReaderObj.ReadDataLine(this->NextField());
-                }
-                catch(...)
-                {
-                    this->ThrowParseErrorInCatchContext();
-                }
+                if(!subReaderObj.TryReadDataRange(this->NextField(), _status))
+                    return NestedFailed();
             }
 
             this->_fieldTracker++;
-            ReadNext(std::forward<RestValues>(restVals)...);
+            return ReadNext(std::forward<RestValues>(restVals)...);
         }
 
         template<class ReaderContainerValueT, class ReaderContainer, class ReaderContainerUtils,
                  class ReaderStrT, class ReaderCharT, class ReaderStrTUtils, class ReaderConverter, class PostProcessorFunc, class... RestValues>
-        void ReadNext(CSVBatchReader<ReaderContainerValueT, ReaderContainer, ReaderContainerUtils, ReaderStrT, ReaderCharT, ReaderStrTUtils, ReaderConverter, PostProcessorFunc> subBatchReaderObj, RestValues &&... restVals)
+        bool ReadNext(CSVBatchReader<ReaderContainerValueT, ReaderContainer, ReaderContainerUtils, ReaderStrT, ReaderCharT, ReaderStrTUtils, ReaderConverter, PostProcessorFunc> subBatchReaderObj, RestValues &&... restVals)
         {
-            ThrowIfOutOfBounds();
+            if(!CheckBounds())
+                return false;
 
-            try
-            {
-                subBatchReaderObj.ReadDataLine(this->NextField());
-            }
-            catch(...)
-            {
-                this->ThrowParseErrorInCatchContext();
-            }
+            if(!subBatchReaderObj.TryReadDataRange(this->NextField(), _status))
+                return NestedFailed();
 
             this->_fieldTracker++;
-            ReadNext(std::forward<RestValues>(restVals)...);
+            return ReadNext(std::forward<RestValues>(restVals)...);
         }
 
         template<class IterStrT, class IterCharT, class IterStrTUtils, class IterConverter, class IteratorFunc, class... RestValues>
-        void ReadNext(CSVIterator<IterStrT, IterCharT, IterStrTUtils, IterConverter, IteratorFunc> iteratorObj, RestValues &&... restVals)
+        bool ReadNext(CSVIterator<IterStrT, IterCharT, IterStrTUtils, IterConverter, IteratorFunc> iteratorObj, RestValues &&... restVals)
         {
-            if(!iteratorObj.IsOptional())
-                ThrowIfOutOfBounds();
+            if(!iteratorObj.IsOptional() && !CheckBounds())
+                return false;
 
             // We don't have to check for iteratorObj.IsOptional again, because
-            // ThrowIfOutOfBounds() would have thrown already
-            if(!(this->_currentCharIndex >= StrTUtils::length(this->_currentLine)))
+            // CheckBounds() would have failed already
+            if(!(this->_currentCharIndex >= this->LineEnd()))
             {
-                try
-                {
-                    iteratorObj.ReadDataLine(this->NextField());
-                }
-                catch(...)
-                {
-                    this->ThrowParseErrorInCatchContext();
-                }
+                if(!iteratorObj.TryReadDataRange(this->NextField(), _status))
+                    return NestedFailed();
             }
 
             this->_fieldTracker++;
-            ReadNext(std::forward<RestValues>(restVals)...);
+            return ReadNext(std::forward<RestValues>(restVals)...);
+        }
+
+        bool ReadNext()
+        {
+            return true;
+        }
+
+        inline void BeginDataLine(int totalFields)
+        {
+            this->_lineTracker++;
+            this->BeginLine();
+            _currentTotalFields = totalFields;
+            this->_fieldTracker = 0; // We need the tracker at 0 (because of out of range exception)
+            _status.clear();
+            if(_requireReadLine)
+                _reader->read_line(this->_currentLine);
+            _requireReadLine = true;
         }
 
-        void ReadNext() {}
     public:
         /*!
          * \brief Read the next data line and pushes the result directly to the parameter.
@@ -802,36 +1235,52 @@ namespace CSVReader
          *      * CSVBatchReader
          *      * CSVIterator
          *
+         * Nothing is thrown on failure: the reading stops at the failed field, and
+         * the returned status keeps the reason and the line and field numbers.
+         * Exceptions thrown by post-processor and iterator functions are caught
+         * and kept in the status.
+         */
+        template<typename... Values>
+        const parse_status &TryReadDataLine(Values &&... allValues)
+        {
+            BeginDataLine(static_cast<int>(sizeof...(allValues)));
+            ReadNext(std::forward<Values>(allValues)...);
+            return _status;
+        }
+
+#ifdef CSVREADER_HAS_EXCEPTIONS
+        /*!
+         * \brief Read the next data line and pushes the result directly to the parameter.
+         * \see TryReadDataLine()
+         *
          * \throws std::nested_exception When a parsing or conversion error happens.
          *
          */
         template<typename... Values>
         CSVReader &ReadDataLine(Values &&... allValues)
         {
-            this->_lineTracker++;
-            this->_currentCharIndex = 0;
-            _currentTotalFields = sizeof...(allValues);
-            this->_fieldTracker = 0; // We need the tracker at 0 (because of out of range exception)
-            if(_requireReadLine)
-                _reader->read_line(this->_currentLine);
-            ReadNext(std::forward<Values>(allValues)...);
-            _requireReadLine = true;
-
+            if(!TryReadDataLine(std::forward<Values>(allValues)...))
+                _status.rethrow();
 
             return *this;
         }
+#endif
 
         template<typename T>
         CSVReader &ReadRawLine(T && value)
         {
-            this->_lineTracker++;
-            this->_currentCharIndex = 0;
-            _currentTotalFields = sizeof(value);
-            this->_fieldTracker = 0; // We need the tracker at 0 (because of out of range exception)
-            if(_requireReadLine)
-                _reader->read_line(this->_currentLine);
+            BeginDataLine(static_cast<int>(sizeof(value)));
             value = this->_currentLine;
-            _requireReadLine = true;
+
+            return *this;
+        }
+
+        /*!
+         * \brief Jumps over the current data line without converting any of its fields.
+         */
+        CSVReader &SkipDataLine()
+        {
+            BeginDataLine(0);
 
             return *this;
         }
@@ -844,52 +1293,95 @@ namespace CSVReader
         template<class IteratorFunc>
         CSVReader& IterateDataLine(const IteratorFunc &iteratorFunc)
         {
-            this->_lineTracker++;
-            this->_currentCharIndex = 0;
-            this->_fieldTracker = 0; // We need the tracker at 0 (because of out of range exception)
-            _currentTotalFields = 0;
+            BeginDataLine(0);
 
-            if(_requireReadLine)
-                _reader->read_line(this->_currentLine);
             while(this->HasNext())
             {
-                StrT next = this->NextField();
-                if(!(next == ""))
-                    iteratorFunc(next);
+                detail::CSVFieldRef<StrT> next = this->NextField();
+                if(next.count > 0)
+                    iteratorFunc(StrTUtils::substring(*next.str, next.pos, next.count));
             }
-            _requireReadLine = true;
 
             return *this;
         }
 
-
-        // Begins with 1
         /*!
          * \brief Read out (peeking) a field without going to the next line.
+         * \param fieldNum Number of the field, begins with 1
+         * \param value The converted field value
+         * \return The status of the reading, the reason is kept on failure
          */
         template<typename T>
-        T ReadField(int fieldNum)
+        const parse_status &TryReadField(int fieldNum, T *value)
         {
             if(_requireReadLine)
                 _reader->read_line(this->_currentLine);
             _requireReadLine = false;
-            this->_currentCharIndex = 0;
+            this->BeginLine();
+            _status.clear();
 
-            StrT field;
             for(int i = 1; i < fieldNum; i++)
             {
-                if(this->_currentCharIndex >= StrTUtils::length(this->_currentLine))
-                    throw std::logic_error("Expected " + std::to_string(fieldNum) + " CSV-Fields, got " + std::to_string(i - 1) + " @ line " + std::to_string(this->_lineTracker) + "!");
+                if(this->_currentCharIndex >= this->LineEnd())
+                {
+                    _status.set_error(parse_status::missing_fields,
+                                      "Expected " + std::to_string(fieldNum) + " CSV-Fields, got " + std::to_string(i - 1) + " @ line " + std::to_string(this->_lineTracker) + "!",
+                                      this->_lineTracker, i - 1);
+                    return _status;
+                }
 
                 this->SkipField();
             }
-            field = this->NextField();
 
+            std::string error;
+            if(!detail::TryConvertField<StrTUtils, Converter>(value, this->NextField(), error))
+                _status.set_error(parse_status::conversion_failed, error, this->_lineTracker, fieldNum - 1);
+
+            return _status;
+        }
+
+#ifdef CSVREADER_HAS_EXCEPTIONS
+        // Begins with 1
+        /*!
+         * \brief Read out (peeking) a field without going to the next line.
+         */
+        template<typename T>
+        T ReadField(int fieldNum)
+        {
             T value;
-            Converter::Convert(&value, field);
+            if(!TryReadField(fieldNum, &value))
+            {
+                if(_status.code() == parse_status::missing_fields)
+                    throw std::logic_error(_status.reason());
+                _status.rethrow();
+            }
             return value;
         }
+#endif
+
+        /*!
+         * \brief Reads the fields from a range of an another line, without copying it.
+         *
+         * Used by CSVSubReader to read the field of the parent reader in place.
+         */
+        template<typename... Values>
+        const parse_status &TryReadDataRange(const detail::CSVFieldRef<StrT> &range, Values &&... allValues)
+        {
+            this->_lineTracker++;
+            this->BeginRange(range);
+            _currentTotalFields = sizeof...(allValues);
+            this->_fieldTracker = 0; // We need the tracker at 0 (because of out of range exception)
+            _status.clear();
+            ReadNext(std::forward<Values>(allValues)...);
+
+            return _status;
+        }
 
+        //! Status of the last reading
+        const parse_status &Status() const
+        {
+            return _status;
+        }
     };
 
     /*!
@@ -905,6 +1397,14 @@ namespace CSVReader
      * Converter is a wrapper for converting StrT fields to literal types:
      *      template<typename T>
      *      static void Convert(T* out, const StrType& field)
+     *
+     * Optionally, Converter may convert fields in the non-owning mode, straight from the line:
+     *      static void Convert(T* out, const StrType& line, size_t pos, size_t count)
+     * When this overload exists for T, no substring is made for the field.
+     *
+     * The non-throwing conversion is used in the first place when it exists for T:
+     *      static bool TryConvert(T* out, const StrType& line, size_t pos, size_t count, std::string& error)
+     * Otherwise, the exception thrown by Convert() becomes the reason of the failure.
      */
     template<class StrT, class StrTUtils, class Converter, class Reader, class CharT>
     constexpr CSVReader<Reader, StrT, CharT, StrTUtils, Converter> MakeCSVReader(Reader *reader, CharT /*sep*/)
@@ -950,9 +1450,19 @@ namespace CSVReader
         CSVSubReader(CharT sep, bool isOptional, Values &&... allValues) : _sep(sep), _val(allValues...), _isOptional(isOptional)
         {}
 
+#ifdef CSVREADER_HAS_EXCEPTIONS
         void ReadDataLine(const StrT &val)
         {
-            ReadDataLineImpl(val, detail::make_index_sequence<sizeof...(Values)> {});
+            parse_status status;
+            detail::CSVFieldRef<StrT> range = {&val, 0u, StrTUtils::length(val)};
+            if(!TryReadDataRange(range, status))
+                status.rethrow();
+        }
+#endif
+
+        bool TryReadDataRange(const detail::CSVFieldRef<StrT> &range, parse_status &status)
+        {
+            return TryReadDataRangeImpl(range, status, detail::make_index_sequence<sizeof...(Values)> {});
         }
 
         bool IsOptional() const
@@ -962,11 +1472,13 @@ namespace CSVReader
 
     private:
         template<std::size_t ...I>
-        void ReadDataLineImpl(const StrT &val, detail::index_sequence<I...>)
+        bool TryReadDataRangeImpl(const detail::CSVFieldRef<StrT> &range, parse_status &status, detail::index_sequence<I...>)
         {
-            DirectReader<StrT> subReader(val);
-            CSVReader<decltype(subReader), StrT, CharT, StrTUtils, Converter> subCSVReader(&subReader, _sep);
-            subCSVReader.ReadDataLine(std::get<I>(_val)...);
+            CSVReader<Reader, StrT, CharT, StrTUtils, Converter> subCSVReader(nullptr, _sep);
+            if(subCSVReader.TryReadDataRange(range, std::get<I>(_val)...))
+                return true;
+            status = subCSVReader.Status();
+            return false;
         }
 
         CharT _sep;
@@ -32,6 +32,13 @@
 
 #include "pge_file_lib_private.h"
 
+#ifndef PGE_FILES_QT
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#endif
+
 #if !defined(_MSC_VER) || _MSC_VER > 1800
 
 namespace CSVReader
@@ -156,7 +163,151 @@ namespace CSVReader
         }
     };
     #else
-    struct CSVPGESTRINGConverter : DefaultCSVConverter<std::string> {};
+    /*!
+     * \brief Converter of STL strings with the non-owning field mode:
+     * numbers and booleans are parsed straight from the range of the line,
+     * strings are only assigned to the target. Conversion errors are reported
+     * without exceptions, the error texts are the same as of std::sto*().
+     */
+    struct CSVPGESTRINGConverter : DefaultCSVConverter<std::string>
+    {
+        static bool TryConvert(double *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            return parseRange(out, line, pos, count, error, "stod", [](const char *s, char **e)
+            {
+                return std::strtod(s, e);
+            });
+        }
+        static bool TryConvert(float *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            return parseRange(out, line, pos, count, error, "stof", [](const char *s, char **e)
+            {
+                return std::strtof(s, e);
+            });
+        }
+        static bool TryConvert(int *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            long ret;
+            if(!parseRange(&ret, line, pos, count, error, "stoi", [](const char *s, char **e)
+                {
+                    return std::strtol(s, e, 10);
+                }))
+                return false;
+            if(ret < INT_MIN || ret > INT_MAX)
+            {
+                error = "stoi";
+                return false;
+            }
+            *out = static_cast<int>(ret);
+            return true;
+        }
+        static bool TryConvert(long *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            return parseRange(out, line, pos, count, error, "stol", [](const char *s, char **e)
+            {
+                return std::strtol(s, e, 10);
+            });
+        }
+        static bool TryConvert(long long *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            return parseRange(out, line, pos, count, error, "stoll", [](const char *s, char **e)
+            {
+                return std::strtoll(s, e, 10);
+            });
+        }
+        static bool TryConvert(long double *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            return parseRange(out, line, pos, count, error, "stold", [](const char *s, char **e)
+            {
+                return std::strtold(s, e);
+            });
+        }
+        static bool TryConvert(unsigned int *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            unsigned long ret;
+            if(!TryConvert(&ret, line, pos, count, error))
+                return false;
+            *out = static_cast<unsigned int>(ret);
+            return true;
+        }
+        static bool TryConvert(unsigned long *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            return parseRange(out, line, pos, count, error, "stoul", [](const char *s, char **e)
+            {
+                return std::strtoul(s, e, 10);
+            });
+        }
+        static bool TryConvert(unsigned long long *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            return parseRange(out, line, pos, count, error, "stoull", [](const char *s, char **e)
+            {
+                return std::strtoull(s, e, 10);
+            });
+        }
+        static bool TryConvert(bool *out, const std::string &line, size_t pos, size_t count, std::string &error)
+        {
+            const char *f = line.data() + pos;
+            if(count == 0 || (count == 1 && f[0] == '0'))
+                *out = false;
+            else if((count == 1 && f[0] == '1') || (count == 2 && f[0] == '!' && f[1] == '0'))
+                *out = true;
+            else
+            {
+                error = "Could not convert to bool (must be empty, \"0\", \"!0\" or \"1\"), got \"" + line.substr(pos, count) + "\"";
+                return false;
+            }
+            return true;
+        }
+        static bool TryConvert(std::string *out, const std::string &line, size_t pos, size_t count, std::string &)
+        {
+            out->assign(line, pos, count);
+            return true;
+        }
+
+    private:
+        /*!
+         * \brief Parses the field with the C function, detects errors the same way as std::sto*() does
+         * \param name Name of the std::sto*() function, used as the error text
+         *
+         * Short fields are copied into the stack buffer to get the terminating null
+         * character without making a new string
+         */
+        template<class T, class ParseFunc>
+        static bool parseRange(T *out, const std::string &line, size_t pos, size_t count, std::string &error, const char *name, ParseFunc parse)
+        {
+            char buf[64];
+            std::string longField;
+            const char *s;
+
+            if(count < sizeof(buf))
+            {
+                std::memcpy(buf, line.data() + pos, count);
+                buf[count] = '\0';
+                s = buf;
+            }
+            else
+            {
+                longField.assign(line, pos, count);
+                s = longField.c_str();
+            }
+
+            char *end;
+            const int savedErrno = errno;
+            errno = 0;
+            T ret = parse(s, &end);
+            const bool outOfRange = (errno == ERANGE);
+            errno = savedErrno;
+
+            if(end == s || outOfRange)
+            {
+                error = name;
+                return false;
+            }
+
+            *out = ret;
+            return true;
+        }
+    };
     #endif
 
     namespace detail
@@ -116,6 +116,60 @@ public:
     static bool WriteNonSMBX64MetaData(PGE_FileFormats_misc::TextOutput &out, MetaData /*Output*/ &metaData);
 
 
+    /*!
+     * \brief Parts of level and world files to load, may be combined as a bit mask
+     *
+     * Skipped parts are jumped over without being decoded, and their arrays
+     * are kept empty. Readers may load more than requested: the fixed-layout
+     * head of SMBX1...64 files (header, sections and player start points)
+     * is always decoded.
+     */
+    enum LoadSections
+    {
+        //! Header data: title, stars, music, custom settings, etc.
+        LOAD_HEADER         = 0x00000001,
+        //! Level sections
+        LOAD_SECTIONS       = 0x00000002,
+        //! Player start points
+        LOAD_PLAYERS        = 0x00000004,
+        //! Level blocks
+        LOAD_BLOCKS         = 0x00000008,
+        //! Level background objects
+        LOAD_BGO            = 0x00000010,
+        //! Level non-playable characters
+        LOAD_NPC            = 0x00000020,
+        //! Level warps and doors
+        LOAD_DOORS          = 0x00000040,
+        //! Level physical environment zones
+        LOAD_PHYSENV        = 0x00000080,
+        //! Layers
+        LOAD_LAYERS         = 0x00000100,
+        //! Classic events
+        LOAD_EVENTS         = 0x00000200,
+        //! Variables and arrays
+        LOAD_VARIABLES      = 0x00000400,
+        //! Scripts
+        LOAD_SCRIPTS        = 0x00000800,
+        //! SMBX-38A custom items setup
+        LOAD_CUSTOM38A      = 0x00001000,
+        //! Bookmarks, crash data and the ".meta" file
+        LOAD_META           = 0x00002000,
+        //! World map terrain tiles
+        LOAD_TILES          = 0x00010000,
+        //! World map sceneries
+        LOAD_SCENERY        = 0x00020000,
+        //! World map paths
+        LOAD_PATHS          = 0x00040000,
+        //! World map level entrances
+        LOAD_LEVELS         = 0x00080000,
+        //! World map music boxes
+        LOAD_MUSICBOXES     = 0x00100000,
+        //! World map area rectangles
+        LOAD_AREARECTS      = 0x00200000,
+        //! Everything
+        LOAD_ALL            = 0x7FFFFFFF
+    };
+
     /******************************Level files***********************************/
     /*!
      * \brief Supported level file formats
@@ -133,34 +187,62 @@ public:
      * \brief Parses a level file with auto-detection of a file type (SMBX1...64 LVL or PGE-LVLX)
      * \param [__in] filePath Full path to file which must be opened
      * \param [__out] FileData Level data structure
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * \return true if file successfully opened and parsed, false if error occouped
      */
-    static bool OpenLevelFile(const PGESTRING &filePath, LevelData &FileData);
+    static bool OpenLevelFile(const PGESTRING &filePath, LevelData &FileData,
+                              uint32_t loadSections = LOAD_ALL);
+    /*!
+     * \brief Parses a level file with auto-detection of a file type and reports level objects to callbacks
+     * \param [__in] filePath Full path to file which must be opened
+     * \param [__out] head Level data structure which receives the header, sections and player start points
+     * \param [__in] callbacks Receiver of other level objects
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
+     * \return true if file successfully opened and parsed, false if error occouped
+     */
+    static bool OpenLevelFile(const PGESTRING &filePath, LevelData &head, LevelLoadCallbacks &callbacks,
+                              uint32_t loadSections = LOAD_ALL);
     /**
      * @brief Parses a level file data with auto-detection of a file type (SMBX1...64 LVL or PGE-LVLX)
      * @param [__in] rawdata Raw data of the supported level file
      * @param [__in] filePath Full path to the file (if empty, custom data in the episode and in the custom directories are will be inaccessible)
      * @param [__out] FileData Level data structure
+     * @param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * @return true if file successfully opened and parsed, false if error occouped
      */
-    static bool OpenLevelRaw(PGESTRING &rawdata, const PGESTRING &filePath, LevelData &FileData);
+    static bool OpenLevelRaw(PGESTRING &rawdata, const PGESTRING &filePath, LevelData &FileData,
+                             uint32_t loadSections = LOAD_ALL);
 #ifdef PGEFL_ENABLE_RWOPS
     /**
      * @brief Parses a level file data with auto-detection of a file type (SMBX1...64 LVL or PGE-LVLX)
      * @param [__in] rwops SDL_RWops read-mode handle to a supported level file
      * @param [__in] filePath Full path to the file (if empty, custom data in the episode and in the custom directories are will be inaccessible)
      * @param [__out] FileData Level data structure
+     * @param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * @return true if file successfully opened and parsed, false if error occouped
      */
-    static bool OpenLevelRWops(SDL_RWops *rwops, const PGESTRING &filePath, LevelData &FileData);
+    static bool OpenLevelRWops(SDL_RWops *rwops, const PGESTRING &filePath, LevelData &FileData,
+                               uint32_t loadSections = LOAD_ALL);
 #endif
     /**
      * @brief Parses a level file data with auto-detection of a file type (SMBX1...64 LVL or PGE-LVLX)
      * @param [__in] file Input file descriptor
      * @param [__out] FileData Level data structure
+     * @param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
+     * @return true if file successfully opened and parsed, false if error occouped
+     */
+    static bool OpenLevelFileT(PGE_FileFormats_misc::TextInput &file, LevelData &FileData,
+                               uint32_t loadSections = LOAD_ALL);
+    /**
+     * @brief Parses a level file data with auto-detection of a file type and reports level objects to callbacks
+     * @param [__in] file Input file descriptor
+     * @param [__out] head Level data structure which receives the header, sections and player start points
+     * @param [__in] callbacks Receiver of other level objects
+     * @param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * @return true if file successfully opened and parsed, false if error occouped
      */
-    static bool OpenLevelFileT(PGE_FileFormats_misc::TextInput &file, LevelData &FileData);
+    static bool OpenLevelFileT(PGE_FileFormats_misc::TextInput &file, LevelData &head, LevelLoadCallbacks &callbacks,
+                               uint32_t loadSections = LOAD_ALL);
     /*!
      * \brief Parses a level file header only with auto-detection of a file type (SMBX1...64 LVL or PGE-LVLX)
      * \param [__in] filePath Full path to file which must be opened
@@ -257,9 +339,21 @@ public:
      * \brief Parses SMBX1...64 level file data
      * \param [__in] in Input file descriptor
      * \param [__out] FileData Level data structure
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * \return true if file successfully parsed, false if error occouped
      */
-    static bool ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelData /*output*/ &FileData);
+    static bool ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelData /*output*/ &FileData,
+                                  uint32_t loadSections = LOAD_ALL);
+    /*!
+     * \brief Parses SMBX1...64 level file data and reports level objects to callbacks
+     * \param [__in] in Input file descriptor
+     * \param [__out] head Level data structure which receives the header, sections and player start points
+     * \param [__in] callbacks Receiver of other level objects
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
+     * \return true if file successfully parsed, false if error occouped
+     */
+    static bool ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &head, LevelLoadCallbacks &callbacks,
+                                  uint32_t loadSections = LOAD_ALL);
     /*!
      * \brief Generates SMBX1...64 Level file data and saves into file
      * \param [__in] filePath Target file path
@@ -286,6 +380,19 @@ public:
     static bool WriteSMBX64LvlFile(PGE_FileFormats_misc::TextOutput &out, LevelData /*output*/ &FileData, unsigned int file_format = c_latest_version_smbx64);
 
     // SMBX-38A LVL File
+    /*!
+     * \brief Sets the number of threads used to read SMBX-38A level and world map files
+     * \param threads Maximal number of threads, 0 and 1 read all lines in the calling thread (default)
+     *
+     * Lines which don't depend on other lines (blocks, BGO, NPC, physical environments, warps, layers,
+     * tiles, scenery, paths and level entrances) are decoded by chunks on worker threads and merged
+     * in the file order, the result is same as on reading in the calling thread.
+     * The number of threads is limited by the number of CPU cores; files smaller than 128 KiB
+     * and all files on single-core machines are read in the calling thread.
+     * Experimental: takes effect only if the library was built with both PGEFL_ENABLE_THREADS and
+     * PGEFL_SMBX38A_READ_THREADS options (the latter is off by default), and never in the Qt build.
+     */
+    static void SetSMBX38AReadThreads(unsigned int threads);
     /*!
      * \brief Parses SMBX-38A level file header and skips other part of a file
      * \param [__in] filePath Full path to level file
@@ -328,9 +435,21 @@ public:
      * \brief Parses SMBX-38A level file data from raw data string
      * \param [__in] in File input descriptor
      * \param [__out] FileData FileData Level data structure
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
+     * \return true if file successfully parsed, false if error occouped
+     */
+    static bool ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelData /*output*/ &FileData,
+                                   uint32_t loadSections = LOAD_ALL);
+    /*!
+     * \brief Parses SMBX-38A level file data and reports level objects to callbacks
+     * \param [__in] in Input file descriptor
+     * \param [__out] head Level data structure which receives the header, sections and player start points
+     * \param [__in] callbacks Receiver of other level objects
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * \return true if file successfully parsed, false if error occouped
      */
-    static bool ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelData /*output*/ &FileData);
+    static bool ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &head, LevelLoadCallbacks &callbacks,
+                                   uint32_t loadSections = LOAD_ALL);
 #if 0 // Removed
     /*!
      * \brief Parses SMBX-38A level file data from raw data string (Old algorithm)
@@ -368,6 +487,25 @@ public:
 
 
     // PGE Extended Level File
+    /*!
+     * \brief Sets the number of threads used to decode PGE-X level and world map files
+     * \param threads Maximal number of threads, 0 and 1 decode all sections in the calling thread (default)
+     *
+     * Big sections which don't depend on other sections (blocks, BGO, NPC, tiles, etc.) are decoded
+     * on worker threads and merged in the file order, the result is same as on decoding in the calling thread.
+     * Takes no effect if the library was built without threads support.
+     */
+    static void SetPGEXReadThreads(unsigned int threads);
+    /*!
+     * \brief Sets the number of threads used to encode PGE-X level and world map files
+     * \param threads Maximal number of threads, 0 and 1 encode all sections in the calling thread (default)
+     *
+     * Big sections which don't depend on other sections (blocks, BGO, NPC, warps, classic events, tiles, etc.)
+     * are encoded into separated buffers on worker threads and written in the canonical order,
+     * the output is same as on encoding in the calling thread.
+     * Takes no effect if the library was built without threads support.
+     */
+    static void SetPGEXWriteThreads(unsigned int threads);
     /*!
      * \brief Parses PGE-X Level file header from the file
      * \param filePath Full path to PGE-X Level file
@@ -409,9 +547,21 @@ public:
      * \brief Parses PGE-X level file data from file input descriptor
      * \param [__in] in File Input descriptor
      * \param [__out] FileData Level data structure
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * \return true if file successfully parsed, false if error occouped
      */
-    static bool ReadExtendedLvlFile(PGE_FileFormats_misc::TextInput &in, LevelData /*output*/ &FileData);
+    static bool ReadExtendedLvlFile(PGE_FileFormats_misc::TextInput &in, LevelData /*output*/ &FileData,
+                                    uint32_t loadSections = LOAD_ALL);
+    /*!
+     * \brief Parses PGE-X level file data and reports level objects to callbacks
+     * \param [__in] in Input file descriptor
+     * \param [__out] head Level data structure which receives the header, sections and player start points
+     * \param [__in] callbacks Receiver of other level objects
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
+     * \return true if file successfully parsed, false if error occouped
+     */
+    static bool ReadExtendedLvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &head, LevelLoadCallbacks &callbacks,
+                                    uint32_t loadSections = LOAD_ALL);
     /*!
      * \brief Generates PGE-X Level file
      * \param [__in] filePath Target file path
@@ -434,6 +584,42 @@ public:
      */
     static bool WriteExtendedLvlFile(PGE_FileFormats_misc::TextOutput &out, LevelData /*output*/ &FileData);
 
+    // PGE Binary Level Cache
+    /*!
+     * \brief Loads level data from the binary level cache file
+     * \param [__in] filePath Full path to the binary level cache file
+     * \param [__out] FileData Level data structure
+     * \param [__in] sourcePath Full path to the level file the cache was made from, if not empty,
+     *                the cache is rejected when the level file has been changed since the cache was written
+     * \return true if file successfully loaded, false if error occouped or the cache is out of date
+     *
+     * Blocks, BGO, NPC and warps are stored as fixed-width records and get loaded
+     * from the memory-mapped file without any text parsing.
+     */
+    static bool ReadBinaryLvlFile(const PGESTRING &filePath, LevelData &FileData, const PGESTRING &sourcePath = PGESTRING());
+    /*!
+     * \brief Writes level data into the binary level cache file
+     * \param [__in] filePath Target file path
+     * \param [__in] FileData Level data structure
+     * \param [__in] sourcePath Full path to the level file the data was read from, its size,
+     *                modification time and hash are stored to check the cache is up to date
+     * \return true if file successfully saved, false if error occouped
+     *
+     * The cache keeps everything what the PGE-X level format keeps. It's not an interchange
+     * format: the layout may change between versions of the library, old caches are rejected then.
+     */
+    static bool WriteBinaryLvlFile(const PGESTRING &filePath, LevelData &FileData, const PGESTRING &sourcePath = PGESTRING());
+    /*!
+     * \brief Opens the level file through the binary level cache
+     * \param [__in] filePath Full path to the level file of any supported format
+     * \param [__in] cachePath Full path to the binary level cache file
+     * \param [__out] FileData Level data structure
+     * \return true if file successfully opened and parsed, false if error occouped
+     *
+     * Loads data from the cache if it's up to date, otherwise opens the level file and rebuilds the cache.
+     */
+    static bool OpenLevelFileCached(const PGESTRING &filePath, const PGESTRING &cachePath, LevelData &FileData);
+
     // Lvl Data
     /*!
      * \brief Generates blank initialized level data structure
@@ -576,34 +762,42 @@ public:
      * \brief Parses a world map file with auto-detection of a file type (SMBX1...64 LVL or PGE-WLDX)
      * \param [__in] filePath Full path to file which must be opened
      * \param [__out] data World data structure
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * \return true on success file reading, false if error was occouped
      */
-    static bool OpenWorldFile(const PGESTRING &filePath, WorldData &data);
+    static bool OpenWorldFile(const PGESTRING &filePath, WorldData &data,
+                              uint32_t loadSections = LOAD_ALL);
     /**
      * @brief Parses a world map file data with auto-detection of a file type (SMBX1...64 LVL or PGE-LVLX)
      * @param [__in] rawdata Raw data of the supported level file
      * @param [__in] filePath Full path to the file (if empty, custom data in the episode and in the custom directories are will be inaccessible)
      * @param [__out] FileData World data structure
+     * @param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * @return true if file successfully opened and parsed, false if error occouped
      */
-    static bool OpenWorldRaw(PGESTRING &rawdata, const PGESTRING &filePath, WorldData &FileData);
+    static bool OpenWorldRaw(PGESTRING &rawdata, const PGESTRING &filePath, WorldData &FileData,
+                             uint32_t loadSections = LOAD_ALL);
 #ifdef PGEFL_ENABLE_RWOPS
     /**
      * @brief Parses a world map file data with auto-detection of a file type (SMBX1...64 LVL or PGE-LVLX)
      * @param [__in] rwops SDL_RWops read-mode handle to a supported world file
      * @param [__in] filePath Full path to the file (if empty, custom data in the episode and in the custom directories are will be inaccessible)
      * @param [__out] FileData World data structure
+     * @param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * @return true if file successfully opened and parsed, false if error occouped
      */
-    static bool OpenWorldRWops(SDL_RWops *rwops, const PGESTRING &filePath, WorldData &FileData);
+    static bool OpenWorldRWops(SDL_RWops *rwops, const PGESTRING &filePath, WorldData &FileData,
+                               uint32_t loadSections = LOAD_ALL);
 #endif
     /**
      * @brief Parses a level world map data with auto-detection of a file type (SMBX1...64 LVL or PGE-LVLX)
      * @param [__in] file Input file descriptor
      * @param [__out] FileData World data structure
+     * @param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * @return true if file successfully opened and parsed, false if error occouped
      */
-    static bool OpenWorldFileT(PGE_FileFormats_misc::TextInput &file, WorldData &data);
+    static bool OpenWorldFileT(PGE_FileFormats_misc::TextInput &file, WorldData &data,
+                               uint32_t loadSections = LOAD_ALL);
     /*!
      * \brief Parses a world map file header only with auto-detection of a file type (SMBX1...64 LVL or PGE-WLDX)
      * \param [__in] filePath Full path to file which must be opened
@@ -688,9 +882,11 @@ public:
      * \brief Parses SMBX1...64 World map file from raw data from file input descriptor
      * \param [__in] in File Input descriptor
      * \param [__out] FileData World data structure
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * \return true if file successfully parsed, false if error occouped
      */
-    static bool ReadSMBX64WldFile(PGE_FileFormats_misc::TextInput &in, WorldData /*output*/ &FileData);
+    static bool ReadSMBX64WldFile(PGE_FileFormats_misc::TextInput &in, WorldData /*output*/ &FileData,
+                                  uint32_t loadSections = LOAD_ALL);
     /*!
      * \brief Saves level data into file of SMBX1...64 World map format
      * \param [__in] filePath Target file path
@@ -758,9 +954,11 @@ public:
      * \brief Parses SMBX-38A world map file data from raw data string
      * \param [__in] in File input descriptor
      * \param [__out] FileData FileData Level data structure
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * \return true if file successfully parsed, false if error occouped
      */
-    static bool ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput &in, WorldData /*output*/ &FileData);
+    static bool ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput &in, WorldData /*output*/ &FileData,
+                                   uint32_t loadSections = LOAD_ALL);
     /*!
      * \brief Generates SMBX-38A Level file data and saves into file
      * \param [__in] filePath Target file path
@@ -828,9 +1026,11 @@ public:
      * \brief Parses PGE-X World map file from file input descriptor
      * \param [__in] in File Input descriptor
      * \param [__out] FileData World map data structure
+     * \param [__in] loadSections Bit mask of parts to load, see FileFormats::LoadSections
      * \return true if file successfully parsed, false if error occouped
      */
-    static bool ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, WorldData /*output*/ &FileData);
+    static bool ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, WorldData /*output*/ &FileData,
+                                    uint32_t loadSections = LOAD_ALL);
     /*!
      * \brief Saves world map data into file of PGE-X World map format
      * \param [__in] filePath Target file path
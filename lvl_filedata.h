@@ -1135,6 +1135,136 @@ struct LevelData
     bool layerIsExist(const PGESTRING &title);
 };
 
+/*!
+ * \brief Receiver of level objects reported by level file readers one by one while they are parsed
+ *
+ * Every callback receives a complete object which can be moved out of the argument.
+ * Returning false from any callback interrupts the loading, and the reader fails.
+ *
+ * Header data, sections and player start points are not reported, they are stored
+ * into the head level data structure passed to the reader. Objects which are reported
+ * through callbacks are never stored into the head.
+ *
+ * An object which array ID was already reported replaces the previously reported one:
+ * PGE-X files may redefine layers and events of the same name, including the default
+ * ones which are initially present in the head.
+ */
+class LevelLoadCallbacks
+{
+public:
+    virtual ~LevelLoadCallbacks() = default;
+
+    //! Block was parsed
+    virtual bool onBlock(LevelBlock &block)
+    {
+        (void)block;
+        return true;
+    }
+
+    //! Background object was parsed
+    virtual bool onBGO(LevelBGO &bgo)
+    {
+        (void)bgo;
+        return true;
+    }
+
+    //! Non-playable character was parsed
+    virtual bool onNPC(LevelNPC &npc)
+    {
+        (void)npc;
+        return true;
+    }
+
+    //! Warp or door was parsed
+    virtual bool onWarp(LevelDoor &warp)
+    {
+        (void)warp;
+        return true;
+    }
+
+    //! Physical environment zone was parsed
+    virtual bool onPhysEnv(LevelPhysEnv &physEnv)
+    {
+        (void)physEnv;
+        return true;
+    }
+
+    //! Layer was parsed
+    virtual bool onLayer(LevelLayer &layer)
+    {
+        (void)layer;
+        return true;
+    }
+
+    //! Classic event was parsed
+    virtual bool onEvent(LevelSMBX64Event &event)
+    {
+        (void)event;
+        return true;
+    }
+
+    //! Local or global variable was parsed
+    virtual bool onVariable(LevelVariable &variable)
+    {
+        (void)variable;
+        return true;
+    }
+
+    //! Array was parsed
+    virtual bool onArray(LevelArray &array)
+    {
+        (void)array;
+        return true;
+    }
+
+    //! Script was parsed
+    virtual bool onScript(LevelScript &script)
+    {
+        (void)script;
+        return true;
+    }
+
+    //! SMBX-38A custom item setup was parsed
+    virtual bool onCustomItem38A(LevelItemSetup38A &setup)
+    {
+        (void)setup;
+        return true;
+    }
+};
+
+/*!
+ * \brief Load callbacks which store all reported objects into the level data structure
+ *
+ * Used by readers into the LevelData, may be subclassed to filter or to inspect objects.
+ */
+class LevelDataLoadCallbacks : public LevelLoadCallbacks
+{
+public:
+    /*!
+     * \brief Constructor
+     * \param target Level data where objects will be stored, usually same as the head given to the reader
+     */
+    explicit LevelDataLoadCallbacks(LevelData &target) :
+        m_target(target)
+    {}
+
+    bool onBlock(LevelBlock &block) override;
+    bool onBGO(LevelBGO &bgo) override;
+    bool onNPC(LevelNPC &npc) override;
+    bool onWarp(LevelDoor &warp) override;
+    bool onPhysEnv(LevelPhysEnv &physEnv) override;
+    bool onLayer(LevelLayer &layer) override;
+    bool onEvent(LevelSMBX64Event &event) override;
+    bool onVariable(LevelVariable &variable) override;
+    bool onArray(LevelArray &array) override;
+    bool onScript(LevelScript &script) override;
+    bool onCustomItem38A(LevelItemSetup38A &setup) override;
+
+protected:
+    //! Level data where objects are stored
+    LevelData &m_target;
+};
+
 
 
 #endif // LVL_FILEDATA_H
@@ -128,6 +128,19 @@ namespace PGE_FileFormats_misc
  */
 bool PGE_DetectSMBXFile(PGESTRING src);
 
+/*!
+ * \brief Replaces content of the file with the binary data
+ * \param filePath Full or relative path to the file
+ * \param data Pointer to the data to write
+ * \param size Size of the data in bytes
+ * \return true if file has been written successfully
+ *
+ * Data gets written into a temporary file which then replaces the target file,
+ * so readers of the file never get a partially written data. Every call uses its own
+ * temporary file, so concurrent writers of the same file don't mix their data.
+ */
+bool writeFileReplace(const PGESTRING &filePath, const char *data, size_t size);
+
 /*!
  * \brief Provides cross-platform file path calculation for a file names or paths
  */
@@ -173,6 +186,13 @@ public:
      * \return full directory path where actual file is located
      */
     PGESTRING dirpath();
+    /*!
+     * \brief Reads size and time of the last modification of the file
+     * \param [__out] size Size of the file in bytes
+     * \param [__out] mtime Time of the last modification in nanoseconds since epoch (precision depends on the platform and the file system)
+     * \return true if file exists and its attributes have been read
+     */
+    bool stamp(uint64_t &size, int64_t &mtime) const;
 private:
     /*!
      * \brief Recalculates all internal fields
@@ -261,6 +281,15 @@ public:
     TextOutput();
     virtual ~TextOutput() = default;
     virtual int write(PGESTRING buffer);
+    /*!
+     * \brief Writes the piece of raw data without making the string of it
+     * \param data Pointer to the data
+     * \param size Size of the data in bytes
+     * \return Number of written bytes or -1 on error
+     *
+     * Used by the << operators in the STL version. By default, the data is passed to the write(PGESTRING).
+     */
+    virtual int write(const char *data, size_t size);
     virtual int64_t tell();
     virtual int seek(int64_t pos, positions relativeTo);
     virtual PGESTRING getFilePath();
@@ -306,6 +335,7 @@ public:
     bool open(PGESTRING *rawString, outputMode mode = truncate);
     void close();
     int write(PGESTRING buffer);
+    int write(const char *data, size_t size);
     int64_t tell();
     int seek(int64_t pos, positions relativeTo);
 private:
@@ -458,12 +488,163 @@ private:
     //! File input stream used in Qt version of PGE file Library
     QTextStream stream;
 #else
+    /*!
+     * \brief Refill the read buffer with the next block of the file
+     * \return false if no more data can be read (EOF flag gets set)
+     */
+    bool fillBuffer();
+    /*!
+     * \brief Drops buffered data and synchronizes the buffer offset with the stream
+     */
+    void resetBuffer();
+
     //! File input stream used in STL version of PGE file Library
     FILE *stream = nullptr;
+    //! Block of the file data read ahead of the carriage
+    std::vector<char> m_buffer;
+    //! Count of valid bytes in the buffer
+    size_t m_bufferSize = 0;
+    //! Position of carriage inside of the buffer
+    size_t m_bufferPos = 0;
+    //! Absolute file position of the first buffer byte
+    int64_t m_bufferStartOffset = 0;
+    //! Last read has been attempted past the end of file (same as feof())
+    bool m_isEOF = false;
 #endif
 };
 
 
+/*!
+ * \brief Read-only text input which serves data straight from the memory-mapped file
+ *
+ * Files smaller than 1 MiB, and all files on platforms without memory mapping support,
+ * get read into an internal buffer once. Reading behaviour is same as of TextFileInput.
+ *
+ * \warning The mapped file must not be modified while it's opened: on POSIX systems
+ * reading of the data beyond the end of the truncated file raises SIGBUS. Write files
+ * which may be read concurrently through writeFileReplace(), which replaces the file
+ * instead of truncating it.
+ */
+class MappedTextInput: public TextInput
+{
+public:
+    /*!
+     * \brief Constructor
+     */
+    MappedTextInput();
+
+    /*!
+     * \brief Constructor with pre-opening of the file
+     * \param filePath Full or relative path to the file
+     * \param utf8 Use UTF-8 encoding or will be used local 8-bin encoding
+     */
+    MappedTextInput(const PGESTRING &filePath, bool utf8 = false);
+
+    /*!
+     * \brief Destructor
+     */
+    virtual ~MappedTextInput();
+
+    /*!
+     * \brief Opening and mapping of the file
+     * \param filePath Full or relative path to the file
+     * \param utf8 Use UTF-8 encoding or will be used local 8-bin encoding
+     * \return true if file has been opened successfully
+     */
+    bool open(const PGESTRING &filePath, bool utf8 = false);
+
+    /*!
+     * \brief Rewind to begin of the file and switch UTF8 mode (file stays mapped)
+     * \param utf8 Use UTF-8 encoding or will be used local 8-bin encoding
+     */
+    bool reOpen(bool utf8 = false);
+
+    /*!
+     * \brief Unmap and close currently opened file
+     */
+    void close();
+
+    /*!
+     * \brief Reads requested number of characters from a file
+     * \param ret - reset and filled with requested set of characters
+     * \param Maximal lenght of characters to read from file
+     */
+    void read(PGESTRING &ret, int64_t len);
+
+    /*!
+     * \brief Reads whole line before line feed character
+     * \param ret - reset and filled with gotten line
+     */
+    void readLine(PGESTRING &ret);
+
+    /*!
+     * \brief Reads whole line before line feed character or before first unquoted comma
+     * \param ret - reset and filled with gotten line
+     */
+    void readCVSLine(PGESTRING &ret);
+
+    /*!
+     * \brief Reads all data from a file at current position of carriage
+     * \return
+     */
+    PGESTRING readAll();
+
+    /*!
+     * \brief Is carriage position at end of file
+     * \return true if carriage position at end of file
+     */
+    bool eof();
+
+    /*!
+     * \brief Returns current position of carriage relative to begin of file
+     * \return current position of carriage relative to begin of file
+     */
+    int64_t tell();
+
+    /*!
+     * \brief Changes position of carriage to specific file position
+     * \param pos Target position of carriage
+     * \param relativeTo defines relativity of target position of carriage (current position, begin of file or end of file)
+     */
+    int seek(int64_t pos, positions relativeTo);
+
+    /*!
+     * \brief Raw file data (no copy), valid until file will be closed
+     * \return pointer to begin of file data
+     */
+    const char *data() const;
+
+    /*!
+     * \brief Size of the raw file data
+     * \return size of file in bytes
+     */
+    size_t size() const;
+
+private:
+    //! Read as UTF8 or as ANSI
+    bool m_utf8 = true;
+#ifdef PGE_FILES_QT
+    //! File handler used in Qt version of PGE file Library
+    QFile m_file;
+#else
+    //! Memory mapping handle (Win32 only)
+    void *m_mapHandle = nullptr;
+#endif
+    //! File data has been mapped and must be unmapped on close
+    bool m_isMapped = false;
+    //! File data loaded in case memory mapping is not available
+    std::string m_fallback;
+    //! Begin of the file data
+    const char *m_data = nullptr;
+    //! Size of the file data
+    size_t m_size = 0;
+    //! Position of carriage
+    size_t m_pos = 0;
+    //! Last read has been attempted past the end of file (same as feof())
+    bool m_isEOF = false;
+};
+
+
 class TextFileOutput: public TextOutput
 {
 public:
@@ -473,6 +654,13 @@ public:
      * \return true if file exists
      */
     static bool exists(const PGESTRING &filePath);
+    /*!
+     * \brief Closes the file which has been written by a file format writer
+     * \param file Opened file
+     * \param errorInfo Receives the error message if pending data was not written
+     * \return true if all data has been written into the file
+     */
+    static bool closeWritten(TextFileOutput &file, PGESTRING &errorInfo);
     /*!
      * \brief Constructor
      */
@@ -494,15 +682,26 @@ public:
      */
     bool open(PGESTRING filePath, bool utf8 = false, bool forceCRLF = false, outputMode mode = truncate);
     /*!
-     * \brief Close currently opened file
+     * \brief Writes pending data and closes currently opened file
+     * \return false if pending data was not completely written or the file failed to close
+     *
+     * Data is kept in the 64 KiB buffer before it gets written into the file, so a failed
+     * flushing of this buffer on closing is reported here, not by write().
      */
-    void close();
+    bool close();
     /*!
      * \brief Reads requested number of characters from a file
      * \param Maximal lenght of characters to read from file
      * \return string contains requested line of characters
      */
     int write(PGESTRING buffer);
+    /*!
+     * \brief Writes the piece of raw data, line feeds get expanded into CRLF if it's forced
+     * \param data Pointer to the data
+     * \param size Size of the data in bytes
+     * \return Number of written bytes, including inserted CR characters, or -1 on error
+     */
+    int write(const char *data, size_t size);
     /*!
      * \brief Returns current position of carriage relative to begin of file
      * \return current position of carriage relative to begin of file
@@ -526,8 +725,16 @@ private:
     //! File input stream used in Qt version of PGE file Library
     QTextStream stream;
 #else
+    /*!
+     * \brief Writes the pending CRLF-expanded data into the file
+     * \return true on success
+     */
+    bool flushBuffer();
+
     //! File input stream used in STL version of PGE file Library
     FILE *stream = nullptr;
+    //! Pending CRLF-expanded data, written into the file by blocks
+    std::string m_buffer;
 #endif
 };
 
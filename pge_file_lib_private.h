@@ -233,6 +233,7 @@ inline PGESTRING fromBoolToNum(bool num)
 namespace PGE_FileFormats_misc
 {
     PGESTRING    url_encode(const PGESTRING &sSrc);
+    void         url_encode(TextOutput &out, const PGESTRING &sSrc);
     std::string  base64_encode(uint8_t const *bytes_to_encode, size_t in_len, bool no_padding = false);
     std::string  base64_encode(std::string const &source, bool no_padding = false);
     std::string  base64_decode(std::string const &encoded_string);
@@ -255,6 +256,10 @@ inline PGESTRING PGE_URLDEC(const PGESTRING &src)
         return PGESTRING();
     return QUrl::fromPercentEncoding(src.toUtf8());
 }
+inline void PGE_URLDEC_INPLACE(PGESTRING &src)
+{
+    src = PGE_URLDEC(src);
+}
 #define PGE_BASE64ENC(src)   PGE_FileFormats_misc::base64_encode(src)
 #define PGE_BASE64ENC_nopad(src)   PGE_FileFormats_misc::base64_encode(src, true)
 #define PGE_BASE64DEC(src)   PGE_FileFormats_misc::base64_decode(src)
@@ -278,6 +283,7 @@ inline PGESTRING PGE_URLDEC(const PGESTRING &src)
 #include <climits>
 #include <cctype>
 #include <unordered_map>
+#include <type_traits>
 
 #ifdef _MSC_VER
 static char ToLowerFun(char ch)
@@ -340,7 +346,9 @@ namespace PGE_FileFormats_misc
     void RemoveSub(std::string &sInput, const std::string &sub);
     bool hasEnding(std::string const &fullString, std::string const &ending);
     PGESTRING url_encode(const PGESTRING &sSrc);
+    void url_encode(TextOutput &out, const PGESTRING &sSrc);
     PGESTRING url_decode(const std::string &sSrc);
+    void url_decode_inplace(std::string &sSrc);
     std::string base64_encode(unsigned char const *bytes_to_encode, size_t in_len, bool no_padding = false);
     std::string base64_encode(std::string const &source, bool no_padding = false);
     std::string base64_decode(std::string const &encoded_string);
@@ -466,22 +474,111 @@ inline PGESTRING removeSpaces(const PGESTRING &src)
 
 #define toPgeString(x) (x)
 
+namespace PGE_FileFormats_misc
+{
+    //! Size of the buffer enough to keep any number formatted by numToChars()
+    const size_t numCharsMax = 32;
+
+    template<typename T>
+    inline bool numIsNegative(T value, std::true_type /*signed*/)
+    {
+        return value < 0;
+    }
+
+    template<typename T>
+    inline bool numIsNegative(T, std::false_type /*unsigned*/)
+    {
+        return false;
+    }
+
+    template<typename T>
+    char *numToChars(char *buf, T value, std::true_type /*integral*/)
+    {
+        typedef typename std::make_unsigned<T>::type U;
+        char tmp[24];
+        char *end = tmp + sizeof(tmp), *p = end;
+        U u = static_cast<U>(value);
+        bool negative = numIsNegative(value, std::is_signed<T>());
+
+        if(negative)
+            u = static_cast<U>(0 - u);
+
+        do
+        {
+            *--p = static_cast<char>('0' + u % 10);
+            u /= 10;
+        } while(u != 0);
+
+        if(negative)
+            *buf++ = '-';
+
+        std::memcpy(buf, p, static_cast<size_t>(end - p));
+        return buf + (end - p);
+    }
+
+    /*!
+     * \brief Formats floating point number the same as the default formatting of the output stream ("%g")
+     * \param buf Target buffer of numCharsMax size at least
+     * \param value Floating point number
+     * \return Pointer to the end of the written number
+     */
+    char *floatToChars(char *buf, double value);
+
+    template<typename T>
+    inline char *numToChars(char *buf, T value, std::false_type /*floating point*/)
+    {
+        return floatToChars(buf, static_cast<double>(value));
+    }
+
+    /*!
+     * \brief Formats the number into the buffer without allocations, the text is the same as of fromNum()
+     * \param buf Target buffer of numCharsMax size at least
+     * \param value Integer or floating point number
+     * \return Pointer to the end of the written number, the text is not nul-terminated
+     */
+    template<typename T>
+    inline char *numToChars(char *buf, T value)
+    {
+        return numToChars(buf, value, std::integral_constant<bool, std::is_integral<T>::value>());
+    }
+
+    inline char *numToChars(char *buf, bool value)
+    {
+        *buf = value ? '1' : '0';
+        return buf + 1;
+    }
+}
+
 template<typename T>
 PGESTRING fromNum(T num)
 {
-    std::ostringstream n;
-    n << num;
-    return n.str();
+    char buf[PGE_FileFormats_misc::numCharsMax];
+    return PGESTRING(buf, PGE_FileFormats_misc::numToChars(buf, num));
+}
+
+// Characters are written as characters, the same as by the output stream
+inline PGESTRING fromNum(char num)
+{
+    return PGESTRING(1, num);
+}
+
+inline PGESTRING fromNum(signed char num)
+{
+    return PGESTRING(1, static_cast<char>(num));
+}
+
+inline PGESTRING fromNum(unsigned char num)
+{
+    return PGESTRING(1, static_cast<char>(num));
 }
 
 inline PGESTRING fromBoolToNum(bool num)
 {
-    std::ostringstream n;
-    n << static_cast<int>(num);
-    return n.str();
+    return PGESTRING(1, num ? '1' : '0');
 }
 #define PGE_URLENC(src) PGE_FileFormats_misc::url_encode(src)
 #define PGE_URLDEC(src) PGE_FileFormats_misc::url_decode(src)
+#define PGE_URLDEC_INPLACE(src) PGE_FileFormats_misc::url_decode_inplace(src)
 #define PGE_BASE64ENC(src)   PGE_FileFormats_misc::base64_encode(src)
 #define PGE_BASE64ENC_nopad(src) PGE_FileFormats_misc::base64_encode(src, true)
 #define PGE_BASE64DEC(src)   PGE_FileFormats_misc::base64_decode(src)
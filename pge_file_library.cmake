@@ -9,6 +9,7 @@ list(APPEND PGE_FILE_LIBRARY_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/smbx64/file_rw_lvl.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/smbx38a/file_rw_lvl_38a.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/pgex/file_rw_lvlx.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/pgex/file_rw_lvlb.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/pgex/file_rw_meta.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/smbx64/file_rw_npc_txt.cpp
     ${CMAKE_CURRENT_LIST_DIR}/src/smbx64/file_rw_sav.cpp
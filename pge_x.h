@@ -37,11 +37,184 @@
 #include "pge_file_lib_globs.h"
 #include "pge_file_lib_private.h"
 
+#include <type_traits>
+
+#ifndef PGE_FILES_QT
+#include <list>
+#include <cstring>
+#endif
+
 /*!
  * \brief Container of raw PGE-X data section
  */
 typedef PGEPAIR<PGESTRING, PGESTRINGList> PGEXSct;
 
+#ifndef PGE_FILES_QT
+/*!
+ * \brief Non-owning reference to a piece of PGE-X raw data
+ *
+ * Markers and values of the PGE-X data tree are referring the source data
+ * directly instead of keeping their own copies. The source data must stay
+ * alive and unchanged while the view is in use.
+ */
+class PGEXStrView
+{
+    //! Begin of the referred data
+    const char *m_data;
+    //! Length of the referred data
+    size_t      m_size;
+
+public:
+    typedef const char *const_iterator;
+
+    PGEXStrView() :
+        m_data(""), m_size(0)
+    {}
+
+    PGEXStrView(const char *data, size_t size) :
+        m_data(data), m_size(size)
+    {}
+
+    PGEXStrView(const char *str) :
+        m_data(str), m_size(strlen(str))
+    {}
+
+    explicit PGEXStrView(const std::string &str) :
+        m_data(str.data()), m_size(str.size())
+    {}
+
+    //! The view of a temporary string would refer the destroyed data
+    explicit PGEXStrView(std::string &&str) = delete;
+
+    inline const char *data() const
+    {
+        return m_data;
+    }
+
+    inline size_t size() const
+    {
+        return m_size;
+    }
+
+    inline bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    inline const char &operator[](size_t i) const
+    {
+        return m_data[i];
+    }
+
+    inline const_iterator begin() const
+    {
+        return m_data;
+    }
+
+    inline const_iterator end() const
+    {
+        return m_data + m_size;
+    }
+
+    /*!
+     * \brief Makes an owned copy of the referred data
+     * \return Copy of the referred data
+     */
+    inline std::string str() const
+    {
+        return std::string(m_data, m_size);
+    }
+
+    inline operator std::string() const
+    {
+        return str();
+    }
+
+    friend inline bool operator==(const PGEXStrView &a, const PGEXStrView &b)
+    {
+        return (a.m_size == b.m_size) && (memcmp(a.m_data, b.m_data, a.m_size) == 0);
+    }
+
+    friend inline bool operator!=(const PGEXStrView &a, const PGEXStrView &b)
+    {
+        return !(a == b);
+    }
+
+    friend inline bool operator==(const PGEXStrView &a, const char *b)
+    {
+        return a == PGEXStrView(b);
+    }
+
+    friend inline bool operator!=(const PGEXStrView &a, const char *b)
+    {
+        return !(a == PGEXStrView(b));
+    }
+
+    friend inline bool operator==(const PGEXStrView &a, const std::string &b)
+    {
+        return a == PGEXStrView(b.data(), b.size());
+    }
+
+    friend inline bool operator==(const std::string &a, const PGEXStrView &b)
+    {
+        return b == a;
+    }
+
+    friend inline bool operator!=(const PGEXStrView &a, const std::string &b)
+    {
+        return !(a == b);
+    }
+
+    friend inline bool operator!=(const std::string &a, const PGEXStrView &b)
+    {
+        return !(b == a);
+    }
+
+    friend inline std::string operator+(const std::string &a, const PGEXStrView &b)
+    {
+        std::string out;
+        out.reserve(a.size() + b.m_size);
+        out.append(a);
+        out.append(b.m_data, b.m_size);
+        return out;
+    }
+
+    friend inline std::string operator+(std::string &&a, const PGEXStrView &b)
+    {
+        a.append(b.m_data, b.m_size);
+        return std::move(a);
+    }
+
+    friend inline std::string operator+(const char *a, const PGEXStrView &b)
+    {
+        return std::string(a) + b;
+    }
+
+    friend inline std::string operator+(const PGEXStrView &a, const std::string &b)
+    {
+        return a.str() + b;
+    }
+
+    friend inline std::string operator+(const PGEXStrView &a, const char *b)
+    {
+        return a.str() + b;
+    }
+};
+
+inline bool IsEmpty(const PGEXStrView &str)
+{
+    return str.empty();
+}
+
+/*!
+ * \brief Type of markers and values in the PGE-X data tree: PGEXStrView in the STL mode
+ *        and QString in the Qt mode
+ */
+typedef PGEXStrView PGEXSTRING;
+#else
+typedef PGESTRING   PGEXSTRING;
+#endif
+
 /*!
  * \brief Provides parsing, generation and validating tools for PGE-X baded file formats such as LVLX, WLDX, SAVX and many other
  */
@@ -68,9 +241,9 @@ public:
     struct PGEX_Val
     {
         //! Name of the entry field
-        PGESTRING marker;
+        PGEXSTRING marker;
         //! Encoded value of the entry field
-        PGESTRING value;
+        PGEXSTRING value;
     };
 
     /*!
@@ -99,6 +272,78 @@ public:
         PGELIST<PGEX_Entry > subTree;
     };
 
+    /*!
+     * \brief Location of the value being parsed, the error message gets formatted on failure only
+     */
+    struct PGEX_ValueContext
+    {
+        //! Section of the value
+        const PGEX_Entry *section = nullptr;
+        //! Index of the data item in the section
+        pge_size_t item = 0;
+        //! Value itself
+        const PGEX_Val *value = nullptr;
+
+        /*!
+         * \brief Formats the syntax error message of the value
+         * \return Error message or an empty string if no values were parsed
+         */
+        PGESTRING errorString() const;
+    };
+
+    /*!
+     * \brief Sequential reader of the sub-structure arrays such as `["K:V;K:V;","K:V;"]`
+     *
+     * Every entry gets unescaped into the buffer reused between entries and gets split
+     * into values which are referring that buffer, so entries can be decoded right into
+     * target structures without of intermediate lists of strings.
+     * The array syntax must be validated by IsStringArray() before reading.
+     */
+    class PGEX_SubStructReader
+    {
+        //! Encoded array
+        PGEXSTRING m_array;
+        //! Position of the next entry at the encoded array
+        pge_size_t m_pos;
+        //! Unescaped data line of the current entry
+        PGESTRING m_buffer;
+        //! Values of the current entry
+        PGEX_Item m_entry;
+        //! Is the current entry a valid data line
+        bool m_entryValid;
+
+    public:
+        /*!
+         * \brief Constructor
+         * \param array Encoded sub-structure array, must stay alive while reading
+         */
+        explicit PGEX_SubStructReader(const PGEXSTRING &array);
+
+        /*!
+         * \brief Reads the next entry of the array
+         * \return false if no more entries left
+         */
+        bool next();
+
+        /*!
+         * \brief Is the current entry a valid data line?
+         * \return true if the data line of the entry is valid
+         */
+        inline bool entryValid() const
+        {
+            return m_entryValid;
+        }
+
+        /*!
+         * \brief Values of the current entry, valid until the next call of next()
+         * \return Data item of the current entry
+         */
+        inline const PGEX_Item &entry() const
+        {
+            return m_entry;
+        }
+    };
+
 #ifdef PGE_FILES_QT
     /*!
      * \brief QObject-based constructor Constructor
@@ -136,12 +381,30 @@ public:
      */
     explicit PGEFile(const PGESTRING &_rawData);
 
+    /*!
+     * \brief Constructor with taking of raw data without copying
+     * \param _rawData
+     */
+    explicit PGEFile(PGESTRING &&_rawData);
+
     /*!
      * \brief Stores raw data string
      * \param _rawData String contains raw data of entire file
      */
     void setRawData(const PGESTRING &_rawData);
 
+    /*!
+     * \brief Takes raw data string without copying
+     * \param _rawData String contains raw data of entire file
+     */
+    void setRawData(PGESTRING &&_rawData);
+
+    /*!
+     * \brief Sets names of data sections which must be jumped over by buildTreeFromRaw()
+     * \param names Names of data sections which will not appear in the data tree
+     */
+    void setSkippedSections(const PGESTRINGList &names);
+
     /*!
      * \brief Parses stored raw data into the data tree
      * \return
@@ -154,28 +417,149 @@ public:
      */
     PGESTRING lastError();
 
-    //! Full data tree of all parsed data
+    /*!
+     * \brief Full data tree of all parsed data
+     *
+     * In the STL mode markers and values are referring the stored raw data,
+     * therefore the tree gets cleared when raw data gets replaced.
+     */
     PGELIST<PGEX_Entry > dataTree;
 
 private:
+    friend class PGEXEventReader;
+
+    /*!
+     * \brief Range of the raw data
+     */
+    struct RawRange
+    {
+        //! Offset of the range begin
+        pge_size_t begin;
+        //! Length of the range
+        pge_size_t length;
+    };
+
+    /*!
+     * \brief Unparsed data section, refers lines in the stored raw data set
+     */
+    struct RawSection
+    {
+        //! Name of the data section
+        PGESTRING name;
+        //! Non-empty lines of the data section
+        PGELIST<RawRange> lines;
+    };
+
+    /*!
+     * \brief Parses a single raw line into the data item
+     * \param line Begin of the line data
+     * \param lineSize Length of the line
+     * \param dataItem Target data item where parsed values will be stored
+     * \return true if line is valid
+     */
+    static bool buildItem(const PGEChar *line, pge_size_t lineSize, PGEX_Item &dataItem);
+
     //! Last occouped error
     PGESTRING m_lastError;
     //! Stored raw data set
     PGESTRING m_rawData;
     //! Unparsed data separated to their data sections
-    PGELIST<PGEXSct > m_rawDataTree;
+    PGELIST<RawSection > m_rawDataTree;
+    //! Names of data sections which are not needed to be parsed
+    PGESTRINGList m_skippedSections;
+#ifndef PGE_FILES_QT
+    //! Values which are not a part of raw data (such as the content of plain text sections)
+    std::list<PGESTRING> m_ownedValues;
+#endif
 
     //Static functions
 public:
     /*!
      * \brief Builds a branch of PGE-X data tree
-     * \param List of raw data lines
+     * \param List of raw data lines, in the STL mode must stay alive while resulting branch is in use
      * \param _valid given value will accept 'true' if everything is fine or false if error was occouped
      * \return Parsed PGE-X tree branch
      */
     static PGEX_Entry buildTree(PGESTRINGList &src_data, bool *_valid = 0);
 
 
+    // /////////////Marker keys///////////////
+    /*!
+     * \brief Maximum length of the marker which has a distinct key
+     */
+    static const size_t markerKeyMaxLength = 7;
+
+    /*!
+     * \brief Computes key of the marker at compile time, used by the marker dispatch of readers
+     * \param marker Marker name literal, no longer than markerKeyMaxLength characters
+     * \return Unique key of the marker
+     */
+    template<size_t N>
+    static constexpr uint64_t markerKey(const char (&marker)[N])
+    {
+        static_assert((N > 1) && (N - 1 <= markerKeyMaxLength), "Marker must be non-empty and not longer than 7 characters");
+        return markerKeyPack(marker, N - 1, 0);
+    }
+
+    /*!
+     * \brief Computes key of the parsed marker
+     * \param marker Marker of the data tree value
+     * \return Unique key of the marker, or 0 if marker is empty, too long or has non-Latin1 characters
+     */
+    static inline uint64_t markerKey(const PGEXSTRING &marker)
+    {
+        const pge_size_t len = marker.size();
+        if(len == 0 || static_cast<size_t>(len) > markerKeyMaxLength)
+            return 0;
+
+        uint64_t key = static_cast<uint64_t>(len) << 56;
+#ifdef PGE_FILES_QT
+        for(int i = 0; i < len; i++)
+        {
+            ushort c = marker[i].unicode();
+            if(c > 0xFF)
+                return 0;
+            key |= static_cast<uint64_t>(c) << (i * 8);
+        }
+#else
+        const unsigned char *c = reinterpret_cast<const unsigned char *>(marker.data());
+        switch(len)
+        {
+        case 7:
+            key |= static_cast<uint64_t>(c[6]) << 48;
+            /* fallthrough */
+        case 6:
+            key |= static_cast<uint64_t>(c[5]) << 40;
+            /* fallthrough */
+        case 5:
+            key |= static_cast<uint64_t>(c[4]) << 32;
+            /* fallthrough */
+        case 4:
+            key |= static_cast<uint64_t>(c[3]) << 24;
+            /* fallthrough */
+        case 3:
+            key |= static_cast<uint64_t>(c[2]) << 16;
+            /* fallthrough */
+        case 2:
+            key |= static_cast<uint64_t>(c[1]) << 8;
+            /* fallthrough */
+        default:
+            key |= static_cast<uint64_t>(c[0]);
+        }
+#endif
+
+        return key;
+    }
+
+private:
+    static constexpr uint64_t markerKeyPack(const char *marker, pge_size_t len, pge_size_t i)
+    {
+        return (i == len) ?
+               (static_cast<uint64_t>(len) << 56) :
+               ((static_cast<uint64_t>(static_cast<unsigned char>(marker[i])) << (i * 8)) | markerKeyPack(marker, len, i + 1));
+    }
+
+public:
     // /////////////Validators///////////////
     /*!
      * \brief Validates title of data section
@@ -189,55 +573,55 @@ public:
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsQoutedString(const PGESTRING &in);// QUOTED STRING
+    static bool IsQoutedString(const PGEXSTRING &in);// QUOTED STRING
     /*!
      * \brief Is given value is a heximal number?
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsHex(const PGESTRING &in);// Hex Encoded String
+    static bool IsHex(const PGEXSTRING &in);// Hex Encoded String
     /*!
      * \brief Is given value is an unsigned integer number?
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsIntU(const PGESTRING &in);// UNSIGNED INT
+    static bool IsIntU(const PGEXSTRING &in);// UNSIGNED INT
     /*!
      * \brief Is given value is a signed integer number?
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsIntS(const PGESTRING &in);// SIGNED INT
+    static bool IsIntS(const PGEXSTRING &in);// SIGNED INT
     /*!
      * \brief Is given value is a floating point number?
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsFloat(const PGESTRING &in);// FLOAT
+    static bool IsFloat(const PGEXSTRING &in);// FLOAT
     /*!
      * \brief Is given value is a boolean degit?
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsBool(const PGESTRING &in);//BOOL
+    static bool IsBool(const PGEXSTRING &in);//BOOL
     /*!
      * \brief Is given value is a boolean array (string contains 0 or 1 degits only)?
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsBoolArray(const PGESTRING &in);//Boolean array
+    static bool IsBoolArray(const PGEXSTRING &in);//Boolean array
     /*!
      * \brief Is given value is an integer array?
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsIntArray(const PGESTRING &in);//Integer array
+    static bool IsIntArray(const PGEXSTRING &in);//Integer array
     /*!
      * \brief Is given value is a string array?
      * \param in Input data string with data required to valitade
      * \return true if given value is passed or false if value is invalid
      */
-    static bool IsStringArray(const PGESTRING &in);//String array
+    static bool IsStringArray(const PGEXSTRING &in);//String array
 
     //Split string into data values
     static PGELIST<PGESTRINGList> splitDataLine(const PGESTRING &src_data, bool *valid = nullptr);
@@ -343,25 +727,66 @@ public:
      * \param input Encoded PGE-X string value
      * \return Plain text string
      */
+#ifdef PGE_FILES_QT
     static PGESTRING X2STRING(PGESTRING input);
+#else
+    static PGESTRING X2STRING(const PGEXStrView &input);
+#endif
     /*!
      * \brief Decodes PGE-X String array into array of plain text strings
      * \param src Encoded PGE-X string value
      * \return List of plain text strings
      */
-    static PGESTRINGList X2STRArr(const PGESTRING &in, bool *_valid = nullptr);
+    static PGESTRINGList X2STRArr(const PGEXSTRING &in, bool *_valid = nullptr);
     /*!
      * \brief Decodes PGE-X String array into array of plain text strings
      * \param src Encoded PGE-X string value
      * \return List of plain text strings
      */
-    static PGELIST<long> X2IntArr(const PGESTRING &in, bool *_valid = nullptr);
+    static PGELIST<long> X2IntArr(const PGEXSTRING &in, bool *_valid = nullptr);
     /*!
      * \brief Decodes PGE-X Boolean array into array of boolean flags
      * \param src Encoded PGE-X boolean array
      * \return List of boolean flags
      */
-    static PGELIST<bool> X2BollArr(const PGESTRING &src);
+    static PGELIST<bool> X2BollArr(const PGEXSTRING &src);
+
+    /*!
+     * \brief Validates and decodes PGE-X unsigned integer in a single pass
+     * \param [__in]  in Encoded PGE-X value
+     * \param [__out] out Decoded number, kept untouched if value is invalid
+     * \return true if value is an unsigned integer which fits the type of the output
+     */
+    static bool X2IntU(const PGEXSTRING &in, int &out);
+    static bool X2IntU(const PGEXSTRING &in, unsigned int &out);
+    static bool X2IntU(const PGEXSTRING &in, long &out);
+    static bool X2IntU(const PGEXSTRING &in, unsigned long &out);
+    static bool X2IntU(const PGEXSTRING &in, long long &out);
+    static bool X2IntU(const PGEXSTRING &in, unsigned long long &out);
+    /*!
+     * \brief Validates and decodes PGE-X signed integer in a single pass
+     * \param [__in]  in Encoded PGE-X value
+     * \param [__out] out Decoded number, kept untouched if value is invalid
+     * \return true if value is a signed integer which fits the type of the output
+     */
+    static bool X2IntS(const PGEXSTRING &in, int &out);
+    static bool X2IntS(const PGEXSTRING &in, long &out);
+    static bool X2IntS(const PGEXSTRING &in, long long &out);
+    /*!
+     * \brief Validates and decodes PGE-X floating point number
+     * \param [__in]  in Encoded PGE-X value
+     * \param [__out] out Decoded number, kept untouched if value is invalid
+     * \return true if value is a floating point number which doesn't overflow the type of the output
+     */
+    static bool X2Float(const PGEXSTRING &in, float &out);
+    static bool X2Float(const PGEXSTRING &in, double &out);
+    /*!
+     * \brief Validates and decodes PGE-X boolean flag
+     * \param [__in]  in Encoded PGE-X value
+     * \param [__out] out Decoded flag, kept untouched if value is invalid
+     * \return true if value is a boolean digit
+     */
+    static bool X2Bool(const PGEXSTRING &in, bool &out);
 
     /*!
      * \brief Applies PGE-X escape sequensions to the plain text string
@@ -401,4 +826,346 @@ public:
 };
 
 
+/*!
+ * \brief Event-driven PGE-X parser, reads the data line by line and reports it
+ *        to the handler without building of the data tree
+ *
+ * Only one line of the input gets kept in the memory at once, therefore even big files
+ * are processed in constant memory. Unlike PGEFile::buildTreeFromRaw(), a malformed line
+ * doesn't turn the whole section into plain text, it gets reported as an invalid item.
+ */
+class PGEXEventReader
+{
+public:
+    /*!
+     * \brief Receiver of parse events, returning false from callbacks interrupts parsing
+     *        unless other is specified
+     */
+    class Handler
+    {
+    public:
+        virtual ~Handler() = default;
+
+        /*!
+         * \brief Data section begins
+         * \param name Name of the section
+         * \return true to process items of the section or false to skip the section entirely
+         */
+        virtual bool sectionBegin(const PGESTRING &name)
+        {
+            (void)name;
+            return true;
+        }
+
+        /*!
+         * \brief Data item begins
+         * \param index Index of the item in the section
+         * \return false to interrupt parsing
+         */
+        virtual bool itemBegin(pge_size_t index)
+        {
+            (void)index;
+            return true;
+        }
+
+        /*!
+         * \brief Value of the current data item
+         * \param marker Name of the field
+         * \param value Encoded value of the field, in the STL mode it's valid during this call only
+         * \return false to interrupt parsing
+         */
+        virtual bool value(const PGEXSTRING &marker, const PGEXSTRING &value)
+        {
+            (void)marker;
+            (void)value;
+            return true;
+        }
+
+        /*!
+         * \brief Data item ends
+         * \return false to interrupt parsing
+         */
+        virtual bool itemEnd()
+        {
+            return true;
+        }
+
+        /*!
+         * \brief Line of the section can't be parsed as data item
+         * \param index Index of the item in the section
+         * \param line Raw line data
+         * \return true to ignore the line or false to fail parsing
+         */
+        virtual bool invalidItem(pge_size_t index, const PGESTRING &line)
+        {
+            (void)index;
+            (void)line;
+            return false;
+        }
+
+        /*!
+         * \brief Data section ends, not called for skipped sections
+         * \param name Name of the section
+         * \return false to interrupt parsing
+         */
+        virtual bool sectionEnd(const PGESTRING &name)
+        {
+            (void)name;
+            return true;
+        }
+    };
+
+    /*!
+     * \brief Parses the PGE-X data and reports it to the handler
+     * \param in Input data
+     * \param handler Receiver of parse events
+     * \return true if entire data was parsed successfully, false on error or if parsing was interrupted
+     */
+    bool parse(PGE_FileFormats_misc::TextInput &in, Handler &handler);
+
+    /*!
+     * \brief Returns the last occurred error
+     * \return Last occurred error
+     */
+    PGESTRING lastError() const;
+
+    /*!
+     * \brief Returns number of the last read line
+     * \return Number of line counted from 1
+     */
+    long lineNumber() const;
+
+private:
+    //! Last occurred error
+    PGESTRING m_lastError;
+    //! Number of the last read line
+    long m_lineNumber = 0;
+};
+
+
+/*!
+ * \brief Builder of PGE-X data, appends sections, markers and encoded values into one buffer
+ *
+ * Unlike PGEFile::value() and PGEFile::Write*() functions, values are encoded directly
+ * into the buffer without temporary strings. The output is the same as of the concatenation
+ * of PGEFile::value() results: fields with empty encoded values are omitted.
+ *
+ * When the output is given, the data gets written into it each time the buffer gets full
+ * at the end of data line, and by flush().
+ */
+class PGEXWriter
+{
+public:
+    //! Size of the buffer which causes the writing into the output
+    static const pge_size_t defaultBufferSize = 65536;
+
+    /*!
+     * \brief Constructor of the builder which collects the data into the buffer only
+     * \param reserve Initial capacity of the buffer
+     */
+    explicit PGEXWriter(pge_size_t reserve = 0);
+
+    /*!
+     * \brief Constructor of the builder which writes the data into the output
+     * \param out Output which must stay alive while the builder is in use
+     * \param bufferSize Size of the buffer which causes the writing into the output
+     */
+    explicit PGEXWriter(PGE_FileFormats_misc::TextOutput &out, pge_size_t bufferSize = defaultBufferSize);
+
+    /*!
+     * \brief Built data which is not written into the output yet
+     * \return Raw PGE-X data
+     */
+    inline const PGESTRING &data() const
+    {
+        return m_buffer;
+    }
+
+    /*!
+     * \brief Is nothing built since the last clear() or flush()
+     */
+    inline bool empty() const
+    {
+        return m_buffer.empty();
+    }
+
+    /*!
+     * \brief Drops the built data but keeps the capacity of the buffer
+     */
+    inline void clear()
+    {
+        m_buffer.clear();
+    }
+
+    /*!
+     * \brief Writes the built data into the output and clears the buffer
+     */
+    void flush();
+
+    /*!
+     * \brief Appends the raw data as is
+     * \param raw Raw PGE-X data
+     */
+    void raw(const char *raw);
+    void raw(const PGESTRING &raw);
+
+    /*!
+     * \brief Appends the data built by another builder
+     * \param other Builder with the collected data
+     *
+     * Big data gets written into the output directly, without copying into the buffer.
+     */
+    void append(const PGEXWriter &other);
+
+    /*!
+     * \brief Appends the title of the section
+     * \param name Name of the section
+     */
+    void beginSection(const char *name);
+
+    /*!
+     * \brief Appends the end marker of the section
+     * \param name Name of the section
+     */
+    void endSection(const char *name);
+
+    /*!
+     * \brief Ends the data line, and writes the buffer into the output when it's full
+     */
+    void endLine();
+
+    /*!
+     * \brief Appends the field with the integer value, the same as PGEFile::WriteInt()
+     * \param marker Name of field
+     * \param value Integer value
+     */
+    template<typename T>
+    void writeInt(const char *marker, const T &value)
+    {
+        beginValue(marker);
+        appendNum(+value);
+        m_buffer.push_back(';');
+    }
+
+    /*!
+     * \brief Appends the field with the floating point value, the same as PGEFile::WriteFloat()
+     * \param marker Name of field
+     * \param value Floating point value
+     */
+    template<typename T>
+    void writeFloat(const char *marker, const T &value)
+    {
+        beginValue(marker);
+        if(value == 0)
+            m_buffer.push_back('0');
+        else
+            appendNum(+value);
+        m_buffer.push_back(';');
+    }
+
+    /*!
+     * \brief Appends the field with the boolean flag, the same as PGEFile::WriteBool()
+     * \param marker Name of field
+     * \param value Boolean flag
+     */
+    void writeBool(const char *marker, bool value);
+
+    /*!
+     * \brief Appends the field with the escaped string, the same as PGEFile::WriteStr()
+     * \param marker Name of field
+     * \param value Plain text string
+     */
+    void writeStr(const char *marker, const PGESTRING &value);
+
+    /*!
+     * \brief Appends the field with the string array, the same as PGEFile::WriteStrArr()
+     * \param marker Name of field
+     * \param value List of plain text strings, the field is omitted when it's empty
+     */
+    void writeStrArr(const char *marker, const PGESTRINGList &value);
+
+    /*!
+     * \brief Appends the field with the integer array, the same as PGEFile::WriteIntArr()
+     * \param marker Name of field
+     * \param value List of integer numbers, the field is omitted when it's empty
+     */
+    template<typename T>
+    void writeIntArr(const char *marker, const PGELIST<T> &value)
+    {
+        if(value.empty())
+            return;
+
+        beginValue(marker);
+        m_buffer.push_back('[');
+        for(pge_size_t i = 0; i < value.size(); i++)
+        {
+            if(i > 0)
+                m_buffer.push_back(',');
+            appendNum(+value[i]);
+        }
+        m_buffer.push_back(']');
+        m_buffer.push_back(';');
+    }
+
+    /*!
+     * \brief Appends the field with the boolean array, the same as PGEFile::WriteBoolArr()
+     * \param marker Name of field
+     * \param value List of boolean flags, the field is omitted when it's empty
+     */
+    void writeBoolArr(const char *marker, const PGELIST<bool> &value);
+
+    /*!
+     * \brief Begins the field with the string array whose elements are added one by one
+     * \param marker Name of field
+     *
+     * The field is omitted when no elements were added until endStrArr().
+     */
+    void beginStrArr(const char *marker);
+
+    /*!
+     * \brief Appends the element of the string array begun by beginStrArr()
+     * \param value Plain text string, commonly the data built by another writer
+     */
+    void addStrArrItem(const PGESTRING &value);
+
+    /*!
+     * \brief Ends the field with the string array begun by beginStrArr()
+     */
+    void endStrArr();
+
+    /*!
+     * \brief Appends the escaped string, the same as PGEFile::escapeString()
+     * \param [__out] output Target string
+     * \param [__in] input Plain text string
+     * \param [__in] addQuotes Adds quotes to begin and end of the string
+     */
+    static void appendEscaped(PGESTRING &output, const PGESTRING &input, bool addQuotes);
+
+private:
+    void beginValue(const char *marker);
+
+    //! Floating point numbers are formatted by the locale-independent floatToChars()
+    template<typename T>
+    void appendNum(T value)
+    {
+#ifdef PGE_FILES_QT
+        m_buffer.append(QString::number(value));
+#else
+        char buf[PGE_FileFormats_misc::numCharsMax];
+        m_buffer.append(buf, PGE_FileFormats_misc::numToChars(buf, value));
+#endif
+    }
+
+    //! Built data
+    PGESTRING m_buffer;
+    //! Output to write the data, or null to keep the data in the buffer
+    PGE_FileFormats_misc::TextOutput *m_out = nullptr;
+    //! Size of the buffer which causes the writing into the output
+    pge_size_t m_bufferSize = 0;
+    //! Position of the string array field begun by beginStrArr()
+    pge_size_t m_arrayBegin = 0;
+    //! Number of elements added to the string array
+    pge_size_t m_arrayItems = 0;
+};
+
 #endif // PGE_X_H
@@ -63,7 +63,7 @@ extern const int SMBX38A_NpcGeneratorDirections[29];
 // Common functions
 static auto PGEUrlDecodeFunc = [](PGESTRING &data)
 {
-    data = PGE_URLDEC(data);
+    PGE_URLDEC_INPLACE(data);
 };
 static auto PGEBase64DecodeFunc = [](PGESTRING &data)
 {
@@ -75,13 +75,44 @@ static auto PGEBase64DecodeFuncA = [](PGESTRING &data)
 };
 static auto PGELayerOrDefault = [](PGESTRING &data)
 {
-    data = (IsEmpty(data) ? "Default" : PGE_URLDEC(data));
+    if(IsEmpty(data))
+        data = "Default";
+    else
+        PGE_URLDEC_INPLACE(data);
 };
 static auto PGEFilpBool = [](bool &value)
 {
     value = !value;
 };
 
+/*!
+ * \brief String field which gets percent-encoded while writing into the text output
+ *
+ * Unlike PGE_URLENC(), doesn't make the temporary string of the encoded data.
+ */
+struct PGEUrlEncoded
+{
+    explicit PGEUrlEncoded(const PGESTRING &s) : str(s) {}
+    const PGESTRING &str;
+};
+
+inline PGE_FileFormats_misc::TextOutput &operator<<(PGE_FileFormats_misc::TextOutput &out, const PGEUrlEncoded &field)
+{
+    PGE_FileFormats_misc::url_encode(out, field.str);
+    return out;
+}
+
+/*!
+ * \brief Layer name field, the "Default" layer is written as an empty field
+ * \param layer Name of the layer
+ * \return Field to write
+ */
+inline PGEUrlEncoded PGEUrlEncodedLayer(const PGESTRING &layer)
+{
+    static const PGESTRING noLayer;
+    return PGEUrlEncoded((layer != "Default") ? layer : noLayer);
+}
+
 template<class T>
 constexpr std::function<void(T &)> MakeMinFunc(T min)
 {
@@ -34,6 +34,7 @@
 
 #include "pge_file_lib_globs.h"
 #include "pge_file_lib_private.h"
+#include <limits>
 
 /*!
  * \brief SMBX64 Standard validation and raw data conversion functions
@@ -263,6 +264,197 @@ namespace SMBX64
     }
 
 
+    /*****************Non-throwing field parsers*****************/
+    /*!
+     * \brief Parse unsigned integer value (same rules as of ReadUInt())
+     * \param in raw value
+     * \param out [__out] Parsed value
+     * \return true if value is valid
+     */
+    bool ParseUInt(const PGESTRING &in, unsigned long long &out);
+
+    /*!
+     * \brief Parse signed integer value (same rules as of ReadSInt())
+     * \param in raw value
+     * \param out [__out] Parsed value
+     * \return true if value is valid
+     */
+    bool ParseSInt(const PGESTRING &in, long long &out);
+
+    /*!
+     * \brief Parse floating point value and round it to integer (same rules as of ReadSIntFromFloat())
+     * \param in raw value
+     * \param out [__out] Parsed value
+     * \return true if value is valid
+     */
+    bool ParseSIntFromFloat(const PGESTRING &in, long long &out);
+
+    /*!
+     * \brief Parse floating point value (CSV fields never contain commas, only dot separator is possible)
+     * \param in raw value
+     * \param out [__out] Parsed value
+     * \return true if value is valid
+     */
+    bool ParseFloat(const PGESTRING &in, float &out);
+
+    /*!
+     * \brief Parse double floating point value
+     * \param in raw value
+     * \param out [__out] Parsed value
+     * \return true if value is valid
+     */
+    bool ParseFloat(const PGESTRING &in, double &out);
+
+    /*!
+     * \brief Parse CSV-boolean value (same rules as of ReadCSVBool())
+     * \param in raw value
+     * \param out [__out] Parsed value
+     * \return true if value is valid
+     */
+    bool ParseCSVBool(const PGESTRING &in, bool &out);
+
+    /*!
+     * \brief Exception-free reader of SMBX64 fields
+     *
+     * Reads fields of the text input into one reused buffer and converts
+     * them in place. Conversion functions return false on invalid data,
+     * the reason and the line number of the first failure are kept
+     * for the error report.
+     */
+    class FieldCursor
+    {
+    public:
+        enum Error
+        {
+            //! No errors
+            ERROR_NONE = 0,
+            //! Invalid unsigned integer field
+            ERROR_UINT,
+            //! Invalid or out of range signed integer field
+            ERROR_SINT,
+            //! Invalid floating point field
+            ERROR_FLOAT,
+            //! Invalid CSV-boolean field
+            ERROR_CSVBOOL
+        };
+
+        explicit FieldCursor(PGE_FileFormats_misc::TextInput &in) :
+            m_in(in)
+        {}
+
+        //! Current field data
+        inline PGESTRING &field()
+        {
+            return m_field;
+        }
+
+        //! Read the next field
+        inline void next()
+        {
+            m_in.readCVSLine(m_field);
+        }
+
+        template<typename T>
+        bool toUInt(T *out)
+        {
+            unsigned long long v;
+            if(!ParseUInt(m_field, v))
+                return fail(ERROR_UINT);
+            *out = static_cast<T>(v);
+            return true;
+        }
+
+        template<typename T>
+        bool toSInt(T *out)
+        {
+            long long v;
+            if(!ParseSInt(m_field, v) ||
+               (v < static_cast<long long>(std::numeric_limits<T>::min())) ||
+               (v > static_cast<long long>(std::numeric_limits<T>::max())))
+                return fail(ERROR_SINT);
+            *out = static_cast<T>(v);
+            return true;
+        }
+
+        template<typename T>
+        bool toSIntFromFloat(T *out)
+        {
+            long long v;
+            if(!ParseSIntFromFloat(m_field, v))
+                return fail(ERROR_FLOAT);
+            *out = static_cast<T>(v);
+            return true;
+        }
+
+        template<typename T>
+        bool toFloat(T *out)
+        {
+            if(!ParseFloat(m_field, *out))
+                return fail(ERROR_FLOAT);
+            return true;
+        }
+
+        template<typename T>
+        bool toCSVBool(T *out)
+        {
+            bool v;
+            if(!ParseCSVBool(m_field, v))
+                return fail(ERROR_CSVBOOL);
+            *out = static_cast<T>(v);
+            return true;
+        }
+
+        bool toStr(PGESTRING *out)
+        {
+            ReadStr(out, m_field);
+            return true;
+        }
+
+        template<typename T>
+        bool readUInt(T *out) { next(); return toUInt(out); }
+        template<typename T>
+        bool readSInt(T *out) { next(); return toSInt(out); }
+        template<typename T>
+        bool readSIntFromFloat(T *out) { next(); return toSIntFromFloat(out); }
+        template<typename T>
+        bool readFloat(T *out) { next(); return toFloat(out); }
+        template<typename T>
+        bool readCSVBool(T *out) { next(); return toCSVBool(out); }
+        bool readStr(PGESTRING *out) { next(); return toStr(out); }
+
+        //! Reason of the first failure
+        inline Error error() const
+        {
+            return m_error;
+        }
+
+        //! Line number of the first failure
+        inline long errorLine() const
+        {
+            return m_errorLine;
+        }
+
+        //! Human-readable reason of the first failure
+        PGESTRING errorString() const;
+
+    private:
+        bool fail(Error error)
+        {
+            if(m_error == ERROR_NONE)
+            {
+                m_error = error;
+                m_errorLine = m_in.getCurrentLineNumber();
+            }
+            return false;
+        }
+
+        PGE_FileFormats_misc::TextInput &m_in;
+        PGESTRING m_field;
+        Error m_error = ERROR_NONE;
+        long m_errorLine = -1;
+    };
+
+
     /*********************Validations**********************/
     /*!
      * \brief Validate Unsigned Integer value
@@ -350,6 +542,24 @@ namespace SMBX64
     }
 
     /******************Internal to RAW**********************/
+    /*!
+     * \brief Generate raw string line from the number
+     * \param input Source number
+     * \return ASCII encoded number with the line feed
+     */
+    template<typename T>
+    inline PGESTRING NumToLine(T input)
+    {
+#ifdef PGE_FILES_QT
+        return fromNum(input)+"\n";
+#else
+        char buf[PGE_FileFormats_misc::numCharsMax + 1];
+        char *end = PGE_FileFormats_misc::numToChars(buf, input);
+        *end++ = '\n';
+        return PGESTRING(buf, end);
+#endif
+    }
+
     /*!
      * \brief Generate raw string from integer value
      * \param input Source signed integer value
@@ -357,7 +567,7 @@ namespace SMBX64
      */
     template<typename T>
     inline PGESTRING WriteSInt(T input)
-    {  return fromNum(static_cast<long long>(input))+"\n"; }
+    {  return NumToLine(static_cast<long long>(input)); }
 
     /*!
      * \brief Generate raw string from unsigned integer value
@@ -366,7 +576,7 @@ namespace SMBX64
      */
     template<typename T>
     inline PGESTRING WriteUInt(T input)
-    {  return fromNum(static_cast<unsigned long long>(input))+"\n"; }
+    {  return NumToLine(static_cast<unsigned long long>(input)); }
 
     /*!
      * \brief Generate raw CVS-bool string from boolean value
@@ -374,20 +584,26 @@ namespace SMBX64
      * \return ASCII encoded CVS-bool value
      */
     inline PGESTRING WriteCSVBool(bool input)
-    {  return PGESTRING( (input)?"#TRUE#":"#FALSE#" )+"\n"; }
+    {  return PGESTRING((input) ? "#TRUE#\n" : "#FALSE#\n"); }
 
     /*!
      * \brief Convert string into valid CVS string line (line feeds are will be removed)
      * \param input Source string
      * \return Valid CVS string
      */
-    inline PGESTRING WriteStr(PGESTRING input)
+    inline PGESTRING WriteStr(const PGESTRING &input)
     {
-        input = PGE_RemSubSTRING(input, "\n");
-        input = PGE_RemSubSTRING(input, "\r");
-        input = PGE_RemSubSTRING(input, "\t");
-        input = PGE_RemSubSTRING(input, "\"");
-        return PGESTRING("\"")+input+PGESTRING("\"\n");
+        PGESTRING output;
+        output.reserve(input.size() + 3);
+        output.push_back(PGEChar('"'));
+        for(pge_size_t i = 0; i < input.size(); ++i)
+        {
+            const PGEChar c = input[i];
+            if((c != PGEChar('\n')) && (c != PGEChar('\r')) && (c != PGEChar('\t')) && (c != PGEChar('"')))
+                output.push_back(c);
+        }
+        output.append("\"\n");
+        return output;
     }
 
     /*!
@@ -395,11 +611,21 @@ namespace SMBX64
      * \param input Source string
      * \return Valid CVS string
      */
-    inline PGESTRING WriteStr_multiline(PGESTRING input)
+    inline PGESTRING WriteStr_multiline(const PGESTRING &input)
     {
-        input = PGE_RemSubSTRING(input, "\t");
-        input = PGE_ReplSTRING(input, "\"", "'");
-        return PGESTRING("\"")+input+PGESTRING("\"\n");
+        PGESTRING output;
+        output.reserve(input.size() + 3);
+        output.push_back(PGEChar('"'));
+        for(pge_size_t i = 0; i < input.size(); ++i)
+        {
+            const PGEChar c = input[i];
+            if(c == PGEChar('"'))
+                output.push_back(PGEChar('\''));
+            else if(c != PGEChar('\t'))
+                output.push_back(c);
+        }
+        output.append("\"\n");
+        return output;
     }
 
     /*!
@@ -408,7 +634,7 @@ namespace SMBX64
      * \return ASCII encoded floating point value
      */
     inline PGESTRING WriteFloat(float input)
-    {  return fromNum(input)+"\n"; }
+    {  return NumToLine(input); }
 
     /*!
      * \brief Generate raw string from double floating point value
@@ -416,7 +642,7 @@ namespace SMBX64
      * \return ASCII encoded floating point value
      */
     inline PGESTRING WriteFloat(double input)
-    {  return fromNum(input)+"\n"; }
+    {  return NumToLine(input); }
 
 
     /******************Units converters**********************/
@@ -436,6 +662,32 @@ namespace SMBX64
     inline double ms_to_65(double ms)
     { return ms * (65.0/1000.0); }
 
+
+    /******************Section skipping**********************/
+    /*!
+     * \brief Jumps over a number of fields without decoding them
+     * \param in File input descriptor
+     * \param line [__out] Receives the last read field
+     * \param fields Number of fields to read
+     */
+    inline void SkipFields(PGE_FileFormats_misc::TextInput &in, PGESTRING &line, int fields)
+    {
+        for(int i = 0; i < fields; ++i)
+            in.readCVSLine(line);
+    }
+
+    /*!
+     * \brief Jumps over the fixed-length records of a data section without decoding them
+     * \param in File input descriptor
+     * \param line [__inout] First field of the first record, receives the "next" separator
+     * \param fields Number of fields per record
+     */
+    inline void SkipRecords(PGE_FileFormats_misc::TextInput &in, PGESTRING &line, int fields)
+    {
+        while((line != "next") && (!in.eof()))
+            SkipFields(in, line, fields);
+    }
+
 }
 
 
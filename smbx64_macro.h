@@ -40,9 +40,20 @@
 #define SMBX64_FileBegin() unsigned int file_format = 0;   /*File format number*/\
                            PGESTRING line                  /*Current Line data*/
 
+//Field cursor based file begin, the "badfile" label must present to handle invalid fields
+#define SMBX64_CursorBegin(input) unsigned int file_format = 0;   /*File format number*/\
+                                  SMBX64::FieldCursor cursor(input);\
+                                  PGESTRING &line = cursor.field() /*Current Line data*/
+
 //Jump to next line
 #define nextLine() in.readCVSLine(line)
 
+//Read next field and convert it, jump to the "badfile" label on invalid data
+#define readField(type, target) do { if(!cursor.read##type(target)) goto badfile; } while(false)
+
+//Convert the current field, jump to the "badfile" label on invalid data
+#define convField(type, target) do { if(!cursor.to##type(target)) goto badfile; } while(false)
+
 //Version comparison
 #define ge(v) file_format>=(v)
 #define gt(v) file_format>(v)
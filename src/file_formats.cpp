@@ -28,8 +28,28 @@
 #include "pge_file_lib_private.h"
 
 #include "file_formats.h"
+#include "pge_file_lib_threads.h"
 
 
+unsigned int PGE_FileFormats_misc::g_pgexReadThreads = 0;
+unsigned int PGE_FileFormats_misc::g_pgexWriteThreads = 0;
+unsigned int PGE_FileFormats_misc::g_smbx38aReadThreads = 0;
+
+void FileFormats::SetPGEXReadThreads(unsigned int threads)
+{
+    PGE_FileFormats_misc::g_pgexReadThreads = threads;
+}
+
+void FileFormats::SetPGEXWriteThreads(unsigned int threads)
+{
+    PGE_FileFormats_misc::g_pgexWriteThreads = threads;
+}
+
+void FileFormats::SetSMBX38AReadThreads(unsigned int threads)
+{
+    PGE_FileFormats_misc::g_smbx38aReadThreads = threads;
+}
+
 PGESTRING FileFormats::removeQuotes(const PGESTRING &str)
 {
     PGESTRING target = str;
@@ -32,9 +32,17 @@
 #include "file_formats.h"
 #include "pge_file_lib_private.h"
 
-bool FileFormats::OpenLevelFile(const PGESTRING &filePath, LevelData &FileData)
+#ifdef PGE_FILES_QT
+//! Qt version keeps using of QTextStream based input with its encoding detection
+typedef PGE_FileFormats_misc::TextFileInput OpenFileInput;
+#else
+//! Level and world files are read straight from the memory-mapped file
+typedef PGE_FileFormats_misc::MappedTextInput OpenFileInput;
+#endif
+
+bool FileFormats::OpenLevelFile(const PGESTRING &filePath, LevelData &FileData, uint32_t loadSections)
 {
-    PGE_FileFormats_misc::TextFileInput file;
+    OpenFileInput file;
 
     if(!file.open(filePath, true))
     {
@@ -45,10 +53,26 @@ bool FileFormats::OpenLevelFile(const PGESTRING &filePath, LevelData &FileData)
         return false;
     }
 
-    return OpenLevelFileT(file, FileData);
+    return OpenLevelFileT(file, FileData, loadSections);
 }
 
-bool FileFormats::OpenLevelRaw(PGESTRING &rawdata, const PGESTRING &filePath, LevelData &FileData)
+bool FileFormats::OpenLevelFile(const PGESTRING &filePath, LevelData &head, LevelLoadCallbacks &callbacks, uint32_t loadSections)
+{
+    OpenFileInput file;
+
+    if(!file.open(filePath, true))
+    {
+        head.meta.ReadFileValid = false;
+        head.meta.ERROR_info = "Can't open file";
+        head.meta.ERROR_linedata.clear();
+        head.meta.ERROR_linenum = -1;
+        return false;
+    }
+
+    return OpenLevelFileT(file, head, callbacks, loadSections);
+}
+
+bool FileFormats::OpenLevelRaw(PGESTRING &rawdata, const PGESTRING &filePath, LevelData &FileData, uint32_t loadSections)
 {
     PGE_FileFormats_misc::RawTextInput file;
 
@@ -61,11 +85,11 @@ bool FileFormats::OpenLevelRaw(PGESTRING &rawdata, const PGESTRING &filePath, Le
         return false;
     }
 
-    return OpenLevelFileT(file, FileData);
+    return OpenLevelFileT(file, FileData, loadSections);
 }
 
 #ifdef PGEFL_ENABLE_RWOPS
-bool FileFormats::OpenLevelRWops(SDL_RWops *rwops, const PGESTRING &filePath, LevelData &FileData)
+bool FileFormats::OpenLevelRWops(SDL_RWops *rwops, const PGESTRING &filePath, LevelData &FileData, uint32_t loadSections)
 {
     PGE_FileFormats_misc::RWopsTextInput file;
 
@@ -78,23 +102,37 @@ bool FileFormats::OpenLevelRWops(SDL_RWops *rwops, const PGESTRING &filePath, Le
         return false;
     }
 
-    return OpenLevelFileT(file, FileData);
+    return OpenLevelFileT(file, FileData, loadSections);
 }
 #endif
 
-bool FileFormats::OpenLevelFileT(PGE_FileFormats_misc::TextInput &file, LevelData &FileData)
+bool FileFormats::OpenLevelFileT(PGE_FileFormats_misc::TextInput &file, LevelData &FileData, uint32_t loadSections)
+{
+    LevelDataLoadCallbacks loader(FileData);
+
+    if(!OpenLevelFileT(file, FileData, loader, loadSections))
+        return false;
+
+    // SMBX files don't store system layers and events
+    if(FileData.meta.RecentFormat != LevelData::PGEX)
+        LevelAddInternalEvents(FileData);
+
+    return true;
+}
+
+bool FileFormats::OpenLevelFileT(PGE_FileFormats_misc::TextInput &file, LevelData &head, LevelLoadCallbacks &callbacks, uint32_t loadSections)
 {
     PGESTRING firstLine;
-    CreateLevelData(FileData);
+    CreateLevelData(head);
 
-    FileData.meta.ERROR_info.clear();
+    head.meta.ERROR_info.clear();
     file.read(firstLine, 8);
     file.seek(0, PGE_FileFormats_misc::TextInput::begin);
 
     if(PGE_StartsWith(firstLine, "SMBXFile"))
     {
         //Read SMBX65-38A LVL File
-        if(!ReadSMBX38ALvlFile(file, FileData))
+        if(!ReadSMBX38ALvlFile(file, head, callbacks, loadSections))
             return false;
     }
     else if(PGE_FileFormats_misc::PGE_DetectSMBXFile(firstLine))
@@ -102,24 +140,25 @@ bool FileFormats::OpenLevelFileT(PGE_FileFormats_misc::TextInput &file, LevelDat
         //Disable UTF8 for SMBX64 files
         if(!file.reOpen(false))
         {
-            FileData.meta.ReadFileValid = false;
+            head.meta.ReadFileValid = false;
             return false;
         }
         //Read SMBX LVL File
-        if(!ReadSMBX64LvlFile(file, FileData))
+        if(!ReadSMBX64LvlFile(file, head, callbacks, loadSections))
             return false;
     }
     else
     {
         //Read PGE LVLX File
-        if(!ReadExtendedLvlFile(file, FileData))
+        if(!ReadExtendedLvlFile(file, head, callbacks, loadSections))
             return false;
     }
 
-    if(PGE_FileFormats_misc::TextFileInput::exists(file.getFilePath() + ".meta"))
+    if((loadSections & LOAD_META) &&
+       PGE_FileFormats_misc::TextFileInput::exists(file.getFilePath() + ".meta"))
     {
-        if(!ReadNonSMBX64MetaDataF(file.getFilePath() + ".meta", FileData.metaData))
-            FileData.meta.ERROR_info = "Can't open meta-file";
+        if(!ReadNonSMBX64MetaDataF(file.getFilePath() + ".meta", head.metaData))
+            head.meta.ERROR_info = "Can't open meta-file";
     }
 
     return true;
@@ -127,7 +166,7 @@ bool FileFormats::OpenLevelFileT(PGE_FileFormats_misc::TextInput &file, LevelDat
 
 bool FileFormats::OpenLevelFileHeader(const PGESTRING &filePath, LevelData &data)
 {
-    PGE_FileFormats_misc::TextFileInput file;
+    OpenFileInput file;
     data.meta.ERROR_info.clear();
 
     if(!file.open(filePath, true))
@@ -291,9 +330,9 @@ bool FileFormats::SaveLevelData(LevelData &FileData,
 
 
 
-bool FileFormats::OpenWorldFile(const PGESTRING &filePath, WorldData &data)
+bool FileFormats::OpenWorldFile(const PGESTRING &filePath, WorldData &data, uint32_t loadSections)
 {
-    PGE_FileFormats_misc::TextFileInput file;
+    OpenFileInput file;
 
     if(!file.open(filePath, true))
     {
@@ -304,10 +343,10 @@ bool FileFormats::OpenWorldFile(const PGESTRING &filePath, WorldData &data)
         return false;
     }
 
-    return OpenWorldFileT(file, data);
+    return OpenWorldFileT(file, data, loadSections);
 }
 
-bool FileFormats::OpenWorldRaw(PGESTRING &rawdata, const PGESTRING &filePath, WorldData &FileData)
+bool FileFormats::OpenWorldRaw(PGESTRING &rawdata, const PGESTRING &filePath, WorldData &FileData, uint32_t loadSections)
 {
     PGE_FileFormats_misc::RawTextInput file;
 
@@ -320,11 +359,11 @@ bool FileFormats::OpenWorldRaw(PGESTRING &rawdata, const PGESTRING &filePath, Wo
         return false;
     }
 
-    return OpenWorldFileT(file, FileData);
+    return OpenWorldFileT(file, FileData, loadSections);
 }
 
 #ifdef PGEFL_ENABLE_RWOPS
-bool FileFormats::OpenWorldRWops(SDL_RWops *rwops, const PGESTRING &filePath, WorldData &FileData)
+bool FileFormats::OpenWorldRWops(SDL_RWops *rwops, const PGESTRING &filePath, WorldData &FileData, uint32_t loadSections)
 {
     PGE_FileFormats_misc::RWopsTextInput file;
 
@@ -337,11 +376,11 @@ bool FileFormats::OpenWorldRWops(SDL_RWops *rwops, const PGESTRING &filePath, Wo
         return false;
     }
 
-    return OpenWorldFileT(file, FileData);
+    return OpenWorldFileT(file, FileData, loadSections);
 }
 #endif
 
-bool FileFormats::OpenWorldFileT(PGE_FileFormats_misc::TextInput &file, WorldData &data)
+bool FileFormats::OpenWorldFileT(PGE_FileFormats_misc::TextInput &file, WorldData &data, uint32_t loadSections)
 {
     PGESTRING firstLine;
 
@@ -354,7 +393,7 @@ bool FileFormats::OpenWorldFileT(PGE_FileFormats_misc::TextInput &file, WorldDat
     if(PGE_StartsWith(firstLine, "SMBXFile"))
     {
         //Read SMBX-38A WLD File
-        if(!ReadSMBX38AWldFile(file, data))
+        if(!ReadSMBX38AWldFile(file, data, loadSections))
             return false;
     }
     else if(PGE_FileFormats_misc::PGE_DetectSMBXFile(firstLine))
@@ -366,17 +405,18 @@ bool FileFormats::OpenWorldFileT(PGE_FileFormats_misc::TextInput &file, WorldDat
             return false;
         }
         //Read SMBX WLD File
-        if(!ReadSMBX64WldFile(file, data))
+        if(!ReadSMBX64WldFile(file, data, loadSections))
             return false;
     }
     else
     {
         //Read PGE WLDX File
-        if(!ReadExtendedWldFile(file, data))
+        if(!ReadExtendedWldFile(file, data, loadSections))
             return false;
     }
 
-    if(PGE_FileFormats_misc::TextFileInput::exists(file.getFilePath() + ".meta"))
+    if((loadSections & LOAD_META) &&
+       PGE_FileFormats_misc::TextFileInput::exists(file.getFilePath() + ".meta"))
     {
         if(!ReadNonSMBX64MetaDataF(file.getFilePath() + ".meta", data.metaData))
             data.meta.ERROR_info = "Can't open meta-file";
@@ -387,7 +427,7 @@ bool FileFormats::OpenWorldFileT(PGE_FileFormats_misc::TextInput &file, WorldDat
 
 bool FileFormats::OpenWorldFileHeader(const PGESTRING &filePath, WorldData &data)
 {
-    PGE_FileFormats_misc::TextFileInput file;
+    OpenFileInput file;
     data.meta.ERROR_info.clear();
 
     if(!file.open(filePath, true))
@@ -596,6 +596,92 @@ bool LevelData::layerIsExist(const PGESTRING &title)
     return false;
 }
 
+/*!
+ * \brief Stores the object, or replaces the stored one when the object of same array ID was already reported
+ */
+template<class T>
+static void storeLevelObject(PGELIST<T> &list, T &obj)
+{
+    if(!list.empty() && obj.meta.array_id <= list.back().meta.array_id)
+    {
+        for(pge_size_t i = 0; i < list.size(); i++)
+        {
+            if(list[i].meta.array_id == obj.meta.array_id)
+            {
+                list[i] = std::move(obj);
+                return;
+            }
+        }
+    }
+    list.push_back(std::move(obj));
+}
+
+bool LevelDataLoadCallbacks::onBlock(LevelBlock &block)
+{
+    m_target.blocks.push_back(std::move(block));
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onBGO(LevelBGO &bgo)
+{
+    m_target.bgo.push_back(std::move(bgo));
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onNPC(LevelNPC &npc)
+{
+    m_target.npc.push_back(std::move(npc));
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onWarp(LevelDoor &warp)
+{
+    m_target.doors.push_back(std::move(warp));
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onPhysEnv(LevelPhysEnv &physEnv)
+{
+    m_target.physez.push_back(std::move(physEnv));
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onLayer(LevelLayer &layer)
+{
+    storeLevelObject(m_target.layers, layer);
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onEvent(LevelSMBX64Event &event)
+{
+    storeLevelObject(m_target.events, event);
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onVariable(LevelVariable &variable)
+{
+    m_target.variables.push_back(std::move(variable));
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onArray(LevelArray &array)
+{
+    m_target.arrays.push_back(std::move(array));
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onScript(LevelScript &script)
+{
+    m_target.scripts.push_back(std::move(script));
+    return true;
+}
+
+bool LevelDataLoadCallbacks::onCustomItem38A(LevelItemSetup38A &setup)
+{
+    m_target.custom38A_configs.push_back(std::move(setup));
+    return true;
+}
+
 bool LevelSMBX64Event::ctrlKeyPressed() const
 {
     return ctrl_up ||
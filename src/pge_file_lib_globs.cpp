@@ -43,10 +43,36 @@
  */
 #define PATH_MAX 2048
 #endif
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <atomic>
+#include <cerrno>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 #else
 #include <QFileInfo>
+#include <QSaveFile>
 #endif
 #include <memory>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <clocale>
+
+#if !defined(PGE_FILES_QT) && !defined(PGEFL_DISABLE_MMAP)
+#   if defined(_WIN32)
+#       define PGEFL_MMAP_WIN32
+#   elif defined(__unix__) || defined(__APPLE__) || defined(__HAIKU__)
+#       define PGEFL_MMAP_POSIX
+#       include <sys/mman.h>
+#       include <sys/stat.h>
+#       include <fcntl.h>
+#       include <unistd.h>
+#   endif
+#endif
 
 namespace PGE_FileFormats_misc
 {
@@ -177,28 +203,57 @@ PGESTRING url_encode(const PGESTRING &sSrc)
         return sSrc;
     const char DEC2HEX[16 + 1] = "0123456789ABCDEF";
 #ifndef PGE_FILES_QT
-    const uint8_t *pSrc = reinterpret_cast<const uint8_t *>(sSrc.c_str());
+    const std::string &ssSrc = sSrc;
 #else
     std::string ssSrc = sSrc.toStdString();
-    const uint8_t *pSrc = reinterpret_cast<const uint8_t *>(ssSrc.c_str());
 #endif
-    const size_t SRC_LEN = static_cast<size_t>(sSrc.length());
-    std::unique_ptr<uint8_t[]> pStart(new uint8_t[SRC_LEN * 3]);
-    uint8_t *pEnd = pStart.get();
+    const uint8_t *pSrc = reinterpret_cast<const uint8_t *>(ssSrc.c_str());
+    const size_t SRC_LEN = ssSrc.size();
     const uint8_t *const SRC_END = pSrc + SRC_LEN;
+
+    // Every byte takes exactly three characters, write them straight into the result
+    std::string sResult;
+    sResult.resize(SRC_LEN * 3);
+    char *pEnd = &sResult[0];
     for(; pSrc < SRC_END; ++pSrc)
     {
         //Do full encoding!
         *pEnd++ = '%';
-        *pEnd++ = static_cast<uint8_t>(DEC2HEX[*pSrc >> 4]);
-        *pEnd++ = static_cast<uint8_t>(DEC2HEX[*pSrc & 0x0F]);
+        *pEnd++ = DEC2HEX[*pSrc >> 4];
+        *pEnd++ = DEC2HEX[*pSrc & 0x0F];
     }
 #ifndef PGE_FILES_QT
-    PGESTRING sResult(reinterpret_cast<char *>(pStart.get()), reinterpret_cast<char *>(pEnd));
+    return sResult;
 #else
-    PGESTRING sResult = QString::fromUtf8(reinterpret_cast<char *>(pStart.get()), static_cast<int>(pEnd - pStart.get()));
+    return QString::fromLatin1(sResult.data(), static_cast<int>(sResult.size()));
+#endif
+}
+
+void url_encode(TextOutput &out, const PGESTRING &sSrc)
+{
+#ifndef PGE_FILES_QT
+    const char DEC2HEX[16 + 1] = "0123456789ABCDEF";
+    const uint8_t *pSrc = reinterpret_cast<const uint8_t *>(sSrc.c_str());
+    const uint8_t *const SRC_END = pSrc + sSrc.size();
+    // Encode by pieces of 256 bytes into the stack buffer
+    char buffer[256 * 3];
+
+    while(pSrc < SRC_END)
+    {
+        const size_t chunk = std::min(static_cast<size_t>(SRC_END - pSrc), sizeof(buffer) / 3);
+        const uint8_t *const CHUNK_END = pSrc + chunk;
+        char *pEnd = buffer;
+        for(; pSrc < CHUNK_END; ++pSrc)
+        {
+            *pEnd++ = '%';
+            *pEnd++ = DEC2HEX[*pSrc >> 4];
+            *pEnd++ = DEC2HEX[*pSrc & 0x0F];
+        }
+        out.write(buffer, static_cast<size_t>(pEnd - buffer));
+    }
+#else
+    out << url_encode(sSrc);
 #endif
-    return sResult;
 }
 
 #ifndef PGE_FILES_QT
@@ -226,32 +281,35 @@ const int_fast8_t HEX2DEC[256] =
     /* F */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
 };
 
-PGESTRING url_decode(const std::string &sSrc)
+void url_decode_inplace(std::string &sSrc)
 {
-    if(sSrc.empty())
-        return sSrc;
     // Note from RFC1630: "Sequences which start with a percent
     // sign but are not followed by two hexadecimal characters
     // (0-9, A-F) are reserved for future extension"
-    const uint8_t *pSrc = reinterpret_cast<const uint8_t *>(sSrc.c_str());
-    const size_t SRC_LEN = sSrc.length();
-    const uint8_t *const SRC_END = pSrc + SRC_LEN;
+    const size_t SRC_LEN = sSrc.size();
+    if(SRC_LEN < 3)
+        return; // Too short to contain any escape
+
+    char *const pStart = &sSrc[0];
+    char *const SRC_END = pStart + SRC_LEN;
     // last decodable '%'
-    const uint8_t *const SRC_LAST_DEC = SRC_END - 2;
+    char *const SRC_LAST_DEC = SRC_END - 2;
+
+    // Most of strings have no escapes at all, keep them untouched
+    char *pSrc = reinterpret_cast<char *>(std::memchr(pStart, '%', static_cast<size_t>(SRC_LAST_DEC - pStart)));
+    if(!pSrc)
+        return;
 
-    char *pStart = reinterpret_cast<char *>(std::malloc(SRC_LEN + 1));
-    if(!pStart)
-        return "";
-    std::memset(pStart, 0, SRC_LEN + 1);
-    char *pEnd = pStart;
+    // The decoded string is never longer than the source, decode it in place
+    char *pEnd = pSrc;
 
     while(pSrc < SRC_LAST_DEC)
     {
         if(*pSrc == '%')
         {
             int_fast8_t dec1, dec2;
-            if(-1 != (dec1 = HEX2DEC[*(pSrc + 1)])
-               && -1 != (dec2 = HEX2DEC[*(pSrc + 2)]))
+            if(-1 != (dec1 = HEX2DEC[static_cast<uint8_t>(*(pSrc + 1))])
+               && -1 != (dec2 = HEX2DEC[static_cast<uint8_t>(*(pSrc + 2))]))
             {
                 *pEnd++ = static_cast<char>((dec1 << 4) + dec2);
                 pSrc += 3;
@@ -259,16 +317,26 @@ PGESTRING url_decode(const std::string &sSrc)
             }
         }
 
-        *pEnd++ = static_cast<char>(*pSrc++);
+        // Move the plain run up to the next '%'
+        char *pNext = reinterpret_cast<char *>(std::memchr(pSrc + 1, '%', static_cast<size_t>(SRC_LAST_DEC - pSrc - 1)));
+        size_t run = static_cast<size_t>((pNext ? pNext : SRC_LAST_DEC) - pSrc);
+        if(pEnd != pSrc)
+            std::memmove(pEnd, pSrc, run);
+        pEnd += run;
+        pSrc += run;
     }
 
     // the last 2- chars
     while(pSrc < SRC_END)
-        *pEnd++ = static_cast<char>(*pSrc++);
+        *pEnd++ = *pSrc++;
 
-    std::string::size_type pLen = static_cast<std::string::size_type>(pEnd - pStart);
-    std::string sResult(pStart, pLen);
-    std::free(pStart);
+    sSrc.resize(static_cast<size_t>(pEnd - pStart));
+}
+
+PGESTRING url_decode(const std::string &sSrc)
+{
+    std::string sResult(sSrc);
+    url_decode_inplace(sResult);
     return sResult;
 }
 #endif
@@ -489,6 +557,127 @@ std::string base64_decode(std::string const &encoded_string)
     return ret;
 }
 
+#ifndef PGE_FILES_QT
+char *floatToChars(char *buf, double value)
+{
+    // Whole numbers below the exponent notation limit are common in files, they
+    // are printed the same as integers. The negative zero is printed as "-0".
+    if((value > -1e6) && (value < 1e6) && (value == static_cast<double>(static_cast<long>(value))) &&
+       !((value == 0.0) && std::signbit(value)))
+        return numToChars(buf, static_cast<long>(value));
+
+    int len = std::snprintf(buf, numCharsMax, "%g", value);
+    if(len <= 0)
+        return buf;
+
+    // The printf() follows the LC_NUMERIC locale, while files always use the dot
+    const char *point = std::localeconv()->decimal_point;
+    if(point && (point[0] != '.' || point[1] != '\0'))
+    {
+        size_t pointLen = std::strlen(point);
+        char *found = (pointLen > 0) ? std::strstr(buf, point) : nullptr;
+        if(found)
+        {
+            *found = '.';
+            std::memmove(found + 1, found + pointLen, static_cast<size_t>(buf + len - (found + pointLen)));
+            len -= static_cast<int>(pointLen - 1);
+        }
+    }
+
+    return buf + len;
+}
+#endif
+
+#ifndef PGE_FILES_QT
+/*!
+ * \brief Creates a new temporary file next to the target file
+ * \param [__in] filePath Full path to the target file
+ * \param [__out] tempPath Full path to the created file
+ * \return Opened file or nullptr on error
+ *
+ * Name of the file is unique for every process and call, so concurrent writers of the same file never share it.
+ */
+static FILE *openTempFile(const std::string &filePath, std::string &tempPath)
+{
+    static std::atomic<unsigned int> counter(0);
+#   ifdef _WIN32
+    const unsigned long pid = GetCurrentProcessId();
+#   else
+    const unsigned long pid = static_cast<unsigned long>(getpid());
+#   endif
+
+    for(int attempt = 0; attempt < 100; ++attempt)
+    {
+        tempPath = filePath + "." + std::to_string(pid) + "-" + std::to_string(counter++) + ".tmp";
+#   ifdef _WIN32
+        int fd = _wopen(Str2WStr(tempPath).c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE);
+#   else
+        int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+#   endif
+        if(fd < 0)
+        {
+            if(errno == EEXIST)
+                continue; // Left by a crashed process with the same ID
+            return nullptr;
+        }
+
+#   ifdef _WIN32
+        FILE *f = _fdopen(fd, "wb");
+        if(!f)
+        {
+            _close(fd);
+            _wremove(Str2WStr(tempPath).c_str());
+        }
+#   else
+        FILE *f = fdopen(fd, "wb");
+        if(!f)
+        {
+            ::close(fd);
+            remove(tempPath.c_str());
+        }
+#   endif
+        return f;
+    }
+
+    return nullptr;
+}
+#endif
+
+bool writeFileReplace(const PGESTRING &filePath, const char *data, size_t size)
+{
+#ifdef PGE_FILES_QT
+    QSaveFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly))
+        return false;
+    if(file.write(data, static_cast<qint64>(size)) != static_cast<qint64>(size))
+    {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+#else
+    std::string tempPath;
+    FILE *f = openTempFile(filePath, tempPath);
+    if(!f)
+        return false;
+
+    bool ok = (size == 0) || (fwrite(data, 1, size, f) == size);
+    ok = (fclose(f) == 0) && ok;
+
+#   ifdef _WIN32
+    ok = ok && MoveFileExW(Str2WStr(tempPath).c_str(), Str2WStr(filePath).c_str(), MOVEFILE_REPLACE_EXISTING);
+    if(!ok)
+        _wremove(Str2WStr(tempPath).c_str());
+#   else
+    ok = ok && (rename(tempPath.c_str(), filePath.c_str()) == 0);
+    if(!ok)
+        remove(tempPath.c_str());
+#   endif
+
+    return ok;
+#endif
+}
+
 bool TextFileInput::exists(const PGESTRING &filePath)
 {
 #ifdef PGE_FILES_QT
@@ -578,6 +767,14 @@ int TextOutput::write(PGESTRING)
 {
     return 0;
 }
+int TextOutput::write(const char *data, size_t size)
+{
+#ifdef PGE_FILES_QT
+    return write(QString::fromUtf8(data, static_cast<int>(size)));
+#else
+    return write(PGESTRING(data, size));
+#endif
+}
 int64_t TextOutput::tell()
 {
     return 0;
@@ -803,6 +1000,9 @@ void RawTextOutput::close()
 
 int RawTextOutput::write(PGESTRING buffer)
 {
+#ifndef PGE_FILES_QT
+    return write(buffer.data(), buffer.size());
+#else
     if(!m_data) return -1;
     int64_t written = 0;
 fillEnd:
@@ -826,6 +1026,30 @@ fillEnd:
             goto fillEnd;
     }
     return static_cast<int>(written);
+#endif
+}
+
+int RawTextOutput::write(const char *data, size_t size)
+{
+#ifdef PGE_FILES_QT
+    return TextOutput::write(data, size);
+#else
+    if(!m_data) return -1;
+
+    size_t pos = static_cast<size_t>(m_pos);
+    if(pos >= m_data->size())
+        m_data->append(data, size);
+    else
+    {
+        // Overwrite the existing data, and append the rest
+        size_t over = std::min(size, m_data->size() - pos);
+        m_data->replace(pos, over, data, over);
+        m_data->append(data + over, size - over);
+    }
+
+    m_pos = static_cast<int64_t>(pos + size);
+    return static_cast<int>(size);
+#endif
 }
 
 int64_t RawTextOutput::tell()
@@ -866,13 +1090,21 @@ int RawTextOutput::seek(int64_t pos, TextOutput::positions relativeTo)
 
 TextOutput &TextOutput::operator<<(const PGESTRING &s)
 {
+#ifdef PGE_FILES_QT
     this->write(s);
+#else
+    this->write(s.data(), s.size());
+#endif
     return *this;
 }
 
 TextOutput &TextOutput::operator <<(const char *s)
 {
+#ifdef PGE_FILES_QT
     this->write(s);
+#else
+    this->write(s, std::strlen(s));
+#endif
     return *this;
 }
 /*****************RAW TEXT I/O CLASS***************************/
@@ -881,6 +1113,134 @@ TextOutput &TextOutput::operator <<(const char *s)
 
 /*****************FILE TEXT I/O CLASS***************************/
 
+#ifndef PGE_FILES_QT
+//! Size of the read-ahead block of the STL version of TextFileInput
+static const size_t c_textFileInputBlockSize = 65536;
+#endif
+
+/*!
+ * \brief Appends a range of characters to the string skipping all CR characters
+ * \param out Target string
+ * \param begin Begin of the source range
+ * \param end End of the source range
+ */
+static inline void appendSkipCR(std::string &out, const char *begin, const char *end)
+{
+    while(begin < end)
+    {
+        const char *cr = static_cast<const char *>(std::memchr(begin, '\r', static_cast<size_t>(end - begin)));
+        if(!cr)
+        {
+            out.append(begin, static_cast<size_t>(end - begin));
+            return;
+        }
+        out.append(begin, static_cast<size_t>(cr - begin));
+        begin = cr + 1;
+    }
+}
+
+/*!
+ * \brief Finds the first character that is significant for the CSV field reader
+ * \param begin Begin of the source range
+ * \param end End of the source range
+ * \return Pointer to the found character or the end of range
+ */
+static inline const char *findCSVSpecial(const char *begin, const char *end)
+{
+    while(begin != end)
+    {
+        char c = *begin;
+        if(c == ',' || c == '\n' || c == '\"' || c == '\r')
+            break;
+        ++begin;
+    }
+    return begin;
+}
+
+/*!
+ * \brief Appends a part of the line from the range, CR characters are skipped
+ * \param pos [in,out] Begin of the range, moved after the line feed or to the end of range
+ * \param end End of the source range
+ * \param out Target string
+ * \return true if line feed has been reached
+ */
+static inline bool scanLine(const char *&pos, const char *end, std::string &out)
+{
+    const char *lf = static_cast<const char *>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    appendSkipCR(out, pos, lf ? lf : end);
+
+    if(lf)
+    {
+        pos = lf + 1;
+        return true;
+    }
+
+    pos = end;
+    return false;
+}
+
+/*!
+ * \brief Appends a part of the CSV field from the range
+ *
+ * Quotes are toggling the quoted state and get removed, CR characters are
+ * always skipped, the field ends with an unquoted comma or line feed.
+ *
+ * \param pos [in,out] Begin of the range, moved after the field end or to the end of range
+ * \param end End of the source range
+ * \param out Target string
+ * \param quoteIsOpen [in,out] Quoted state which is kept between calls
+ * \param lineNumber [in,out] Line counter
+ * \return true if field end has been reached
+ */
+static inline bool scanCSVField(const char *&pos, const char *end, std::string &out,
+                                bool &quoteIsOpen, long &lineNumber)
+{
+    const char *chunk = pos;
+    const char *cur = pos;
+
+    while((cur = findCSVSpecial(cur, end)) != end)
+    {
+        switch(*cur)
+        {
+        case '\n':
+            lineNumber++;
+            // fallthrough
+        case ',':
+            if(!quoteIsOpen)
+            {
+                out.append(chunk, static_cast<size_t>(cur - chunk));
+                pos = cur + 1;
+                return true;
+            }
+            ++cur; // Keep quoted separators as part of the field
+            break;
+        case '\r':
+            // Fast path for the CRLF line ending
+            if(!quoteIsOpen && (cur + 1) != end && *(cur + 1) == '\n')
+            {
+                lineNumber++;
+                out.append(chunk, static_cast<size_t>(cur - chunk));
+                pos = cur + 2;
+                return true;
+            }
+            out.append(chunk, static_cast<size_t>(cur - chunk));
+            chunk = ++cur;
+            break;
+        case '\"':
+            quoteIsOpen = !quoteIsOpen;
+            // fallthrough
+        default:
+            out.append(chunk, static_cast<size_t>(cur - chunk));
+            chunk = ++cur;
+            break;
+        }
+    }
+
+    out.append(chunk, static_cast<size_t>(end - chunk));
+    pos = end;
+    return false;
+}
+
 TextFileInput::TextFileInput() :
     TextInput()
 #ifndef PGE_FILES_QT
@@ -945,6 +1305,10 @@ bool TextFileInput::open(const PGESTRING &filePath, bool utf8)
 #else
     (void)utf8;
     stream = utf8_fopen(filePath.c_str(), "rb");
+    m_bufferStartOffset = 0;
+    m_bufferSize = 0;
+    m_bufferPos = 0;
+    m_isEOF = false;
     return (stream != nullptr);
 #endif
 }
@@ -966,9 +1330,44 @@ void TextFileInput::close()
     if(stream)
         fclose(stream);
     stream = nullptr;
+    m_bufferStartOffset = 0;
+    m_bufferSize = 0;
+    m_bufferPos = 0;
+    m_isEOF = false;
 #endif
 }
 
+#ifndef PGE_FILES_QT
+bool TextFileInput::fillBuffer()
+{
+    if(!stream)
+        return false;
+
+    if(m_buffer.size() != c_textFileInputBlockSize)
+        m_buffer.resize(c_textFileInputBlockSize);
+
+    m_bufferStartOffset += static_cast<int64_t>(m_bufferSize);
+    m_bufferPos = 0;
+    m_bufferSize = fread(m_buffer.data(), 1, m_buffer.size(), stream);
+
+    if(m_bufferSize == 0)
+    {
+        m_isEOF = true;
+        return false;
+    }
+
+    return true;
+}
+
+void TextFileInput::resetBuffer()
+{
+    m_bufferSize = 0;
+    m_bufferPos = 0;
+    m_bufferStartOffset = stream ? static_cast<int64_t>(ftell(stream)) : 0;
+    m_isEOF = false;
+}
+#endif
+
 void TextFileInput::read(PGESTRING &out, int64_t len)
 {
     out.clear();
@@ -984,11 +1383,25 @@ void TextFileInput::read(PGESTRING &out, int64_t len)
     delete[] buf;
     return;//stream.read(len);
 #else
-    if(!stream)
+    if(!stream || len <= 0)
         return;
-    out.resize(len);
-    size_t lenR = fread(&out[0], 1, static_cast<size_t>(len), stream);
-    out.resize(lenR);
+
+    size_t left = static_cast<size_t>(len);
+    out.reserve(left);
+
+    while(left > 0)
+    {
+        if(m_bufferPos >= m_bufferSize && !fillBuffer())
+            break;
+
+        size_t got = m_bufferSize - m_bufferPos;
+        if(got > left)
+            got = left;
+
+        out.append(m_buffer.data() + m_bufferPos, got);
+        m_bufferPos += got;
+        left -= got;
+    }
 #endif
 }
 
@@ -1003,14 +1416,19 @@ void TextFileInput::readLine(PGESTRING &out)
     if(!stream)
         return;
 
-    int C = 0;
-    do
+    while(true)
     {
-        C = fgetc(stream);
-        if((C != '\n') && (C != '\r') && (C != EOF))
-            out.push_back(static_cast<char>(C));
+        if(m_bufferPos >= m_bufferSize && !fillBuffer())
+            break;
+
+        const char *begin = m_buffer.data() + m_bufferPos;
+        const char *pos = begin;
+        bool gotLF = scanLine(pos, m_buffer.data() + m_bufferSize, out);
+        m_bufferPos += static_cast<size_t>(pos - begin);
+
+        if(gotLF)
+            break;
     }
-    while((C != '\n') && (C != EOF));
 
     if(out.size() == 0)
         return;
@@ -1048,31 +1466,22 @@ void TextFileInput::readCVSLine(PGESTRING &buffer)
            QString::fromStdString(_buffer) :
            QString::fromLocal8Bit(_buffer.c_str(), static_cast<int>(_buffer.size()));
 #else
-    if(!stream)
+    if(!stream || m_isEOF)
         return;
 
-    int  gc;
-    char cur;
-    if(!feof(stream))
-        do
-        {
-            gc = fgetc(stream);
-            if(gc == EOF)
-                break;
-            cur = static_cast<char>(gc);
-            if(cur == '\"')
-                quoteIsOpen = !quoteIsOpen;
-            else
-            {
-                if((cur != '\r') && (((cur != '\n') && (cur != ',')) || (quoteIsOpen)))
-                    buffer.push_back(cur);
-                if(cur == '\n')
-                    m_lineNumber++;
-            }
-        }
-        while((((cur != '\n') && (cur != ',')) || quoteIsOpen));
+    while(true)
+    {
+        if(m_bufferPos >= m_bufferSize && !fillBuffer())
+            return;
 
-    return;
+        const char *begin = m_buffer.data() + m_bufferPos;
+        const char *pos = begin;
+        bool gotEnd = scanCSVField(pos, m_buffer.data() + m_bufferSize, buffer, quoteIsOpen, m_lineNumber);
+        m_bufferPos += static_cast<size_t>(pos - begin);
+
+        if(gotEnd)
+            return;
+    }
 #endif
 }
 
@@ -1083,17 +1492,25 @@ PGESTRING TextFileInput::readAll()
 #else
     if(!stream)
         return PGESTRING();
+
     std::string out;
-    out.reserve(10240);
+
+    if(fseek(stream, 0, SEEK_END) == 0)
+    {
+        long fileSize = ftell(stream);
+        if(fileSize > 0)
+            out.reserve(static_cast<size_t>(fileSize));
+    }
+
     fseek(stream, 0, SEEK_SET);
-    int x = 0;
-    do
+    resetBuffer();
+
+    while(fillBuffer())
     {
-        x = fgetc(stream);
-        if((x != '\r') && (x != EOF))
-            out.push_back(static_cast<char>(x));
+        appendSkipCR(out, m_buffer.data(), m_buffer.data() + m_bufferSize);
+        m_bufferPos = m_bufferSize;
     }
-    while(!feof(stream));
+
     return out;
 #endif
 }
@@ -1103,7 +1520,7 @@ bool TextFileInput::eof()
 #ifdef PGE_FILES_QT
     return stream.atEnd();
 #else
-    return (feof(stream) != 0);
+    return m_isEOF;
 #endif
 }
 
@@ -1112,7 +1529,9 @@ int64_t TextFileInput::tell()
 #ifdef PGE_FILES_QT
     return static_cast<int64_t>(file.pos());
 #else
-    return static_cast<int64_t>(ftell(stream));
+    if(!stream)
+        return -1;
+    return m_bufferStartOffset + static_cast<int64_t>(m_bufferPos);
 #endif
 }
 
@@ -1139,45 +1558,426 @@ int TextFileInput::seek(int64_t pos, TextFileInput::positions relativeTo)
     }
     return 0;
 #else
-    int s = 0;
+    if(!stream)
+        return -1;
+
+    int64_t target = pos;
     switch(relativeTo)
     {
     case current:
-        s = SEEK_CUR;
-        break;
-    case begin:
-        s = SEEK_SET;
+        target = tell() + pos;
         break;
     case end:
-        s = SEEK_END;
-        break;
+    {
+        int ret = fseek(stream, static_cast<long>(pos), SEEK_END);
+        resetBuffer();
+        return ret;
+    }
+    case begin:
     default:
-        s = SEEK_SET;
         break;
     }
-    return fseek(stream, static_cast<long>(pos), static_cast<int>(s));
+
+    // Jump inside of already loaded block without touching the file
+    if(target >= m_bufferStartOffset &&
+       target <= m_bufferStartOffset + static_cast<int64_t>(m_bufferSize))
+    {
+        m_bufferPos = static_cast<size_t>(target - m_bufferStartOffset);
+        m_isEOF = false;
+        return 0;
+    }
+
+    int ret = fseek(stream, static_cast<long>(target), SEEK_SET);
+    resetBuffer();
+    return ret;
 #endif
 }
 
 
 
-TextFileOutput::TextFileOutput() : TextOutput(), m_forceCRLF(false)
+/*****************MAPPED FILE TEXT INPUT CLASS***************************/
+
+/*
+ * Smaller files are read into memory at once: that is nearly as fast as mapping,
+ * and truncation of the file by a concurrent writer can't crash the reader then
+ */
+static const size_t c_mappedFileMinSize = 1024 * 1024;
+
+MappedTextInput::MappedTextInput() :
+    TextInput()
+{}
+
+MappedTextInput::MappedTextInput(const PGESTRING &filePath, bool utf8) :
+    TextInput()
 {
-#ifndef PGE_FILES_QT
-    stream = nullptr;
-#endif
+    open(filePath, utf8);
 }
 
-TextFileOutput::TextFileOutput(PGESTRING filePath, bool utf8, bool forceCRLF, TextOutput::outputMode mode) : TextOutput()
+MappedTextInput::~MappedTextInput()
 {
-    if(!open(filePath, utf8, forceCRLF, mode))
-    {
-#ifndef PGE_FILES_QT
-        stream = nullptr;
-#else
-        file.flush();
-        file.close();
-#endif
+    close();
+}
+
+bool MappedTextInput::open(const PGESTRING &filePath, bool utf8)
+{
+    close();
+
+    m_filePath = filePath;
+    m_utf8 = utf8;
+
+#ifdef PGE_FILES_QT
+    m_file.setFileName(filePath);
+    if(!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    m_size = static_cast<size_t>(m_file.size());
+    if(m_size >= c_mappedFileMinSize)
+    {
+        uchar *map = m_file.map(0, m_file.size());
+        if(map)
+        {
+            m_data = reinterpret_cast<const char *>(map);
+            m_isMapped = true;
+        }
+    }
+
+    if(m_size > 0 && !m_isMapped)
+    {
+        QByteArray all = m_file.readAll();
+        m_fallback.assign(all.constData(), static_cast<size_t>(all.size()));
+        m_data = m_fallback.data();
+        m_size = m_fallback.size();
+    }
+
+#elif defined(PGEFL_MMAP_WIN32)
+    HANDLE file = CreateFileW(Str2WStr(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    if(m_size >= c_mappedFileMinSize)
+    {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping)
+        {
+            m_data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if(m_data)
+            {
+                m_mapHandle = mapping;
+                m_isMapped = true;
+            }
+            else
+                CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file); // The mapping keeps the file opened
+
+    if(m_size > 0 && !m_isMapped)
+    {
+        FILE *f = utf8_fopen(filePath.c_str(), "rb");
+        if(!f)
+            return false;
+        m_fallback.resize(m_size);
+        m_fallback.resize(fread(&m_fallback[0], 1, m_size, f));
+        fclose(f);
+        m_data = m_fallback.data();
+        m_size = m_fallback.size();
+    }
+
+#else
+#   ifdef PGEFL_MMAP_POSIX
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    struct stat st;
+    const bool isFile = (fstat(fd, &st) == 0) && S_ISREG(st.st_mode);
+    if(isFile && static_cast<size_t>(st.st_size) >= c_mappedFileMinSize)
+    {
+        m_size = static_cast<size_t>(st.st_size);
+        void *map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map != MAP_FAILED)
+        {
+#       ifdef POSIX_MADV_SEQUENTIAL
+            posix_madvise(map, m_size, POSIX_MADV_SEQUENTIAL);
+#       endif
+            m_data = static_cast<const char *>(map);
+            m_isMapped = true;
+        }
+    }
+
+    if(!m_isMapped)
+    {
+        // Read the same opened file, it may be replaced meanwhile
+        char block[65536];
+        ssize_t got;
+        m_fallback.clear();
+        if(isFile)
+            m_fallback.reserve(static_cast<size_t>(st.st_size));
+        while((got = ::read(fd, block, sizeof(block))) > 0)
+            m_fallback.append(block, static_cast<size_t>(got));
+
+        m_data = m_fallback.data();
+        m_size = m_fallback.size();
+    }
+
+    ::close(fd); // The mapping keeps the file opened
+#   else
+    {
+        FILE *f = utf8_fopen(filePath.c_str(), "rb");
+        if(!f)
+            return false;
+
+        char block[4096];
+        size_t got;
+        m_fallback.clear();
+        while((got = fread(block, 1, sizeof(block), f)) > 0)
+            m_fallback.append(block, got);
+        fclose(f);
+
+        m_data = m_fallback.data();
+        m_size = m_fallback.size();
+    }
+#   endif
+#endif
+
+    if(!m_data)
+        m_size = 0;
+
+    return true;
+}
+
+bool MappedTextInput::reOpen(bool utf8)
+{
+    m_utf8 = utf8;
+    m_lineNumber = 0;
+    m_pos = 0;
+    m_isEOF = false;
+    return true;
+}
+
+void MappedTextInput::close()
+{
+    if(m_isMapped)
+    {
+#if defined(PGE_FILES_QT)
+        m_file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(m_data)));
+#elif defined(PGEFL_MMAP_WIN32)
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapHandle));
+        m_mapHandle = nullptr;
+#elif defined(PGEFL_MMAP_POSIX)
+        munmap(const_cast<char *>(m_data), m_size);
+#endif
+    }
+
+#ifdef PGE_FILES_QT
+    m_file.close();
+#endif
+
+    m_isMapped = false;
+    m_fallback.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_pos = 0;
+    m_isEOF = false;
+    m_filePath.clear();
+    m_lineNumber = 0;
+}
+
+#ifndef PGE_FILES_QT
+void MappedTextInput::read(PGESTRING &out, int64_t len)
+#else
+void MappedTextInput::read(PGESTRING &out_utf16, int64_t len)
+#endif
+{
+#ifndef PGE_FILES_QT
+    out.clear();
+#else
+    out_utf16.clear();
+    std::string out;
+#endif
+
+    if(!m_data || len <= 0)
+        return;
+
+    size_t left = m_size - m_pos;
+    size_t got = static_cast<size_t>(len);
+    if(got > left)
+    {
+        got = left;
+        m_isEOF = true;
+    }
+
+    out.assign(m_data + m_pos, got);
+    m_pos += got;
+
+#ifdef PGE_FILES_QT
+    out_utf16 = m_utf8 ? QString::fromStdString(out) : QString::fromLocal8Bit(out.c_str(), static_cast<int>(out.size()));
+#endif
+}
+
+#ifndef PGE_FILES_QT
+void MappedTextInput::readLine(PGESTRING &out)
+#else
+void MappedTextInput::readLine(PGESTRING &out_utf16)
+#endif
+{
+#ifndef PGE_FILES_QT
+    out.clear();
+#else
+    out_utf16.clear();
+    std::string out;
+#endif
+
+    if(!m_data)
+    {
+        m_isEOF = true;
+        return;
+    }
+
+    const char *pos = m_data + m_pos;
+    if(!scanLine(pos, m_data + m_size, out))
+        m_isEOF = true;
+    m_pos = static_cast<size_t>(pos - m_data);
+
+    if(out.size() == 0)
+        return;
+
+    m_lineNumber++;
+
+#ifdef PGE_FILES_QT
+    out_utf16 = m_utf8 ? QString::fromStdString(out) : QString::fromLocal8Bit(out.c_str(), static_cast<int>(out.size()));
+#endif
+}
+
+#ifndef PGE_FILES_QT
+void MappedTextInput::readCVSLine(PGESTRING &out)
+#else
+void MappedTextInput::readCVSLine(PGESTRING &out_utf16)
+#endif
+{
+#ifndef PGE_FILES_QT
+    out.clear();
+#else
+    out_utf16.clear();
+    std::string out;
+#endif
+
+    if(m_isEOF)
+        return;
+
+    if(!m_data)
+    {
+        m_isEOF = true;
+        return;
+    }
+
+    bool quoteIsOpen = false;
+    const char *pos = m_data + m_pos;
+    if(!scanCSVField(pos, m_data + m_size, out, quoteIsOpen, m_lineNumber))
+        m_isEOF = true;
+    m_pos = static_cast<size_t>(pos - m_data);
+
+#ifdef PGE_FILES_QT
+    out_utf16 = m_utf8 ? QString::fromStdString(out) : QString::fromLocal8Bit(out.c_str(), static_cast<int>(out.size()));
+#endif
+}
+
+PGESTRING MappedTextInput::readAll()
+{
+    std::string out;
+    out.reserve(m_size);
+
+    if(m_data)
+        appendSkipCR(out, m_data, m_data + m_size);
+    m_pos = m_size;
+    m_isEOF = true;
+
+#ifdef PGE_FILES_QT
+    return m_utf8 ? QString::fromStdString(out) : QString::fromLocal8Bit(out.c_str(), static_cast<int>(out.size()));
+#else
+    return out;
+#endif
+}
+
+bool MappedTextInput::eof()
+{
+    return m_isEOF;
+}
+
+int64_t MappedTextInput::tell()
+{
+    return static_cast<int64_t>(m_pos);
+}
+
+int MappedTextInput::seek(int64_t pos, TextInput::positions relativeTo)
+{
+    int64_t target = pos;
+
+    switch(relativeTo)
+    {
+    case current:
+        target = static_cast<int64_t>(m_pos) + pos;
+        break;
+    case end:
+        target = static_cast<int64_t>(m_size) + pos;
+        break;
+    case begin:
+    default:
+        break;
+    }
+
+    if(target < 0)
+        return -1;
+
+    if(target > static_cast<int64_t>(m_size))
+        target = static_cast<int64_t>(m_size);
+
+    m_pos = static_cast<size_t>(target);
+    m_isEOF = false;
+    return 0;
+}
+
+const char *MappedTextInput::data() const
+{
+    return m_data;
+}
+
+size_t MappedTextInput::size() const
+{
+    return m_size;
+}
+
+/*****************MAPPED FILE TEXT INPUT CLASS***************************/
+
+
+
+TextFileOutput::TextFileOutput() : TextOutput(), m_forceCRLF(false)
+{
+#ifndef PGE_FILES_QT
+    stream = nullptr;
+#endif
+}
+
+TextFileOutput::TextFileOutput(PGESTRING filePath, bool utf8, bool forceCRLF, TextOutput::outputMode mode) : TextOutput()
+{
+    if(!open(filePath, utf8, forceCRLF, mode))
+    {
+#ifndef PGE_FILES_QT
+        stream = nullptr;
+#else
+        file.flush();
+        file.close();
+#endif
     }
 }
 
@@ -1243,59 +2043,120 @@ bool TextFileOutput::open(PGESTRING filePath, bool utf8, bool forceCRLF, TextOut
 #endif
 }
 
-void TextFileOutput::close()
+bool TextFileOutput::closeWritten(TextFileOutput &file, PGESTRING &errorInfo)
 {
+    // Pending data is written on closing
+    if(!file.close())
+    {
+        errorInfo = "Failed to write file";
+        return false;
+    }
+
+    return true;
+}
+
+bool TextFileOutput::close()
+{
+    bool ok = true;
     m_filePath.clear();
     m_lineNumber = 0;
 #ifdef PGE_FILES_QT
-    file.flush();
-    file.close();
+    if(file.isOpen())
+    {
+        if(!m_forceCRLF)
+        {
+            stream.flush();
+            ok = (stream.status() == QTextStream::Ok);
+        }
+        ok = file.flush() && (file.error() == QFileDevice::NoError) && ok;
+        file.close();
+    }
 #else
     if(stream)
-        fclose(stream);
+    {
+        ok = flushBuffer() && (fflush(stream) == 0) && (ferror(stream) == 0); // Earlier writes may fail too
+        ok = (fclose(stream) == 0) && ok;
+    }
     stream = nullptr;
+    m_buffer.clear();
 #endif
+    return ok;
+}
+
+#ifndef PGE_FILES_QT
+//! Size of the pending data which causes writing into the file
+static const size_t c_crlfBufferSize = 65536;
+
+bool TextFileOutput::flushBuffer()
+{
+    if(m_buffer.empty())
+        return true;
+
+    size_t written = fwrite(m_buffer.data(), 1, m_buffer.size(), stream);
+    bool ok = (written == m_buffer.size());
+    m_buffer.clear();
+    return ok;
 }
+#endif
 
 int TextFileOutput::write(PGESTRING buffer)
 {
+#ifdef PGE_FILES_QT
     pge_size_t writtenBytes = 0;
     if(m_forceCRLF)
     {
-#ifdef PGE_FILES_QT
         buffer.replace("\n", "\r\n");
         writtenBytes = static_cast<pge_size_t>(file.write(m_utf8 ? buffer.toUtf8() : buffer.toLocal8Bit()));
-#else
-        for(pge_size_t i = 0; i < buffer.size(); i++)
-        {
-            if(buffer[i] == '\n')
-            {
-                //Force writing CRLF to prevent fakse damage of file on SMBX in Windows
-                static const char bytes[2] = {0x0D, 0x0A};
-                size_t bytesNum = fwrite(&bytes, 1, 2, stream);
-                if(bytesNum == 0)
-                    return -1;
-                writtenBytes += bytesNum;
-            }
-            else
-            {
-                pge_size_t bytesNum = 1;
-                fputc(buffer[i], stream);
-                writtenBytes += bytesNum;
-            }
-        }
-#endif
     }
     else
     {
         writtenBytes = static_cast<pge_size_t>(buffer.size());
-#ifdef PGE_FILES_QT
         stream << buffer;
+    }
+    return static_cast<int>(writtenBytes);
 #else
-        fwrite(buffer.c_str(), 1, buffer.size(), stream);
+    return write(buffer.data(), buffer.size());
 #endif
+}
+
+int TextFileOutput::write(const char *data, size_t size)
+{
+#ifdef PGE_FILES_QT
+    return TextOutput::write(data, size);
+#else
+    if(!stream)
+        return -1;
+
+    if(!m_forceCRLF)
+        return static_cast<int>(fwrite(data, 1, size, stream));
+
+    //Force writing CRLF to prevent fakse damage of file on SMBX in Windows
+    size_t writtenBytes = 0;
+    const char *end = data + size;
+
+    while(data < end)
+    {
+        const char *lf = static_cast<const char *>(std::memchr(data, '\n', static_cast<size_t>(end - data)));
+        const char *chunkEnd = lf ? lf : end;
+
+        m_buffer.append(data, static_cast<size_t>(chunkEnd - data));
+        writtenBytes += static_cast<size_t>(chunkEnd - data);
+
+        if(lf)
+        {
+            m_buffer.append("\r\n", 2);
+            writtenBytes += 2;
+            ++chunkEnd;
+        }
+
+        data = chunkEnd;
+
+        if(m_buffer.size() >= c_crlfBufferSize && !flushBuffer())
+            return -1;
     }
+
     return static_cast<int>(writtenBytes);
+#endif
 }
 
 int64_t TextFileOutput::tell()
@@ -1306,7 +2167,7 @@ int64_t TextFileOutput::tell()
     else
         return static_cast<int64_t>(file.pos());
 #else
-    return ftell(stream);
+    return ftell(stream) + static_cast<int64_t>(m_buffer.size());
 #endif
 }
 
@@ -1336,6 +2197,8 @@ int TextFileOutput::seek(int64_t pos, TextOutput::positions relativeTo)
         s = SEEK_SET;
         break;
     }
+    if(!flushBuffer())
+        return -1;
     return fseek(stream, static_cast<long>(pos), static_cast<int>(s));
 #endif
 }
@@ -1382,6 +2245,40 @@ PGESTRING FileInfo::dirpath()
     return m_dirPath;
 }
 
+bool FileInfo::stamp(uint64_t &size, int64_t &mtime) const
+{
+#ifdef PGE_FILES_QT
+    QFileInfo info(m_filePath);
+    if(!info.isFile())
+        return false;
+    size = static_cast<uint64_t>(info.size());
+    mtime = static_cast<int64_t>(info.lastModified().toMSecsSinceEpoch()) * 1000000;
+    return true;
+#elif defined(_WIN32)
+    WIN32_FILE_ATTRIBUTE_DATA attr;
+    if(!GetFileAttributesExW(Str2WStr(m_filePath).c_str(), GetFileExInfoStandard, &attr) ||
+       (attr.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+        return false;
+    size = (static_cast<uint64_t>(attr.nFileSizeHigh) << 32) | attr.nFileSizeLow;
+    // FILETIME counts 100-nanosecond intervals since 1601-01-01
+    const int64_t ticks = static_cast<int64_t>((static_cast<uint64_t>(attr.ftLastWriteTime.dwHighDateTime) << 32) |
+                                               attr.ftLastWriteTime.dwLowDateTime);
+    mtime = (ticks - 116444736000000000LL) * 100;
+    return true;
+#else
+    struct stat st;
+    if(::stat(m_filePath.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+    size = static_cast<uint64_t>(st.st_size);
+#   if defined(__APPLE__)
+    mtime = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#   else
+    mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#   endif
+    return true;
+#endif
+}
+
 void FileInfo::rebuildData()
 {
 #ifdef _WIN32
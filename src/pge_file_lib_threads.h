@@ -0,0 +1,137 @@
+/*
+ * PGE File Library - a library to process file formats, part of Moondust project
+ *
+ * Copyright (c) 2014-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef PGE_FILE_LIB_THREADS_H_
+#define PGE_FILE_LIB_THREADS_H_
+
+/*!
+ * \file pge_file_lib_threads.h
+ * \brief Contains internally used helpers to run independent jobs on worker threads
+ *
+ */
+
+#include <cstddef>
+
+#ifdef PGEFL_ENABLE_THREADS
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#endif
+
+namespace PGE_FileFormats_misc
+{
+
+/*!
+ * \brief Number of threads allowed to the PGE-X readers, set by FileFormats::SetPGEXReadThreads()
+ */
+extern unsigned int g_pgexReadThreads;
+
+/*!
+ * \brief Number of threads allowed to the PGE-X writers, set by FileFormats::SetPGEXWriteThreads()
+ */
+extern unsigned int g_pgexWriteThreads;
+
+/*!
+ * \brief Number of threads allowed to the SMBX-38A readers, set by FileFormats::SetSMBX38AReadThreads()
+ */
+extern unsigned int g_smbx38aReadThreads;
+
+/*!
+ * \brief Calls job(i) for every i in [0, count) on up to the given number of threads, including the calling one
+ * \param count Number of jobs
+ * \param threads Maximal number of threads, 0 and 1 run all jobs in the calling thread
+ * \param job Function called for every job index, jobs must not depend on each other
+ *
+ * Returns when all jobs are done. The first exception thrown by a job is re-thrown in the calling thread.
+ */
+template<class Job>
+void parallelFor(size_t count, unsigned int threads, Job job)
+{
+#ifdef PGEFL_ENABLE_THREADS
+    if(threads > count)
+        threads = static_cast<unsigned int>(count);
+
+    if(threads > 1)
+    {
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr error;
+        std::mutex errorLock;
+
+        auto worker = [&]()
+        {
+            try
+            {
+                for(size_t i = next++; i < count && !failed; i = next++)
+                    job(i);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(errorLock);
+                if(!error)
+                    error = std::current_exception();
+                failed = true;
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+
+        try
+        {
+            for(unsigned int i = 1; i < threads; ++i)
+                pool.emplace_back(worker);
+        }
+        catch(const std::system_error &)
+        {
+            // The remaining jobs are taken by the threads which did start
+        }
+
+        worker();
+
+        for(std::thread &t : pool)
+            t.join();
+
+        if(error)
+            std::rethrow_exception(error);
+
+        return;
+    }
+#else
+    (void)threads;
+#endif
+
+    for(size_t i = 0; i < count; ++i)
+        job(i);
+}
+
+} // namespace PGE_FileFormats_misc
+
+#endif // PGE_FILE_LIB_THREADS_H_
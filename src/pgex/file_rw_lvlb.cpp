@@ -0,0 +1,847 @@
+/*
+ * PGE File Library - a library to process file formats, part of Moondust project
+ *
+ * Copyright (c) 2014-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pge_file_lib_sys.h"
+#include "file_formats.h"
+#include "pge_file_lib_private.h"
+#include <cstring>
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+
+/*
+ * Binary level cache (LVLB)
+ *
+ * All numbers are little-endian. The file starts with the 64-byte header:
+ *   0 char[8]  signature "PGELVLB\0"
+ *   8 u32      format version
+ *  12 u32      flags
+ *  16 u64      size of the whole file
+ *  24 u64      size of the source file
+ *  32 i64      time of the last modification of the source file
+ *  40 u64      FNV-1a hash of the source file
+ *  48 i32      recent format of the level
+ *  52 u32      recent format version of the level
+ *  56 i32      number of stars
+ *  60 u32      number of chunks
+ * and the table of chunks (24 bytes per entry) follows:
+ *   0 u32      tag
+ *   4 u32      size of the record
+ *   8 u32      number of records
+ *  12 u32      next array-id of the elements array
+ *  16 u64      offset of the data from begin of the file
+ *
+ * Blocks, BGO, NPC and warps are stored as arrays of fixed-width records,
+ * strings are stored as indices in the shared string table. Everything else
+ * is stored as the PGE-X data which is small and cheap to parse.
+ */
+
+namespace
+{
+
+const char     s_lvlbMagic[8] = {'P', 'G', 'E', 'L', 'V', 'L', 'B', '\0'};
+//! Must be increased on any change of the layout or of the records
+const uint32_t s_lvlbVersion = 2;
+const size_t   s_lvlbHeaderSize = 64;
+const size_t   s_lvlbChunkEntrySize = 24;
+//! Header contains stamp of the source file
+const uint32_t s_lvlbFlagSourceStamp = 0x01;
+
+constexpr uint32_t lvlbTag(char a, char b, char c, char d)
+{
+    return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) |
+           (uint32_t(uint8_t(c)) << 16) | (uint32_t(uint8_t(d)) << 24);
+}
+
+enum LvlbChunkTag : uint32_t
+{
+    LVLB_STRING_INDEX = lvlbTag('S', 'T', 'R', 'I'),
+    LVLB_STRING_DATA  = lvlbTag('S', 'T', 'R', 'D'),
+    LVLB_PGEX         = lvlbTag('P', 'G', 'E', 'X'),
+    LVLB_BLOCKS       = lvlbTag('B', 'L', 'C', 'K'),
+    LVLB_BGO          = lvlbTag('B', 'G', 'O', 'S'),
+    LVLB_NPC          = lvlbTag('N', 'P', 'C', 'S'),
+    LVLB_DOORS        = lvlbTag('D', 'O', 'O', 'R')
+};
+
+static_assert(sizeof(double) == 8, "Binary level cache requires 64-bit double");
+
+inline void lvlbPut32(std::string &out, uint32_t v)
+{
+    char b[4];
+    for(int i = 0; i < 4; ++i)
+        b[i] = static_cast<char>((v >> (i * 8)) & 0xFF);
+    out.append(b, 4);
+}
+
+inline void lvlbPut64(std::string &out, uint64_t v)
+{
+    char b[8];
+    for(int i = 0; i < 8; ++i)
+        b[i] = static_cast<char>((v >> (i * 8)) & 0xFF);
+    out.append(b, 8);
+}
+
+inline uint32_t lvlbGet32(const unsigned char *p)
+{
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline uint64_t lvlbGet64(const unsigned char *p)
+{
+    return uint64_t(lvlbGet32(p)) | (uint64_t(lvlbGet32(p + 4)) << 32);
+}
+
+inline PGESTRING lvlbString(const unsigned char *p, size_t len)
+{
+#ifdef PGE_FILES_QT
+    return QString::fromUtf8(reinterpret_cast<const char *>(p), static_cast<int>(len));
+#else
+    return std::string(reinterpret_cast<const char *>(p), len);
+#endif
+}
+
+struct LvlbSourceStamp
+{
+    uint64_t size = 0;
+    //! Modification time in nanoseconds, 0 if it's too close to the stamp time to be trusted
+    int64_t  mtime = 0;
+    uint64_t hash = 0;
+};
+
+//! Files modified this close to the stamp time may be modified again with the same time (FAT has 2 seconds)
+const int64_t s_lvlbRacyTime = 2000000000;
+
+bool lvlbHashFile(const PGESTRING &filePath, uint64_t &hash)
+{
+    PGE_FileFormats_misc::MappedTextInput file;
+    if(!file.open(filePath))
+        return false;
+
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(file.data());
+    const size_t size = file.size();
+    hash = 14695981039346656037ull;
+    for(size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+
+    return true;
+}
+
+bool lvlbMakeStamp(const PGESTRING &filePath, LvlbSourceStamp &stamp)
+{
+    PGE_FileFormats_misc::FileInfo info(filePath);
+    if(!info.stamp(stamp.size, stamp.mtime) || !lvlbHashFile(filePath, stamp.hash))
+        return false;
+
+    // The next change within the resolution of the file system's timer may keep the time,
+    // the content of such file is always compared
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()).count();
+    if(now - stamp.mtime < s_lvlbRacyTime)
+        stamp.mtime = 0;
+
+    return true;
+}
+
+bool lvlbSourceIsSame(const PGESTRING &filePath, const LvlbSourceStamp &stamp)
+{
+    LvlbSourceStamp cur;
+    PGE_FileFormats_misc::FileInfo info(filePath);
+
+    if(!info.stamp(cur.size, cur.mtime) || cur.size != stamp.size)
+        return false;
+
+    if(stamp.mtime != 0 && cur.mtime == stamp.mtime)
+        return true;
+
+    // Time changes on copying or on checking out the same file, compare the content then
+    return lvlbHashFile(filePath, cur.hash) && cur.hash == stamp.hash;
+}
+
+/*!
+ * \brief Shared table of the unique strings, the empty string has index 0
+ */
+class LvlbStringTable
+{
+    std::unordered_map<std::string, uint32_t> m_ids;
+public:
+    std::string index;
+    std::string data;
+    uint32_t    count = 0;
+
+    LvlbStringTable()
+    {
+        add(std::string());
+    }
+
+    uint32_t intern(const PGESTRING &str)
+    {
+        if(IsEmpty(str))
+            return 0;
+#ifdef PGE_FILES_QT
+        QByteArray u8 = str.toUtf8();
+        std::string key(u8.constData(), static_cast<size_t>(u8.size()));
+#else
+        const std::string &key = str;
+#endif
+        auto it = m_ids.find(key);
+        if(it != m_ids.end())
+            return it->second;
+        return add(key);
+    }
+
+private:
+    uint32_t add(const std::string &str)
+    {
+        uint32_t id = count++;
+        m_ids.emplace(str, id);
+        lvlbPut32(index, static_cast<uint32_t>(data.size()));
+        lvlbPut32(index, static_cast<uint32_t>(str.size()));
+        data.append(str);
+        return id;
+    }
+};
+
+//! Computes size of the record
+struct LvlbRecordSizer
+{
+    uint32_t size = 0;
+
+    template<class T>
+    void sint(const T &) { size += 8; }
+    template<class T>
+    void uint(const T &) { size += 8; }
+    void real(const double &) { size += 8; }
+    void flag(const bool &) { size += 1; }
+    void str(const PGESTRING &) { size += 4; }
+    void timeUnit(const PGE_FileLibrary::TimeUnit &) { size += 8; }
+};
+
+class LvlbRecordWriter
+{
+    std::string     &m_out;
+    LvlbStringTable &m_strings;
+public:
+    LvlbRecordWriter(std::string &out, LvlbStringTable &strings) :
+        m_out(out), m_strings(strings)
+    {}
+
+    template<class T>
+    void sint(const T &v) { lvlbPut64(m_out, static_cast<uint64_t>(static_cast<int64_t>(v))); }
+    template<class T>
+    void uint(const T &v) { lvlbPut64(m_out, static_cast<uint64_t>(v)); }
+
+    void real(const double &v)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        lvlbPut64(m_out, bits);
+    }
+
+    void flag(const bool &v) { m_out.push_back(v ? '\1' : '\0'); }
+    void str(const PGESTRING &v) { lvlbPut32(m_out, m_strings.intern(v)); }
+    void timeUnit(const PGE_FileLibrary::TimeUnit &v) { sint(static_cast<int>(v)); }
+};
+
+class LvlbRecordReader
+{
+    const unsigned char *m_p = nullptr;
+    const std::vector<PGESTRING> &m_strings;
+    bool m_valid = true;
+public:
+    explicit LvlbRecordReader(const std::vector<PGESTRING> &strings) :
+        m_strings(strings)
+    {}
+
+    void seek(const unsigned char *record) { m_p = record; }
+    bool valid() const { return m_valid; }
+
+    template<class T>
+    void sint(T &v)
+    {
+        int64_t raw = static_cast<int64_t>(lvlbGet64(m_p));
+        m_p += 8;
+        v = static_cast<T>(raw);
+        if(static_cast<int64_t>(v) != raw)
+            m_valid = false; // Doesn't fit on this platform
+    }
+
+    template<class T>
+    void uint(T &v)
+    {
+        uint64_t raw = lvlbGet64(m_p);
+        m_p += 8;
+        v = static_cast<T>(raw);
+        if(static_cast<uint64_t>(v) != raw)
+            m_valid = false;
+    }
+
+    void real(double &v)
+    {
+        uint64_t bits = lvlbGet64(m_p);
+        m_p += 8;
+        std::memcpy(&v, &bits, sizeof(v));
+    }
+
+    void flag(bool &v)
+    {
+        v = (*m_p++ != 0);
+    }
+
+    void str(PGESTRING &v)
+    {
+        uint32_t id = lvlbGet32(m_p);
+        m_p += 4;
+        if(id < m_strings.size())
+            v = m_strings[id];
+        else
+            m_valid = false;
+    }
+
+    void timeUnit(PGE_FileLibrary::TimeUnit &v)
+    {
+        int raw = 0;
+        sint(raw);
+        if(raw < static_cast<int>(PGE_FileLibrary::TimeUnit::FrameOneOf65sec) ||
+           raw > static_cast<int>(PGE_FileLibrary::TimeUnit::Second))
+            m_valid = false;
+        else
+            v = static_cast<PGE_FileLibrary::TimeUnit>(raw);
+    }
+};
+
+template<class IO, class Meta>
+void lvlbMetaFields(IO &io, Meta &m)
+{
+    io.uint(m.array_id);
+    io.uint(m.index);
+    io.str(m.custom_params);
+}
+
+/*!
+ * \brief Layout of the fixed-width records, the same list of fields is used to write and to read
+ */
+template<class T>
+struct LvlbRecord;
+
+template<>
+struct LvlbRecord<LevelBlock>
+{
+    static const uint32_t tag = LVLB_BLOCKS;
+
+    template<class IO, class Block>
+    static void fields(IO &io, Block &b)
+    {
+        io.sint(b.x);
+        io.sint(b.y);
+        io.sint(b.h);
+        io.sint(b.w);
+        io.flag(b.autoscale);
+        io.uint(b.id);
+        io.sint(b.npc_id);
+        io.sint(b.npc_special_value);
+        io.flag(b.invisible);
+        io.flag(b.slippery);
+        io.uint(b.motion_ai_id);
+        io.sint(b.special_data);
+        io.sint(b.special_data2);
+        io.str(b.layer);
+        io.str(b.gfx_name);
+        io.sint(b.gfx_dx);
+        io.sint(b.gfx_dy);
+        io.str(b.event_destroy);
+        io.str(b.event_hit);
+        io.str(b.event_emptylayer);
+        io.str(b.event_on_screen);
+        lvlbMetaFields(io, b.meta);
+    }
+};
+
+template<>
+struct LvlbRecord<LevelBGO>
+{
+    static const uint32_t tag = LVLB_BGO;
+
+    template<class IO, class Bgo>
+    static void fields(IO &io, Bgo &b)
+    {
+        io.sint(b.x);
+        io.sint(b.y);
+        io.uint(b.id);
+        io.str(b.layer);
+        io.sint(b.gfx_dx);
+        io.sint(b.gfx_dy);
+        io.sint(b.z_mode);
+        io.real(b.z_offset);
+        io.sint(b.smbx64_sp);
+        io.sint(b.smbx64_sp_apply);
+        lvlbMetaFields(io, b.meta);
+    }
+};
+
+template<>
+struct LvlbRecord<LevelNPC>
+{
+    static const uint32_t tag = LVLB_NPC;
+
+    template<class IO, class Npc>
+    static void fields(IO &io, Npc &n)
+    {
+        io.sint(n.x);
+        io.sint(n.y);
+        io.sint(n.direct);
+        io.uint(n.id);
+        io.str(n.gfx_name);
+        io.sint(n.gfx_dx);
+        io.sint(n.gfx_dy);
+        io.sint(n.contents);
+        io.flag(n.gfx_autoscale);
+        io.sint(n.override_width);
+        io.sint(n.override_height);
+        io.sint(n.wings_type);
+        io.sint(n.wings_style);
+        io.sint(n.special_data);
+        io.sint(n.special_data2);
+        io.flag(n.generator);
+        io.sint(n.generator_direct);
+        io.sint(n.generator_type);
+        io.timeUnit(n.generator_period_orig_unit);
+        io.sint(n.generator_period);
+        io.sint(n.generator_period_orig);
+        io.real(n.generator_custom_angle);
+        io.sint(n.generator_branches);
+        io.real(n.generator_angle_range);
+        io.real(n.generator_initial_speed);
+        io.str(n.msg);
+        io.flag(n.friendly);
+        io.flag(n.nomove);
+        io.flag(n.is_boss);
+        io.str(n.layer);
+        io.str(n.event_activate);
+        io.str(n.event_die);
+        io.str(n.event_talk);
+        io.str(n.event_emptylayer);
+        io.str(n.event_grab);
+        io.str(n.event_nextframe);
+        io.str(n.event_touch);
+        io.str(n.attach_layer);
+        io.str(n.send_id_to_variable);
+        io.flag(n.is_star);
+        lvlbMetaFields(io, n.meta);
+    }
+};
+
+template<>
+struct LvlbRecord<LevelDoor>
+{
+    static const uint32_t tag = LVLB_DOORS;
+
+    template<class IO, class Door>
+    static void fields(IO &io, Door &d)
+    {
+        io.sint(d.ix);
+        io.sint(d.iy);
+        io.flag(d.isSetIn);
+        io.sint(d.ox);
+        io.sint(d.oy);
+        io.flag(d.isSetOut);
+        io.sint(d.idirect);
+        io.sint(d.odirect);
+        io.sint(d.type);
+        io.sint(d.transition_effect);
+        io.str(d.lname);
+        io.sint(d.warpto);
+        io.flag(d.lvl_i);
+        io.flag(d.lvl_o);
+        io.sint(d.world_x);
+        io.sint(d.world_y);
+        io.sint(d.stars);
+        io.str(d.stars_msg);
+        io.flag(d.star_num_hide);
+        io.str(d.layer);
+        io.flag(d.unknown);
+        io.flag(d.novehicles);
+        io.flag(d.allownpc);
+        io.flag(d.locked);
+        io.flag(d.need_a_bomb);
+        io.flag(d.hide_entering_scene);
+        io.flag(d.allownpc_interlevel);
+        io.flag(d.special_state_required);
+        io.uint(d.length_i);
+        io.uint(d.height_i);
+        io.uint(d.length_o);
+        io.uint(d.height_o);
+        io.str(d.event_enter);
+        io.str(d.event_exit);
+        io.flag(d.two_way);
+        io.flag(d.cannon_exit);
+        io.real(d.cannon_exit_speed);
+        io.flag(d.stood_state_required);
+        lvlbMetaFields(io, d.meta);
+    }
+};
+
+template<class T>
+uint32_t lvlbRecordSize()
+{
+    static const uint32_t size = []()
+    {
+        LvlbRecordSizer sizer;
+        const T item = T();
+        LvlbRecord<T>::fields(sizer, item);
+        return sizer.size;
+    }();
+    return size;
+}
+
+struct LvlbChunk
+{
+    uint32_t tag = 0;
+    uint32_t recordSize = 0;
+    uint32_t count = 0;
+    uint32_t nextArrayId = 1;
+    uint64_t offset = 0;
+    //! Data of the chunk to write
+    const std::string *payload = nullptr;
+    //! Data of the chunk which has been read
+    const unsigned char *data = nullptr;
+};
+
+template<class T>
+void lvlbEncode(const PGELIST<T> &items, unsigned int nextArrayId, LvlbStringTable &strings,
+                std::string &out, LvlbChunk &chunk)
+{
+    LvlbRecordWriter writer(out, strings);
+    out.reserve(static_cast<size_t>(items.size()) * lvlbRecordSize<T>());
+    for(const T &item : items)
+        LvlbRecord<T>::fields(writer, item);
+
+    chunk.tag = LvlbRecord<T>::tag;
+    chunk.recordSize = lvlbRecordSize<T>();
+    chunk.count = static_cast<uint32_t>(items.size());
+    chunk.nextArrayId = nextArrayId;
+    chunk.payload = &out;
+}
+
+template<class T>
+bool lvlbDecode(const LvlbChunk *chunk, const std::vector<PGESTRING> &strings,
+                PGELIST<T> &items, unsigned int &nextArrayId)
+{
+    items.clear();
+    if(!chunk)
+        return true;
+
+    if(chunk->recordSize != lvlbRecordSize<T>())
+        return false;
+
+    LvlbRecordReader reader(strings);
+    items.reserve(static_cast<pge_size_t>(chunk->count));
+    for(uint32_t i = 0; i < chunk->count; ++i)
+    {
+        items.push_back(T());
+        reader.seek(chunk->data + static_cast<size_t>(i) * chunk->recordSize);
+        LvlbRecord<T>::fields(reader, items.back());
+    }
+
+    nextArrayId = chunk->nextArrayId;
+    return reader.valid();
+}
+
+/*!
+ * \brief Keeps the fixed-width arrays aside while the rest of level gets written as PGE-X data
+ */
+class LvlbObjectsAside
+{
+    LevelData &m_data;
+    PGELIST<LevelBlock> m_blocks;
+    PGELIST<LevelBGO> m_bgo;
+    PGELIST<LevelNPC> m_npc;
+    PGELIST<LevelDoor> m_doors;
+    int m_stars;
+    int m_recentFormat;
+    unsigned int m_recentFormatVersion;
+public:
+    explicit LvlbObjectsAside(LevelData &data) :
+        m_data(data),
+        m_stars(data.stars),
+        m_recentFormat(data.meta.RecentFormat),
+        m_recentFormatVersion(data.meta.RecentFormatVersion)
+    {
+        m_blocks.swap(m_data.blocks);
+        m_bgo.swap(m_data.bgo);
+        m_npc.swap(m_data.npc);
+        m_doors.swap(m_data.doors);
+    }
+
+    ~LvlbObjectsAside()
+    {
+        m_blocks.swap(m_data.blocks);
+        m_bgo.swap(m_data.bgo);
+        m_npc.swap(m_data.npc);
+        m_doors.swap(m_data.doors);
+        m_data.stars = m_stars;
+        m_data.meta.RecentFormat = m_recentFormat;
+        m_data.meta.RecentFormatVersion = m_recentFormatVersion;
+    }
+};
+
+bool lvlbWrite(const PGESTRING &filePath, LevelData &FileData, const LvlbSourceStamp *stamp)
+{
+    std::string rest;
+    {
+        LvlbObjectsAside aside(FileData);
+        PGESTRING restRaw;
+        if(!FileFormats::WriteExtendedLvlFileRaw(FileData, restRaw))
+            return false;
+#ifdef PGE_FILES_QT
+        QByteArray u8 = restRaw.toUtf8();
+        rest.assign(u8.constData(), static_cast<size_t>(u8.size()));
+#else
+        rest.swap(restRaw);
+#endif
+    }
+
+    LvlbStringTable strings;
+    std::string blocks, bgo, npc, doors;
+    LvlbChunk chunks[7];
+
+    lvlbEncode(FileData.blocks, FileData.blocks_array_id, strings, blocks, chunks[0]);
+    lvlbEncode(FileData.bgo, FileData.bgo_array_id, strings, bgo, chunks[1]);
+    lvlbEncode(FileData.npc, FileData.npc_array_id, strings, npc, chunks[2]);
+    lvlbEncode(FileData.doors, FileData.doors_array_id, strings, doors, chunks[3]);
+
+    chunks[4].tag = LVLB_STRING_INDEX;
+    chunks[4].recordSize = 8;
+    chunks[4].count = strings.count;
+    chunks[4].payload = &strings.index;
+
+    chunks[5].tag = LVLB_STRING_DATA;
+    chunks[5].recordSize = 1;
+    chunks[5].count = static_cast<uint32_t>(strings.data.size());
+    chunks[5].payload = &strings.data;
+
+    chunks[6].tag = LVLB_PGEX;
+    chunks[6].recordSize = 1;
+    chunks[6].count = static_cast<uint32_t>(rest.size());
+    chunks[6].payload = &rest;
+
+    const uint32_t chunksCount = 7;
+    uint64_t fileSize = s_lvlbHeaderSize + chunksCount * s_lvlbChunkEntrySize;
+    for(LvlbChunk &c : chunks)
+    {
+        fileSize = (fileSize + 7) & ~uint64_t(7);
+        c.offset = fileSize;
+        fileSize += c.payload->size();
+    }
+
+    std::string out;
+    out.reserve(static_cast<size_t>(fileSize));
+    out.append(s_lvlbMagic, sizeof(s_lvlbMagic));
+    lvlbPut32(out, s_lvlbVersion);
+    lvlbPut32(out, stamp ? s_lvlbFlagSourceStamp : 0);
+    lvlbPut64(out, fileSize);
+    lvlbPut64(out, stamp ? stamp->size : 0);
+    lvlbPut64(out, stamp ? static_cast<uint64_t>(stamp->mtime) : 0);
+    lvlbPut64(out, stamp ? stamp->hash : 0);
+    lvlbPut32(out, static_cast<uint32_t>(FileData.meta.RecentFormat));
+    lvlbPut32(out, FileData.meta.RecentFormatVersion);
+    lvlbPut32(out, static_cast<uint32_t>(FileData.stars));
+    lvlbPut32(out, chunksCount);
+
+    for(const LvlbChunk &c : chunks)
+    {
+        lvlbPut32(out, c.tag);
+        lvlbPut32(out, c.recordSize);
+        lvlbPut32(out, c.count);
+        lvlbPut32(out, c.nextArrayId);
+        lvlbPut64(out, c.offset);
+    }
+
+    for(const LvlbChunk &c : chunks)
+    {
+        out.resize(static_cast<size_t>(c.offset), '\0');
+        out.append(*c.payload);
+    }
+
+    if(!PGE_FileFormats_misc::writeFileReplace(filePath, out.data(), out.size()))
+    {
+        FileData.meta.ERROR_info = "Failed to open file for write";
+        return false;
+    }
+
+    return true;
+}
+
+bool lvlbBadFile(LevelData &FileData, const char *info)
+{
+    FileData.meta.ReadFileValid = false;
+    FileData.meta.ERROR_info = info;
+    FileData.meta.ERROR_linedata.clear();
+    FileData.meta.ERROR_linenum = -1;
+    return false;
+}
+
+} // namespace
+
+bool FileFormats::ReadBinaryLvlFile(const PGESTRING &filePath, LevelData &FileData, const PGESTRING &sourcePath)
+{
+    FileData.meta.ERROR_info.clear();
+    PGE_FileFormats_misc::MappedTextInput file;
+
+    if(!file.open(filePath))
+        return lvlbBadFile(FileData, "Can't open file");
+
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(file.data());
+    const uint64_t size = file.size();
+
+    if(size < s_lvlbHeaderSize || std::memcmp(data, s_lvlbMagic, sizeof(s_lvlbMagic)) != 0)
+        return lvlbBadFile(FileData, "Invalid file format");
+
+    if(lvlbGet32(data + 8) != s_lvlbVersion)
+        return lvlbBadFile(FileData, "Unsupported version of binary level cache");
+
+    const uint32_t flags = lvlbGet32(data + 12);
+    const uint32_t chunksCount = lvlbGet32(data + 60);
+    const uint64_t tableEnd = s_lvlbHeaderSize + uint64_t(chunksCount) * s_lvlbChunkEntrySize;
+
+    if(lvlbGet64(data + 16) != size || tableEnd > size)
+        return lvlbBadFile(FileData, "Binary level cache is damaged");
+
+    if(!IsEmpty(sourcePath))
+    {
+        LvlbSourceStamp stamp;
+        stamp.size = lvlbGet64(data + 24);
+        stamp.mtime = static_cast<int64_t>(lvlbGet64(data + 32));
+        stamp.hash = lvlbGet64(data + 40);
+        if((flags & s_lvlbFlagSourceStamp) == 0 || !lvlbSourceIsSame(sourcePath, stamp))
+            return lvlbBadFile(FileData, "Binary level cache is out of date");
+    }
+
+    std::vector<LvlbChunk> chunks(chunksCount);
+    for(uint32_t i = 0; i < chunksCount; ++i)
+    {
+        const unsigned char *e = data + s_lvlbHeaderSize + i * s_lvlbChunkEntrySize;
+        LvlbChunk &c = chunks[i];
+        c.tag = lvlbGet32(e);
+        c.recordSize = lvlbGet32(e + 4);
+        c.count = lvlbGet32(e + 8);
+        c.nextArrayId = lvlbGet32(e + 12);
+        c.offset = lvlbGet64(e + 16);
+        if(c.offset < tableEnd || c.offset > size ||
+           uint64_t(c.recordSize) * c.count > size - c.offset)
+            return lvlbBadFile(FileData, "Binary level cache is damaged");
+        c.data = data + c.offset;
+    }
+
+    auto findChunk = [&chunks](uint32_t tag) -> const LvlbChunk *
+    {
+        for(const LvlbChunk &c : chunks)
+        {
+            if(c.tag == tag)
+                return &c;
+        }
+        return nullptr;
+    };
+
+    const LvlbChunk *strIndex = findChunk(LVLB_STRING_INDEX);
+    const LvlbChunk *strData = findChunk(LVLB_STRING_DATA);
+    const LvlbChunk *pgex = findChunk(LVLB_PGEX);
+
+    if(!strIndex || !strData || !pgex ||
+       strIndex->recordSize != 8 || strData->recordSize != 1 || pgex->recordSize != 1)
+        return lvlbBadFile(FileData, "Binary level cache is damaged");
+
+    std::vector<PGESTRING> strings;
+    strings.reserve(strIndex->count);
+    for(uint32_t i = 0; i < strIndex->count; ++i)
+    {
+        const uint32_t offset = lvlbGet32(strIndex->data + i * 8);
+        const uint32_t len = lvlbGet32(strIndex->data + i * 8 + 4);
+        if(uint64_t(offset) + len > strData->count)
+            return lvlbBadFile(FileData, "Binary level cache is damaged");
+        strings.push_back(lvlbString(strData->data + offset, len));
+    }
+
+    // Level header, sections, layers, events, etc.
+    PGESTRING rest = lvlbString(pgex->data, pgex->count);
+    if(!ReadExtendedLvlFileRaw(rest, IsEmpty(sourcePath) ? filePath : sourcePath, FileData))
+        return false;
+
+    FileData.meta.RecentFormat = static_cast<int>(lvlbGet32(data + 48));
+    FileData.meta.RecentFormatVersion = lvlbGet32(data + 52);
+    FileData.stars = static_cast<int>(lvlbGet32(data + 56));
+
+    if(!lvlbDecode(findChunk(LVLB_BLOCKS), strings, FileData.blocks, FileData.blocks_array_id) ||
+       !lvlbDecode(findChunk(LVLB_BGO), strings, FileData.bgo, FileData.bgo_array_id) ||
+       !lvlbDecode(findChunk(LVLB_NPC), strings, FileData.npc, FileData.npc_array_id) ||
+       !lvlbDecode(findChunk(LVLB_DOORS), strings, FileData.doors, FileData.doors_array_id))
+        return lvlbBadFile(FileData, "Binary level cache is damaged");
+
+    return true;
+}
+
+bool FileFormats::WriteBinaryLvlFile(const PGESTRING &filePath, LevelData &FileData, const PGESTRING &sourcePath)
+{
+    FileData.meta.ERROR_info.clear();
+
+    if(IsEmpty(sourcePath))
+        return lvlbWrite(filePath, FileData, nullptr);
+
+    LvlbSourceStamp stamp;
+    if(!lvlbMakeStamp(sourcePath, stamp))
+    {
+        FileData.meta.ERROR_info = "Can't open source file";
+        return false;
+    }
+
+    return lvlbWrite(filePath, FileData, &stamp);
+}
+
+bool FileFormats::OpenLevelFileCached(const PGESTRING &filePath, const PGESTRING &cachePath, LevelData &FileData)
+{
+    if(ReadBinaryLvlFile(cachePath, FileData, filePath))
+        return true;
+
+    // Stamp is taken before reading, so changes made meanwhile will outdate the cache
+    LvlbSourceStamp stamp;
+    const bool canCache = lvlbMakeStamp(filePath, stamp);
+
+    if(!OpenLevelFile(filePath, FileData))
+        return false;
+
+    if(canCache)
+    {
+        // Failed update of the cache is not an error of the level reading
+        PGESTRING errorInfo = FileData.meta.ERROR_info;
+        lvlbWrite(cachePath, FileData, &stamp);
+        FileData.meta.ERROR_info = errorInfo;
+    }
+
+    return true;
+}
@@ -73,6 +73,7 @@ bool FileFormats::ReadNonSMBX64MetaDataFile(PGE_FileFormats_misc::TextInput &in,
     PGESTRING line;           //Current Line data
     ///////////////////////////////////////Begin file///////////////////////////////////////
     PGEFile pgeX_Data(in.readAll());
+    PGEFile::PGEX_ValueContext pgeX_Value;
 
     if(!pgeX_Data.buildTreeFromRaw())
     {
@@ -102,7 +103,7 @@ bool FileFormats::ReadNonSMBX64MetaDataFile(PGE_FileFormats_misc::TextInput &in,
                     goto badfile;
                 }
 
-                PGEFile::PGEX_Item x = f_section.data[sdata];
+                const PGEFile::PGEX_Item &x = f_section.data[sdata];
                 Bookmark meta_bookmark;
                 meta_bookmark.bookmarkName.clear();
                 meta_bookmark.x = 0;
@@ -110,32 +111,43 @@ bool FileFormats::ReadNonSMBX64MetaDataFile(PGE_FileFormats_misc::TextInput &in,
 
                 for(const auto &v : x.values) //Look markers and values
                 {
-                    errorString = PGESTRING("Wrong value syntax\nSection [") +
-                                  f_section.name + "]\nData line " +
-                                  fromNum(sdata) + "\nMarker " +
-                                  v.marker + "\nValue " +
-                                  v.value;
+                    // Error message gets formatted on failure only
+                    pgeX_Value.section = &f_section;
+                    pgeX_Value.item = sdata;
+                    pgeX_Value.value = &v;
+                    errorString.clear();
 
-                    if(v.marker == "BM") //Bookmark name
+                    switch(PGEFile::markerKey(v.marker))
                     {
+                    case PGEFile::markerKey("BM"): //Bookmark name
                         if(PGEFile::IsQoutedString(v.value))
                             meta_bookmark.bookmarkName = PGEFile::X2STRING(v.value);
                         else
                             goto badfile;
-                    }
-                    else if(v.marker == "X") // Position X
+                        break;
+
+                    case PGEFile::markerKey("X"): // Position X
                     {
-                        if(PGEFile::IsFloat(v.value))
-                            meta_bookmark.x = toFloat(v.value);
+                        float num;
+                        if(PGEFile::X2Float(v.value, num))
+                            meta_bookmark.x = num;
                         else
                             goto badfile;
+                        break;
                     }
-                    else if(v.marker == "Y") //Position Y
+
+                    case PGEFile::markerKey("Y"): //Position Y
                     {
-                        if(PGEFile::IsFloat(v.value))
-                            meta_bookmark.y = toFloat(v.value);
+                        float num;
+                        if(PGEFile::X2Float(v.value, num))
+                            meta_bookmark.y = num;
                         else
                             goto badfile;
+                        break;
+                    }
+
+                    default:
+                        break;
                     }
                 }
 
@@ -151,6 +163,8 @@ bool FileFormats::ReadNonSMBX64MetaDataFile(PGE_FileFormats_misc::TextInput &in,
 
 badfile:    //If file format is not correct
     //BadFileMsg(filePath+"\nError message: "+errorString, str_count, line);
+    if(IsEmpty(errorString))
+        errorString = pgeX_Value.errorString();
     FileData.meta.ERROR_info = errorString;
     FileData.meta.ERROR_linenum = str_count;
     FileData.meta.ERROR_linedata = line;
@@ -179,7 +193,10 @@ bool FileFormats::WriteNonSMBX64MetaDataF(const PGESTRING &filePath, MetaData &m
         return false;
     }
 
-    return WriteNonSMBX64MetaData(file, metaData);
+    if(!WriteNonSMBX64MetaData(file, metaData))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, metaData.meta.ERROR_info);
 }
 
 bool FileFormats::WriteNonSMBX64MetaDataRaw(MetaData &metaData, PGESTRING &rawdata)
@@ -199,24 +216,26 @@ bool FileFormats::WriteNonSMBX64MetaDataRaw(MetaData &metaData, PGESTRING &rawda
 bool FileFormats::WriteNonSMBX64MetaData(PGE_FileFormats_misc::TextOutput &out, MetaData &metaData)
 {
     pge_size_t i;
+    PGEXWriter w(out);
 
     //Bookmarks
     if(!metaData.bookmarks.empty())
     {
-        out << "META_BOOKMARKS\n";
+        w.beginSection("META_BOOKMARKS");
 
         for(i = 0; i < metaData.bookmarks.size(); i++)
         {
             Bookmark &bm = metaData.bookmarks[i];
             //Bookmark name
-            out << PGEFile::value("BM", PGEFile::WriteStr(bm.bookmarkName));
-            out << PGEFile::value("X", PGEFile::WriteFloat(bm.x));
-            out << PGEFile::value("Y", PGEFile::WriteFloat(bm.y));
-            out << "\n";
+            w.writeStr("BM", bm.bookmarkName);
+            w.writeFloat("X", bm.x);
+            w.writeFloat("Y", bm.y);
+            w.endLine();
         }
 
-        out << "META_BOOKMARKS_END\n";
+        w.endSection("META_BOOKMARKS");
     }
 
+    w.flush();
     return true;
 }
@@ -127,6 +127,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_StrVal("MF", FileData.musicFile)
                     PGEX_BoolVal("GC", FileData.gameCompleted)
                     PGEX_UIntVal("TI", FileData.lvl_path_count)
+                    PGEX_ValueEnd()
                 }
             }
         }//Header
@@ -147,6 +148,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_UIntVal("MT", plr_state.mountType)
                     PGEX_UIntVal("MI", plr_state.mountID)
                     PGEX_UIntVal("HL", plr_state.health)
+                    PGEX_ValueEnd()
                 }
                 FileData.characterStates.push_back(plr_state);
             }
@@ -163,6 +165,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                 {
                     PGEX_ValueBegin()
                     PGEX_ULongVal("ID", character)
+                    PGEX_ValueEnd()
                 }
                 FileData.currentCharacter.push_back(character);
             }
@@ -181,6 +184,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_ValueBegin()
                     PGEX_UIntVal("ID", vz_item.first)
                     PGEX_BoolVal("V", vz_item.second)
+                    PGEX_ValueEnd()
                 }
                 FileData.visibleLevels.push_back(vz_item);
             }
@@ -199,6 +203,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_ValueBegin()
                     PGEX_UIntVal("ID", vz_item.first)
                     PGEX_BoolVal("V", vz_item.second)
+                    PGEX_ValueEnd()
                 }
                 FileData.visiblePaths.push_back(vz_item);
             }
@@ -217,6 +222,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_ValueBegin()
                     PGEX_UIntVal("ID", vz_item.first)
                     PGEX_BoolVal("V", vz_item.second)
+                    PGEX_ValueEnd()
                 }
                 FileData.visibleScenery.push_back(vz_item);
             }
@@ -235,6 +241,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_ValueBegin()
                     PGEX_StrVal("L", star_level.first)
                     PGEX_SIntVal("S", star_level.second)
+                    PGEX_ValueEnd()
                 }
                 FileData.gottenStars.push_back(star_level);
             }
@@ -253,6 +260,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_ValueBegin()
                     PGEX_StrVal("L", saved_layer.first)
                     PGEX_SIntVal("S", saved_layer.second)
+                    PGEX_ValueEnd()
                 }
                 FileData.savedLayers.push_back(saved_layer);
             }
@@ -274,6 +282,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_BoolArrVal("MG", level_info.medals_got)
                     PGEX_BoolArrVal("MB", level_info.medals_best)
                     PGEX_UIntVal("E", level_info.exits_got)
+                    PGEX_ValueEnd()
                 }
                 FileData.levelInfo.push_back(level_info);
             }
@@ -297,6 +306,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGEX_StrVal("SN", user_data_entry.name)
                     PGEX_StrVal("LN", user_data_entry.location_name)
                     PGEX_StrArrVal("D", data)
+                    PGEX_ValueEnd()
                 }
                 for(PGESTRING &s : data)
                 {
@@ -305,8 +315,8 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
                     PGE_SPLITSTRING(dp, s, "=");
                     if(dp.size() < 2)
                         goto badfile;
-                    e.key = PGE_ReplSTRING(PGEFile::X2STRING(dp[0]), "\\q", "=");
-                    e.value = PGE_ReplSTRING(PGEFile::X2STRING(dp[1]), "\\q", "=");
+                    e.key = PGE_ReplSTRING(PGEFile::X2STRING(PGEXSTRING(dp[0])), "\\q", "=");
+                    e.value = PGE_ReplSTRING(PGEFile::X2STRING(PGEXSTRING(dp[1])), "\\q", "=");
                     user_data_entry.data.push_back(e);
                 }
                 FileData.userData.store.push_back(user_data_entry);
@@ -318,6 +328,7 @@ bool FileFormats::ReadExtendedSaveFile(PGE_FileFormats_misc::TextInput &in, Game
     FileData.meta.ReadFileValid = true;
     return true;
 badfile:    //If file format not corrects
+    PGEX_ValueError()
     FileData.meta.ERROR_info = errorString;
     FileData.meta.ERROR_linenum = str_count;
     FileData.meta.ERROR_linedata = line;
@@ -352,7 +363,10 @@ bool FileFormats::WriteExtendedSaveFileF(const PGESTRING &filePath, GamesaveData
         return false;
     }
 
-    return WriteExtendedSaveFile(file, FileData);
+    if(!WriteExtendedSaveFile(file, FileData))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, FileData.meta.ERROR_info);
 }
 
 bool FileFormats::WriteExtendedSaveFileRaw(GamesaveData &FileData, PGESTRING &rawdata)
@@ -372,158 +386,159 @@ bool FileFormats::WriteExtendedSaveFileRaw(GamesaveData &FileData, PGESTRING &ra
 bool FileFormats::WriteExtendedSaveFile(PGE_FileFormats_misc::TextOutput &out, GamesaveData &FileData)
 {
     pge_size_t i;
-    out << "SAVE_HEADER\n";
-    out << PGEFile::value("LV", PGEFile::WriteInt(FileData.lives));
-    out << PGEFile::value("HN", PGEFile::WriteInt(FileData.hundreds));
-    out << PGEFile::value("CN", PGEFile::WriteInt(FileData.coins));
-    out << PGEFile::value("PT", PGEFile::WriteInt(FileData.points));
-    out << PGEFile::value("TS", PGEFile::WriteInt(FileData.totalStars));
-    out << PGEFile::value("WX", PGEFile::WriteInt(FileData.worldPosX));
-    out << PGEFile::value("WY", PGEFile::WriteInt(FileData.worldPosY));
-    out << PGEFile::value("HW", PGEFile::WriteInt(FileData.last_hub_warp));
-    out << PGEFile::value("HL", PGEFile::WriteStr(FileData.last_hub_level_file));
-    out << PGEFile::value("MI", PGEFile::WriteInt(FileData.musicID));
-    out << PGEFile::value("MF", PGEFile::WriteStr(FileData.musicFile));
-    out << PGEFile::value("GC", PGEFile::WriteBool(FileData.gameCompleted));
-    out << PGEFile::value("TI", PGEFile::WriteInt(FileData.lvl_path_count));
-    out << "\n";
-    out << "SAVE_HEADER_END\n";
+    PGEXWriter w(out);
+    w.beginSection("SAVE_HEADER");
+    w.writeInt("LV", FileData.lives);
+    w.writeInt("HN", FileData.hundreds);
+    w.writeInt("CN", FileData.coins);
+    w.writeInt("PT", FileData.points);
+    w.writeInt("TS", FileData.totalStars);
+    w.writeInt("WX", FileData.worldPosX);
+    w.writeInt("WY", FileData.worldPosY);
+    w.writeInt("HW", FileData.last_hub_warp);
+    w.writeStr("HL", FileData.last_hub_level_file);
+    w.writeInt("MI", FileData.musicID);
+    w.writeStr("MF", FileData.musicFile);
+    w.writeBool("GC", FileData.gameCompleted);
+    w.writeInt("TI", FileData.lvl_path_count);
+    w.endLine();
+    w.endSection("SAVE_HEADER");
 
     if(!FileData.characterStates.empty())
     {
-        out << "CHARACTERS\n";
+        w.beginSection("CHARACTERS");
 
         for(i = 0; i < FileData.characterStates.size(); i++)
         {
             saveCharState &chState = FileData.characterStates[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(chState.id));
-            out << PGEFile::value("ST", PGEFile::WriteInt(chState.state));
-            out << PGEFile::value("IT", PGEFile::WriteInt(chState.itemID));
-            out << PGEFile::value("MT", PGEFile::WriteInt(chState.mountType));
-            out << PGEFile::value("MI", PGEFile::WriteInt(chState.mountID));
-            out << PGEFile::value("HL", PGEFile::WriteInt(chState.health));
-            out << "\n";
+            w.writeInt("ID", chState.id);
+            w.writeInt("ST", chState.state);
+            w.writeInt("IT", chState.itemID);
+            w.writeInt("MT", chState.mountType);
+            w.writeInt("MI", chState.mountID);
+            w.writeInt("HL", chState.health);
+            w.endLine();
         }
 
-        out << "CHARACTERS_END\n";
+        w.endSection("CHARACTERS");
     }
 
     if(!FileData.currentCharacter.empty())
     {
-        out << "CHARACTERS_PER_PLAYERS\n";
+        w.beginSection("CHARACTERS_PER_PLAYERS");
 
         for(i = 0; i < FileData.currentCharacter.size(); i++)
         {
-            out << PGEFile::value("ID", PGEFile::WriteInt(FileData.currentCharacter[i]));
-            out << "\n";
+            w.writeInt("ID", FileData.currentCharacter[i]);
+            w.endLine();
         }
 
-        out << "CHARACTERS_PER_PLAYERS_END\n";
+        w.endSection("CHARACTERS_PER_PLAYERS");
     }
 
     if(!FileData.visibleLevels.empty())
     {
-        out << "VIZ_LEVELS\n";
+        w.beginSection("VIZ_LEVELS");
 
         for(i = 0; i < FileData.visibleLevels.size(); i++)
         {
             visibleItem &slevel = FileData.visibleLevels[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(slevel.first));
-            out << PGEFile::value("V", PGEFile::WriteBool(slevel.second));
-            out << "\n";
+            w.writeInt("ID", slevel.first);
+            w.writeBool("V", slevel.second);
+            w.endLine();
         }
 
-        out << "VIZ_LEVELS_END\n";
+        w.endSection("VIZ_LEVELS");
     }
 
     if(!FileData.visiblePaths.empty())
     {
-        out << "VIZ_PATHS\n";
+        w.beginSection("VIZ_PATHS");
 
         for(i = 0; i < FileData.visiblePaths.size(); i++)
         {
             visibleItem &slevel = FileData.visiblePaths[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(slevel.first));
-            out << PGEFile::value("V", PGEFile::WriteBool(slevel.second));
-            out << "\n";
+            w.writeInt("ID", slevel.first);
+            w.writeBool("V", slevel.second);
+            w.endLine();
         }
 
-        out << "VIZ_PATHS_END\n";
+        w.endSection("VIZ_PATHS");
     }
 
     if(!FileData.visibleScenery.empty())
     {
-        out << "VIZ_SCENERY\n";
+        w.beginSection("VIZ_SCENERY");
 
         for(i = 0; i < FileData.visibleScenery.size(); i++)
         {
             visibleItem &slevel = FileData.visibleScenery[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(slevel.first));
-            out << PGEFile::value("V", PGEFile::WriteBool(slevel.second));
-            out << "\n";
+            w.writeInt("ID", slevel.first);
+            w.writeBool("V", slevel.second);
+            w.endLine();
         }
 
-        out << "VIZ_SCENERY_END\n";
+        w.endSection("VIZ_SCENERY");
     }
 
     if(!FileData.gottenStars.empty())
     {
-        out << "STARS\n";
+        w.beginSection("STARS");
 
         for(i = 0; i < FileData.gottenStars.size(); i++)
         {
             starOnLevel &slevel = FileData.gottenStars[i];
-            out << PGEFile::value("L", PGEFile::WriteStr(slevel.first));
-            out << PGEFile::value("S", PGEFile::WriteInt(slevel.second));
-            out << "\n";
+            w.writeStr("L", slevel.first);
+            w.writeInt("S", slevel.second);
+            w.endLine();
         }
 
-        out << "STARS_END\n";
+        w.endSection("STARS");
     }
 
     if(!FileData.savedLayers.empty())
     {
-        out << "SAVED_LAYERS\n";
+        w.beginSection("SAVED_LAYERS");
 
         for(i = 0; i < FileData.savedLayers.size(); i++)
         {
             savedLayerSaveEntry &slayer = FileData.savedLayers[i];
-            out << PGEFile::value("L", PGEFile::WriteStr(slayer.first));
-            out << PGEFile::value("S", PGEFile::WriteInt(slayer.second));
-            out << "\n";
+            w.writeStr("L", slayer.first);
+            w.writeInt("S", slayer.second);
+            w.endLine();
         }
 
-        out << "SAVED_LAYERS_END\n";
+        w.endSection("SAVED_LAYERS");
     }
 
     if(!FileData.levelInfo.empty())
     {
-        out << "LEVEL_INFO\n";
+        w.beginSection("LEVEL_INFO");
 
         for(i = 0; i < FileData.levelInfo.size(); i++)
         {
             saveLevelInfo &slinfo = FileData.levelInfo[i];
-            out << PGEFile::value("L", PGEFile::WriteStr(slinfo.level_filename));
-            out << PGEFile::value("S", PGEFile::WriteInt(slinfo.max_stars));
-            out << PGEFile::value("M", PGEFile::WriteInt(slinfo.max_medals));
+            w.writeStr("L", slinfo.level_filename);
+            w.writeInt("S", slinfo.max_stars);
+            w.writeInt("M", slinfo.max_medals);
 
             if(!slinfo.medals_got.empty())
-                out << PGEFile::value("MG", PGEFile::WriteBoolArr(slinfo.medals_got));
+                w.writeBoolArr("MG", slinfo.medals_got);
 
             if(!slinfo.medals_best.empty())
-                out << PGEFile::value("MB", PGEFile::WriteBoolArr(slinfo.medals_best));
+                w.writeBoolArr("MB", slinfo.medals_best);
 
-            out << PGEFile::value("E", PGEFile::WriteInt(slinfo.exits_got));
+            w.writeInt("E", slinfo.exits_got);
 
-            out << "\n";
+            w.endLine();
         }
 
-        out << "LEVEL_INFO_END\n";
+        w.endSection("LEVEL_INFO");
     }
 
     if(!FileData.userData.store.empty())
     {
-        out << "USERDATA\n";
+        w.beginSection("USERDATA");
 
         for(const auto &e : FileData.userData.store)
         {
@@ -531,13 +546,13 @@ bool FileFormats::WriteExtendedSaveFile(PGE_FileFormats_misc::TextOutput &out, G
                 continue;// Don't save volatile fields into the file!
 
             int location_clean = (e.location & saveUserData::DATA_LOCATION_MASK);
-            out << PGEFile::value("L", PGEFile::WriteInt(location_clean));
+            w.writeInt("L", location_clean);
 
             if(!IsEmpty(e.name) && (e.name != "default"))
-                out << PGEFile::value("SN", PGEFile::WriteStr(e.name));
+                w.writeStr("SN", e.name);
 
             if(!IsEmpty(e.location_name))
-                out << PGEFile::value("LN", PGEFile::WriteStr(e.location_name));
+                w.writeStr("LN", e.location_name);
 
             PGESTRINGList data;
             for(const auto &d : e.data)
@@ -547,12 +562,13 @@ bool FileFormats::WriteExtendedSaveFile(PGE_FileFormats_misc::TextOutput &out, G
                 data.PGESTRING_EMPLACE(PGEFile::WriteStr(key) + "=" + PGEFile::WriteStr(value));
             }
 
-            out << PGEFile::value("D", PGEFile::WriteStrArr(data));
-            out << "\n";
+            w.writeStrArr("D", data);
+            w.endLine();
         }
-        out << "USERDATA_END\n";
+        w.endSection("USERDATA");
     }
 
-    out << "\n";
+    w.endLine();
+    w.flush();
     return true;
 }
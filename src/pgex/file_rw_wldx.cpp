@@ -29,6 +29,7 @@
 #include "wld_filedata.h"
 #include "pge_x.h"
 #include "pgex/pge_x_macro.h"
+#include "pgex/pge_x_parallel.h"
 #include "pge_file_lib_sys.h"
 
 //*********************************************************
@@ -130,94 +131,101 @@ bool FileFormats::ReadExtendedWldFileHeaderT(PGE_FileFormats_misc::TextInput &in
         {
             if(data[i].size() != 2) goto badfile;
 
+            const PGEXSTRING value(data[i][1]);
+
             if(data[i][0] == "TL") //Episode Title
             {
-                if(PGEFile::IsQoutedString(data[i][1]))
-                    FileData.EpisodeTitle = PGEFile::X2STRING(data[i][1]);
+                if(PGEFile::IsQoutedString(value))
+                    FileData.EpisodeTitle = PGEFile::X2STRING(value);
                 else
                     goto badfile;
             }
             else if(data[i][0] == "DC") //Disabled characters
             {
-                if(PGEFile::IsBoolArray(data[i][1]))
-                    FileData.nocharacter = PGEFile::X2BollArr(data[i][1]);
+                if(PGEFile::IsBoolArray(value))
+                    FileData.nocharacter = PGEFile::X2BollArr(value);
                 else
                     goto badfile;
             }
             else if(data[i][0] == "IT") //Intro level
             {
-                if(PGEFile::IsQoutedString(data[i][1]))
-                    FileData.IntroLevel_file = PGEFile::X2STRING(data[i][1]);
+                if(PGEFile::IsQoutedString(value))
+                    FileData.IntroLevel_file = PGEFile::X2STRING(value);
                 else
                     goto badfile;
             }
             else if(data[i][0] == "GO") //Game Over level
             {
-                if(PGEFile::IsQoutedString(data[i][1]))
-                    FileData.GameOverLevel_file = PGEFile::X2STRING(data[i][1]);
+                if(PGEFile::IsQoutedString(value))
+                    FileData.GameOverLevel_file = PGEFile::X2STRING(value);
                 else
                     goto badfile;
             }
             else if(data[i][0] == "HB") //Hub Styled
             {
-                if(PGEFile::IsBool(data[i][1]))
-                    FileData.HubStyledWorld = static_cast<bool>(toInt(data[i][1]) != 0);
+                bool flag;
+                if(PGEFile::X2Bool(value, flag))
+                    FileData.HubStyledWorld = flag;
                 else
                     goto badfile;
             }
             else if(data[i][0] == "RL") //Restart level on fail
             {
-                if(PGEFile::IsBool(data[i][1]))
-                    FileData.restartlevel = static_cast<bool>(toInt(data[i][1]) != 0);
+                bool flag;
+                if(PGEFile::X2Bool(value, flag))
+                    FileData.restartlevel = flag;
                 else
                     goto badfile;
             }
             else if(data[i][0] == "SZ") //Starz number
             {
-                if(PGEFile::IsIntU(data[i][1]))
-                    FileData.stars = toUInt(data[i][1]);
+                unsigned int num;
+                if(PGEFile::X2IntU(value, num))
+                    FileData.stars = num;
                 else
                     goto badfile;
             }
             else if(data[i][0] == "CD") //Credits list
             {
-                if(PGEFile::IsQoutedString(data[i][1]))
-                    FileData.authors = PGEFile::X2STRING(data[i][1]);
+                if(PGEFile::IsQoutedString(value))
+                    FileData.authors = PGEFile::X2STRING(value);
                 else
                     goto badfile;
             }
             else if(data[i][0] == "CM") //Credits scene background music
             {
-                if(PGEFile::IsQoutedString(data[i][1]))
-                    FileData.authors_music = PGEFile::X2STRING(data[i][1]);
+                if(PGEFile::IsQoutedString(value))
+                    FileData.authors_music = PGEFile::X2STRING(value);
                 else
                     goto badfile;
             }
             else if(data[i][0] == "SSS") //Per-level stars count showing policy
             {
-                if(PGEFile::IsIntS(data[i][1]))
-                    FileData.starsShowPolicy = toInt(data[i][1]);
+                int num;
+                if(PGEFile::X2IntS(value, num))
+                    FileData.starsShowPolicy = num;
                 else
                     goto badfile;
             }
             else if(data[i][0] == "XTRA") //Extra settings
             {
-                if(PGEFile::IsQoutedString(data[i][1]))
-                    FileData.custom_params = PGEFile::X2STRING(data[i][1]);
+                if(PGEFile::IsQoutedString(value))
+                    FileData.custom_params = PGEFile::X2STRING(value);
                 else
                     goto badfile;
             }
             else if(data[i][0] == "CPID") //Config pack ID string
             {
-                if(PGEFile::IsQoutedString(data[i][1]))
-                    FileData.meta.configPackId = PGEFile::X2STRING(data[i][1]);
+                if(PGEFile::IsQoutedString(value))
+                    FileData.meta.configPackId = PGEFile::X2STRING(value);
                 else
                     goto badfile;
             }
             else if(data[i][0] == "EFL") //Engine feature level
             {
-                if(PGEFile::IsIntU(data[i][1]))
-                    FileData.meta.engineFeatureLevel = toUInt(data[i][1]);
+                unsigned int num;
+                if(PGEFile::X2IntU(value, num))
+                    FileData.meta.engineFeatureLevel = num;
                 else
                     goto badfile;
             }
@@ -282,7 +290,258 @@ bool FileFormats::ReadExtendedWldFileRaw(PGESTRING &rawdata, const PGESTRING &fi
     return ReadExtendedWldFile(file, FileData);
 }
 
-bool FileFormats::ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, WorldData &FileData)
+/*
+ * Decodes entries [begin, end) of the TILES section, every entry is a terrain tile
+ */
+static bool readWldxTiles(const PGEFile::PGEX_Entry &f_section, pge_size_t begin, pge_size_t end,
+                          PGELIST<WorldTerrainTile> &tiles, unsigned int &arrayId, int &lines, PGESTRING &errorString)
+{
+    PGEFile::PGEX_ValueContext pgeX_Value;
+    WorldTerrainTile tile;
+
+    PGEX_ItemsRange(begin, end)
+    {
+        lines++;
+        PGEX_ItemBegin(PGEFile::PGEX_Struct)
+        tile = FileFormats::CreateWldTile();
+        PGEX_Values() //Look markers and values
+        {
+            PGEX_ValueBegin()
+            PGEX_ULongVal("ID", tile.id) //Tile ID
+            PGEX_SLongVal("X",  tile.x) //X Position
+            PGEX_SLongVal("Y",  tile.y) //Y Position
+            PGEX_StrVal("XTRA", tile.meta.custom_params)//Custom JSON data tree
+            PGEX_ValueEnd()
+        }
+        tile.meta.array_id = arrayId++;
+        tile.meta.index = static_cast<unsigned int>(tiles.size());
+        tiles.push_back(tile);
+    }
+
+    return true;
+
+badfile:
+    PGEX_ValueError()
+    return false;
+}
+
+/*
+ * Decodes entries [begin, end) of the SCENERY section, every entry is a scenery
+ */
+static bool readWldxScenery(const PGEFile::PGEX_Entry &f_section, pge_size_t begin, pge_size_t end,
+                            PGELIST<WorldScenery> &scenery, unsigned int &arrayId, int &lines, PGESTRING &errorString)
+{
+    PGEFile::PGEX_ValueContext pgeX_Value;
+    WorldScenery scen;
+
+    PGEX_ItemsRange(begin, end)
+    {
+        lines++;
+        PGEX_ItemBegin(PGEFile::PGEX_Struct)
+        scen = FileFormats::CreateWldScenery();
+        PGEX_Values() //Look markers and values
+        {
+            PGEX_ValueBegin()
+            PGEX_ULongVal("ID", scen.id)  //Scenery ID
+            PGEX_SLongVal("X", scen.x) //X Position
+            PGEX_SLongVal("Y", scen.y) //Y Position
+            PGEX_StrVal("XTRA", scen.meta.custom_params)//Custom JSON data tree
+            PGEX_ValueEnd()
+        }
+        scen.meta.array_id = arrayId++;
+        scen.meta.index = static_cast<unsigned int>(scenery.size());
+        scenery.push_back(scen);
+    }
+
+    return true;
+
+badfile:
+    PGEX_ValueError()
+    return false;
+}
+
+/*
+ * Decodes entries [begin, end) of the PATHS section, every entry is a path
+ */
+static bool readWldxPaths(const PGEFile::PGEX_Entry &f_section, pge_size_t begin, pge_size_t end,
+                          PGELIST<WorldPathTile> &paths, unsigned int &arrayId, int &lines, PGESTRING &errorString)
+{
+    PGEFile::PGEX_ValueContext pgeX_Value;
+    WorldPathTile pathitem;
+
+    PGEX_ItemsRange(begin, end)
+    {
+        lines++;
+        PGEX_ItemBegin(PGEFile::PGEX_Struct)
+        pathitem = FileFormats::CreateWldPath();
+        PGEX_Values() //Look markers and values
+        {
+            PGEX_ValueBegin()
+            PGEX_ULongVal("ID", pathitem.id)  //Path ID
+            PGEX_SLongVal("X", pathitem.x) //X Position
+            PGEX_SLongVal("Y", pathitem.y) //Y Position
+            PGEX_StrVal("XTRA", pathitem.meta.custom_params)//Custom JSON data tree
+            PGEX_ValueEnd()
+        }
+        pathitem.meta.array_id = arrayId++;
+        pathitem.meta.index =  static_cast<unsigned int>(paths.size());
+        paths.push_back(pathitem);
+    }
+
+    return true;
+
+badfile:
+    PGEX_ValueError()
+    return false;
+}
+
+/*
+ * Decodes entries [begin, end) of the MUSICBOXES section, every entry is a music box
+ */
+static bool readWldxMusicBoxes(const PGEFile::PGEX_Entry &f_section, pge_size_t begin, pge_size_t end,
+                               PGELIST<WorldMusicBox> &music, unsigned int &arrayId, int &lines, PGESTRING &errorString)
+{
+    PGEFile::PGEX_ValueContext pgeX_Value;
+    WorldMusicBox musicbox;
+
+    PGEX_ItemsRange(begin, end)
+    {
+        lines++;
+        PGEX_ItemBegin(PGEFile::PGEX_Struct)
+        musicbox = FileFormats::CreateWldMusicbox();
+        PGEX_Values() //Look markers and values
+        {
+            PGEX_ValueBegin()
+            PGEX_ULongVal("ID", musicbox.id) //MISICBOX ID
+            PGEX_SLongVal("X", musicbox.x) //X Position
+            PGEX_SLongVal("Y", musicbox.y) //X Position
+            PGEX_StrVal("MF", musicbox.music_file)  //Custom music file
+            PGEX_StrVal("XTRA", musicbox.meta.custom_params)//Custom JSON data tree
+            PGEX_ValueEnd()
+        }
+        musicbox.meta.array_id = arrayId++;
+        musicbox.meta.index =  static_cast<unsigned int>(music.size());
+        music.push_back(musicbox);
+    }
+
+    return true;
+
+badfile:
+    PGEX_ValueError()
+    return false;
+}
+
+/*
+ * Decodes entries [begin, end) of the AREARECTS section, every entry is a area rectangle
+ */
+static bool readWldxAreaRects(const PGEFile::PGEX_Entry &f_section, pge_size_t begin, pge_size_t end,
+                              PGELIST<WorldAreaRect> &arearects, unsigned int &arrayId, int &lines, PGESTRING &errorString)
+{
+    PGEFile::PGEX_ValueContext pgeX_Value;
+    WorldAreaRect arearect;
+
+    PGEX_ItemsRange(begin, end)
+    {
+        lines++;
+        PGEX_ItemBegin(PGEFile::PGEX_Struct)
+        arearect = WorldAreaRect();
+        PGEX_Values() //Look markers and values
+        {
+            PGEX_ValueBegin()
+            PGEX_UIntVal("F", arearect.flags)  //Flags
+            PGEX_SLongVal("X", arearect.x) //X Position
+            PGEX_SLongVal("Y", arearect.y) //X Position
+            PGEX_USLongVal("W", arearect.w) //Width
+            PGEX_USLongVal("H", arearect.h) //Height
+
+            // unused stuff
+            PGEX_ULongVal("MI", arearect.music_id) //MUSICBOX ID
+            PGEX_StrVal("MF", arearect.music_file)  //Custom music file
+            PGEX_StrVal("LR", arearect.layer)
+            PGEX_StrVal("EB", arearect.eventBreak)
+            PGEX_StrVal("EW", arearect.eventWarp)
+            PGEX_StrVal("EA", arearect.eventAnchor)
+            PGEX_StrVal("ET", arearect.eventTouch)
+            PGEX_UIntVal("TP", arearect.eventTouchPolicy)
+            PGEX_StrVal("XTRA", arearect.meta.custom_params)//Custom JSON data tree
+            PGEX_ValueEnd()
+        }
+        arearect.meta.array_id = arrayId++;
+        arearect.meta.index =  static_cast<unsigned int>(arearects.size());
+        arearects.push_back(arearect);
+    }
+
+    return true;
+
+badfile:
+    PGEX_ValueError()
+    return false;
+}
+
+/*
+ * Decodes entries [begin, end) of the LEVELS section, every entry is a level entrance
+ */
+static bool readWldxLevels(const PGEFile::PGEX_Entry &f_section, pge_size_t begin, pge_size_t end,
+                           PGELIST<WorldLevelTile> &levels, unsigned int &arrayId, int &lines, PGESTRING &errorString)
+{
+    PGEFile::PGEX_ValueContext pgeX_Value;
+    WorldLevelTile lvlitem;
+
+    PGEX_ItemsRange(begin, end)
+    {
+        lines++;
+        PGEX_ItemBegin(PGEFile::PGEX_Struct)
+        lvlitem = FileFormats::CreateWldLevel();
+        PGEX_Values() //Look markers and values
+        {
+            PGEX_ValueBegin()
+            PGEX_ULongVal("ID", lvlitem.id) //LEVEL IMAGE ID
+            PGEX_SLongVal("X",  lvlitem.x) //X Position
+            PGEX_SLongVal("Y",  lvlitem.y) //X Position
+            PGEX_StrVal("LF", lvlitem.lvlfile)  //Target level file
+            PGEX_StrVal("LT", lvlitem.title)   //Level title
+            PGEX_ULongVal("EI", lvlitem.entertowarp) //Entrance Warp ID (if 0 - start level from default points)
+            PGEX_SIntVal("ET", lvlitem.top_exit) //Open top path on exit type
+            PGEX_SIntVal("EL", lvlitem.left_exit) //Open left path on exit type
+            PGEX_SIntVal("ER", lvlitem.right_exit) //Open right path on exit type
+            PGEX_SIntVal("EB", lvlitem.bottom_exit) //Open bottom path on exit type
+            PGEX_SLongVal("WX", lvlitem.gotox) //Goto world map X
+            PGEX_SLongVal("WY", lvlitem.gotoy) //Goto world map Y
+            PGEX_BoolVal("AV", lvlitem.alwaysVisible) //Always visible
+            PGEX_BoolVal("SP", lvlitem.gamestart) //Is Game start point
+            PGEX_BoolVal("BP", lvlitem.pathbg) //Path background
+            PGEX_BoolVal("BG", lvlitem.bigpathbg) //Big path background
+            PGEX_SIntVal("SSS", lvlitem.starsShowPolicy) // Stars count showing policy
+            PGEX_StrVal("XTRA", lvlitem.meta.custom_params)//Custom JSON data tree
+            PGEX_ValueEnd()
+        }
+        lvlitem.meta.array_id = arrayId++;
+        lvlitem.meta.index = static_cast<unsigned int>(levels.size());
+        levels.push_back(lvlitem);
+    }
+
+    return true;
+
+badfile:
+    PGEX_ValueError()
+    return false;
+}
+
+//! PGE-X world map sections which can be skipped by FileFormats::LoadSections
+static const PGEX_SectionPart s_wldxSectionParts[] =
+{
+    {FileFormats::LOAD_HEADER,      "HEAD"},
+    {FileFormats::LOAD_META,        "META_BOOKMARKS"},
+    {FileFormats::LOAD_META,        "META_SYS_CRASH"},
+    {FileFormats::LOAD_TILES,       "TILES"},
+    {FileFormats::LOAD_SCENERY,     "SCENERY"},
+    {FileFormats::LOAD_PATHS,       "PATHS"},
+    {FileFormats::LOAD_MUSICBOXES,  "MUSICBOXES"},
+    {FileFormats::LOAD_AREARECTS,   "AREARECTS"},
+    {FileFormats::LOAD_LEVELS,      "LEVELS"},
+};
+
+bool FileFormats::ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, WorldData &FileData, uint32_t loadSections)
 {
   // indented 2 spaces to avoid large diff hunk
   try
@@ -303,14 +562,28 @@ bool FileFormats::ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, World
 
     FileData.meta.untitled = false;
     FileData.meta.modified = false;
-    WorldTerrainTile tile;
-    WorldScenery scen;
-    WorldPathTile pathitem;
-    WorldMusicBox musicbox;
-    WorldAreaRect arearect;
-    WorldLevelTile lvlitem;
+    PGEX_SectionBatch<WorldTerrainTile> tilesSections("TILES", readWldxTiles);
+    PGEX_SectionBatch<WorldScenery> scenerySections("SCENERY", readWldxScenery);
+    PGEX_SectionBatch<WorldPathTile> pathsSections("PATHS", readWldxPaths);
+    PGEX_SectionBatch<WorldMusicBox> musicboxesSections("MUSICBOXES", readWldxMusicBoxes);
+    PGEX_SectionBatch<WorldAreaRect> arearectsSections("AREARECTS", readWldxAreaRects);
+    PGEX_SectionBatch<WorldLevelTile> levelsSections("LEVELS", readWldxLevels);
     ///////////////////////////////////////Begin file///////////////////////////////////////
-    PGEX_FileParseTree(in.readAll());
+    PGEX_FileParseTreeSkipping(in.readAll(), PGEX_SkippedSections(s_wldxSectionParts, loadSections));
+
+    if(PGE_FileFormats_misc::g_pgexReadThreads > 1)
+    {
+        // Decode independent sections ahead, they get merged in the file order below
+        std::vector<PGEX_SectionJob> jobs;
+        tilesSections.schedule(pgeX_Data, jobs);
+        scenerySections.schedule(pgeX_Data, jobs);
+        pathsSections.schedule(pgeX_Data, jobs);
+        musicboxesSections.schedule(pgeX_Data, jobs);
+        arearectsSections.schedule(pgeX_Data, jobs);
+        levelsSections.schedule(pgeX_Data, jobs);
+        PGEX_RunSectionJobs(jobs, PGE_FileFormats_misc::g_pgexReadThreads);
+    }
+
     PGEX_FetchSection() //look sections
     {
         PGEX_FetchSection_begin()
@@ -339,6 +612,7 @@ bool FileFormats::ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, World
                     PGEX_StrVal("XTRA", FileData.custom_params)     //World-wide Extra settings
                     PGEX_StrVal("CPID", FileData.meta.configPackId)//Config pack ID string
                     PGEX_UIntVal("EFL", FileData.meta.engineFeatureLevel) //Target engine version
+                    PGEX_ValueEnd()
                 }
             }
         }//head
@@ -361,6 +635,7 @@ bool FileFormats::ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, World
                     PGEX_StrVal("BM", meta_bookmark.bookmarkName) //Bookmark name
                     PGEX_FloatVal("X", meta_bookmark.x) // Position X
                     PGEX_FloatVal("Y", meta_bookmark.y) // Position Y
+                    PGEX_ValueEnd()
                 }
                 FileData.metaData.bookmarks.push_back(meta_bookmark);
             }
@@ -385,6 +660,7 @@ bool FileFormats::ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, World
                     PGEX_StrVal("N",  FileData.metaData.crash.filename)  //Filename
                     PGEX_StrVal("P",  FileData.metaData.crash.path)  //Path
                     PGEX_StrVal("FP", FileData.metaData.crash.fullPath)  //Full file Path
+                    PGEX_ValueEnd()
                 }
             }
         }//meta sys crash
@@ -394,165 +670,48 @@ bool FileFormats::ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, World
         {
             str_count++;
             PGEX_SectionBegin(PGEFile::PGEX_Struct);
-            PGEX_Items()
-            {
-                str_count++;
-                PGEX_ItemBegin(PGEFile::PGEX_Struct);
-                tile = CreateWldTile();
-                PGEX_Values() //Look markers and values
-                {
-                    PGEX_ValueBegin()
-                    PGEX_ULongVal("ID", tile.id) //Tile ID
-                    PGEX_SLongVal("X",  tile.x) //X Position
-                    PGEX_SLongVal("Y",  tile.y) //Y Position
-                    PGEX_StrVal("XTRA", tile.meta.custom_params)//Custom JSON data tree
-                }
-                tile.meta.array_id = FileData.tile_array_id++;
-                tile.meta.index = static_cast<unsigned int>(FileData.tiles.size());
-                FileData.tiles.push_back(tile);
-            }
+            if(!tilesSections.read(f_section, section, FileData.tiles, FileData.tile_array_id, str_count, errorString))
+                goto badfile;
         }//TILES
         ///////////////////SCENERY//////////////////////
         PGEX_Section("SCENERY")
         {
             str_count++;
             PGEX_SectionBegin(PGEFile::PGEX_Struct);
-            PGEX_Items()
-            {
-                str_count++;
-                PGEX_ItemBegin(PGEFile::PGEX_Struct);
-                scen = CreateWldScenery();
-                PGEX_Values() //Look markers and values
-                {
-                    PGEX_ValueBegin()
-                    PGEX_ULongVal("ID", scen.id)  //Scenery ID
-                    PGEX_SLongVal("X", scen.x) //X Position
-                    PGEX_SLongVal("Y", scen.y) //Y Position
-                    PGEX_StrVal("XTRA", scen.meta.custom_params)//Custom JSON data tree
-                }
-                scen.meta.array_id = FileData.scene_array_id++;
-                scen.meta.index = static_cast<unsigned int>(FileData.scenery.size());
-                FileData.scenery.push_back(scen);
-            }
+            if(!scenerySections.read(f_section, section, FileData.scenery, FileData.scene_array_id, str_count, errorString))
+                goto badfile;
         }//SCENERY
         ///////////////////PATHS//////////////////////
         PGEX_Section("PATHS")
         {
             str_count++;
             PGEX_SectionBegin(PGEFile::PGEX_Struct);
-            PGEX_Items()
-            {
-                str_count++;
-                PGEX_ItemBegin(PGEFile::PGEX_Struct);
-                pathitem = CreateWldPath();
-                PGEX_Values() //Look markers and values
-                {
-                    PGEX_ValueBegin()
-                    PGEX_ULongVal("ID", pathitem.id)  //Path ID
-                    PGEX_SLongVal("X", pathitem.x) //X Position
-                    PGEX_SLongVal("Y", pathitem.y) //Y Position
-                    PGEX_StrVal("XTRA", pathitem.meta.custom_params)//Custom JSON data tree
-                }
-                pathitem.meta.array_id = FileData.path_array_id++;
-                pathitem.meta.index =  static_cast<unsigned int>(FileData.paths.size());
-                FileData.paths.push_back(pathitem);
-            }
+            if(!pathsSections.read(f_section, section, FileData.paths, FileData.path_array_id, str_count, errorString))
+                goto badfile;
         }//PATHS
         ///////////////////MUSICBOXES//////////////////////
         PGEX_Section("MUSICBOXES")
         {
             str_count++;
             PGEX_SectionBegin(PGEFile::PGEX_Struct);
-            PGEX_Items()
-            {
-                str_count++;
-                PGEX_ItemBegin(PGEFile::PGEX_Struct);
-                musicbox = CreateWldMusicbox();
-                PGEX_Values() //Look markers and values
-                {
-                    PGEX_ValueBegin()
-                    PGEX_ULongVal("ID", musicbox.id) //MISICBOX ID
-                    PGEX_SLongVal("X", musicbox.x) //X Position
-                    PGEX_SLongVal("Y", musicbox.y) //X Position
-                    PGEX_StrVal("MF", musicbox.music_file)  //Custom music file
-                    PGEX_StrVal("XTRA", musicbox.meta.custom_params)//Custom JSON data tree
-                }
-                musicbox.meta.array_id = FileData.musicbox_array_id++;
-                musicbox.meta.index =  static_cast<unsigned int>(FileData.music.size());
-                FileData.music.push_back(musicbox);
-            }
+            if(!musicboxesSections.read(f_section, section, FileData.music, FileData.musicbox_array_id, str_count, errorString))
+                goto badfile;
         }//MUSICBOXES
         ///////////////////AREARECTS//////////////////////
         PGEX_Section("AREARECTS")
         {
             str_count++;
             PGEX_SectionBegin(PGEFile::PGEX_Struct);
-            PGEX_Items()
-            {
-                str_count++;
-                PGEX_ItemBegin(PGEFile::PGEX_Struct);
-                arearect = WorldAreaRect();
-                PGEX_Values() //Look markers and values
-                {
-                    PGEX_ValueBegin()
-                    PGEX_UIntVal("F", arearect.flags)  //Flags
-                    PGEX_SLongVal("X", arearect.x) //X Position
-                    PGEX_SLongVal("Y", arearect.y) //X Position
-                    PGEX_USLongVal("W", arearect.w) //Width
-                    PGEX_USLongVal("H", arearect.h) //Height
-
-                    // unused stuff
-                    PGEX_ULongVal("MI", arearect.music_id) //MUSICBOX ID
-                    PGEX_StrVal("MF", arearect.music_file)  //Custom music file
-                    PGEX_StrVal("LR", arearect.layer)
-                    PGEX_StrVal("EB", arearect.eventBreak)
-                    PGEX_StrVal("EW", arearect.eventWarp)
-                    PGEX_StrVal("EA", arearect.eventAnchor)
-                    PGEX_StrVal("ET", arearect.eventTouch)
-                    PGEX_UIntVal("TP", arearect.eventTouchPolicy)
-                    PGEX_StrVal("XTRA", arearect.meta.custom_params)//Custom JSON data tree
-                }
-                arearect.meta.array_id = FileData.arearect_array_id++;
-                arearect.meta.index =  static_cast<unsigned int>(FileData.arearects.size());
-                FileData.arearects.push_back(arearect);
-            }
+            if(!arearectsSections.read(f_section, section, FileData.arearects, FileData.arearect_array_id, str_count, errorString))
+                goto badfile;
         }//AREARECTS
         ///////////////////LEVELS//////////////////////
         PGEX_Section("LEVELS")
         {
             str_count++;
             PGEX_SectionBegin(PGEFile::PGEX_Struct);
-            PGEX_Items()
-            {
-                str_count++;
-                PGEX_ItemBegin(PGEFile::PGEX_Struct);
-                lvlitem = CreateWldLevel();
-                PGEX_Values() //Look markers and values
-                {
-                    PGEX_ValueBegin()
-                    PGEX_ULongVal("ID", lvlitem.id) //LEVEL IMAGE ID
-                    PGEX_SLongVal("X",  lvlitem.x) //X Position
-                    PGEX_SLongVal("Y",  lvlitem.y) //X Position
-                    PGEX_StrVal("LF", lvlitem.lvlfile)  //Target level file
-                    PGEX_StrVal("LT", lvlitem.title)   //Level title
-                    PGEX_ULongVal("EI", lvlitem.entertowarp) //Entrance Warp ID (if 0 - start level from default points)
-                    PGEX_SIntVal("ET", lvlitem.top_exit) //Open top path on exit type
-                    PGEX_SIntVal("EL", lvlitem.left_exit) //Open left path on exit type
-                    PGEX_SIntVal("ER", lvlitem.right_exit) //Open right path on exit type
-                    PGEX_SIntVal("EB", lvlitem.bottom_exit) //Open bottom path on exit type
-                    PGEX_SLongVal("WX", lvlitem.gotox) //Goto world map X
-                    PGEX_SLongVal("WY", lvlitem.gotoy) //Goto world map Y
-                    PGEX_BoolVal("AV", lvlitem.alwaysVisible) //Always visible
-                    PGEX_BoolVal("SP", lvlitem.gamestart) //Is Game start point
-                    PGEX_BoolVal("BP", lvlitem.pathbg) //Path background
-                    PGEX_BoolVal("BG", lvlitem.bigpathbg) //Big path background
-                    PGEX_SIntVal("SSS", lvlitem.starsShowPolicy) // Stars count showing policy
-                    PGEX_StrVal("XTRA", lvlitem.meta.custom_params)//Custom JSON data tree
-                }
-                lvlitem.meta.array_id = FileData.level_array_id++;
-                lvlitem.meta.index = static_cast<unsigned int>(FileData.levels.size());
-                FileData.levels.push_back(lvlitem);
-            }
+            if(!levelsSections.read(f_section, section, FileData.levels, FileData.level_array_id, str_count, errorString))
+                goto badfile;
         }//LEVELS
     }
     ///////////////////////////////////////EndFile///////////////////////////////////////
@@ -560,6 +719,7 @@ bool FileFormats::ReadExtendedWldFile(PGE_FileFormats_misc::TextInput &in, World
     FileData.meta.ReadFileValid = true;
     return true;
 badfile:    //If file format not corrects
+    PGEX_ValueError()
     FileData.meta.ERROR_info = errorString;
     FileData.meta.ERROR_linenum = str_count;
     FileData.meta.ERROR_linedata = line;
@@ -595,7 +755,10 @@ bool FileFormats::WriteExtendedWldFileF(const PGESTRING &filePath, WorldData &Fi
         return false;
     }
 
-    return WriteExtendedWldFile(file, FileData);
+    if(!WriteExtendedWldFile(file, FileData))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, FileData.meta.ERROR_info);
 }
 
 bool FileFormats::WriteExtendedWldFileRaw(WorldData &FileData, PGESTRING &rawdata)
@@ -612,17 +775,159 @@ bool FileFormats::WriteExtendedWldFileRaw(WorldData &FileData, PGESTRING &rawdat
     return WriteExtendedWldFile(file, FileData);
 }
 
+//TILES section
+static void writeWldxTiles(PGEXWriter &w, const WorldData &FileData)
+{
+    pge_size_t i;
+
+    if(!FileData.tiles.empty())
+    {
+        w.beginSection("TILES");
+
+        for(i = 0; i < FileData.tiles.size(); i++)
+        {
+            const WorldTerrainTile &tt = FileData.tiles[i];
+            w.writeInt("ID", tt.id);
+            w.writeInt("X", tt.x);
+            w.writeInt("Y", tt.y);
+            if(!IsEmpty(tt.meta.custom_params))
+                w.writeStr("XTRA", tt.meta.custom_params);
+            w.endLine();
+        }
+
+        w.endSection("TILES");
+    }
+}
+
+//SCENERY section
+static void writeWldxScenery(PGEXWriter &w, const WorldData &FileData)
+{
+    pge_size_t i;
+
+    if(!FileData.scenery.empty())
+    {
+        w.beginSection("SCENERY");
+
+        for(i = 0; i < FileData.scenery.size(); i++)
+        {
+            const WorldScenery &ws = FileData.scenery[i];
+            w.writeInt("ID", ws.id);
+            w.writeInt("X", ws.x);
+            w.writeInt("Y", ws.y);
+            if(!IsEmpty(ws.meta.custom_params))
+                w.writeStr("XTRA", ws.meta.custom_params);
+            w.endLine();
+        }
+
+        w.endSection("SCENERY");
+    }
+}
+
+//PATHS section
+static void writeWldxPaths(PGEXWriter &w, const WorldData &FileData)
+{
+    pge_size_t i;
+
+    if(!FileData.paths.empty())
+    {
+        w.beginSection("PATHS");
+
+        for(i = 0; i < FileData.paths.size(); i++)
+        {
+            const WorldPathTile &wp = FileData.paths[i];
+            w.writeInt("ID", wp.id);
+            w.writeInt("X", wp.x);
+            w.writeInt("Y", wp.y);
+            if(!IsEmpty(wp.meta.custom_params))
+                w.writeStr("XTRA", wp.meta.custom_params);
+            w.endLine();
+        }
+
+        w.endSection("PATHS");
+    }
+}
+
+//LEVELS section
+static void writeWldxLevels(PGEXWriter &w, const WorldData &FileData)
+{
+    pge_size_t i;
+
+    if(!FileData.levels.empty())
+    {
+        w.beginSection("LEVELS");
+        WorldLevelTile defLvl = FileFormats::CreateWldLevel();
+
+        for(i = 0; i < FileData.levels.size(); i++)
+        {
+            const WorldLevelTile &lt = FileData.levels[i];
+            w.writeInt("ID", lt.id);
+            w.writeInt("X", lt.x);
+            w.writeInt("Y", lt.y);
+            if(!IsEmpty(lt.title))
+                w.writeStr("LT", lt.title);
+            if(!IsEmpty(lt.lvlfile))
+                w.writeStr("LF", lt.lvlfile);
+            if(lt.entertowarp != defLvl.entertowarp)
+                w.writeInt("EI", lt.entertowarp);
+            if(lt.left_exit != defLvl.left_exit)
+                w.writeInt("EL", lt.left_exit);
+            if(lt.top_exit != defLvl.top_exit)
+                w.writeInt("ET", lt.top_exit);
+            if(lt.right_exit != defLvl.right_exit)
+                w.writeInt("ER", lt.right_exit);
+            if(lt.bottom_exit != defLvl.bottom_exit)
+                w.writeInt("EB", lt.bottom_exit);
+            if(lt.gotox != defLvl.gotox)
+                w.writeInt("WX", lt.gotox);
+            if(lt.gotoy != defLvl.gotoy)
+                w.writeInt("WY", lt.gotoy);
+            if(lt.alwaysVisible)
+                w.writeBool("AV", lt.alwaysVisible);
+            if(lt.gamestart)
+                w.writeBool("SP", lt.gamestart);
+            if(lt.pathbg)
+                w.writeBool("BP", lt.pathbg);
+            if(lt.bigpathbg)
+                w.writeBool("BG", lt.bigpathbg);
+            if(lt.starsShowPolicy != WorldLevelTile::STARS_UNSPECIFIED)
+                w.writeInt("SSS", lt.starsShowPolicy);
+            if(!IsEmpty(lt.meta.custom_params))
+                w.writeStr("XTRA", lt.meta.custom_params);
+            w.endLine();
+        }
+
+        w.endSection("LEVELS");
+    }
+}
+
 bool FileFormats::WriteExtendedWldFile(PGE_FileFormats_misc::TextOutput &out, WorldData &FileData)
 {
     pge_size_t i = 0;
+    PGEXWriter w(out);
     FileData.meta.RecentFormat = WorldData::PGEX;
 
+    PGEX_SectionRender<WorldData> tilesSection(writeWldxTiles, FileData);
+    PGEX_SectionRender<WorldData> scenerySection(writeWldxScenery, FileData);
+    PGEX_SectionRender<WorldData> pathsSection(writeWldxPaths, FileData);
+    PGEX_SectionRender<WorldData> levelsSection(writeWldxLevels, FileData);
+
+    if(PGE_FileFormats_misc::g_pgexWriteThreads > 1)
+    {
+        // Encode independent sections ahead, they get written in the canonical order below
+        std::vector<PGEX_SectionJob> jobs;
+        tilesSection.schedule(FileData.tiles.size(), jobs);
+        scenerySection.schedule(FileData.scenery.size(), jobs);
+        pathsSection.schedule(FileData.paths.size(), jobs);
+        levelsSection.schedule(FileData.levels.size(), jobs);
+        PGEX_RunSectionJobs(jobs, PGE_FileFormats_misc::g_pgexWriteThreads);
+    }
+
     //HEAD section
     {
-        PGESTRING outHeader;
+        PGEXWriter outHeader;
 
         if(!IsEmpty(FileData.EpisodeTitle))
-            outHeader += PGEFile::value("TL", PGEFile::WriteStr(FileData.EpisodeTitle)); // Episode title
+            outHeader.writeStr("TL", FileData.EpisodeTitle); // Episode title
 
         {
             bool needToAdd = false;
@@ -633,231 +938,148 @@ bool FileFormats::WriteExtendedWldFile(PGE_FileFormats_misc::TextOutput &out, Wo
             }
 
             if(needToAdd)
-                outHeader += PGEFile::value("DC", PGEFile::WriteBoolArr(FileData.nocharacter)); // Disabled characters
+                outHeader.writeBoolArr("DC", FileData.nocharacter); // Disabled characters
         }
 
         if(!IsEmpty(FileData.IntroLevel_file))
-            outHeader += PGEFile::value("IT", PGEFile::WriteStr(FileData.IntroLevel_file)); // Intro level
+            outHeader.writeStr("IT", FileData.IntroLevel_file); // Intro level
         if(!IsEmpty(FileData.GameOverLevel_file))
-            outHeader += PGEFile::value("GO", PGEFile::WriteStr(FileData.GameOverLevel_file)); // Game Over level
+            outHeader.writeStr("GO", FileData.GameOverLevel_file); // Game Over level
         if(FileData.HubStyledWorld)
-            outHeader += PGEFile::value("HB", PGEFile::WriteBool(FileData.HubStyledWorld)); // Hub-styled episode
+            outHeader.writeBool("HB", FileData.HubStyledWorld); // Hub-styled episode
         if(FileData.restartlevel)
-            outHeader += PGEFile::value("RL", PGEFile::WriteBool(FileData.restartlevel)); // Restart on fail
+            outHeader.writeBool("RL", FileData.restartlevel); // Restart on fail
         if(FileData.stars > 0)
-            outHeader += PGEFile::value("SZ", PGEFile::WriteInt(FileData.stars));      // Total stars number
+            outHeader.writeInt("SZ", FileData.stars);      // Total stars number
         if(!IsEmpty(FileData.authors))
-            outHeader += PGEFile::value("CD", PGEFile::WriteStr(FileData.authors));   // Credits
+            outHeader.writeStr("CD", FileData.authors);   // Credits
         if(!IsEmpty(FileData.authors_music))
-            outHeader += PGEFile::value("CM", PGEFile::WriteStr(FileData.authors_music));   // Credits scene background music
+            outHeader.writeStr("CM", FileData.authors_music);   // Credits scene background music
         if(FileData.starsShowPolicy != WorldData::STARS_UNSPECIFIED)
-            outHeader += PGEFile::value("SSS", PGEFile::WriteInt(FileData.starsShowPolicy));
+            outHeader.writeInt("SSS", FileData.starsShowPolicy);
         if(!IsEmpty(FileData.custom_params))
-            outHeader += PGEFile::value("XTRA", PGEFile::WriteStr(FileData.custom_params));   // World-wide extra settings
+            outHeader.writeStr("XTRA", FileData.custom_params);   // World-wide extra settings
         if(!IsEmpty(FileData.meta.configPackId))
-            outHeader += PGEFile::value("CPID", PGEFile::WriteStr(FileData.meta.configPackId));
+            outHeader.writeStr("CPID", FileData.meta.configPackId);
         if(FileData.meta.engineFeatureLevel != 0)
-            outHeader += PGEFile::value("EFL", PGEFile::WriteInt(FileData.meta.engineFeatureLevel));
+            outHeader.writeInt("EFL", FileData.meta.engineFeatureLevel);
 
-        if(!IsEmpty(outHeader))
-            out << "HEAD\n" << outHeader << "\n" << "HEAD_END\n";
+        if(!outHeader.empty())
+        {
+            w.beginSection("HEAD");
+            w.raw(outHeader.data());
+            w.endLine();
+            w.endSection("HEAD");
+        }
     }
 
     //////////////////////////////////////MetaData////////////////////////////////////////////////
     //Bookmarks
     if(!FileData.metaData.bookmarks.empty())
     {
-        out << "META_BOOKMARKS\n";
+        w.beginSection("META_BOOKMARKS");
 
         for(i = 0; i < FileData.metaData.bookmarks.size(); i++)
         {
             Bookmark &bm = FileData.metaData.bookmarks[i];
             //Bookmark name
-            out << PGEFile::value("BM", PGEFile::WriteStr(bm.bookmarkName));
-            out << PGEFile::value("X", PGEFile::WriteFloat(bm.x));
-            out << PGEFile::value("Y", PGEFile::WriteFloat(bm.y));
-            out << "\n";
+            w.writeStr("BM", bm.bookmarkName);
+            w.writeFloat("X", bm.x);
+            w.writeFloat("Y", bm.y);
+            w.endLine();
         }
 
-        out << "META_BOOKMARKS_END\n";
+        w.endSection("META_BOOKMARKS");
     }
 
     //Some System information
     if(FileData.metaData.crash.used)
     {
-        out << "META_SYS_CRASH\n";
-        out << PGEFile::value("UT", PGEFile::WriteBool(FileData.metaData.crash.untitled));
-        out << PGEFile::value("MD", PGEFile::WriteBool(FileData.metaData.crash.modifyed));
-        out << PGEFile::value("FF", PGEFile::WriteInt(FileData.metaData.crash.fmtID));
-        out << PGEFile::value("FV", PGEFile::WriteInt(FileData.metaData.crash.fmtVer));
-        out << PGEFile::value("N",  PGEFile::WriteStr(FileData.metaData.crash.filename));
-        out << PGEFile::value("P",  PGEFile::WriteStr(FileData.metaData.crash.path));
-        out << PGEFile::value("FP", PGEFile::WriteStr(FileData.metaData.crash.fullPath));
-        out << "\n";
-        out << "META_SYS_CRASH_END\n";
+        w.beginSection("META_SYS_CRASH");
+        w.writeBool("UT", FileData.metaData.crash.untitled);
+        w.writeBool("MD", FileData.metaData.crash.modifyed);
+        w.writeInt("FF", FileData.metaData.crash.fmtID);
+        w.writeInt("FV", FileData.metaData.crash.fmtVer);
+        w.writeStr("N", FileData.metaData.crash.filename);
+        w.writeStr("P", FileData.metaData.crash.path);
+        w.writeStr("FP", FileData.metaData.crash.fullPath);
+        w.endLine();
+        w.endSection("META_SYS_CRASH");
     }
     //////////////////////////////////////MetaData///END//////////////////////////////////////////
 
-    if(!FileData.tiles.empty())
-    {
-        out << "TILES\n";
-
-        for(i = 0; i < FileData.tiles.size(); i++)
-        {
-            WorldTerrainTile &tt = FileData.tiles[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(tt.id));
-            out << PGEFile::value("X", PGEFile::WriteInt(tt.x));
-            out << PGEFile::value("Y", PGEFile::WriteInt(tt.y));
-            if(!IsEmpty(tt.meta.custom_params))
-                out << PGEFile::value("XTRA", PGEFile::WriteStr(tt.meta.custom_params));
-            out << "\n";
-        }
-
-        out << "TILES_END\n";
-    }
-
-    if(!FileData.scenery.empty())
-    {
-        out << "SCENERY\n";
-
-        for(i = 0; i < FileData.scenery.size(); i++)
-        {
-            WorldScenery &ws = FileData.scenery[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(ws.id));
-            out << PGEFile::value("X", PGEFile::WriteInt(ws.x));
-            out << PGEFile::value("Y", PGEFile::WriteInt(ws.y));
-            if(!IsEmpty(ws.meta.custom_params))
-                out << PGEFile::value("XTRA", PGEFile::WriteStr(ws.meta.custom_params));
-            out << "\n";
-        }
-
-        out << "SCENERY_END\n";
-    }
+    //TILES section
+    tilesSection.write(w);
 
-    if(!FileData.paths.empty())
-    {
-        out << "PATHS\n";
-
-        for(i = 0; i < FileData.paths.size(); i++)
-        {
-            WorldPathTile &wp = FileData.paths[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(wp.id));
-            out << PGEFile::value("X", PGEFile::WriteInt(wp.x));
-            out << PGEFile::value("Y", PGEFile::WriteInt(wp.y));
-            if(!IsEmpty(wp.meta.custom_params))
-                out << PGEFile::value("XTRA", PGEFile::WriteStr(wp.meta.custom_params));
-            out << "\n";
-        }
+    //SCENERY section
+    scenerySection.write(w);
 
-        out << "PATHS_END\n";
-    }
+    //PATHS section
+    pathsSection.write(w);
 
     if(!FileData.music.empty())
     {
-        out << "MUSICBOXES\n";
+        w.beginSection("MUSICBOXES");
 
         for(i = 0; i < FileData.music.size(); i++)
         {
             WorldMusicBox &wm = FileData.music[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(wm.id));
-            out << PGEFile::value("X", PGEFile::WriteInt(wm.x));
-            out << PGEFile::value("Y", PGEFile::WriteInt(wm.y));
+            w.writeInt("ID", wm.id);
+            w.writeInt("X", wm.x);
+            w.writeInt("Y", wm.y);
             if(!IsEmpty(wm.music_file))
-                out << PGEFile::value("MF", PGEFile::WriteStr(wm.music_file));
+                w.writeStr("MF", wm.music_file);
             if(!IsEmpty(wm.meta.custom_params))
-                out << PGEFile::value("XTRA", PGEFile::WriteStr(wm.meta.custom_params));
-            out << "\n";
+                w.writeStr("XTRA", wm.meta.custom_params);
+            w.endLine();
         }
 
-        out << "MUSICBOXES_END\n";
+        w.endSection("MUSICBOXES");
     }
 
     if(!FileData.arearects.empty())
     {
-        out << "AREARECTS\n";
+        w.beginSection("AREARECTS");
 
         WorldAreaRect defA;
 
         for(i = 0; i < FileData.arearects.size(); i++)
         {
             WorldAreaRect &a = FileData.arearects[i];
-            out << PGEFile::value("F", PGEFile::WriteInt(a.flags));
-            out << PGEFile::value("X", PGEFile::WriteInt(a.x));
-            out << PGEFile::value("Y", PGEFile::WriteInt(a.y));
-            out << PGEFile::value("W", PGEFile::WriteInt(a.w));
-            out << PGEFile::value("H", PGEFile::WriteInt(a.h));
+            w.writeInt("F", a.flags);
+            w.writeInt("X", a.x);
+            w.writeInt("Y", a.y);
+            w.writeInt("W", a.w);
+            w.writeInt("H", a.h);
 
             // unused stuff
             if(a.music_id)
-                out << PGEFile::value("MI", PGEFile::WriteInt(a.music_id));
+                w.writeInt("MI", a.music_id);
             if(!IsEmpty(a.music_file))
-                out << PGEFile::value("MF", PGEFile::WriteStr(a.music_file));
+                w.writeStr("MF", a.music_file);
             if(!IsEmpty(a.layer) && a.layer != defA.layer)
-                out << PGEFile::value("LR", PGEFile::WriteStr(a.layer));
+                w.writeStr("LR", a.layer);
             if(!IsEmpty(a.eventBreak))
-                out << PGEFile::value("EB", PGEFile::WriteStr(a.eventBreak));
+                w.writeStr("EB", a.eventBreak);
             if(!IsEmpty(a.eventWarp))
-                out << PGEFile::value("EW", PGEFile::WriteStr(a.eventWarp));
+                w.writeStr("EW", a.eventWarp);
             if(!IsEmpty(a.eventAnchor))
-                out << PGEFile::value("EA", PGEFile::WriteStr(a.eventAnchor));
+                w.writeStr("EA", a.eventAnchor);
             if(!IsEmpty(a.eventTouch))
-                out << PGEFile::value("ET", PGEFile::WriteStr(a.eventTouch));
+                w.writeStr("ET", a.eventTouch);
             if(a.eventTouchPolicy != defA.eventTouchPolicy)
-                out << PGEFile::value("TP", PGEFile::WriteInt(a.eventTouchPolicy));
+                w.writeInt("TP", a.eventTouchPolicy);
             if(!IsEmpty(a.meta.custom_params))
-                out << PGEFile::value("XTRA", PGEFile::WriteStr(a.meta.custom_params));
-            out << "\n";
+                w.writeStr("XTRA", a.meta.custom_params);
+            w.endLine();
         }
 
-        out << "AREARECTS_END\n";
+        w.endSection("AREARECTS");
     }
 
-    if(!FileData.levels.empty())
-    {
-        out << "LEVELS\n";
-        WorldLevelTile defLvl = CreateWldLevel();
-
-        for(i = 0; i < FileData.levels.size(); i++)
-        {
-            WorldLevelTile &lt = FileData.levels[i];
-            out << PGEFile::value("ID", PGEFile::WriteInt(lt.id));
-            out << PGEFile::value("X",  PGEFile::WriteInt(lt.x));
-            out << PGEFile::value("Y",  PGEFile::WriteInt(lt.y));
-            if(!IsEmpty(lt.title))
-                out << PGEFile::value("LT", PGEFile::WriteStr(lt.title));
-            if(!IsEmpty(lt.lvlfile))
-                out << PGEFile::value("LF", PGEFile::WriteStr(lt.lvlfile));
-            if(lt.entertowarp != defLvl.entertowarp)
-                out << PGEFile::value("EI", PGEFile::WriteInt(lt.entertowarp));
-            if(lt.left_exit != defLvl.left_exit)
-                out << PGEFile::value("EL", PGEFile::WriteInt(lt.left_exit));
-            if(lt.top_exit != defLvl.top_exit)
-                out << PGEFile::value("ET", PGEFile::WriteInt(lt.top_exit));
-            if(lt.right_exit != defLvl.right_exit)
-                out << PGEFile::value("ER", PGEFile::WriteInt(lt.right_exit));
-            if(lt.bottom_exit != defLvl.bottom_exit)
-                out << PGEFile::value("EB", PGEFile::WriteInt(lt.bottom_exit));
-            if(lt.gotox != defLvl.gotox)
-                out << PGEFile::value("WX", PGEFile::WriteInt(lt.gotox));
-            if(lt.gotoy != defLvl.gotoy)
-                out << PGEFile::value("WY", PGEFile::WriteInt(lt.gotoy));
-            if(lt.alwaysVisible)
-                out << PGEFile::value("AV", PGEFile::WriteBool(lt.alwaysVisible));
-            if(lt.gamestart)
-                out << PGEFile::value("SP", PGEFile::WriteBool(lt.gamestart));
-            if(lt.pathbg)
-                out << PGEFile::value("BP", PGEFile::WriteBool(lt.pathbg));
-            if(lt.bigpathbg)
-                out << PGEFile::value("BG", PGEFile::WriteBool(lt.bigpathbg));
-            if(lt.starsShowPolicy != WorldLevelTile::STARS_UNSPECIFIED)
-                out << PGEFile::value("SSS", PGEFile::WriteInt(lt.starsShowPolicy));
-            if(!IsEmpty(lt.meta.custom_params))
-                out << PGEFile::value("XTRA", PGEFile::WriteStr(lt.meta.custom_params));
-            out << "\n";
-        }
-
-        out << "LEVELS_END\n";
-    }
+    //LEVELS section
+    levelsSection.write(w);
 
+    w.flush();
     return true;
 }
@@ -27,52 +27,80 @@
 #include "pge_file_lib_sys.h"
 #include "pge_file_lib_private.h"
 #include "pgex/file_strlist.h"
+#include <cstring>
 
-FileStringList::FileStringList()
-{
-    lineID=0;
-}
+FileStringList::FileStringList() :
+    m_data(nullptr),
+    m_pos(1)
+{}
 
-FileStringList::FileStringList(PGESTRING fileData)
+FileStringList::FileStringList(const PGESTRING &fileData)
 {
     addData(fileData);
 }
 
 FileStringList::~FileStringList()
+{}
+
+void FileStringList::addData(const PGESTRING &fileData)
 {
-    buffer.clear();
+    m_data = &fileData;
+    m_pos = 0;
 }
 
-void FileStringList::addData(const PGESTRING &fileData)
+PGESTRING FileStringList::readLine()
 {
-    buffer.clear();
+    pge_size_t begin, length;
+
+    if(!readLine(begin, length))
+        return PGESTRING();
+
 #ifdef PGE_FILES_QT
-    buffer = fileData.split(PGEFL_QRegExp("[\r\n]"), QSTR_SKIP_EMPTY_PARTS);
+    return m_data->mid(begin, length);
 #else
-    PGE_SPLITSTRING(buffer, fileData, "\n");
+    return m_data->substr(begin, length);
 #endif
-    lineID = 0;
 }
 
-PGESTRING FileStringList::readLine()
+bool FileStringList::readLine(pge_size_t &begin, pge_size_t &length)
 {
-    PGESTRING sent;
-
-    if(!isEOF())
-    {
-        sent = buffer[static_cast<pge_size_t>(lineID)];
-        lineID++;
-    }
-    return sent;
+    if(isEOF())
+        return false;
+
+    const pge_size_t size = m_data->size();
+    pge_size_t end = m_pos;
+
+#ifdef PGE_FILES_QT
+    // Qt version splits by both CR and LF and skips empty lines
+    while(end < size && (*m_data)[end] != '\n' && (*m_data)[end] != '\r')
+        end++;
+#else
+    const char *lf = static_cast<const char *>(std::memchr(m_data->data() + m_pos, '\n', size - m_pos));
+    end = lf ? static_cast<pge_size_t>(lf - m_data->data()) : size;
+#endif
+
+    begin = m_pos;
+    length = end - m_pos;
+    m_pos = end + 1;
+
+    return true;
 }
 
 bool FileStringList::isEOF()
 {
-    return (lineID >= (signed)buffer.size());
+    if(!m_data)
+        return true;
+
+#ifdef PGE_FILES_QT
+    while(m_pos < m_data->size() && ((*m_data)[m_pos] == '\n' || (*m_data)[m_pos] == '\r'))
+        m_pos++;
+    return m_pos >= m_data->size();
+#else
+    return m_pos > m_data->size();
+#endif
 }
 
 bool FileStringList::atEnd()
 {
     return isEOF();
 }
-
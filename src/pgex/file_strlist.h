@@ -34,21 +34,14 @@
 #ifndef FILE_STRLIST_H
 #define FILE_STRLIST_H
 
-#ifdef PGE_FILES_QT
-#include <QString>
-#include <QStringList>
-#include <QObject>
-typedef QString PGESTRING;
-typedef QStringList PGESTRINGList;
-#else
-#include <vector>
-#include <string>
-typedef std::string PGESTRING;
-typedef std::vector<std::string> PGESTRINGList;
-#endif
+#include "pge_file_lib_globs.h"
+#include "pge_file_lib_private.h"
 
 /*!
- * \brief Provides string container automatically splited from entire file data
+ * \brief Provides line-by-line access to entire file data
+ *
+ * Lines are not copied: the list refers the given file data which must stay
+ * alive and unchanged while lines are being read.
  */
 #ifdef PGE_FILES_QT
 class FileStringList:public QObject
@@ -69,7 +62,7 @@ public:
      * \brief Constructor with pre-set data
      * \param fileData file data which will be splited by line-feeds
      */
-    FileStringList(PGESTRING fileData);
+    FileStringList(const PGESTRING &fileData);
 
     /*!
      * Destructor
@@ -77,7 +70,7 @@ public:
     ~FileStringList();
 
     /*!
-     * \brief Changes filedata and rebuilds list of lines
+     * \brief Changes filedata and resets the line counter
      * \param fileData file data which will be splited by line-feeds
      */
     void addData(const PGESTRING& fileData);
@@ -88,6 +81,14 @@ public:
      */
     PGESTRING readLine();
 
+    /*!
+     * \brief Finds current line and incements internal line counter
+     * \param begin [__out] offset of the line begin in the file data
+     * \param length [__out] length of the line
+     * \return false if there are no more lines
+     */
+    bool readLine(pge_size_t &begin, pge_size_t &length);
+
     /*!
      * \brief Are all lines was gotten?
      * \return true if internal line counter is equal or more than total number of lines
@@ -101,15 +102,14 @@ public:
     bool atEnd();
 private:
     /*!
-     * \brief Contains splited list of string lines
+     * \brief Referenced file data
      */
-    PGESTRINGList buffer;
+    const PGESTRING *m_data;
 
     /*!
-     * \brief Internal counter of gotten lines
+     * \brief Offset of the next line begin, greater than data size at end
      */
-    long lineID;
+    pge_size_t m_pos;
 };
 
 #endif // FILE_STRLIST_H
-
@@ -44,9 +44,86 @@
 
 #include "pge_x.h"
 #include "pgex/file_strlist.h"
+#include <algorithm>
+#include <limits>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef PGE_FILES_QT
+#   define PGEX_RawChars(s) (s).constData()
+#else
+#   define PGEX_RawChars(s) (s).data()
+#endif
+
+#if !defined(PGE_FILES_QT) && !defined(PGEFL_DISABLE_SIMD)
+#   if defined(__AVX2__)
+#       include <immintrin.h>
+#       define PGEX_DELIMITER_SIMD
+#       define PGEX_DELIMITER_AVX2
+#   elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#       include <emmintrin.h>
+#       define PGEX_DELIMITER_SIMD
+#       define PGEX_DELIMITER_SSE2
+#   endif
+#   if defined(PGEX_DELIMITER_SIMD) && defined(_MSC_VER)
+#       include <intrin.h>
+#   endif
+#endif
 
 namespace PGEExtendedFormat
 {
+    /*
+     * Structural characters of data lines: separators of markers and values,
+     * escape character and nul which ends the parse of the line
+     */
+    static inline bool isDelimiter(PGEChar c)
+    {
+        return (c == ':') || (c == ';') || (c == '\\') || (c == '\0');
+    }
+
+#ifdef PGEX_DELIMITER_SIMD
+#   ifdef PGEX_DELIMITER_AVX2
+    static const pge_size_t delimiterBlockSize = 32;
+
+    //! Returns a bit mask of structural characters in the block of 32 bytes
+    static inline uint32_t delimiterMask(const char *block)
+    {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+        __m256i mask = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(':'));
+        mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(data, _mm256_set1_epi8(';')));
+        mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\\')));
+        mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(data, _mm256_setzero_si256()));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+    }
+#   else
+    static const pge_size_t delimiterBlockSize = 16;
+
+    //! Returns a bit mask of structural characters in the block of 16 bytes
+    static inline uint32_t delimiterMask(const char *block)
+    {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+        __m128i mask = _mm_cmpeq_epi8(data, _mm_set1_epi8(':'));
+        mask = _mm_or_si128(mask, _mm_cmpeq_epi8(data, _mm_set1_epi8(';')));
+        mask = _mm_or_si128(mask, _mm_cmpeq_epi8(data, _mm_set1_epi8('\\')));
+        mask = _mm_or_si128(mask, _mm_cmpeq_epi8(data, _mm_setzero_si128()));
+        return static_cast<uint32_t>(_mm_movemask_epi8(mask));
+    }
+#   endif
+
+    //! Index of the lowest set bit, the mask must not be zero
+    static inline pge_size_t lowestBit(uint32_t mask)
+    {
+#   ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<pge_size_t>(index);
+#   else
+        return static_cast<pge_size_t>(__builtin_ctz(mask));
+#   endif
+    }
+#endif // PGEX_DELIMITER_SIMD
+
     static const char *heximal_valid_chars    = "0123456789ABCDEFabcdef";
     static const pge_size_t heximal_valid_chars_len = 22;
 
@@ -55,7 +132,7 @@ namespace PGEExtendedFormat
         return ((c >= '0') && (c <= '9'));
     }
 
-    static bool isValid(const PGESTRING &s, const char *valid_chars, const pge_size_t valid_chars_len, bool allow_empty = false)
+    static bool isValid(const PGEXSTRING &s, const char *valid_chars, const pge_size_t valid_chars_len, bool allow_empty = false)
     {
         if(IsEmpty(s))
             return allow_empty;
@@ -81,6 +158,177 @@ namespace PGEExtendedFormat
 
         return true;
     }
+
+    /*
+     * Validates and accumulates a non-empty sequence of decimal digits,
+     * fails if any other character met or if the number exceeds the limit
+     */
+    static bool parseDigits(const PGEChar *it, const PGEChar *end, unsigned long long max, unsigned long long &out)
+    {
+        if(it == end)
+            return false;
+
+        unsigned long long ret = 0;
+        for(; it != end; ++it)
+        {
+            const char c = PGEGetChar((*it));
+            if((c < '0') || (c > '9'))
+                return false;
+            const unsigned int digit = static_cast<unsigned int>(c - '0');
+            if(ret > (max - digit) / 10)
+                return false;
+            ret = ret * 10 + digit;
+        }
+
+        out = ret;
+        return true;
+    }
+
+    template<typename T>
+    static bool parseIntU(const PGEXSTRING &in, T &out)
+    {
+        unsigned long long ret;
+        const PGEChar *data = in.data();
+        if(!parseDigits(data, data + in.size(), static_cast<unsigned long long>(std::numeric_limits<T>::max()), ret))
+            return false;
+        out = static_cast<T>(ret);
+        return true;
+    }
+
+    template<typename T>
+    static bool parseIntS(const PGEXSTRING &in, T &out)
+    {
+        const PGEChar *data = in.data();
+        const PGEChar *end = data + in.size();
+        const bool negative = (data != end) && (PGEGetChar((*data)) == '-');
+        if(negative)
+            ++data;
+
+        // The magnitude of the minimum is greater than the maximum by one
+        const unsigned long long max = static_cast<unsigned long long>(std::numeric_limits<T>::max());
+        unsigned long long ret;
+        if(!parseDigits(data, end, negative ? max + 1 : max, ret))
+            return false;
+
+        if(!negative)
+            out = static_cast<T>(ret);
+        else if(ret == 0)
+            out = 0;
+        else
+            out = -static_cast<T>(ret - 1) - 1;
+        return true;
+    }
+
+    /*
+     * Validates the floating point number: optional '-', at least one digit
+     * with optional '.', and optional exponent 'e' with optional sign and 1-4 digits
+     */
+    static bool validateFloat(const PGEXSTRING &in)
+    {
+        const pge_size_t size = in.size();
+        pge_size_t i = 0;
+        bool has_digit = false;
+        bool decimal = false;
+        pge_size_t pow10_digits = 0;
+
+        if((size > 0) && (PGEGetChar(in[0]) == '-'))
+            i++;
+
+        for(; i < size; i++)
+        {
+            const char c = PGEGetChar(in[i]);
+            if((c >= '0') && (c <= '9'))
+                has_digit = true;
+            else if((c == '.') && !decimal)
+                decimal = true;
+            else if(c == 'e')
+                break;
+            else
+                return false;
+        }
+
+        if(!has_digit)
+            return false;
+
+        if(i == size)
+            return true;
+
+        // exponent, with optional sign (negative or positive)
+        i++;
+        if((i < size) && ((PGEGetChar(in[i]) == '-') || (PGEGetChar(in[i]) == '+')))
+            i++;
+
+        for(; i < size; i++)
+        {
+            const char c = PGEGetChar(in[i]);
+            if((c < '0') || (c > '9') || (++pow10_digits > 4))
+                return false;
+        }
+
+        return pow10_digits > 0;
+    }
+
+#ifdef PGE_FILES_QT
+    static inline bool convertFloat(const PGEXSTRING &in, float &out)
+    {
+        bool ok = false;
+        out = in.toFloat(&ok);
+        return ok;
+    }
+
+    static inline bool convertFloat(const PGEXSTRING &in, double &out)
+    {
+        bool ok = false;
+        out = in.toDouble(&ok);
+        return ok;
+    }
+#else
+    static inline void convertFloat(const char *str, char **end, float &out)
+    {
+        out = std::strtof(str, end);
+    }
+
+    static inline void convertFloat(const char *str, char **end, double &out)
+    {
+        out = std::strtod(str, end);
+    }
+
+    // Same as the std::stod() and the std::stof(): the overflow or underflow is an error
+    template<typename T>
+    static bool convertFloat(const PGEXSTRING &in, T &out)
+    {
+        // The value is not nul-terminated, nearly all of them fit the buffer on the stack
+        char buf[64];
+        std::string longBuf;
+        const char *str = buf;
+
+        if(in.size() < sizeof(buf))
+        {
+            memcpy(buf, in.data(), in.size());
+            buf[in.size()] = '\0';
+        }
+        else
+        {
+            longBuf.assign(in.data(), in.size());
+            str = longBuf.c_str();
+        }
+
+        char *end = nullptr;
+        errno = 0;
+        convertFloat(str, &end, out);
+        return (end != str) && (errno != ERANGE);
+    }
+#endif
+
+    template<typename T>
+    static bool parseFloat(const PGEXSTRING &in, T &out)
+    {
+        T ret;
+        if(!validateFloat(in) || !convertFloat(in, ret))
+            return false;
+        out = ret;
+        return true;
+    }
 }
 
 
@@ -105,6 +353,7 @@ PGEFile::PGEFile(const PGEFile &pgeFile)
     m_rawData = pgeFile.m_rawData;
     m_rawDataTree = pgeFile.m_rawDataTree;
     m_lastError = pgeFile.m_lastError;
+    m_skippedSections = pgeFile.m_skippedSections;
 }
 
 PGEFile &PGEFile::operator=(const PGEFile &other)
@@ -112,6 +361,12 @@ PGEFile &PGEFile::operator=(const PGEFile &other)
     m_rawData = other.m_rawData;
     m_rawDataTree = other.m_rawDataTree;
     m_lastError = other.m_lastError;
+    m_skippedSections = other.m_skippedSections;
+#ifndef PGE_FILES_QT
+    // Data tree refers the replaced raw data
+    dataTree.clear();
+    m_ownedValues.clear();
+#endif
     return *this;
 }
 
@@ -119,6 +374,10 @@ PGEFile::PGEFile(const PGESTRING &_rawData) :
     m_rawData(_rawData)
 {}
 
+PGEFile::PGEFile(PGESTRING &&_rawData) :
+    m_rawData(std::move(_rawData))
+{}
+
 PGESTRING PGEFile::removeQuotes(PGESTRING str)
 {
     PGESTRING target = PGE_RemStrRng(str, 0, 1);
@@ -128,70 +387,104 @@ PGESTRING PGEFile::removeQuotes(PGESTRING str)
 
 void PGEFile::setRawData(const PGESTRING &_rawData)
 {
+#ifndef PGE_FILES_QT
+    dataTree.clear();
+    m_ownedValues.clear();
+#endif
     m_rawData = _rawData;
 }
 
+void PGEFile::setRawData(PGESTRING &&_rawData)
+{
+#ifndef PGE_FILES_QT
+    dataTree.clear();
+    m_ownedValues.clear();
+#endif
+    m_rawData = std::move(_rawData);
+}
+
+void PGEFile::setSkippedSections(const PGESTRINGList &names)
+{
+    m_skippedSections = names;
+}
+
 bool PGEFile::buildTreeFromRaw()
 {
-    PGEXSct PGEXsection;
+    RawSection PGEXsection;
+    RawRange line;
 
     FileStringList in;
     in.addData(m_rawData);
 
+    const PGEChar *raw = PGEX_RawChars(m_rawData);
+
+    m_rawDataTree.clear();
+
     //Read raw data sections
     bool sectionOpened = false;
-    while(!in.atEnd())
+    while(in.readLine(line.begin, line.length))
     {
-        PGEXsection.first = in.readLine();
-        PGEXsection.second.clear();
+        PGEXsection.lines.clear();
 
         // ignore line if all spaces
         bool all_spaces = true;
-        for(const auto c : PGEXsection.first)
+        for(pge_size_t i = 0; i < line.length; i++)
         {
-            if(c != ' ')
+            if(raw[line.begin + i] != ' ')
+            {
                 all_spaces = false;
+                break;
+            }
         }
         if(all_spaces)
             continue;
 
+        PGEXsection.name = PGESTRING(raw + line.begin, line.length);
+
         // ban section name including null characters
 #ifndef PGE_FILES_QT
-        if(PGEXsection.first.size() != strlen(PGEXsection.first.c_str()))
+        if(PGEXsection.name.size() != strlen(PGEXsection.name.c_str()))
 #else
-        int found = PGEXsection.first.indexOf(QChar('\0'));
+        int found = PGEXsection.name.indexOf(QChar('\0'));
         if(found != -1)
 #endif
         {
-            PGESTRING errSect = PGEXsection.first;
+            PGESTRING errSect = PGEXsection.name;
             PGE_CutLength(errSect, 20);
             PGE_FilterBinary(errSect);
             m_lastError = PGESTRING("Section [" + errSect + "] has invalid name");
             return false;
         }
 
+        const PGESTRING sectionEnd = PGEXsection.name + "_END";
+        const pge_size_t sectionEndLen = sectionEnd.size();
+        bool skipped = false;
+        for(pge_size_t i = 0; i < m_skippedSections.size() && !skipped; i++)
+            skipped = (m_skippedSections[i] == PGEXsection.name);
+
         sectionOpened = true;
-        PGESTRING data;
-        while(!in.atEnd())
+        while(in.readLine(line.begin, line.length))
         {
-            data = in.readLine();
-
-            if(IsEmpty(data))
+            if(line.length == 0)
                 continue;
 
-            if(data == PGEXsection.first + "_END")
+            if(line.length == sectionEndLen &&
+               std::equal(raw + line.begin, raw + line.begin + line.length, PGEX_RawChars(sectionEnd)))
             {
                 sectionOpened = false;    // Close Section
                 break;
             }
-            PGEXsection.second.push_back(data);
+            if(!skipped)
+                PGEXsection.lines.push_back(line);
         }
-        m_rawDataTree.push_back(PGEXsection);
+
+        if(!skipped)
+            m_rawDataTree.push_back(PGEXsection);
     }
 
     if(sectionOpened)
     {
-        PGESTRING errSect = PGEXsection.first;
+        PGESTRING errSect = PGEXsection.name;
         PGE_CutLength(errSect, 20);
         PGE_FilterBinary(errSect);
         m_lastError = PGESTRING("Section [" + errSect + "] is not closed");
@@ -199,19 +492,28 @@ bool PGEFile::buildTreeFromRaw()
     }
 
     //Building tree
+    dataTree.reserve(m_rawDataTree.size());
 
     for(pge_size_t z = 0; z < m_rawDataTree.size(); z++)
     {
+        const RawSection &rawSection = m_rawDataTree[z];
+        PGEX_Entry subTree;
         bool valid = true;
-        PGEX_Entry subTree = buildTree(m_rawDataTree[z].second, &valid);
-        if(valid)
+
+        subTree.name = rawSection.name;
+        subTree.type = PGEX_Struct;
+        subTree.data.reserve(rawSection.lines.size());
+
+        for(pge_size_t q = 0; q < rawSection.lines.size(); q++)
         {
-            //Store like subtree
-            subTree.type = PGEX_Struct;
-            subTree.name = m_rawDataTree[z].first;
-            dataTree.push_back(subTree);
+            const RawRange &r = rawSection.lines[q];
+            subTree.data.push_back(PGEX_Item());
+            valid = buildItem(raw + r.begin, r.length, subTree.data.back());
+            if(!valid)
+                break;
         }
-        else
+
+        if(!valid)
         {
             //Store like plain text
             PGEX_Item dataItem;
@@ -219,194 +521,271 @@ bool PGEFile::buildTreeFromRaw()
             subTree.data.clear();
             subTree.subTree.clear();
             PGEX_Val dataValue;
+            PGESTRING plainText;
             dataValue.marker = "PlainText";
-            for(pge_size_t i = 0; i < m_rawDataTree[z].second.size(); i++)
-                dataValue.value += m_rawDataTree[z].second[i] + "\n";
+            for(pge_size_t i = 0; i < rawSection.lines.size(); i++)
+            {
+                const RawRange &r = rawSection.lines[i];
+                plainText += PGESTRING(raw + r.begin, r.length) + "\n";
+            }
+#ifndef PGE_FILES_QT
+            // Joined lines are not contiguous at the raw data, keep them here
+            m_ownedValues.push_back(std::move(plainText));
+            dataValue.value = PGEXSTRING(m_ownedValues.back());
+#else
+            dataValue.value = plainText;
+#endif
             dataItem.values.push_back(dataValue);
-            subTree.name = m_rawDataTree[z].first;
             subTree.type = PGEX_PlainText;
             subTree.data.push_back(dataItem);
-            dataTree.push_back(subTree);
-            valid = true;
         }
+
+        dataTree.push_back(std::move(subTree));
     }
 
+    // Line ranges are not needed anymore
+    m_rawDataTree.clear();
+
     return true;
 }
 
 
-PGEFile::PGEX_Entry PGEFile::buildTree(PGESTRINGList &src_data, bool *_valid)
+bool PGEFile::buildItem(const PGEChar *line, pge_size_t lineSize, PGEX_Item &dataItem)
 {
-    PGEX_Entry entryData;
+    using namespace PGEExtendedFormat;
 
-    bool valid = true;
-    for(pge_size_t q = 0; q < src_data.size(); q++)
+    enum DelimiterResult
+    {
+        DELIM_NEXT = 0,
+        DELIM_END,
+        DELIM_ERROR
+    };
+
+    dataItem.type = PGEX_Struct;
+
+    // even if there is a nul in the line, it must still end with a semicolon
+    // (so two semicolons will be required for a valid parse if there is a nul)
+    if(lineSize > 0 && line[lineSize - 1] != ';')
+        return false;
+
+    bool inValue = false;
+    // Beginning of the marker and the value of the current field
+    pge_size_t markerBegin = 0;
+    pge_size_t markerEnd = 0;
+    pge_size_t valueBegin = 0;
+    // Position of the character escaped by a backslash
+    pge_size_t escaped = lineSize;
+    // the line gets parsed up to the first nul character
+    pge_size_t size = lineSize;
+
+    // Only the structural characters (':', ';', '\\' and nul) are changing the state
+    auto onDelimiter = [&](pge_size_t i) -> int
     {
-#if 0
-        if(IsSectionTitle(removeSpaces(src_data[q])))
+        const PGEChar c = line[i];
+
+        if(c == '\0')
         {
-            //Build and store subTree
-            PGESTRING nameOfTree = removeSpaces(src_data[q]);
-            PGESTRINGList rawSubTree;
-            q++;
-            for(; q < src_data.size() && src_data[q] != nameOfTree + "_END" ; q++)
-            {
-                rawSubTree.push_back(src_data[q]);
-            }
-            PGEX_Entry subTree = buildTree(rawSubTree, &valid);
-            if(valid)
-            {
-                //Store like subtree
-                subTree.name = nameOfTree;
-                entryData.subTree.push_back(subTree);
-                entryData.type = PGEX_Struct;
-            }
-            else
-            {
-                //Store like plain text
-                subTree.name = nameOfTree;
-                subTree.subTree.clear();
-                subTree.type = PGEX_PlainText;
-                subTree.data.clear();
-
-                PGEX_Item dataItem;
-                PGEX_Val dataValue;
-                dataItem.type = PGEX_PlainText;
-
-                dataValue.marker = nameOfTree; //-V820
-                //foreach(PGESTRING x, rawSubTree) dataValue.value += x+"\n";
-                for(auto &st : rawSubTree)
-                    dataValue.value += st + "\n";
-                dataItem.values.push_back(dataValue);
-                subTree.data.push_back(dataItem);
-                entryData.subTree.push_back(subTree);
-                entryData.type = PGEX_Struct;
-                valid = true;
-            }
+            size = i;
+            return DELIM_END;
+        }
 
+        if(!inValue)
+        {
+            // markers can't include ';' and '\\'
+            if(c != ':')
+                return DELIM_ERROR;
+            markerEnd = i;
+            valueBegin = i + 1;
+            inValue = true;
+            return DELIM_NEXT;
         }
-        else
+
+        if(i == escaped)
+            return DELIM_NEXT;
+
+        if(c == '\\')
+        {
+            //Skip escape sequence
+            escaped = i + 1;
+            return DELIM_NEXT;
+        }
+
+        if(c == ':')
+            return DELIM_ERROR;
+
+        //STORE DATA
+        dataItem.values.push_back(PGEX_Val());
+        PGEX_Val &dataValue = dataItem.values.back();
+        dataValue.marker = PGEXSTRING(line + markerBegin, markerEnd - markerBegin);
+        dataValue.value = PGEXSTRING(line + valueBegin, i - valueBegin);
+        markerBegin = i + 1;
+        inValue = false;
+        return DELIM_NEXT;
+    };
+
+    pge_size_t pos = 0;
+    int res = DELIM_NEXT;
+
+#ifdef PGEX_DELIMITER_SIMD
+    // Find structural characters a block at a time
+    for(; pos + delimiterBlockSize <= lineSize && res == DELIM_NEXT; pos += delimiterBlockSize)
+    {
+        uint32_t mask = delimiterMask(line + pos);
+        while(mask && res == DELIM_NEXT)
+        {
+            res = onDelimiter(pos + lowestBit(mask));
+            mask &= mask - 1;
+        }
+    }
 #endif
+
+    for(; pos < lineSize && res == DELIM_NEXT; pos++)
+    {
+        if(isDelimiter(line[pos]))
+            res = onDelimiter(pos);
+    }
+
+    if(res == DELIM_ERROR)
+        return false;
+
+    // the last field must be terminated right at the end of the line
+    return !inValue && (markerBegin == size);
+}
+
+bool PGEXEventReader::parse(PGE_FileFormats_misc::TextInput &in, Handler &handler)
+{
+    PGESTRING line;
+    PGESTRING sectionName;
+    PGESTRING sectionEnd;
+    PGEFile::PGEX_Item item;
+    pge_size_t itemIndex = 0;
+    bool sectionOpened = false;
+    bool skipSection = false;
+
+    m_lastError.clear();
+    m_lineNumber = 0;
+
+    while(!in.eof())
+    {
+        in.readLine(line);
+        m_lineNumber++;
+
+        if(!sectionOpened)
         {
-            PGEX_Item dataItem;
-            PGESTRING &srcData_nc = src_data[q];
-            enum States
+            // ignore line if all spaces
+            bool all_spaces = true;
+            for(pge_size_t i = 0; i < line.size(); i++)
             {
-                STATE_MARKER = 0,
-                STATE_VALUE = 1,
-                STATE_ERROR = 2
-            };
-            pge_size_t state = 0;
+                if(line[i] != ' ')
+                {
+                    all_spaces = false;
+                    break;
+                }
+            }
+            if(all_spaces)
+                continue;
+
+            // ban section name including null characters
 #ifndef PGE_FILES_QT
-            pge_size_t size = strlen(srcData_nc.c_str());
+            if(line.size() != strlen(line.c_str()))
 #else
-            int first_nul = srcData_nc.indexOf(QChar('\0'));
-            pge_size_t size = (first_nul == -1) ? srcData_nc.size() : first_nul;
+            if(line.indexOf(QChar('\0')) != -1)
 #endif
-            pge_size_t tail = size - 1;
+            {
+                PGESTRING errSect = line;
+                PGE_CutLength(errSect, 20);
+                PGE_FilterBinary(errSect);
+                m_lastError = PGESTRING("Section [" + errSect + "] has invalid name");
+                return false;
+            }
+
+            sectionName = line;
+            sectionEnd = line + "_END";
+            sectionOpened = true;
+            itemIndex = 0;
+            skipSection = !handler.sectionBegin(sectionName);
+            continue;
+        }
 
-            // even if there is a nul in the line, it must still end with a semicolon
-            // (so two semicolons will be required for a valid parse if there is a nul)
-            if(srcData_nc.size() > 0 && Back(srcData_nc) != ';')
-                state = STATE_ERROR;
+        if(IsEmpty(line))
+            continue;
 
-            PGEX_Val dataValue;
-            int escape = 0;
-            for(pge_size_t i = 0; i < size; i++)
+        if(line == sectionEnd)
+        {
+            sectionOpened = false; // Close Section
+            if(!skipSection && !handler.sectionEnd(sectionName))
+                goto interrupted;
+            continue;
+        }
+
+        if(skipSection)
+            continue;
+
+        item.values.clear();
+        if(!PGEFile::buildItem(PGEX_RawChars(line), line.size(), item))
+        {
+            if(!handler.invalidItem(itemIndex, line))
             {
-                if(state == STATE_ERROR)
-                {
-                    valid = false;
-                    break;
-                }
-                PGEChar c = srcData_nc[i];
-                if(escape > 0)
-                {
-                    escape--;
-                }
-                switch(state)
-                {
-                case STATE_MARKER:
-                    if(i == tail)
-                    {
-                        valid = false;
-                        break;
-                    }
-                    if(c == ';' || c == '\\')
-                    {
-                        state = STATE_ERROR;
-                        continue;
-                    }
-                    if(c == ':')
-                    {
-                        state = STATE_VALUE;
-                        continue;
-                    }
-                    dataValue.marker.push_back(c);
-                    break;
-                case STATE_VALUE:
-                    if((c == '\\') && (escape == 0))
-                    {
-                        //Skip escape sequence
-                        escape = 2;
-                    }
-                    if((c == ':') && (escape == 0))
-                    {
-                        state = STATE_ERROR;
-                        continue;
-                    }
-                    if((c == ';') && (escape == 0))
-                    {
-                        //STORE DATA
-                        dataItem.values.push_back(dataValue);
-                        dataValue.marker.clear();
-                        dataValue.value.clear();
-                        state = STATE_MARKER;
-                        continue;
-                    }
-                    else if(i == tail)
-                    {
-                        valid = false;
-                        break;
-                    }
-                    dataValue.value.push_back(c);
-                    break;
-                    //case STATE_ERROR: //Dead code
-                    //break;
-                }
+                m_lastError = PGESTRING("Wrong data item syntax:\nSection [" + sectionName + "]\nData line " + fromNum(itemIndex));
+                return false;
             }
+            itemIndex++;
+            continue;
+        }
 
-            if(state == STATE_ERROR)
-                valid = false;
+        if(!handler.itemBegin(itemIndex))
+            goto interrupted;
 
-            dataItem.type = PGEX_Struct;
-            entryData.type = PGEX_Struct;
-            entryData.data.push_back(dataItem);
-            //            PGE_SPLITSTRING(fields, srcData_nc, ";");
-            //            PGEX_Item dataItem;
-            //            dataItem.type = PGEX_Struct;
-            //            for(int i=0;i<(signed)fields.size(); i++)
-            //            {
-            //                PGESTRING fields_ns = removeSpaces(fields[i]);
-            //                if(IsEmpty(fields_ns)) continue;
-
-            //                //Store data into list
-            //                PGESTRINGList value;
-            //                PGE_SPLITSTRING(value, fields[i], ":");
-
-            //                if( value.size() != 2 )
-            //                {
-            //                    valid = false; break;
-            //                }
-
-            //                PGEX_Val dataValue;
-            //                    dataValue.marker = value[0];
-            //                    dataValue.value = value[1];
-            //                dataItem.values.push_back(dataValue);
-            //            }
-            //            entryData.type = PGEX_Struct;
-            //            entryData.data.push_back(dataItem);
+        for(pge_size_t i = 0; i < item.values.size(); i++)
+        {
+            const PGEFile::PGEX_Val &v = item.values[i];
+            if(!handler.value(v.marker, v.value))
+                goto interrupted;
         }
+
+        if(!handler.itemEnd())
+            goto interrupted;
+
+        itemIndex++;
+    }
+
+    if(sectionOpened)
+    {
+        PGESTRING errSect = sectionName;
+        PGE_CutLength(errSect, 20);
+        PGE_FilterBinary(errSect);
+        m_lastError = PGESTRING("Section [" + errSect + "] is not closed");
+        return false;
+    }
+
+    return true;
+
+interrupted:
+    m_lastError = PGESTRING("Parsing was interrupted at section [" + sectionName + "], data line " + fromNum(itemIndex));
+    return false;
+}
+
+PGESTRING PGEXEventReader::lastError() const
+{
+    return m_lastError;
+}
+
+long PGEXEventReader::lineNumber() const
+{
+    return m_lineNumber;
+}
+
+PGEFile::PGEX_Entry PGEFile::buildTree(PGESTRINGList &src_data, bool *_valid)
+{
+    PGEX_Entry entryData;
+
+    bool valid = true;
+    for(pge_size_t q = 0; q < src_data.size(); q++)
+    {
+        const PGESTRING &srcData_nc = src_data[q];
+        entryData.type = PGEX_Struct;
+        entryData.data.push_back(PGEX_Item());
+        valid = buildItem(PGEX_RawChars(srcData_nc), srcData_nc.size(), entryData.data.back());
         if(!valid) break;
     }
 
@@ -421,6 +800,65 @@ PGESTRING PGEFile::lastError()
     return m_lastError;
 }
 
+PGESTRING PGEFile::PGEX_ValueContext::errorString() const
+{
+    if(!section || !value)
+        return PGESTRING();
+
+    return PGESTRING("Wrong value syntax\nSection [" + section->name +
+                     "]\nData line " + fromNum(item) +
+                     "\nMarker " + value->marker + "\nValue " + value->value);
+}
+
+PGEFile::PGEX_SubStructReader::PGEX_SubStructReader(const PGEXSTRING &array) :
+    m_array(array),
+    m_pos(0),
+    m_entryValid(false)
+{
+    m_entry.type = PGEX_Struct;
+}
+
+bool PGEFile::PGEX_SubStructReader::next()
+{
+    const pge_size_t size = m_array.size();
+
+    // Seek for the opening quote of the next entry
+    while((m_pos < size) && (m_array[m_pos] != '"'))
+    {
+        if(m_array[m_pos] == ']')
+            return false; // Array terminated
+        m_pos++;
+    }
+
+    if(m_pos >= size)
+        return false;
+
+    const pge_size_t begin = ++m_pos;
+    bool escape = false;
+
+    while(m_pos < size)
+    {
+        if((m_array[m_pos] == '"') && !escape)
+            break;
+        escape = (m_array[m_pos] == '\\') && !escape;
+        m_pos++;
+    }
+
+#ifdef PGE_FILES_QT
+    m_buffer = m_array.mid(static_cast<int>(begin), static_cast<int>(m_pos - begin));
+#else
+    m_buffer.assign(m_array.data() + begin, m_pos - begin);
+#endif
+    m_pos++; // Skip the closing quote
+
+    restoreString(m_buffer, true);
+
+    m_entry.values.clear();
+    m_entryValid = buildItem(PGEX_RawChars(m_buffer), m_buffer.size(), m_entry);
+
+    return true;
+}
+
 
 bool PGEFile::IsSectionTitle(const PGESTRING &in)
 {
@@ -443,7 +881,7 @@ bool PGEFile::IsSectionTitle(const PGESTRING &in)
 
 
 //validatos
-bool PGEFile::IsQoutedString(const PGESTRING &in) // QUOTED STRING
+bool PGEFile::IsQoutedString(const PGEXSTRING &in) // QUOTED STRING
 {
     //return QRegExp("^\"(?:[^\"\\\\]|\\\\.)*\"$").exactMatch(in);
     pge_size_t i = 0;
@@ -479,20 +917,20 @@ bool PGEFile::IsQoutedString(const PGESTRING &in) // QUOTED STRING
     return true;
 }
 
-bool PGEFile::IsHex(const PGESTRING &in) // Heximal string
+bool PGEFile::IsHex(const PGEXSTRING &in) // Heximal string
 {
     using namespace PGEExtendedFormat;
     return isValid(in, heximal_valid_chars, heximal_valid_chars_len);
 }
 
-bool PGEFile::IsBool(const PGESTRING &in) // Boolean
+bool PGEFile::IsBool(const PGEXSTRING &in) // Boolean
 {
     if((in.size() != 1) || (IsEmpty(in)))
         return false;
     return ((PGEGetChar(in[0]) == '1') || (PGEGetChar(in[0]) == '0'));
 }
 
-bool PGEFile::IsIntU(const PGESTRING &in) // Unsigned Int
+bool PGEFile::IsIntU(const PGEXSTRING &in) // Unsigned Int
 {
     using namespace PGEExtendedFormat;
 
@@ -515,7 +953,7 @@ bool PGEFile::IsIntU(const PGESTRING &in) // Unsigned Int
     return true;
 }
 
-bool PGEFile::IsIntS(const PGESTRING &in) // Signed Int
+bool PGEFile::IsIntS(const PGEXSTRING &in) // Signed Int
 {
     using namespace PGEExtendedFormat;
 
@@ -542,7 +980,7 @@ bool PGEFile::IsIntS(const PGESTRING &in) // Signed Int
     return true;
 }
 
-bool PGEFile::IsFloat(const PGESTRING &in) // Float Point numeric
+bool PGEFile::IsFloat(const PGEXSTRING &in) // Float Point numeric
 {
     using namespace PGEExtendedFormat;
 
@@ -590,13 +1028,13 @@ bool PGEFile::IsFloat(const PGESTRING &in) // Float Point numeric
     return has_digit && (pow10_digits <= 4);
 }
 
-bool PGEFile::IsBoolArray(const PGESTRING &in) // Boolean array
+bool PGEFile::IsBoolArray(const PGEXSTRING &in) // Boolean array
 {
     using namespace PGEExtendedFormat;
     return isValid(in, "01", 2, true);
 }
 
-bool PGEFile::IsIntArray(const PGESTRING &in) // Boolean array
+bool PGEFile::IsIntArray(const PGEXSTRING &in) // Boolean array
 {
     using namespace PGEExtendedFormat;
 #ifdef PGE_FILES_QT
@@ -604,11 +1042,11 @@ bool PGEFile::IsIntArray(const PGESTRING &in) // Boolean array
 #else
     //FIXME
     std::regex rx("^\\[(\\-?\\d+,?)*\\]$");
-    return std::regex_match(in, rx);
+    return std::regex_match(in.begin(), in.end(), rx);
 #endif
 }
 
-bool PGEFile::IsStringArray(const PGESTRING &in) // String array
+bool PGEFile::IsStringArray(const PGEXSTRING &in) // String array
 {
     bool valid = true;
     pge_size_t i = 0, depth = 0, comma = 0;
@@ -692,7 +1130,7 @@ bool PGEFile::IsStringArray(const PGESTRING &in) // String array
 }
 
 
-PGESTRINGList PGEFile::X2STRArr(const PGESTRING &in, bool *_valid)
+PGESTRINGList PGEFile::X2STRArr(const PGEXSTRING &in, bool *_valid)
 {
     PGESTRINGList strArr;
     PGESTRING entry;
@@ -743,7 +1181,7 @@ PGESTRINGList PGEFile::X2STRArr(const PGESTRING &in, bool *_valid)
         case 2://Inside entry
             if((in[i] == '"') && (!escape))
             {
-                strArr.push_back(X2STRING(entry));    //Close value //-V823
+                strArr.push_back(X2STRING(PGEXSTRING(entry)));    //Close value //-V823
                 entry.clear();
                 depth = 1;
                 comma = 0;
@@ -790,7 +1228,7 @@ PGESTRINGList PGEFile::X2STRArr(const PGESTRING &in, bool *_valid)
     return strArr;
 }
 
-PGELIST<long> PGEFile::X2IntArr(const PGESTRING &in, bool *_valid)
+PGELIST<long> PGEFile::X2IntArr(const PGEXSTRING &in, bool *_valid)
 {
     PGELIST<long> intArr;
     PGESTRINGList strArr;
@@ -808,12 +1246,13 @@ PGELIST<long> PGEFile::X2IntArr(const PGESTRING &in, bool *_valid)
 
     for(auto &s : strArr)
     {
-        if(!IsIntS(s))
+        long num;
+        if(!X2IntS(PGEXSTRING(s), num))
         {
             if(_valid) *_valid = false;
             return intArr;
         }
-        intArr.push_back(toLong(s));
+        intArr.push_back(num);
     }
 
     if(_valid)
@@ -822,7 +1261,7 @@ PGELIST<long> PGEFile::X2IntArr(const PGESTRING &in, bool *_valid)
     return intArr;
 }
 
-PGELIST<bool > PGEFile::X2BollArr(const PGESTRING &src)
+PGELIST<bool > PGEFile::X2BollArr(const PGEXSTRING &src)
 {
     PGELIST<bool > arr;
     for(PGEChar i : src)
@@ -830,111 +1269,90 @@ PGELIST<bool > PGEFile::X2BollArr(const PGESTRING &src)
     return arr;
 }
 
-PGELIST<PGESTRINGList > PGEFile::splitDataLine(const PGESTRING &src_data, bool *_valid)
+bool PGEFile::X2IntU(const PGEXSTRING &in, int &out)
 {
-    PGELIST<PGESTRINGList > entryData;
-    bool valid = true;
-    enum States
-    {
-        STATE_MARKER = 0,
-        STATE_VALUE = 1,
-        STATE_ERROR = 2
-    };
+    return PGEExtendedFormat::parseIntU(in, out);
+}
 
-    pge_size_t state = 0;
-#ifndef PGE_FILES_QT
-    pge_size_t size = strlen(src_data.c_str());
-#else
-    int first_nul = src_data.indexOf(QChar('\0'));
-    pge_size_t size = (first_nul == -1) ? src_data.size() : first_nul;
-#endif
-    pge_size_t tail = size - 1;
+bool PGEFile::X2IntU(const PGEXSTRING &in, unsigned int &out)
+{
+    return PGEExtendedFormat::parseIntU(in, out);
+}
 
-    // even if there is a nul in the line, it must still end with a semicolon
-    // (so two semicolons will be required for a valid parse if there is a nul)
-    if(src_data.size() > 0 && Back(src_data) != ';')
-        state = STATE_ERROR;
+bool PGEFile::X2IntU(const PGEXSTRING &in, long &out)
+{
+    return PGEExtendedFormat::parseIntU(in, out);
+}
 
-    PGESTRING marker;
-    PGESTRING value;
-    int escape = 0;
+bool PGEFile::X2IntU(const PGEXSTRING &in, unsigned long &out)
+{
+    return PGEExtendedFormat::parseIntU(in, out);
+}
 
-    for(pge_size_t i = 0; i < size; i++)
-    {
-        if(state == STATE_ERROR)
-        {
-            valid = false;
-            break;
-        }
+bool PGEFile::X2IntU(const PGEXSTRING &in, long long &out)
+{
+    return PGEExtendedFormat::parseIntU(in, out);
+}
 
-        PGEChar c = src_data[i];
-        if(escape > 0)
-        {
-            escape--;
-        }
+bool PGEFile::X2IntU(const PGEXSTRING &in, unsigned long long &out)
+{
+    return PGEExtendedFormat::parseIntU(in, out);
+}
 
-        switch(state)
-        {
-        default:
-            abort(); // unexpected behavior!
-            break;
+bool PGEFile::X2IntS(const PGEXSTRING &in, int &out)
+{
+    return PGEExtendedFormat::parseIntS(in, out);
+}
 
-        case STATE_MARKER:
-            if(i == tail)
-            {
-                valid = false;
-                break;
-            }
-            if(c == ';' || c == '\\')
-            {
-                state = STATE_ERROR;
-                continue;
-            }
-            if(c == ':')
-            {
-                state = STATE_VALUE;
-                continue;
-            }
-            marker.push_back(c);
-            break;
+bool PGEFile::X2IntS(const PGEXSTRING &in, long &out)
+{
+    return PGEExtendedFormat::parseIntS(in, out);
+}
 
-        case STATE_VALUE:
-            if((c == '\\') && (escape == 0))
-            {
-                //Skip escape sequence
-                escape = 2;
-            }
-            if((c == ':') && (escape == 0))
-            {
-                state = STATE_ERROR;
-                continue;
-            }
-            if((c == ';') && (escape == 0))
-            {
-                //STORE ENTRY!
-                PGESTRINGList fields;
-                fields.push_back(marker);
-                fields.push_back(value);
-                entryData.push_back(fields);
-                marker.clear();
-                value.clear();
-                state = STATE_MARKER;
-                continue;
-            }
-            else if(i == tail)
-            {
-                valid = false;
-                break;
-            }
-            value.push_back(c);
-            break;
-            //case STATE_ERROR:  //Dead code
-            //break;
-        }
-    }
+bool PGEFile::X2IntS(const PGEXSTRING &in, long long &out)
+{
+    return PGEExtendedFormat::parseIntS(in, out);
+}
 
-    if(state == STATE_ERROR)
-        valid = false;
+bool PGEFile::X2Float(const PGEXSTRING &in, float &out)
+{
+    return PGEExtendedFormat::parseFloat(in, out);
+}
+
+bool PGEFile::X2Float(const PGEXSTRING &in, double &out)
+{
+    return PGEExtendedFormat::parseFloat(in, out);
+}
+
+bool PGEFile::X2Bool(const PGEXSTRING &in, bool &out)
+{
+    if(in.size() != 1)
+        return false;
+
+    const char c = PGEGetChar(in[0]);
+    if((c != '0') && (c != '1'))
+        return false;
+
+    out = (c == '1');
+    return true;
+}
+
+PGELIST<PGESTRINGList > PGEFile::splitDataLine(const PGESTRING &src_data, bool *_valid)
+{
+    PGELIST<PGESTRINGList > entryData;
+    PGEX_Item item;
+
+    bool valid = buildItem(PGEX_RawChars(src_data), src_data.size(), item);
+
+    entryData.reserve(item.values.size());
+    for(pge_size_t i = 0; i < item.values.size(); i++)
+    {
+        const PGEX_Val &v = item.values[i];
+        entryData.push_back(PGESTRINGList());
+        PGESTRINGList &fields = entryData.back();
+        fields.push_back(PGESTRING(v.marker));
+        fields.push_back(PGESTRING(v.value));
+    }
 
     if(_valid)
         *_valid = valid;
@@ -1004,11 +1422,21 @@ PGESTRING PGEFile::WriteBoolArr(const PGELIST<bool> &input)
     return output;
 }
 
+#ifdef PGE_FILES_QT
 PGESTRING PGEFile::X2STRING(PGESTRING input)
 {
     restoreString(input, true);
     return input;
 }
+#else
+PGESTRING PGEFile::X2STRING(const PGEXStrView &input)
+{
+    // The only copy of the value: it gets unescaped in place
+    PGESTRING output(input.data(), input.size());
+    restoreString(output, true);
+    return output;
+}
+#endif
 
 void PGEFile::restoreString(PGESTRING &input, bool removeQuotes)
 {
@@ -1098,8 +1526,14 @@ ReCheckQuotie:
 
 void PGEFile::escapeString(PGESTRING &output, const PGESTRING &input, bool addQuotes)
 {
-    pge_size_t j = 0, size = input.size();
-    output.resize(size * 2 + (addQuotes ? 2 : 0));
+    output.clear();
+    PGEXWriter::appendEscaped(output, input, addQuotes);
+}
+
+void PGEXWriter::appendEscaped(PGESTRING &output, const PGESTRING &input, bool addQuotes)
+{
+    pge_size_t j = output.size(), size = input.size();
+    output.resize(j + size * 2 + (addQuotes ? 2 : 0));
     if(addQuotes)
         output[j++] = '\"';
     for(pge_size_t i = 0; i < size; i++, j++)
@@ -1158,3 +1592,131 @@ void PGEFile::escapeString(PGESTRING &output, const PGESTRING &input, bool addQu
 
     output.resize(j);
 }
+
+PGEXWriter::PGEXWriter(pge_size_t reserve)
+{
+    if(reserve > 0)
+        m_buffer.reserve(reserve);
+}
+
+PGEXWriter::PGEXWriter(PGE_FileFormats_misc::TextOutput &out, pge_size_t bufferSize) :
+    m_out(&out),
+    m_bufferSize(bufferSize)
+{
+    // Keep some room for the line which overflows the buffer
+    m_buffer.reserve(bufferSize + bufferSize / 4);
+}
+
+void PGEXWriter::flush()
+{
+    if(m_out && !m_buffer.empty())
+        *m_out << m_buffer;
+    m_buffer.clear();
+}
+
+void PGEXWriter::raw(const char *raw)
+{
+    m_buffer.append(raw);
+}
+
+void PGEXWriter::raw(const PGESTRING &raw)
+{
+    m_buffer.append(raw);
+}
+
+void PGEXWriter::append(const PGEXWriter &other)
+{
+    if(m_out && other.m_buffer.size() >= m_bufferSize)
+    {
+        flush();
+        *m_out << other.m_buffer;
+        return;
+    }
+
+    m_buffer.append(other.m_buffer);
+}
+
+void PGEXWriter::beginSection(const char *name)
+{
+    m_buffer.append(name);
+    m_buffer.push_back('\n');
+}
+
+void PGEXWriter::endSection(const char *name)
+{
+    m_buffer.append(name);
+    m_buffer.append("_END\n");
+}
+
+void PGEXWriter::endLine()
+{
+    m_buffer.push_back('\n');
+    if(m_out && m_buffer.size() >= m_bufferSize)
+        flush();
+}
+
+void PGEXWriter::writeBool(const char *marker, bool value)
+{
+    beginValue(marker);
+    m_buffer.push_back(value ? '1' : '0');
+    m_buffer.push_back(';');
+}
+
+void PGEXWriter::writeStr(const char *marker, const PGESTRING &value)
+{
+    beginValue(marker);
+    appendEscaped(m_buffer, value, true);
+    m_buffer.push_back(';');
+}
+
+void PGEXWriter::writeStrArr(const char *marker, const PGESTRINGList &value)
+{
+    beginStrArr(marker);
+    for(const PGESTRING &v : value)
+        addStrArrItem(v);
+    endStrArr();
+}
+
+void PGEXWriter::writeBoolArr(const char *marker, const PGELIST<bool> &value)
+{
+    if(value.empty())
+        return;
+
+    beginValue(marker);
+    for(bool v : value)
+        m_buffer.push_back(v ? '1' : '0');
+    m_buffer.push_back(';');
+}
+
+void PGEXWriter::beginStrArr(const char *marker)
+{
+    m_arrayBegin = m_buffer.size();
+    m_arrayItems = 0;
+    beginValue(marker);
+    m_buffer.push_back('[');
+}
+
+void PGEXWriter::addStrArrItem(const PGESTRING &value)
+{
+    if(m_arrayItems++ > 0)
+        m_buffer.push_back(',');
+    appendEscaped(m_buffer, value, true);
+}
+
+void PGEXWriter::endStrArr()
+{
+    if(m_arrayItems == 0)
+    {
+        m_buffer.resize(m_arrayBegin);
+        return;
+    }
+
+    m_buffer.push_back(']');
+    m_buffer.push_back(';');
+}
+
+void PGEXWriter::beginValue(const char *marker)
+{
+    m_buffer.append(marker);
+    m_buffer.push_back(':');
+}
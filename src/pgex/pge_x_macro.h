@@ -36,6 +36,8 @@
 #define PGE_X_MACRO_H
 
 #include <climits>
+#include <cstddef>
+#include <stdint.h>
 
 struct PGEX_IGNORE
 {
@@ -62,16 +64,52 @@ static inline void PGE_check_inst(const PGEX_IGNORE&) {}
 #define PGEX_FileBegin() int str_count=0; /*Line Counter*/\
                          PGESTRING line;  /*Current Line data*/
 
-/*! \def PGEX_FileParseTree(raw)
-    \brief Parse PGE-X Tree from raw data
+/*!
+ * \brief Relation between a bit of FileFormats::LoadSections and a PGE-X section name
+ */
+struct PGEX_SectionPart
+{
+    //! Bit of FileFormats::LoadSections
+    uint32_t part;
+    //! Name of the PGE-X data section
+    const char *name;
+};
+
+/*!
+ * \brief Makes the list of PGE-X section names which parts are not requested to load
+ * \param parts Table of section parts
+ * \param loadSections Bit mask of parts to load
+ * \return List of section names to skip
+ */
+template<size_t N>
+static inline PGESTRINGList PGEX_SkippedSections(const PGEX_SectionPart (&parts)[N], uint32_t loadSections)
+{
+    PGESTRINGList ret;
+    for(size_t i = 0; i < N; i++)
+    {
+        if(!(loadSections & parts[i].part))
+            ret.push_back(PGESTRING(parts[i].name));
+    }
+    return ret;
+}
+
+/*! \def PGEX_FileParseTreeSkipping(raw, skipped)
+    \brief Parse PGE-X Tree from raw data, sections listed in the skipped list are jumped over
 */
-#define PGEX_FileParseTree(raw)  PGEFile pgeX_Data(raw);\
+#define PGEX_FileParseTreeSkipping(raw, skipped)  PGEFile pgeX_Data(raw);\
+                            PGEFile::PGEX_ValueContext pgeX_Value;\
+                            pgeX_Data.setSkippedSections(skipped);\
                             if( !pgeX_Data.buildTreeFromRaw() )\
                             {\
                                 errorString = pgeX_Data.lastError();\
                                 goto badfile;\
                             }
 
+/*! \def PGEX_FileParseTree(raw)
+    \brief Parse PGE-X Tree from raw data
+*/
+#define PGEX_FileParseTree(raw)  PGEX_FileParseTreeSkipping(raw, PGESTRINGList())
+
 /*! \def PGEX_FetchSection()
     \brief Prepare to fetch all data from specified section
 */
@@ -97,6 +135,10 @@ static inline void PGE_check_inst(const PGEX_IGNORE&) {}
     \brief Prepare to read items from this section
 */
 #define PGEX_Items() for(pge_size_t sdata = 0; sdata < f_section.data.size(); sdata++)
+/*! \def PGEX_ItemsRange(begin, end)
+    \brief Prepare to read items of the given range from this section
+*/
+#define PGEX_ItemsRange(begin, end) for(pge_size_t sdata = begin; sdata < end; sdata++)
 /*! \def PGEX_ItemBegin(stype)
     \brief Declares block with a list of values
 */
@@ -105,33 +147,46 @@ static inline void PGE_check_inst(const PGEX_IGNORE&) {}
     errorString=PGESTRING("Wrong data item syntax:\nSection ["+f_section.name+"]\nData line "+fromNum(sdata));\
     goto badfile;\
 }\
-PGEFile::PGEX_Item x = f_section.data[sdata];
+const PGEFile::PGEX_Item &x = f_section.data[sdata];
 
 /*! \def PGEX_Values()
     \brief Declares block with a list of values
 */
 #define PGEX_Values() for(pge_size_t sval=0; sval < x.values.size(); sval++)
 /*! \def PGEX_ValueBegin()
-    \brief Initializes getting of the values
+    \brief Initializes getting of the values and opens dispatch by a marker key, must be closed by PGEX_ValueEnd()
+*/
+#define PGEX_ValueBegin()  const PGEFile::PGEX_Val &v = x.values[sval];\
+                           pgeX_Value.section = &f_section;\
+                           pgeX_Value.item = sdata;\
+                           pgeX_Value.value = &v;\
+                           errorString.clear();\
+                           if(IsEmpty(v.marker)) continue;\
+                           switch(PGEFile::markerKey(v.marker)) { \
+                           default: break;
+
+/*! \def PGEX_ValueError()
+    \brief Formats the syntax error of the last parsed value if no other error was set, place right after the "badfile" label
+*/
+#define PGEX_ValueError()  if(IsEmpty(errorString)) errorString = pgeX_Value.errorString();
+
+/*! \def PGEX_ValueEnd()
+    \brief Closes the list of values opened by PGEX_ValueBegin()
 */
-#define PGEX_ValueBegin()  PGEFile::PGEX_Val v = x.values[sval];\
-                           errorString=PGESTRING("Wrong value syntax\nSection ["+f_section.name+ \
-                           "]\nData line "+fromNum(sdata) \
-                           +"\nMarker "+v.marker+"\nValue "+v.value);\
-                           if(IsEmpty(v.marker)) continue;
+#define PGEX_ValueEnd()    }
 
 /*! \def PGEX_StrVal(Mark, targetValue)
     \brief Parse Plain text string value by requested Marker and write into target variable
 */
-#define PGEX_StrVal(Mark, targetValue)  else if(v.marker==Mark) { if(PGEFile::IsQoutedString(v.value)) \
+#define PGEX_StrVal(Mark, targetValue)  case PGEFile::markerKey(Mark): { if(PGEFile::IsQoutedString(v.value)) \
                                                 targetValue = PGEFile::X2STRING(v.value); \
-                                                else goto badfile; }
+                                                else goto badfile; } break;
 /*! \def PGEX_StrArrVal(Mark, targetValue)
     \brief Parse Plain text string array value by requested Marker and write into target variable
 */
-#define PGEX_StrArrVal(Mark, targetValue)  else if(v.marker==Mark) { bool valid=false;\
+#define PGEX_StrArrVal(Mark, targetValue)  case PGEFile::markerKey(Mark): { bool valid=false;\
                                                 targetValue = PGEFile::X2STRArr(v.value, &valid); \
-                                                if(!valid) goto badfile; }
+                                                if(!valid) goto badfile; } break;
 
 /*! \def PGEX_StrArrVal_Validate(Mark, targetValue)
     \brief Parse sub-struct string array value by requested Marker and write into target variable.
@@ -139,113 +194,97 @@ PGEFile::PGEX_Item x = f_section.data[sdata];
 */
 
 #ifndef PGE_FILES_QT
-#    define PGEX_StrArrVal_Validate(Mark, targetValue, targetValueBegin)  else if(v.marker==Mark) { bool valid=false;\
+#    define PGEX_StrArrVal_Validate(Mark, targetValue, targetValueBegin)  case PGEFile::markerKey(Mark): { bool valid=false;\
                                                 targetValueBegin = targetValue.size(); \
                                                 auto newValues = PGEFile::X2STRArr(v.value, &valid); \
                                                 targetValue.insert(targetValue.end(), newValues.begin(), newValues.end()); \
                                                 if(!valid) goto badfile; \
-                                                }
+                                                } break;
 #else
-#    define PGEX_StrArrVal_Validate(Mark, targetValue, targetValueBegin)  else if(v.marker==Mark) { bool valid=false;\
+#    define PGEX_StrArrVal_Validate(Mark, targetValue, targetValueBegin)  case PGEFile::markerKey(Mark): { bool valid=false;\
                                                 targetValueBegin = targetValue.size(); \
                                                 auto newValues = PGEFile::X2STRArr(v.value, &valid); \
                                                 targetValue.append(newValues); \
                                                 if(!valid) goto badfile; \
-                                                }
+                                                } break;
 #endif
 
 /*! \def PGEX_BoolVal(Mark, targetValue)
     \brief Parse boolean flag value by requested Marker and write into target variable
 */
-#define PGEX_BoolVal(Mark, targetValue)  if(v.marker==Mark) { if(PGEFile::IsBool(v.value)) \
-                                         targetValue = static_cast<bool>(toInt(v.value) != 0);\
-                                         else goto badfile; }
+#define PGEX_BoolVal(Mark, targetValue)  case PGEFile::markerKey(Mark): { bool flag; \
+                                         if(PGEFile::X2Bool(v.value, flag)) \
+                                         targetValue = flag;\
+                                         else goto badfile; } break;
 
 /*! \def PGEX_BoolArrVal(Mark, targetValue)
     \brief Parse boolean flags array value by requested Marker and write into target variable
 */
-#define PGEX_BoolArrVal(Mark, targetValue)  else if(v.marker==Mark) { if(PGEFile::IsBoolArray(v.value)) \
+#define PGEX_BoolArrVal(Mark, targetValue)  case PGEFile::markerKey(Mark): { if(PGEFile::IsBoolArray(v.value)) \
                                              targetValue = PGEFile::X2BollArr(v.value); \
-                                            else goto badfile; }
+                                            else goto badfile; } break;
+
+/*! \def PGEX_NumVal(Mark, targetValue, numType, decode)
+    \brief Validate and decode the number of given type in a single pass and write into target variable
+*/
+#define PGEX_NumVal(Mark, targetValue, numType, decode)  case PGEFile::markerKey(Mark): { numType num; \
+                                         if(PGEFile::decode(v.value, num)) \
+                                         targetValue = num;\
+                                         else goto badfile; \
+                                         PGE_check_inst<numType>(targetValue); } break;
 
 /*! \def PGEX_UIntVal(Mark, targetValue)
     \brief Parse unsigned integer value by requested Marker and write into target signed int variable
 */
-#define PGEX_USIntVal(Mark, targetValue)  if(v.marker==Mark) { if(PGEFile::IsIntU(v.value)) \
-                                         targetValue = toInt(v.value);\
-                                         else goto badfile; \
-                                         PGE_check_inst<signed int>(targetValue); }
+#define PGEX_USIntVal(Mark, targetValue)  PGEX_NumVal(Mark, targetValue, signed int, X2IntU)
 
 /*! \def PGEX_UIntVal(Mark, targetValue)
     \brief Parse unsigned integer value by requested Marker and write into target variable
 */
-#define PGEX_UIntVal(Mark, targetValue)  if(v.marker==Mark) { if(PGEFile::IsIntU(v.value)) \
-                                         targetValue = toUInt(v.value);\
-                                         else goto badfile; \
-                                         PGE_check_inst<unsigned int>(targetValue); }
+#define PGEX_UIntVal(Mark, targetValue)  PGEX_NumVal(Mark, targetValue, unsigned int, X2IntU)
 
 /*! \def PGEX_UIntVal(Mark, targetValue)
     \brief Parse uint32_t integer value by requested Marker and write into target variable
 */
-#define PGEX_UInt32Val(Mark, targetValue)  if(v.marker==Mark) { if(PGEFile::IsIntU(v.value)) \
-targetValue = toUInt(v.value);\
-    else goto badfile; \
-    PGE_check_inst<uint32_t>(targetValue); }
+#define PGEX_UInt32Val(Mark, targetValue)  PGEX_NumVal(Mark, targetValue, uint32_t, X2IntU)
 
 /*! \def PGEX_SIntVal(Mark, targetValue)
     \brief Parse signed integer value by requested Marker and write into target variable
 */
-#define PGEX_SIntVal(Mark, targetValue)  if(v.marker==Mark) { if(PGEFile::IsIntS(v.value)) \
-                                         targetValue = toInt(v.value);\
-                                         else goto badfile; \
-                                         PGE_check_inst<signed int>(targetValue); }
+#define PGEX_SIntVal(Mark, targetValue)  PGEX_NumVal(Mark, targetValue, signed int, X2IntS)
 
 /*! \def PGEX_SLongVal(Mark, targetValue)
     \brief Parse signed long integer value by requested Marker and write into target variable
 */
-#define PGEX_SLongVal(Mark, targetValue) if(v.marker==Mark) { if(PGEFile::IsIntS(v.value)) \
-                                         targetValue = toLong(v.value);\
-                                         else goto badfile; \
-                                         PGE_check_inst<signed long>(targetValue); }
+#define PGEX_SLongVal(Mark, targetValue) PGEX_NumVal(Mark, targetValue, signed long, X2IntS)
 
 /*! \def PGEX_ULongVal(Mark, targetValue)
     \brief Parse unsigned long integer value by requested Marker and write into target variable
 */
-#define PGEX_ULongVal(Mark, targetValue) if(v.marker==Mark) { if(PGEFile::IsIntU(v.value)) \
-                                         targetValue = toULong(v.value);\
-                                         else goto badfile; \
-                                         PGE_check_inst<unsigned long>(targetValue); }
+#define PGEX_ULongVal(Mark, targetValue) PGEX_NumVal(Mark, targetValue, unsigned long, X2IntU)
 
 /*! \def PGEX_UInt64Val(Mark, targetValue)
     \brief Parse uint64_t integer value by requested Marker and write into target variable
 */
-#define PGEX_UInt64Val(Mark, targetValue) if(v.marker==Mark) { if(PGEFile::IsIntU(v.value)) \
-targetValue = toULong(v.value);\
-    else goto badfile; \
-    PGE_check_inst<uint64_t>(targetValue); }
+#define PGEX_UInt64Val(Mark, targetValue) PGEX_NumVal(Mark, targetValue, uint64_t, X2IntU)
 
 /*! \def PGEX_USLongVal(Mark, targetValue)
     \brief Parse unsigned long integer value by requested Marker and write into target signed long variable
 */
-#define PGEX_USLongVal(Mark, targetValue) if(v.marker==Mark) { if(PGEFile::IsIntU(v.value)) \
-                                         targetValue = toLong(v.value);\
-                                         else goto badfile; \
-                                         PGE_check_inst<signed long>(targetValue); }
+#define PGEX_USLongVal(Mark, targetValue) PGEX_NumVal(Mark, targetValue, signed long, X2IntU)
 
 /*! \def PGEX_USInt64Val(Mark, targetValue)
     \brief Parse unsigned 64-bit integer value by requested Marker and write into target int64_t variable
 */
-#define PGEX_USInt64Val(Mark, targetValue) if(v.marker==Mark) { if(PGEFile::IsIntU(v.value)) \
-                                         targetValue = toLong(v.value);\
-                                         else goto badfile; \
-                                         PGE_check_inst<int64_t>(targetValue); }
+#define PGEX_USInt64Val(Mark, targetValue) PGEX_NumVal(Mark, targetValue, int64_t, X2IntU)
 
 /*! \def PGEX_FloatVal(Mark, targetValue)
     \brief Parse floating point value by requested Marker and write into target variable
 */
-#define PGEX_FloatVal(Mark, targetValue)  if(v.marker==Mark) { if(PGEFile::IsFloat(v.value)) \
-                                          targetValue = toDouble(v.value);\
-                                          else goto badfile; }
+#define PGEX_FloatVal(Mark, targetValue)  case PGEFile::markerKey(Mark): { double num; \
+                                          if(PGEFile::X2Float(v.value, num)) \
+                                          targetValue = num;\
+                                          else goto badfile; } break;
 
 
 #endif // PGE_X_MACRO_H
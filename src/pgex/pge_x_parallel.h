@@ -0,0 +1,357 @@
+/*
+ * PGE File Library - a library to process file formats, part of Moondust project
+ *
+ * Copyright (c) 2014-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file pge_x_parallel.h
+ *
+ * \brief Contains helpers to decode and to encode independent sections of PGE-X data on worker threads
+ *
+ */
+
+#pragma once
+#ifndef PGE_X_PARALLEL_H
+#define PGE_X_PARALLEL_H
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "pge_x.h"
+#include "pge_file_lib_threads.h"
+
+/*!
+ * \brief Deferred decoding or encoding of one section of the PGE-X data
+ */
+struct PGEX_SectionJob
+{
+    //! Number of entries in the section, bigger sections are started first
+    pge_size_t weight;
+    //! Decodes or encodes the section
+    std::function<void()> run;
+};
+
+/*!
+ * \brief Runs all section jobs on up to the given number of threads, the biggest sections first
+ * \param jobs List of section jobs
+ * \param threads Maximal number of threads
+ */
+inline void PGEX_RunSectionJobs(std::vector<PGEX_SectionJob> &jobs, unsigned int threads)
+{
+    std::stable_sort(jobs.begin(), jobs.end(),
+                     [](const PGEX_SectionJob &a, const PGEX_SectionJob &b)
+    {
+        return a.weight > b.weight;
+    });
+
+    PGE_FileFormats_misc::parallelFor(jobs.size(), threads, [&jobs](size_t i)
+    {
+        jobs[i].run();
+    });
+}
+
+/*!
+ * \brief Sections of one name which don't depend on other sections and can be decoded ahead on worker threads
+ *
+ * Every entry of such section is decoded into exactly one element of the target list.
+ * Big sections are split into chunks of entries which are decoded independently.
+ * Decoded chunks are merged in the file order, and their elements are numbered
+ * by array IDs and indices the same way as when decoding them in order.
+ */
+template<class T>
+class PGEX_SectionBatch
+{
+public:
+    /*!
+     * \brief Decodes the range of entries of the section and appends them to the target list
+     * \param [__in] section Section of the data tree
+     * \param [__in] begin First entry to decode
+     * \param [__in] end Entry after the last one to decode
+     * \param [__out] target Target list
+     * \param [__inout] arrayId Array ID counter
+     * \param [__inout] lines Counter of read lines, used by error reports
+     * \param [__out] errorString Error message
+     * \return true if all entries successfully decoded
+     */
+    typedef bool (*Decoder)(const PGEFile::PGEX_Entry &section, pge_size_t begin, pge_size_t end,
+                            PGELIST<T> &target, unsigned int &arrayId, int &lines, PGESTRING &errorString);
+
+    //! Maximal number of entries decoded by one job
+    static const pge_size_t chunkSize = 4096;
+
+    /*!
+     * \brief Constructor
+     * \param name Name of sections
+     * \param decode Decoder of the section
+     */
+    PGEX_SectionBatch(const char *name, Decoder decode) :
+        m_name(name),
+        m_decode(decode)
+    {}
+
+    /*!
+     * \brief Adds jobs to decode all sections of this name ahead
+     * \param tree Data tree which is already built, must stay alive until all sections are read
+     * \param jobs List of section jobs to append
+     *
+     * Sections with invalid type are left for the read() to report the error in order.
+     */
+    void schedule(const PGEFile &tree, std::vector<PGEX_SectionJob> &jobs)
+    {
+        m_parts.clear();
+        m_next = 0;
+
+        for(pge_size_t s = 0; s < tree.dataTree.size(); s++)
+        {
+            const PGEFile::PGEX_Entry &e = tree.dataTree[s];
+            if(e.type != PGEFile::PGEX_Struct || e.name != m_name)
+                continue;
+
+            pge_size_t begin = 0;
+            do
+            {
+                m_parts.push_back(Part());
+                Part &part = m_parts.back();
+                part.section = s;
+                part.begin = begin;
+                part.end = (e.data.size() - begin > chunkSize) ? begin + chunkSize : e.data.size();
+                begin = part.end;
+            } while(begin < e.data.size());
+        }
+
+        for(Part &part : m_parts)
+        {
+            Part *p = &part;
+            const PGEFile::PGEX_Entry *e = &tree.dataTree[p->section];
+            Decoder decode = m_decode;
+            jobs.push_back({p->end - p->begin, [p, e, decode]()
+            {
+                unsigned int arrayId = 0; // Numbered on merge
+                p->valid = decode(*e, p->begin, p->end, p->items, arrayId, p->lines, p->errorString);
+            }});
+        }
+    }
+
+    /*!
+     * \brief Takes the section decoded ahead or decodes it now, and appends its elements to the target list
+     * \param [__in] entry Section of the data tree
+     * \param [__in] section Index of section in the data tree
+     * \param [__out] target Target list
+     * \param [__inout] arrayId Array ID counter
+     * \param [__inout] lines Counter of read lines, used by error reports
+     * \param [__out] errorString Error message
+     * \return true if section successfully decoded
+     */
+    bool read(const PGEFile::PGEX_Entry &entry, pge_size_t section, PGELIST<T> &target,
+              unsigned int &arrayId, int &lines, PGESTRING &errorString)
+    {
+        if(m_next >= m_parts.size() || m_parts[m_next].section != section)
+            return m_decode(entry, 0, entry.data.size(), target, arrayId, lines, errorString);
+
+        pge_size_t first = target.size();
+        if(first > 0)
+            target.reserve(first + entry.data.size());
+
+        for(; m_next < m_parts.size() && m_parts[m_next].section == section; m_next++)
+        {
+            Part &part = m_parts[m_next];
+            lines += part.lines;
+
+            if(!part.valid)
+            {
+                errorString = part.errorString;
+                return false;
+            }
+
+            if(target.empty())
+            {
+                target.swap(part.items);
+                target.reserve(entry.data.size());
+                continue;
+            }
+
+            for(pge_size_t i = 0; i < part.items.size(); i++)
+                target.push_back(std::move(part.items[i]));
+            part.items.clear();
+        }
+
+        // Number the whole section in one pass
+        for(pge_size_t i = first; i < target.size(); i++)
+        {
+            target[i].meta.array_id = arrayId++;
+            target[i].meta.index = static_cast<unsigned int>(i);
+        }
+
+        return true;
+    }
+
+    /*!
+     * \brief Takes the section decoded ahead or decodes it now, for the readers which don't count lines
+     */
+    bool read(const PGEFile::PGEX_Entry &entry, pge_size_t section, PGELIST<T> &target,
+              unsigned int &arrayId, PGESTRING &errorString)
+    {
+        int lines = 0;
+        return read(entry, section, target, arrayId, lines, errorString);
+    }
+
+    /*!
+     * \brief Takes the section decoded ahead or decodes it now, and reports its elements one by one
+     * \param [__in] entry Section of the data tree
+     * \param [__in] section Index of section in the data tree
+     * \param [__inout] arrayId Array ID counter
+     * \param [__inout] index Counter of reported elements, used as their indices
+     * \param [__out] errorString Error message
+     * \param [__in] report Functor called for every element, returns false to interrupt the reading
+     * \return true if section successfully decoded and all elements were accepted
+     */
+    template<class Report>
+    bool read(const PGEFile::PGEX_Entry &entry, pge_size_t section,
+              unsigned int &arrayId, unsigned int &index, PGESTRING &errorString, Report report)
+    {
+        m_buffer.clear();
+        if(!read(entry, section, m_buffer, arrayId, errorString))
+            return false;
+
+        for(pge_size_t i = 0; i < m_buffer.size(); i++)
+        {
+            T &item = m_buffer[i];
+            item.meta.index = index++;
+            if(!report(item))
+            {
+                errorString = "Loading was interrupted by the load callback";
+                m_buffer.clear();
+                return false;
+            }
+        }
+
+        m_buffer.clear();
+        return true;
+    }
+
+private:
+    struct Part
+    {
+        //! Index of section in the data tree
+        pge_size_t section = 0;
+        //! First entry of the chunk
+        pge_size_t begin = 0;
+        //! Entry after the last one of the chunk
+        pge_size_t end = 0;
+        //! Was chunk successfully decoded
+        bool valid = false;
+        //! Number of read lines in this chunk
+        int lines = 0;
+        //! Error message
+        PGESTRING errorString;
+        //! Decoded elements
+        PGELIST<T> items;
+    };
+
+    //! Name of sections
+    const char *m_name;
+    //! Decoder of the section
+    Decoder m_decode;
+    //! Chunks of sections to decode ahead, in the file order
+    std::vector<Part> m_parts;
+    //! Next chunk to merge
+    size_t m_next = 0;
+    //! Elements of the section being reported
+    PGELIST<T> m_buffer;
+};
+
+/*!
+ * \brief Section of the written PGE-X data which doesn't depend on other sections and can be encoded ahead on worker threads
+ *
+ * The section encoded ahead is kept in its own buffer until it gets written in its place of the file,
+ * therefore the output is the same as when encoding it in order.
+ */
+template<class Data>
+class PGEX_SectionRender
+{
+public:
+    /*!
+     * \brief Encoder of the section
+     * \param [__out] w PGE-X data builder
+     * \param [__in] data Written data
+     */
+    typedef void (*Encoder)(PGEXWriter &w, const Data &data);
+
+    /*!
+     * \brief Constructor
+     * \param encode Encoder of the section
+     * \param data Written data which must stay alive and unchanged until the section is written
+     */
+    PGEX_SectionRender(Encoder encode, const Data &data) :
+        m_encode(encode),
+        m_data(data)
+    {}
+
+    /*!
+     * \brief Adds the job to encode the section ahead
+     * \param weight Number of entries in the section
+     * \param jobs List of section jobs to append
+     */
+    void schedule(pge_size_t weight, std::vector<PGEX_SectionJob> &jobs)
+    {
+        if(weight == 0)
+            return;
+
+        m_ahead = true;
+        jobs.push_back({weight, [this]()
+        {
+            m_encode(m_buffer, m_data);
+        }});
+    }
+
+    /*!
+     * \brief Writes the section encoded ahead or encodes it now
+     * \param w PGE-X data builder
+     */
+    void write(PGEXWriter &w)
+    {
+        if(!m_ahead)
+        {
+            m_encode(w, m_data);
+            return;
+        }
+
+        w.append(m_buffer);
+        m_buffer = PGEXWriter();
+        m_ahead = false;
+    }
+
+private:
+    //! Encoder of the section
+    Encoder m_encode;
+    //! Written data
+    const Data &m_data;
+    //! Is section encoded ahead
+    bool m_ahead = false;
+    //! Section encoded ahead
+    PGEXWriter m_buffer;
+};
+
+#endif // PGE_X_PARALLEL_H
@@ -28,6 +28,7 @@
 #include "file_formats.h"
 
 #include "smbx38a_private.h"
+#include "smbx38a_parallel.h"
 
 
 /***********  Pre-defined values dependent to NPC Generator Effect field value  **************/
@@ -111,10 +112,11 @@ bool FileFormats::ReadSMBX38ALvlFileHeaderT(PGE_FileFormats_misc::TextInput &inf
 
     inf.seek(0, PGE_FileFormats_misc::TextFileInput::begin);
 
+    CSVPGEReader readerBridge(&inf);
+    auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
+
     try
     {
-        CSVPGEReader readerBridge(&inf);
-        auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
         PGESTRING fileIndentifier = dataReader.ReadField<PGESTRING>(1);
         dataReader.ReadDataLine();
 
@@ -134,7 +136,7 @@ bool FileFormats::ReadSMBX38ALvlFileHeaderT(PGE_FileFormats_misc::TextInput &inf
             {
                 PGESTRING s[4];
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(), // Skip the first field (this is already "identifier")
                     &FileData.stars,
                     MakeCSVPostProcessor(&FileData.LevelName, PGEUrlDecodeFunc),
@@ -147,7 +149,8 @@ bool FileFormats::ReadSMBX38ALvlFileHeaderT(PGE_FileFormats_misc::TextInput &inf
                         MakeCSVOptional(&s[2], PGESTRING(""), nullptr, PGEUrlDecodeFunc),
                         MakeCSVOptional(&s[3], PGESTRING(""), nullptr, PGEUrlDecodeFunc)
                     )
-                );
+                ))
+                    goto badfile;
 
                 for(uint32_t i = 0; i < 4; i++)
                 {
@@ -191,6 +194,14 @@ bool FileFormats::ReadSMBX38ALvlFileHeaderT(PGE_FileFormats_misc::TextInput &inf
     FileData.CurSection = 0;
     FileData.playmusic = 0;
     return true;
+
+badfile:
+    FileData.meta.ReadFileValid = false;
+    FileData.meta.ERROR_info = "Invalid file format, detected file SMBX-38A-" + fromNum(FileData.meta.RecentFormatVersion) + " format\n"
+                               "Caused by: \n" + PGESTRING(dataReader.Status().pretty_string().c_str());
+    FileData.meta.ERROR_linenum = inf.getCurrentLineNumber();
+    FileData.meta.ERROR_linedata.clear();
+    return false;
 #else
     FileData.meta.ReadFileValid = false;
     FileData.meta.ERROR_info = "Unsupported on MSVC2013";
@@ -242,15 +253,230 @@ struct LevelEvent_layers
 
 
 
+/*!
+ * \brief Types of SMBX-38A level data lines
+ */
+enum Smbx38aLvlRecord
+{
+    LVL38A_REC_UNKNOWN = 0,     //!< Unsupported line
+    LVL38A_REC_HEADER,          //!< A
+    LVL38A_REC_PLAYER_NAMES,    //!< BTNS
+    LVL38A_REC_PLAYER1,         //!< P1
+    LVL38A_REC_PLAYER2,         //!< P2
+    LVL38A_REC_SECTION,         //!< M
+    LVL38A_REC_BLOCK,           //!< B
+    LVL38A_REC_BGO,             //!< T
+    LVL38A_REC_NPC,             //!< N
+    LVL38A_REC_PHYSENV,         //!< Q
+    LVL38A_REC_DOOR,            //!< W
+    LVL38A_REC_LAYER,           //!< L
+    LVL38A_REC_EVENT,           //!< E
+    LVL38A_REC_VARIABLE,        //!< V
+    LVL38A_REC_ARRAY,           //!< R
+    LVL38A_REC_SCRIPT,          //!< S
+    LVL38A_REC_SCRIPT_UNICODE,  //!< Su or SU
+    LVL38A_REC_CUSTOM_BLOCK,    //!< CB
+    LVL38A_REC_CUSTOM_BGO,      //!< CT
+    LVL38A_REC_CUSTOM_EFFECT,   //!< CE
+    LVL38A_REC_SOUNDS,          //!< CW
+    LVL38A_REC_COUNT
+};
+
+/*!
+ * \brief Parts of FileFormats::LoadSections which the data line of each type belongs to
+ */
+static const uint32_t c_smbx38aLvlRecordParts[LVL38A_REC_COUNT] =
+{
+    FileFormats::LOAD_HEADER,       // Unsupported lines
+    FileFormats::LOAD_HEADER,       // A
+    FileFormats::LOAD_HEADER,       // BTNS
+    FileFormats::LOAD_PLAYERS,      // P1
+    FileFormats::LOAD_PLAYERS,      // P2
+    FileFormats::LOAD_SECTIONS,     // M
+    FileFormats::LOAD_BLOCKS,       // B
+    FileFormats::LOAD_BGO,          // T
+    FileFormats::LOAD_NPC,          // N
+    FileFormats::LOAD_PHYSENV,      // Q
+    FileFormats::LOAD_DOORS,        // W
+    FileFormats::LOAD_LAYERS,       // L
+    FileFormats::LOAD_EVENTS,       // E
+    FileFormats::LOAD_VARIABLES,    // V
+    FileFormats::LOAD_VARIABLES,    // R
+    FileFormats::LOAD_SCRIPTS,      // S
+    FileFormats::LOAD_SCRIPTS,      // Su
+    FileFormats::LOAD_CUSTOM38A,    // CB
+    FileFormats::LOAD_CUSTOM38A,    // CT
+    FileFormats::LOAD_CUSTOM38A,    // CE
+    FileFormats::LOAD_HEADER        // CW
+};
+
+/*!
+ * \brief Detects type of the data line by the length and the first characters of the identifier
+ * \param identifier Type of the data line
+ * \return Type of the record, LVL38A_REC_UNKNOWN for unsupported lines
+ */
+static Smbx38aLvlRecord smbx38aLvlRecordType(const PGESTRING &identifier)
+{
+    switch(identifier.size())
+    {
+    case 1:
+        switch(PGEGetChar(identifier[0]))
+        {
+        case 'B':
+            return LVL38A_REC_BLOCK;
+        case 'T':
+            return LVL38A_REC_BGO;
+        case 'N':
+            return LVL38A_REC_NPC;
+        case 'Q':
+            return LVL38A_REC_PHYSENV;
+        case 'W':
+            return LVL38A_REC_DOOR;
+        case 'L':
+            return LVL38A_REC_LAYER;
+        case 'E':
+            return LVL38A_REC_EVENT;
+        case 'M':
+            return LVL38A_REC_SECTION;
+        case 'A':
+            return LVL38A_REC_HEADER;
+        case 'V':
+            return LVL38A_REC_VARIABLE;
+        case 'R':
+            return LVL38A_REC_ARRAY;
+        case 'S':
+            return LVL38A_REC_SCRIPT;
+        default:
+            break;
+        }
+        break;
+
+    case 2:
+    {
+        const char second = PGEGetChar(identifier[1]);
+        switch(PGEGetChar(identifier[0]))
+        {
+        case 'P':
+            if(second == '1')
+                return LVL38A_REC_PLAYER1;
+            else if(second == '2')
+                return LVL38A_REC_PLAYER2;
+            break;
+        case 'S':
+            if(second == 'u' || second == 'U')
+                return LVL38A_REC_SCRIPT_UNICODE;
+            break;
+        case 'C':
+            if(second == 'B')
+                return LVL38A_REC_CUSTOM_BLOCK;
+            else if(second == 'T')
+                return LVL38A_REC_CUSTOM_BGO;
+            else if(second == 'E')
+                return LVL38A_REC_CUSTOM_EFFECT;
+            else if(second == 'W')
+                return LVL38A_REC_SOUNDS;
+            break;
+        default:
+            break;
+        }
+        break;
+    }
+
+    case 4:
+        if(identifier == "BTNS")
+            return LVL38A_REC_PLAYER_NAMES;
+        break;
+
+    default:
+        break;
+    }
+
+    return LVL38A_REC_UNKNOWN;
+}
+
+#ifdef SMBX38A_PARALLEL_READ
+typedef SMBX38A_LineBatch<LevelData, Smbx38aLvlRecord> Smbx38aLvlBatch;
+#else
+struct Smbx38aLvlBatch; //!< Lines are never decoded ahead
+#endif
+
+static bool smbx38aReadLvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &FileData, LevelLoadCallbacks &callbacks,
+                               uint32_t loadSections, Smbx38aLvlBatch *ahead);
+
+#ifdef SMBX38A_PARALLEL_READ
+/*!
+ * \brief Reads the chunk of lines on the worker thread
+ * \param in Header line and lines of the chunk
+ * \param fragment Data which receives read objects
+ * \return true if all lines successfully read
+ */
+static bool smbx38aLvlDecodeAhead(PGE_FileFormats_misc::TextInput &in, LevelData &fragment)
+{
+    LevelDataLoadCallbacks loader(fragment);
+    return smbx38aReadLvlFile(in, fragment, loader, FileFormats::LOAD_ALL, nullptr);
+}
+
+/*!
+ * \brief Reports the object decoded ahead the same way as the reader reports the object read from the line
+ * \param fragment Fragment which contains the object
+ * \param type Type of the line
+ * \param index Index of the object at the fragment's list
+ * \param FileData Level data structure
+ * \param callbacks Receiver of level objects
+ * \return false if loading was interrupted by the callback
+ */
+static bool smbx38aLvlTakeAhead(LevelData &fragment, Smbx38aLvlRecord type, size_t index,
+                                LevelData &FileData, LevelLoadCallbacks &callbacks)
+{
+    const pge_size_t i = static_cast<pge_size_t>(index);
+
+    switch(type)
+    {
+    case LVL38A_REC_BLOCK:
+        fragment.blocks[i].meta.array_id = FileData.blocks_array_id++;
+        return callbacks.onBlock(fragment.blocks[i]);
+    case LVL38A_REC_BGO:
+        fragment.bgo[i].meta.array_id = FileData.bgo_array_id++;
+        return callbacks.onBGO(fragment.bgo[i]);
+    case LVL38A_REC_NPC:
+        fragment.npc[i].meta.array_id = FileData.npc_array_id++;
+        return callbacks.onNPC(fragment.npc[i]);
+    case LVL38A_REC_PHYSENV:
+        fragment.physez[i].meta.array_id = FileData.physenv_array_id++;
+        return callbacks.onPhysEnv(fragment.physez[i]);
+    case LVL38A_REC_DOOR:
+        fragment.doors[i].meta.array_id = FileData.doors_array_id++;
+        return callbacks.onWarp(fragment.doors[i]);
+    case LVL38A_REC_LAYER:
+        fragment.layers[i].meta.array_id = FileData.layers_array_id++;
+        return callbacks.onLayer(fragment.layers[i]);
+    default:
+        return true;
+    }
+}
+#endif
+
 /**********************************************************************************************/
-bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &FileData)
+bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &FileData, uint32_t loadSections)
+{
+    LevelDataLoadCallbacks loader(FileData);
+
+    if(!ReadSMBX38ALvlFile(in, FileData, loader, loadSections))
+        return false;
+
+    LevelAddInternalEvents(FileData);
+    return true;
+}
+
+static bool smbx38aReadLvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &FileData, LevelLoadCallbacks &callbacks,
+                               uint32_t loadSections, Smbx38aLvlBatch *ahead)
 {
     SMBX38A_FileBeginN();
     PGESTRING filePath = in.getFilePath();
     FileData.meta.ERROR_info.clear();
-    CreateLevelData(FileData);
+    FileFormats::CreateLevelData(FileData);
     FileData.meta.RecentFormat = LevelData::SMBX38A;
-    FileData.meta.RecentFormatVersion = c_latest_version_smbx38a;
+    FileData.meta.RecentFormatVersion = FileFormats::c_latest_version_smbx38a;
 #if !defined(_MSC_VER) || _MSC_VER > 1800
     FileData.LevelName.clear();
     FileData.stars = 0;
@@ -287,6 +513,7 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
     LevelItemSetup38A customcfg;
 
     PGESTRING   identifier;
+    Smbx38aLvlRecord recordType = LVL38A_REC_UNKNOWN;
 
     //Add path data
     if(!IsEmpty(filePath))
@@ -298,10 +525,11 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
 
     in.seek(0, PGE_FileFormats_misc::TextFileInput::begin);
 
+    CSVPGEReader readerBridge(&in);
+    auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
+
     try
     {
-        CSVPGEReader readerBridge(&in);
-        auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
         PGESTRING fileIndentifier = dataReader.ReadField<PGESTRING>(1);
         dataReader.ReadDataLine();
 
@@ -310,14 +538,40 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
 
         FileData.meta.RecentFormatVersion = toUInt(PGE_SubStr(fileIndentifier, 8, -1));
 
-        if(FileData.meta.RecentFormatVersion > c_latest_version_smbx38a)
+        if(FileData.meta.RecentFormatVersion > FileFormats::c_latest_version_smbx38a)
             throw std::logic_error("File format has newer version which is not supported yet");
 
         while(!in.eof())
         {
             identifier = dataReader.ReadField<PGESTRING>(1);
+            recordType = smbx38aLvlRecordType(identifier);
 
-            if(identifier == "A")
+            if(!(loadSections & c_smbx38aLvlRecordParts[recordType]))
+            {
+                dataReader.SkipDataLine();
+                continue;
+            }
+
+#ifdef SMBX38A_PARALLEL_READ
+            if(ahead && ahead->isAhead(recordType))
+            {
+                size_t index = 0;
+                LevelData *fragment = ahead->take(in.getCurrentLineNumber(), recordType, index);
+                if(fragment)
+                {
+                    dataReader.SkipDataLine();
+                    if(!smbx38aLvlTakeAhead(*fragment, recordType, index, FileData, callbacks))
+                        goto interrupted;
+                    continue;
+                }
+            }
+#else
+            (void)ahead;
+#endif
+
+            switch(recordType)
+            {
+            case LVL38A_REC_HEADER:
             {
                 // FIXME: Remove copy from line 77
                 // A|param1|param2[|param3|param4]|
@@ -331,7 +585,7 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                 // 0 1   2                               3  4{}
                 // A|0|%4C%61%79%65%72%20%53%70%69%6E%21| |,,,
                 PGESTRING s[4];
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(), // Skip the first field (this is already "identifier")
                     &FileData.stars,
                     MakeCSVPostProcessor(&FileData.LevelName, PGEUrlDecodeFunc),
@@ -344,7 +598,8 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                         MakeCSVOptional(&s[2], PGESTRING(""), nullptr, PGEUrlDecodeFunc),
                         MakeCSVOptional(&s[3], PGESTRING(""), nullptr, PGEUrlDecodeFunc)
                     )
-                );
+                ))
+                    goto badfile;
 
                 for(uint32_t i = 0; i < 4; i++)
                 {
@@ -357,49 +612,56 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                         FileData.music_overrides.push_back(mo);
                     }
                 }
+                break;
             }
-            else if(identifier == "BTNS")
+            case LVL38A_REC_PLAYER_NAMES:
             {
                 // BTNS|mario|luigi|peach|toad|link
                 FileData.player_names_overrides.clear();
                 PGESTRING plr[5];
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVOptionalEmpty(&plr[0], ""),
                     MakeCSVOptionalEmpty(&plr[1], ""),
                     MakeCSVOptionalEmpty(&plr[2], ""),
                     MakeCSVOptionalEmpty(&plr[3], ""),
                     MakeCSVOptionalEmpty(&plr[4], "")
-                );
+                ))
+                    goto badfile;
 
                 for(size_t i = 0; i < 5; i++)
                     FileData.player_names_overrides.push_back(plr[i]);
+                break;
             }
-            else if(identifier == "P1")
+            case LVL38A_REC_PLAYER1:
             {
                 // P1|x1|y1
-                playerdata = CreateLvlPlayerPoint(1);
-                dataReader.ReadDataLine(CSVDiscard(), &playerdata.x, &playerdata.y);
+                playerdata = FileFormats::CreateLvlPlayerPoint(1);
+                if(!dataReader.TryReadDataLine(CSVDiscard(), &playerdata.x, &playerdata.y))
+                    goto badfile;
                 FileData.players.push_back(playerdata);
+                break;
             }
-            else if(identifier == "P2")
+            case LVL38A_REC_PLAYER2:
             {
                 // P2|x2|y2
                 // FIXME: Copy from above (can be solved with switch?)
-                playerdata = CreateLvlPlayerPoint(2);
-                dataReader.ReadDataLine(CSVDiscard(), &playerdata.x, &playerdata.y);
+                playerdata = FileFormats::CreateLvlPlayerPoint(2);
+                if(!dataReader.TryReadDataLine(CSVDiscard(), &playerdata.x, &playerdata.y))
+                    goto badfile;
                 FileData.players.push_back(playerdata);
+                break;
             }
-            else if(identifier == "M")
+            case LVL38A_REC_SECTION:
             {
                 // M|id|x|y|w|h|b1|b2|b3|b4|b5|b6|music|background,lightingvalue|musicfile
-                section = CreateLvlSection();
+                section = FileFormats::CreateLvlSection();
                 double x = 0.0, y = 0.0, w = 0.0, h = 0.0;
                 PGESTRING scroll_lock_x;
                 PGESTRING scroll_lock_y;
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //id=[1-SectionMAX]
                     MakeCSVPostProcessor(&section.id, [](int &sectionID)
@@ -438,7 +700,8 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                     ),
                     //musicfile=custom music file[***urlencode!***]
                     MakeCSVPostProcessor(&section.music_file, PGEUrlDecodeFunc)
-                );
+                ))
+                    goto badfile;
 
                 SMBX38A_mapBGID_From(section.background);//Convert into SMBX64 ID set
                 section.lock_left_scroll =  (scroll_lock_x == "1");
@@ -465,13 +728,14 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                     FileData.sections[static_cast<pge_size_t>(section.id)] = section;//Replace if already exists
                 else
                     FileData.sections.push_back(section); //Add Section in main array
+                break;
             }
-            else if(identifier == "B")
+            case LVL38A_REC_BLOCK:
             {
                 // B|layer[,name]|id[,dx,dy]|x|y|contain,sp|b11[,b12]|b2|[e1,e2,e3,e4]|w|h
-                blockdata = CreateLvlBlock();
+                blockdata = FileFormats::CreateLvlBlock();
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVSubReader(
                         dataReader, ',',
@@ -531,7 +795,8 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                     &blockdata.w,
                     //h=height
                     &blockdata.h
-                );
+                ))
+                    goto badfile;
 
                 blockdata.autoscale = (blockdata.w < 0);
 
@@ -539,14 +804,16 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                     blockdata.w *= -1;
 
                 blockdata.meta.array_id = FileData.blocks_array_id++;
-                FileData.blocks.push_back(blockdata);
+                if(!callbacks.onBlock(blockdata))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "T")
+            case LVL38A_REC_BGO:
             {
                 // T|layer|id[,dx,dy]|x|y
-                bgodata = CreateLvlBgo();
+                bgodata = FileFormats::CreateLvlBgo();
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVPostProcessor(&bgodata.layer, PGELayerOrDefault),
                     MakeCSVSubReader(
@@ -557,22 +824,25 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                     ),
                     &bgodata.x,
                     &bgodata.y
-                );
+                ))
+                    goto badfile;
 
                 bgodata.meta.array_id = FileData.bgo_array_id++;
-                FileData.bgo.push_back(bgodata);
+                if(!callbacks.onBGO(bgodata))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "N")
+            case LVL38A_REC_NPC:
             {
                 // N|layer[,name]|id[,dx,dy]|x|y|b1,b2,b3,b4|sp|[e1,e2,e3,e4,e5,e6,e7]|a1,a2|c1[,c2,c3,c4,c5,c6,c7]|msg|
                 // N|layer[,name]|id[,dx,dy]|x|y|b1,b2,b3,b4|sp|[e1,e2,e3,e4,e5,e6,e7]|a1,a2|c1[,c2,c3,c4,c5,c6,c7]|msg|
                 // N|layer[,name]|id[,dx,dy]|x|y|b1,b2,b3,b4,b5,b6|sp|[e1,e2,e3,e4,e5,e6,e7]|a1,a2|c1[,c2,c3,c4,c5,c6,c7]|msg|[wi,hi]
-                npcdata = CreateLvlNpc();
+                npcdata = FileFormats::CreateLvlNpc();
                 npcdata.generator_period_orig_unit = PGE_FileLibrary::TimeUnit::FrameOneOf65sec;
                 double specialData = 0.0;
                 int genType = 0; // We have to handle that later :(
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVSubReader(
                         dataReader, ',',
@@ -643,7 +913,8 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                         MakeCSVOptional(&npcdata.override_width, -1),
                         MakeCSVOptional(&npcdata.override_height, -1)
                     )
-                );
+                ))
+                    goto badfile;
 
                 if(npcdata.contents > 0)
                 {
@@ -716,14 +987,16 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                                            PGE_FileLibrary::TimeUnit::FrameOneOf65sec,
                                            PGE_FileLibrary::TimeUnit::Decisecond);
                 npcdata.meta.array_id = FileData.npc_array_id++;
-                FileData.npc.push_back(npcdata);
+                if(!callbacks.onNPC(npcdata))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "Q")
+            case LVL38A_REC_PHYSENV:
             {
                 // Q|layer|x|y|w|h|b1,b2,b3,b4,b5|event
-                phyEnv = CreateLvlPhysEnv();
+                phyEnv = FileFormats::CreateLvlPhysEnv();
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVPostProcessor(&phyEnv.layer, PGELayerOrDefault),
                     &phyEnv.x,
@@ -742,19 +1015,22 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                         &phyEnv.accel
                     ),
                     MakeCSVPostProcessor(&phyEnv.touch_event, PGEUrlDecodeFunc)
-                );
+                ))
+                    goto badfile;
 
                 phyEnv.meta.array_id = FileData.physenv_array_id++;
-                FileData.physez.push_back(phyEnv);
+                if(!callbacks.onPhysEnv(phyEnv))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "W")
+            case LVL38A_REC_DOOR:
             {
                 // W|layer|x|y|ex|ey|type|enterd|exitd|sn,msg,hide|locked,noyoshi,canpick,bomb,hidef,anpc,mini,size|lik|liid|noexit|wx|wy|le|we
                 // W|layer|x|y|ex|ey|type|enterd|exitd|sn,msg,hide|locked,noyoshi,canpick,bomb,hidef,anpc,mini,size,ts,cannon,stand|lik|liid|noexit|wx|wy|le|we
-                doordata = CreateLvlWarp();
+                doordata = FileFormats::CreateLvlWarp();
                 int type = 0;
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //layer=layer name["" == "Default"][***urlencode!***]
                     MakeCSVPostProcessor(&doordata.layer, PGELayerOrDefault),
@@ -834,7 +1110,8 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                     MakeCSVOptional(&doordata.lvl_o, false),
                     //we=warp event[***urlencode!***]
                     MakeCSVOptional(&doordata.event_enter, "", nullptr, PGEUrlDecodeFunc)
-                );
+                ))
+                    goto badfile;
 
                 // type%100=[0=instant][1=pipe][2=door][3=loop]
                 doordata.type = type % 100;
@@ -865,26 +1142,31 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                 if(doordata.cannon_exit_speed <= 0)
                     doordata.cannon_exit_speed = 10.0;
                 doordata.meta.array_id = FileData.doors_array_id++;
-                FileData.doors.push_back(doordata);
+                if(!callbacks.onWarp(doordata))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "L")
+            case LVL38A_REC_LAYER:
             {
                 // L|name|status
-                layerdata = CreateLvlLayer();
+                layerdata = FileFormats::CreateLvlLayer();
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVPostProcessor(&layerdata.name, PGELayerOrDefault),
                     MakeCSVPostProcessor(&layerdata.hidden, PGEFilpBool)
-                );
+                ))
+                    goto badfile;
 
                 layerdata.meta.array_id = FileData.layers_array_id++;
-                FileData.layers.push_back(layerdata);
+                if(!callbacks.onLayer(layerdata))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "E")
+            case LVL38A_REC_EVENT:
             {
                 // E|name|msg|ea|el|elm|epy|eps|eef|ecn|evc|ene
-                eventdata = CreateLvlEvent();
+                eventdata = FileFormats::CreateLvlEvent();
                 // Here we can just align the section id with the index of the set
                 // It is an unsafe method, however, we should be safe when reading from the file, where the data object is empty.
                 eventdata.sets.clear();
@@ -902,7 +1184,7 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                 // The first two values are static ones, after that they come in packages (see below)
                 int spawnNpcReaderCurrentIndex = 0;
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(), //-V681
                     // name=event name[***urlencode!***]
                     MakeCSVPostProcessor(&eventdata.name, PGEUrlDecodeFunc),
@@ -1239,7 +1521,8 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                         MakeCSVOptionalEmpty(&eventdata.trigger_api_id, 0),
                         MakeCSVOptionalEmpty(&eventdata.trigger_script, "", nullptr, PGEUrlDecodeFunc)
                     )
-                );
+                ))
+                    goto badfile;
 
                 eventdata.trigger_timer_unit = PGE_FileLibrary::TimeUnit::FrameOneOf65sec;
                 eventdata.trigger_timer = PGE_FileLibrary::TimeUnitsCVT(eventdata.trigger_timer_orig,
@@ -1249,30 +1532,36 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                                                PGE_FileLibrary::TimeUnit::FrameOneOf65sec,
                                                PGE_FileLibrary::TimeUnit::Millisecond);
                 eventdata.meta.array_id = FileData.events_array_id++;
-                FileData.events.push_back(eventdata);
+                if(!callbacks.onEvent(eventdata))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "V")
+            case LVL38A_REC_VARIABLE:
             {
                 // V|name|value
-                vardata = CreateLvlVariable("var");
+                vardata = FileFormats::CreateLvlVariable("var");
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVPostProcessor(&vardata.name, PGEUrlDecodeFunc),
                     &vardata.value, /* save variable value as string
                                        because in PGE is planned to have
                                        variables to be universal */
                     MakeCSVOptionalEmpty(&vardata.is_global, false)
-                );
+                ))
+                    goto badfile;
 
-                FileData.variables.push_back(vardata);
+                if(!callbacks.onVariable(vardata))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "R")
+            case LVL38A_REC_ARRAY:
             {
                 // R|name1|name2|name3|....namen
-                dataReader.IterateDataLine([&FileData](const PGESTRING & nextFieldStr)
+                bool arraysAccepted = true;
+                dataReader.IterateDataLine([&callbacks, &arraysAccepted](const PGESTRING & nextFieldStr)
                 {
-                    if(nextFieldStr == "R")
+                    if(nextFieldStr == "R" || !arraysAccepted)
                         return;
 
                     auto fieldReader = MakeDirectReader(nextFieldStr);
@@ -1284,49 +1573,61 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                         MakeCSVPostProcessor(&arr.name, PGEUrlDecodeFunc)
                     );
 
-                    FileData.arrays.push_back(arr);
+                    arraysAccepted = callbacks.onArray(arr);
                 });
+
+                if(!arraysAccepted)
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "S")
+            case LVL38A_REC_SCRIPT:
             {
                 // S|name|script
-                scriptdata = CreateLvlScript("doScript", LevelScript::LANG_TEASCRIPT);
+                scriptdata = FileFormats::CreateLvlScript("doScript", LevelScript::LANG_TEASCRIPT);
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVPostProcessor(&scriptdata.name, PGEUrlDecodeFunc),
                     MakeCSVPostProcessor(&scriptdata.script, PGEBase64DecodeFunc)
-                );
+                ))
+                    goto badfile;
 
-                FileData.scripts.push_back(scriptdata);
+                if(!callbacks.onScript(scriptdata))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "Su" || identifier == "SU")
+            case LVL38A_REC_SCRIPT_UNICODE:
             {
                 // Su|name|scriptu
-                scriptdata = CreateLvlScript("doScript", LevelScript::LANG_TEASCRIPT);
+                scriptdata = FileFormats::CreateLvlScript("doScript", LevelScript::LANG_TEASCRIPT);
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVPostProcessor(&scriptdata.name, PGEUrlDecodeFunc),
                     MakeCSVPostProcessor(&scriptdata.script, PGEBase64DecodeFuncA)
-                );
+                ))
+                    goto badfile;
 
                 //Convert to LF
                 PGE_ReplSTRING(scriptdata.script, "\r\n", "\n");
-                FileData.scripts.push_back(scriptdata);
+                if(!callbacks.onScript(scriptdata))
+                    goto interrupted;
+                break;
             }
-            else if((identifier == "CB") || (identifier == "CT") || (identifier == "CE") )
+            case LVL38A_REC_CUSTOM_BLOCK:
+            case LVL38A_REC_CUSTOM_BGO:
+            case LVL38A_REC_CUSTOM_EFFECT:
             {
                 // CB|id|data   :custom block/background/effect
                 customcfg = LevelItemSetup38A();
-                if(identifier == "CB")
+                if(recordType == LVL38A_REC_CUSTOM_BLOCK)
                     customcfg.type = LevelItemSetup38A::BLOCK;
-                else if(identifier == "CT")
+                else if(recordType == LVL38A_REC_CUSTOM_BGO)
                     customcfg.type = LevelItemSetup38A::BGO;
                 else
                     customcfg.type = LevelItemSetup38A::EFFECT;
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     &customcfg.id,
                     MakeCSVIterator(dataReader, ',',
@@ -1336,11 +1637,14 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
                         SMBX38A_CC_decode(e.key, e.value, nextFieldStr);
                         customcfg.data.push_back(e);
                     })
-                );
+                ))
+                    goto badfile;
 
-                FileData.custom38A_configs.push_back(customcfg);
+                if(!callbacks.onCustomItem38A(customcfg))
+                    goto interrupted;
+                break;
             }
-            else if(identifier == "CW")
+            case LVL38A_REC_SOUNDS:
             {
                 // CW|cdata1|cdata2|...|cdatan	:custom sound:	same as wls file format
                 dataReader.IterateDataLine([&FileData](const PGESTRING & nextFieldStr)
@@ -1359,13 +1663,16 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
 
                     FileData.sound_overrides.push_back(mo);
                 });
+                break;
             }
-            else
+            default:
             {
                 // Unsupported line, just keep it
                 PGESTRING str;
                 dataReader.ReadRawLine(str);
                 FileData.unsupported_38a_lines.push_back(str);
+                break;
+            }
             }
         }//while is not EOF
     }
@@ -1425,11 +1732,27 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
         return false;
     }
 
-    LevelAddInternalEvents(FileData);
     FileData.CurSection = 0;
     FileData.playmusic = false;
     FileData.meta.ReadFileValid = true;
     return true;
+
+badfile:
+    FileData.meta.ReadFileValid = false;
+    FileData.meta.ERROR_info = "Invalid file format, detected file SMBX-38A-" + fromNum(FileData.meta.RecentFormatVersion) + " format\n"
+                               "Caused by: \n" + PGESTRING(dataReader.Status().pretty_string().c_str());
+    if(!IsEmpty(identifier))
+        FileData.meta.ERROR_info += "\n Field type " + identifier;
+    FileData.meta.ERROR_linenum = dataReader.Status().get_line_number();
+    FileData.meta.ERROR_linedata.clear();
+    return false;
+
+interrupted:
+    FileData.meta.ReadFileValid = false;
+    FileData.meta.ERROR_info = "Loading was interrupted by the load callback";
+    FileData.meta.ERROR_linenum = in.getCurrentLineNumber();
+    FileData.meta.ERROR_linedata.clear();
+    return false;
 #else // MSVC2015+
     FileData.meta.ReadFileValid = false;
     FileData.meta.ERROR_info = "Unsupported on MSVC2013";
@@ -1437,6 +1760,38 @@ bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelD
 #endif // MSVC2015+
 }
 
+bool FileFormats::ReadSMBX38ALvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &FileData, LevelLoadCallbacks &callbacks, uint32_t loadSections)
+{
+#ifdef SMBX38A_PARALLEL_READ
+    const unsigned int threads = smbx38aAheadThreads(in);
+    if(threads > 1)
+    {
+        in.seek(0, PGE_FileFormats_misc::TextFileInput::begin);
+        PGESTRING data = in.readAll();
+        PGE_FileFormats_misc::RawTextInput dataIn(&data, in.getFilePath());
+
+        // Decode independent lines ahead, they get taken in the file order by the reader
+        Smbx38aLvlBatch batch(smbx38aLvlRecordType, smbx38aLvlDecodeAhead, LVL38A_REC_COUNT);
+        const Smbx38aLvlRecord independent[] =
+        {
+            LVL38A_REC_BLOCK, LVL38A_REC_BGO, LVL38A_REC_NPC,
+            LVL38A_REC_PHYSENV, LVL38A_REC_DOOR, LVL38A_REC_LAYER
+        };
+
+        for(Smbx38aLvlRecord type : independent)
+        {
+            if(loadSections & c_smbx38aLvlRecordParts[type])
+                batch.setAhead(type);
+        }
+
+        bool decodedAhead = batch.decode(data, threads);
+        return smbx38aReadLvlFile(dataIn, FileData, callbacks, loadSections, decodedAhead ? &batch : nullptr);
+    }
+#endif
+
+    return smbx38aReadLvlFile(in, FileData, callbacks, loadSections, nullptr);
+}
+
 
 //*********************************************************
 //****************WRITE FILE FORMAT************************
@@ -1453,7 +1808,10 @@ bool FileFormats::WriteSMBX38ALvlFileF(const PGESTRING &filePath, LevelData &Fil
         return false;
     }
 
-    return WriteSMBX38ALvlFile(file, FileData, format_version);
+    if(!WriteSMBX38ALvlFile(file, FileData, format_version))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, FileData.meta.ERROR_info);
 }
 
 bool FileFormats::WriteSMBX38ALvlFileRaw(LevelData &FileData, PGESTRING &rawdata, unsigned int format_version)
@@ -1477,7 +1835,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
     FileData.meta.RecentFormatVersion = format_version;
     //Count placed stars on this level
     FileData.stars = smbx64CountStars(FileData);
-#define layerNotDef(lr) ( ((lr) != "Default") ? PGE_URLENC(lr) : "" )
+#define layerNotDef(lr) PGEUrlEncodedLayer(lr)
     //========================================================
     //Data type markers:
     //A         - Level header settings
@@ -1506,12 +1864,12 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
     //    param1=the number of stars on this level
     out << "|" << fromNum(FileData.stars);
     //    param2=level title
-    out << "|" << PGE_URLENC(FileData.LevelName);
+    out << "|" << PGEUrlEncoded(FileData.LevelName);
 
     if(!IsEmpty(FileData.open_level_on_fail))
     {
         //    param3=a filename, when player died, the player will be sent to this level.
-        out << "|" << PGE_URLENC(FileData.open_level_on_fail);
+        out << "|" << PGEUrlEncoded(FileData.open_level_on_fail);
         //    param4=normal entrance / to warp [0-WARPMAX]
         out << "|" << fromNum(FileData.open_level_on_fail_warpID);
     }
@@ -1543,7 +1901,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         {
             if(it > 0)
                 out << ",";
-            out << PGE_URLENC(s[it]);
+            out << PGEUrlEncoded(s[it]);
         }
     }
 
@@ -1557,7 +1915,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
 
         out << "BTNS";
         for(int i = 0; i < 5; ++i)
-            out << "|" << PGE_URLENC(plr[i]);
+            out << "|" << PGEUrlEncoded(plr[i]);
     }
 
     //next line: player start points
@@ -1627,7 +1985,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
             out << "," << fromNum(sct.lighting_value);
 
         //    musicfile=custom music file[***urlencode!***]
-        out << "|" << PGE_URLENC(sct.music_file);
+        out << "|" << PGEUrlEncoded(sct.music_file);
         out << "\n";
     }
 
@@ -1643,7 +2001,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //  only if name != ""
         //  name=block's name
         if(format_version >= 67 && !IsEmpty(blk.gfx_name))
-            out << "," << PGE_URLENC(blk.gfx_name);
+            out << "," << PGEUrlEncoded(blk.gfx_name);
 
         //    id=block id
         out << "|" << fromNum(blk.id);
@@ -1691,14 +2049,14 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
             !IsEmpty(blk.event_on_screen)
         )
         {
-            out << PGE_URLENC(blk.event_destroy);
+            out << PGEUrlEncoded(blk.event_destroy);
             //    e2=block hit event name[***urlencode!***]
-            out << "," << PGE_URLENC(blk.event_hit);
+            out << "," << PGEUrlEncoded(blk.event_hit);
             //    e3=no more object in layer event name[***urlencode!***]4
-            out << "," << PGE_URLENC(blk.event_emptylayer);
+            out << "," << PGEUrlEncoded(blk.event_emptylayer);
 
             if(format_version >= 68) // e4=block onscreen event name[***urlencode!***]
-                out << "," << PGE_URLENC(blk.event_on_screen);
+                out << "," << PGEUrlEncoded(blk.event_on_screen);
         }
 
         //    w=width
@@ -1834,7 +2192,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //only if name != ""
         //name=npc's name
         if(format_version >= 67 && !IsEmpty(npc.gfx_name))
-            out << "," << PGE_URLENC(npc.gfx_name);
+            out << "," << PGEUrlEncoded(npc.gfx_name);
 
         //    id=npc id
         out << "|" << fromNum(npcID);
@@ -1884,25 +2242,25 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         {
             //        [***urlencode!***]
             //        e1=death event
-            out << PGE_URLENC(npc.event_die);
+            out << PGEUrlEncoded(npc.event_die);
             //        e2=talk event
-            out << "," << PGE_URLENC(npc.event_talk);
+            out << "," << PGEUrlEncoded(npc.event_talk);
             //        e3=activate event
-            out << "," << PGE_URLENC(npc.event_activate);
+            out << "," << PGEUrlEncoded(npc.event_activate);
             //        e4=no more object in layer event
-            out << "," << PGE_URLENC(npc.event_emptylayer);
+            out << "," << PGEUrlEncoded(npc.event_emptylayer);
             //        e5=grabed event
-            out << "," << PGE_URLENC(npc.event_grab);
+            out << "," << PGEUrlEncoded(npc.event_grab);
             //        e6=next frame event
-            out << "," << PGE_URLENC(npc.event_nextframe);
+            out << "," << PGEUrlEncoded(npc.event_nextframe);
             //        e7=touch event
-            out << "," << PGE_URLENC(npc.event_touch);
+            out << "," << PGEUrlEncoded(npc.event_touch);
         }
 
         //        a1=layer name to attach
-        out << "|" << PGE_URLENC(npc.attach_layer);
+        out << "|" << PGEUrlEncoded(npc.attach_layer);
         //        a2=variable name to send
-        out << "," << PGE_URLENC(npc.send_id_to_variable);
+        out << "," << PGEUrlEncoded(npc.send_id_to_variable);
         //    c1=generator enable
         out << "|" << fromNum((int)npc.generator);
 
@@ -1932,7 +2290,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         }
 
         //    msg=message by this npc talkative[***urlencode!***]
-        out << "|" << PGE_URLENC(npc.msg);
+        out << "|" << PGEUrlEncoded(npc.msg);
 
         if(format_version >= 69)
         {
@@ -2018,7 +2376,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //    sn=need stars for enter
         out << "|" << fromNum(door.stars);
         //    msg=a message when you have not enough stars
-        out << "," << PGE_URLENC(door.stars_msg);
+        out << "," << PGEUrlEncoded(door.stars_msg);
         //    hide=hide the star number in this warp
         out << "," << fromNum((int)door.star_num_hide);
         //    locked=locked
@@ -2050,7 +2408,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         }
 
         //    lik=warp to level[***urlencode!***]
-        out << "|" << PGE_URLENC(door.lname);
+        out << "|" << PGEUrlEncoded(door.lname);
         //    liid=normal enterance / to warp[0-WARPMAX]
         out << "|" << fromNum(door.warpto);
         //    noexit=level entrance
@@ -2062,7 +2420,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //    le=level exit
         out << "|" << fromNum((int)door.lvl_o);
         //    we=warp event[***urlencode!***]
-        out << "|" << PGE_URLENC(door.event_enter);
+        out << "|" << PGEUrlEncoded(door.event_enter);
         out << "\n";
     }
 
@@ -2129,7 +2487,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //    b5=Maximum Velocity
         out << "," << fromNum(pez.max_velocity);
         //    event=touch event
-        out << "|" << PGE_URLENC(pez.touch_event);
+        out << "|" << PGEUrlEncoded(pez.touch_event);
         out << "\n";
     }
 
@@ -2140,7 +2498,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //    L|name|status
         out << "L";
         //    name=layer name[***urlencode!***]
-        out << "|" << PGE_URLENC(lyr.name);
+        out << "|" << PGEUrlEncoded(lyr.name);
         //    status=is vizible layer
         out << "|" << fromNum((int)(!lyr.hidden));
         out << "\n";
@@ -2154,14 +2512,14 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //    E|name|msg|ea|el|elm|epy|eps|eef|ecn|evc|ene
         out << "E";
         //    name=event name[***urlencode!***]
-        out << "|" << PGE_URLENC(evt.name);
+        out << "|" << PGEUrlEncoded(evt.name);
         //    msg=show message after start event[***urlencode!***]
-        out << "|" << PGE_URLENC(evt.msg);
+        out << "|" << PGEUrlEncoded(evt.msg);
         //    ea=val,syntax
         //        val=[0=not auto start][1=auto start when level start][2=auto start when match all condition][3=start when called and match all condidtion]
         out << "|" << fromNum(evt.autostart);
         //        syntax=condidtion expression[***urlencode!***]
-        out << "," << PGE_URLENC(evt.autostart_condition);
+        out << "," << PGEUrlEncoded(evt.autostart_condition);
         //    el=b/s1,s2...sn/h1,h2...hn/t1,t2...tn
         //        b=no smoke[0=false !0=true]
         out << "|" << fromNum((int)evt.nosmoke);
@@ -2174,7 +2532,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
             if(j > 0)
                 out << ",";
 
-            out << PGE_URLENC(evt.layers_show[j]);
+            out << PGEUrlEncoded(evt.layers_show[j]);
         }
 
         out << "/";
@@ -2185,7 +2543,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
             if(j > 0)
                 out << ",";
 
-            out << PGE_URLENC(evt.layers_hide[j]);
+            out << PGEUrlEncoded(evt.layers_hide[j]);
         }
 
         out << "/";
@@ -2196,7 +2554,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
             if(j > 0)
                 out << ",";
 
-            out << PGE_URLENC(evt.layers_toggle[j]);
+            out << PGEUrlEncoded(evt.layers_toggle[j]);
         }
 
         out << "|";
@@ -2215,7 +2573,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
             PGESTRING expression_y = mvl.expression_y;
             SMBX38A_Num2Exp_URLEN(mvl.speed_x, expression_x);
             SMBX38A_Num2Exp_URLEN(mvl.speed_y, expression_y);
-            out << PGE_URLENC(mvl.name);
+            out << PGEUrlEncoded(mvl.name);
             //        horizontal syntax,vertical syntax[***urlencode!***][syntax]
             out << "," << expression_x;
             out << "," << expression_y;
@@ -2434,7 +2792,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
             //                musicid=[when mtype=2]custom music id
             out << "," << fromNum(set.music_id >= 0 ? set.music_id : 0);
             //                customfile=[when mtype=3]custom music file name[***urlencode!***]
-            out << "," << PGE_URLENC(set.music_file);
+            out << "," << PGEUrlEncoded(set.music_file);
         }
 
         out << "|";
@@ -2518,9 +2876,9 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
                 out << "/";
 
             //        vc(n)=name,newvalue
-            out        << PGE_URLENC(uvar.name);
+            out        << PGEUrlEncoded(uvar.name);
             //            name=variable name[***urlencode!***]
-            out << "," << PGE_URLENC(uvar.newval);
+            out << "," << PGEUrlEncoded(uvar.newval);
             //            newvalue=new value[***urlencode!***][syntax]
         }
 
@@ -2528,7 +2886,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //    ene=nextevent/timer/apievent/scriptname
         //        nextevent=name,delay
         //            name=trigger event name[***urlencode!***]
-        out        << PGE_URLENC(evt.trigger);
+        out        << PGEUrlEncoded(evt.trigger);
         //            delay=trigger delay[1 frame]
         SMBX38A_RestoreOrigTime(evt.trigger_timer_orig, evt.trigger_timer, PGE_FileLibrary::TimeUnit::Decisecond);
         out << "," << fromNum(evt.trigger_timer_orig);
@@ -2548,7 +2906,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //        apievent=the id of apievent
         out << "/" << fromNum(evt.trigger_api_id);
         //        scriptname=script name[***urlencode!***]
-        out << "/" << PGE_URLENC(evt.trigger_script);
+        out << "/" << PGEUrlEncoded(evt.trigger_script);
         out << "\n";
     }
 
@@ -2558,7 +2916,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         //    V|name|value
         out << "V";
         //    name=variable name[***urlencode!***]
-        out << "|" << PGE_URLENC(var.name);
+        out << "|" << PGEUrlEncoded(var.name);
 
         //    value=initial value of the variable
         if(!SMBX64::IsSInt(var.value))//if is not signed integer, set value as zero
@@ -2577,7 +2935,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         out << "R";
 
         for(LevelArray &arr : FileData.arrays)
-            out << "|" << PGE_URLENC(arr.name);
+            out << "|" << PGEUrlEncoded(arr.name);
 
         out << "\n";
     }
@@ -2589,7 +2947,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         out << "S";
         //    Su|name|scriptu
         //    name=name of script[***urlencode!***]
-        out << "|" << PGE_URLENC(script.name);
+        out << "|" << PGEUrlEncoded(script.name);
         //    script=script[***base64encode!***][utf-8]
         PGESTRING scriptT = script.script;
 
@@ -2662,7 +3020,7 @@ bool FileFormats::WriteSMBX38ALvlFile(PGE_FileFormats_misc::TextOutput &out, Lev
         out << "CW";
 
         for(const LevelData::MusicOverrider &mo : FileData.sound_overrides)
-            out << "|" << fromNum(mo.id) << "," << PGE_URLENC(mo.fileName);
+            out << "|" << fromNum(mo.id) << "," << PGEUrlEncoded(mo.fileName);
 
         out << "\n";
     }
@@ -28,6 +28,7 @@
 #include "file_formats.h"
 
 #include "smbx38a_private.h"
+#include "smbx38a_parallel.h"
 
 
 //*********************************************************
@@ -81,10 +82,11 @@ bool FileFormats::ReadSMBX38AWldFileHeaderT(PGE_FileFormats_misc::TextInput &inf
 
     inf.seek(0, PGE_FileFormats_misc::TextFileInput::begin);
 
+    CSVPGEReader readerBridge(&inf);
+    auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
+
     try
     {
-        CSVPGEReader readerBridge(&inf);
-        auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
         PGESTRING fileIndentifier = dataReader.ReadField<PGESTRING>(1);
         dataReader.ReadDataLine();
 
@@ -103,7 +105,7 @@ bool FileFormats::ReadSMBX38AWldFileHeaderT(PGE_FileFormats_misc::TextInput &inf
             if(identifier == "WS1")
             {
                 // ws1|wn|bp1,bp2,bp3,bp4,bp5|asn,gvn|dtp,nwm,rsd,dcp,sc,sm,asg,smb3,dss|sn,mis|acm|sc
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(), // Skip the first field (this is already "identifier")
                     //  wn=episode name[***urlencode!***]
                     MakeCSVPostProcessor(&FileData.EpisodeTitle, PGEUrlDecodeFunc),
@@ -155,14 +157,15 @@ bool FileFormats::ReadSMBX38AWldFileHeaderT(PGE_FileFormats_misc::TextInput &inf
                     &FileData.cheatsPolicy,
                     //  sc=enable save locker[0=false !0=true]
                     &FileData.saveLocker
-                );
+                ))
+                    goto badfile;
 
                 FileData.charactersFromS64();
             }
             else if(identifier == "WS2")
             {
                 // ws2|credits|creditsmusic
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //  credits=[1]
                     //  #DEFT#xxxxxx[***base64encode!***]
@@ -195,12 +198,13 @@ bool FileFormats::ReadSMBX38AWldFileHeaderT(PGE_FileFormats_misc::TextInput &inf
                         }
                     }),
                     MakeCSVOptionalEmpty(&FileData.authors_music, "", nullptr, PGEUrlDecodeFunc)
-                );
+                ))
+                    goto badfile;
             }
             else if(identifier == "WS3")
             {
                 PGESTRING cheatsList;
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //  list=xxxxxx[***base64encode!***] (list of forbidden)
                     //          xxxxxx=string1,string2...stringn
@@ -209,17 +213,19 @@ bool FileFormats::ReadSMBX38AWldFileHeaderT(PGE_FileFormats_misc::TextInput &inf
                         PGESTRING list = PGE_URLDEC(value);
                         PGE_SPLITSTRING(FileData.cheatsList, list, ",");
                     })
-                );
+                ))
+                    goto badfile;
             }
             else if(identifier == "WS4")
             {
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //    se=save locker syntax[***urlencode!***][syntax]
                     MakeCSVPostProcessor(&FileData.saveLockerEx, PGEUrlDecodeFunc),
                     //    msg=message when save was locked[***urlencode!***]
                     MakeCSVPostProcessor(&FileData.saveLockerMsg, PGEUrlDecodeFunc)
-                );
+                ))
+                    goto badfile;
             }
             else
             {
@@ -241,6 +247,14 @@ bool FileFormats::ReadSMBX38AWldFileHeaderT(PGE_FileFormats_misc::TextInput &inf
     FileData.CurSection = 0;
     FileData.playmusic = 0;
     return true;
+
+badfile:
+    FileData.meta.ReadFileValid = false;
+    FileData.meta.ERROR_info = "Invalid file format, detected file SMBX-38A-" + fromNum(FileData.meta.RecentFormatVersion) + " format\n"
+                               "Caused by: \n" + toPgeString(dataReader.Status().pretty_string());
+    FileData.meta.ERROR_linenum = inf.getCurrentLineNumber();
+    FileData.meta.ERROR_linedata.clear();
+    return false;
 #else
     FileData.meta.ReadFileValid = false;
     FileData.meta.ERROR_info = "Unsupported on MSVC2013 or lower";
@@ -282,16 +296,205 @@ bool FileFormats::ReadSMBX38AWldFileRaw(PGESTRING& rawdata, const PGESTRING &fil
     return ReadSMBX38AWldFile(file, FileData);
 }
 
-bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldData& FileData)
+/*!
+ * \brief Types of SMBX-38A world data lines
+ */
+enum Smbx38aWldRecord
+{
+    WLD38A_REC_UNKNOWN = 0,     //!< Unsupported line
+    WLD38A_REC_HEADER1,         //!< WS1
+    WLD38A_REC_HEADER2,         //!< WS2
+    WLD38A_REC_HEADER3,         //!< WS3
+    WLD38A_REC_HEADER4,         //!< WS4
+    WLD38A_REC_TILE,            //!< T
+    WLD38A_REC_SCENERY,         //!< S
+    WLD38A_REC_PATH,            //!< P
+    WLD38A_REC_MUSICBOX,        //!< M
+    WLD38A_REC_LEVEL,           //!< L
+    WLD38A_REC_LAYER,           //!< WL
+    WLD38A_REC_EVENT,           //!< WE
+    WLD38A_REC_CUSTOM_TILE,     //!< WCT
+    WLD38A_REC_CUSTOM_SCENERY,  //!< WCS
+    WLD38A_REC_CUSTOM_LEVEL,    //!< WCL
+    WLD38A_REC_COUNT
+};
+
+/*!
+ * \brief Parts of FileFormats::LoadSections which the data line of each type belongs to
+ */
+static const uint32_t c_smbx38aWldRecordParts[WLD38A_REC_COUNT] =
+{
+    FileFormats::LOAD_HEADER,       // Unsupported lines
+    FileFormats::LOAD_HEADER,       // WS1
+    FileFormats::LOAD_HEADER,       // WS2
+    FileFormats::LOAD_HEADER,       // WS3
+    FileFormats::LOAD_HEADER,       // WS4
+    FileFormats::LOAD_TILES,        // T
+    FileFormats::LOAD_SCENERY,      // S
+    FileFormats::LOAD_PATHS,        // P
+    FileFormats::LOAD_MUSICBOXES | FileFormats::LOAD_AREARECTS, // M, produces both music boxes and area rectangles
+    FileFormats::LOAD_LEVELS,       // L
+    FileFormats::LOAD_LAYERS,       // WL
+    FileFormats::LOAD_EVENTS,       // WE
+    FileFormats::LOAD_CUSTOM38A,    // WCT
+    FileFormats::LOAD_CUSTOM38A,    // WCS
+    FileFormats::LOAD_CUSTOM38A     // WCL
+};
+
+/*!
+ * \brief Detects type of the data line by the length and the characters of the identifier
+ * \param identifier Type of the data line
+ * \return Type of the record, WLD38A_REC_UNKNOWN for unsupported lines
+ */
+static Smbx38aWldRecord smbx38aWldRecordType(const PGESTRING &identifier)
+{
+    switch(identifier.size())
+    {
+    case 1:
+        switch(PGEGetChar(identifier[0]))
+        {
+        case 'T':
+            return WLD38A_REC_TILE;
+        case 'S':
+            return WLD38A_REC_SCENERY;
+        case 'P':
+            return WLD38A_REC_PATH;
+        case 'L':
+            return WLD38A_REC_LEVEL;
+        case 'M':
+            return WLD38A_REC_MUSICBOX;
+        default:
+            break;
+        }
+        break;
+
+    case 2:
+        if(PGEGetChar(identifier[0]) != 'W')
+            break;
+        switch(PGEGetChar(identifier[1]))
+        {
+        case 'L':
+            return WLD38A_REC_LAYER;
+        case 'E':
+            return WLD38A_REC_EVENT;
+        default:
+            break;
+        }
+        break;
+
+    case 3:
+    {
+        if(PGEGetChar(identifier[0]) != 'W')
+            break;
+        const char second = PGEGetChar(identifier[1]);
+        const char third = PGEGetChar(identifier[2]);
+        if(second == 'S')
+        {
+            switch(third)
+            {
+            case '1':
+                return WLD38A_REC_HEADER1;
+            case '2':
+                return WLD38A_REC_HEADER2;
+            case '3':
+                return WLD38A_REC_HEADER3;
+            case '4':
+                return WLD38A_REC_HEADER4;
+            default:
+                break;
+            }
+        }
+        else if(second == 'C')
+        {
+            switch(third)
+            {
+            case 'T':
+                return WLD38A_REC_CUSTOM_TILE;
+            case 'S':
+                return WLD38A_REC_CUSTOM_SCENERY;
+            case 'L':
+                return WLD38A_REC_CUSTOM_LEVEL;
+            default:
+                break;
+            }
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return WLD38A_REC_UNKNOWN;
+}
+
+#ifdef SMBX38A_PARALLEL_READ
+typedef SMBX38A_LineBatch<WorldData, Smbx38aWldRecord> Smbx38aWldBatch;
+#else
+struct Smbx38aWldBatch; //!< Lines are never decoded ahead
+#endif
+
+static bool smbx38aReadWldFile(PGE_FileFormats_misc::TextInput &in, WorldData &FileData,
+                               uint32_t loadSections, Smbx38aWldBatch *ahead);
+
+#ifdef SMBX38A_PARALLEL_READ
+/*!
+ * \brief Reads the chunk of lines on the worker thread
+ * \param in Header line and lines of the chunk
+ * \param fragment Data which receives read objects
+ * \return true if all lines successfully read
+ */
+static bool smbx38aWldDecodeAhead(PGE_FileFormats_misc::TextInput &in, WorldData &fragment)
+{
+    return smbx38aReadWldFile(in, fragment, FileFormats::LOAD_ALL, nullptr);
+}
+
+/*!
+ * \brief Stores the object decoded ahead the same way as the reader stores the object read from the line
+ * \param fragment Fragment which contains the object
+ * \param type Type of the line
+ * \param index Index of the object at the fragment's list
+ * \param FileData World data structure
+ */
+static void smbx38aWldTakeAhead(WorldData &fragment, Smbx38aWldRecord type, size_t index, WorldData &FileData)
+{
+    const pge_size_t i = static_cast<pge_size_t>(index);
+
+    switch(type)
+    {
+    case WLD38A_REC_TILE:
+        fragment.tiles[i].meta.array_id = FileData.tile_array_id++;
+        FileData.tiles.push_back(std::move(fragment.tiles[i]));
+        break;
+    case WLD38A_REC_SCENERY:
+        fragment.scenery[i].meta.array_id = FileData.scene_array_id++;
+        FileData.scenery.push_back(std::move(fragment.scenery[i]));
+        break;
+    case WLD38A_REC_PATH:
+        fragment.paths[i].meta.array_id = FileData.path_array_id++;
+        FileData.paths.push_back(std::move(fragment.paths[i]));
+        break;
+    case WLD38A_REC_LEVEL:
+        fragment.levels[i].meta.array_id = FileData.level_array_id++;
+        FileData.levels.push_back(std::move(fragment.levels[i]));
+        break;
+    default:
+        break;
+    }
+}
+#endif
+
+static bool smbx38aReadWldFile(PGE_FileFormats_misc::TextInput &in, WorldData &FileData,
+                               uint32_t loadSections, Smbx38aWldBatch *ahead)
 {
     SMBX38A_FileBeginN();
     PGESTRING filePath = in.getFilePath();
     FileData.meta.ERROR_info.clear();
 
-    CreateWorldData(FileData);
+    FileFormats::CreateWorldData(FileData);
 
     FileData.meta.RecentFormat = WorldData::SMBX38A;
-    FileData.meta.RecentFormatVersion = c_latest_version_smbx38a;
+    FileData.meta.RecentFormatVersion = FileFormats::c_latest_version_smbx38a;
 
 #if !defined(_MSC_VER) || _MSC_VER > 1800
     FileData.EpisodeTitle.clear();
@@ -323,6 +526,7 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
     WorldItemSetup38A   customcfg;
 
     PGESTRING           identifier;
+    Smbx38aWldRecord    recordType = WLD38A_REC_UNKNOWN;
 
     //Add path data
     if(!IsEmpty(filePath))
@@ -334,10 +538,11 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
 
     in.seek(0, PGE_FileFormats_misc::TextFileInput::begin);
 
+    CSVPGEReader readerBridge(&in);
+    auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
+
     try
     {
-        CSVPGEReader readerBridge(&in);
-        auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
         PGESTRING fileIndentifier = dataReader.ReadField<PGESTRING>(1);
         dataReader.ReadDataLine();
 
@@ -346,16 +551,41 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
 
         FileData.meta.RecentFormatVersion = toUInt(PGE_SubStr(fileIndentifier, 8, -1));
 
-        if(FileData.meta.RecentFormatVersion > c_latest_version_smbx38a)
+        if(FileData.meta.RecentFormatVersion > FileFormats::c_latest_version_smbx38a)
             throw std::logic_error("File format has newer version which is not supported yet");
 
         while(!in.eof())
         {
             identifier = dataReader.ReadField<PGESTRING>(1);
+            recordType = smbx38aWldRecordType(identifier);
 
-            if(identifier == "WS1")
+            if(!(loadSections & c_smbx38aWldRecordParts[recordType]))
+            {
+                dataReader.SkipDataLine();
+                continue;
+            }
+
+#ifdef SMBX38A_PARALLEL_READ
+            if(ahead && ahead->isAhead(recordType))
+            {
+                size_t index = 0;
+                WorldData *fragment = ahead->take(in.getCurrentLineNumber(), recordType, index);
+                if(fragment)
+                {
+                    dataReader.SkipDataLine();
+                    smbx38aWldTakeAhead(*fragment, recordType, index, FileData);
+                    continue;
+                }
+            }
+#else
+            (void)ahead;
+#endif
+
+            switch(recordType)
             {
-                dataReader.ReadDataLine(
+            case WLD38A_REC_HEADER1:
+            {
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(), // Skip the first field (this is already "identifier")
                     //  wn=episode name[***urlencode!***]
                     MakeCSVPostProcessor(&FileData.EpisodeTitle, PGEUrlDecodeFunc),
@@ -407,13 +637,15 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                     &FileData.cheatsPolicy,
                     //  sc=enable save locker[0=false !0=true]
                     &FileData.saveLocker
-                );
+                ))
+                    goto badfile;
 
                 FileData.charactersFromS64();
+                break;
             }
-            else if(identifier == "WS2")
+            case WLD38A_REC_HEADER2:
             {
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //  credits=[1]
                     //  #DEFT#xxxxxx[***base64encode!***]
@@ -429,13 +661,15 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                         value = PGE_BASE64DEC(value);
                     }),
                     MakeCSVOptionalEmpty(&FileData.authors_music, "", nullptr, PGEUrlDecodeFunc)
-                );
+                ))
+                    goto badfile;
+                break;
             }
-            else if(identifier == "WS3")
+            case WLD38A_REC_HEADER3:
             {
                 PGESTRING cheatsList;
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //  list=xxxxxx[***base64encode!***] (list of forbidden)
                     //          xxxxxx=string1,string2...stringn
@@ -444,23 +678,27 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                         PGESTRING list = PGE_URLDEC(value);
                         PGE_SPLITSTRING(FileData.cheatsList, list, ",");
                     })
-                );
+                ))
+                    goto badfile;
+                break;
             }
-            else if(identifier == "WS4")
+            case WLD38A_REC_HEADER4:
             {
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //    se=save locker syntax[***urlencode!***][syntax]
                     MakeCSVPostProcessor(&FileData.saveLockerEx, PGEUrlDecodeFunc),
                     //    msg=message when save was locked[***urlencode!***]
                     MakeCSVPostProcessor(&FileData.saveLockerMsg, PGEUrlDecodeFunc)
-                );
+                ))
+                    goto badfile;
+                break;
             }
-            else if(identifier == "T")
+            case WLD38A_REC_TILE:
             {
                 tile = WorldTerrainTile();
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVSubReader(
                         dataReader, ',',
@@ -471,16 +709,18 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                     &tile.x,
                     &tile.y,
                     MakeCSVOptional(&tile.layer, "Default", nullptr, PGELayerOrDefault)
-                );
+                ))
+                    goto badfile;
 
                 tile.meta.array_id = FileData.tile_array_id++;
                 FileData.tiles.push_back(tile);
+                break;
             }
-            else if(identifier == "S")
+            case WLD38A_REC_SCENERY:
             {
                 scen = WorldScenery();
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVSubReader(
                         dataReader, ',',
@@ -491,16 +731,18 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                     &scen.x,
                     &scen.y,
                     MakeCSVOptional(&tile.layer, "Default", nullptr, PGELayerOrDefault)
-                );
+                ))
+                    goto badfile;
 
                 scen.meta.array_id = FileData.scene_array_id++;
                 FileData.scenery.push_back(scen);
+                break;
             }
-            else if(identifier == "P")
+            case WLD38A_REC_PATH:
             {
                 pathitem = WorldPathTile();
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVSubReader(
                         dataReader, ',',
@@ -511,12 +753,14 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                     &pathitem.x,
                     &pathitem.y,
                     MakeCSVOptional(&tile.layer, "Default", nullptr, PGELayerOrDefault)
-                );
+                ))
+                    goto badfile;
 
                 pathitem.meta.array_id = FileData.path_array_id++;
                 FileData.paths.push_back(pathitem);
+                break;
             }
-            else if(identifier == "M")
+            case WLD38A_REC_MUSICBOX:
             {
                 musicbox = WorldMusicBox();
                 arearect = WorldAreaRect();
@@ -525,7 +769,7 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                 //M|10|416|1312|    |     |32|32|1   |,0
                 //M|1 |384|384 |    |     |32|32|1   |%66%61%72%74,1
                 //M|id|x  |y   |name|layer|w |h |flag|te,eflag      |ie1,ie2,ie3
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //id=music id
                     &arearect.music_id,
@@ -567,7 +811,8 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                         //ie3=Anchor Event[***urlencode!***]
                         MakeCSVOptional(&arearect.eventAnchor, "", nullptr, PGELayerOrDefault)
                     )
-                );
+                ))
+                    goto badfile;
 
                 if((arearect.flags == WorldAreaRect::SETUP_CHANGE_MUSIC) &&
                    (arearect.w == 32) && (arearect.h == 32))
@@ -587,8 +832,9 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                     arearect.meta.array_id = FileData.arearect_array_id++;
                     FileData.arearects.push_back(arearect);
                 }
+                break;
             }
-            else if(identifier == "L")
+            case WLD38A_REC_LEVEL:
             {
                 //L|id[,dx,dy]|x|y|fn|n|eu\el\ed\er|wx|wy|wlz|bg,pb,av,ls,f,nsc,otl,li,lcm|s|Layer|Lmt
                 lvlitem = WorldLevelTile();
@@ -597,7 +843,7 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                 lvlitem.right_exit_extra.exit_codes = {0, 0};
                 lvlitem.bottom_exit_extra.exit_codes = {0, 0};
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(), //-V681
                     MakeCSVSubReader(
                         dataReader, ',',
@@ -733,25 +979,29 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                             lvlitem.movement.paths.push_back(line);
                         })
                     )
-                );
+                ))
+                    goto badfile;
 
                 lvlitem.meta.array_id = FileData.level_array_id++;
                 FileData.levels.push_back(lvlitem);
+                break;
             }
-            else if(identifier == "WL")
+            case WLD38A_REC_LAYER:
             {
                 layer = WorldLayer();
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     MakeCSVPostProcessor(&layer.name, PGELayerOrDefault),
                     &layer.hidden
-                );
+                ))
+                    goto badfile;
 
                 layer.meta.array_id = FileData.layers_array_id++;
                 FileData.layers.push_back(layer);
+                break;
             }
-            else if(identifier == "WE")
+            case WLD38A_REC_EVENT:
             {
                 int way = 0;
                 int autostrat;
@@ -760,7 +1010,7 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                 //TODO: Implement world map events support
                 //next line: events
                 //    WE|name|layer|layerm|world|other
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     //    name=event name[***urlencode!***]
                     MakeCSVPostProcessor(&event.name, PGEUrlDecodeFunc),
@@ -879,11 +1129,15 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                             &event.level_anchor_id
                         )
                     )
-                );
+                ))
+                    goto badfile;
                 event.meta.array_id = FileData.events38A_array_id++;
                 FileData.events38A.push_back(event);
+                break;
             }
-            else if((identifier == "WCT") || (identifier == "WCS") || (identifier == "WCL") )
+            case WLD38A_REC_CUSTOM_TILE:
+            case WLD38A_REC_CUSTOM_SCENERY:
+            case WLD38A_REC_CUSTOM_LEVEL:
             {
                 //custom object data:
                 //    WCT|id|data	:custom tile
@@ -895,14 +1149,14 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                 //    [HEX]=0002	:gfxheight
                 //    [HEX]=0003	:frames
                 customcfg = WorldItemSetup38A();
-                if(identifier == "WCT")
+                if(recordType == WLD38A_REC_CUSTOM_TILE)
                     customcfg.type = WorldItemSetup38A::TERRAIN;
-                else if(identifier == "WCS")
+                else if(recordType == WLD38A_REC_CUSTOM_SCENERY)
                     customcfg.type = WorldItemSetup38A::SCENERY;
                 else
                     customcfg.type = WorldItemSetup38A::LEVEL;
 
-                dataReader.ReadDataLine(
+                if(!dataReader.TryReadDataLine(
                     CSVDiscard(),
                     &customcfg.id,
                     MakeCSVIterator(
@@ -914,15 +1168,19 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
                             customcfg.data.push_back(e);
                         }
                     )
-                );
+                ))
+                    goto badfile;
                 FileData.custom38A_configs.push_back(customcfg);
+                break;
             }
-            else
+            default:
             {
                 // Unsupported line, just keep it
                 PGESTRING str;
                 dataReader.ReadRawLine(str);
                 FileData.unsupported_38a_lines.push_back(str);
+                break;
+            }
             }
         }//while is not EOF
     }
@@ -982,6 +1240,14 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
     FileData.playmusic = 0;
     FileData.meta.ReadFileValid = true;
     return true;
+
+badfile:
+    FileData.meta.ReadFileValid = false;
+    FileData.meta.ERROR_info = "Invalid file format, detected file SMBX-38A-" + fromNum(FileData.meta.RecentFormatVersion) + " format\n"
+                               "Caused by: \n" + toPgeString(dataReader.Status().pretty_string());
+    FileData.meta.ERROR_linenum = dataReader.Status().get_line_number();
+    FileData.meta.ERROR_linedata.clear();
+    return false;
 #else
     FileData.meta.ReadFileValid = false;
     FileData.meta.ERROR_info = "Unsupported on MSVC2013 or lower";
@@ -989,6 +1255,37 @@ bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput& in, WorldD
 #endif
 }
 
+bool FileFormats::ReadSMBX38AWldFile(PGE_FileFormats_misc::TextInput &in, WorldData &FileData, uint32_t loadSections)
+{
+#ifdef SMBX38A_PARALLEL_READ
+    const unsigned int threads = smbx38aAheadThreads(in);
+    if(threads > 1)
+    {
+        in.seek(0, PGE_FileFormats_misc::TextFileInput::begin);
+        PGESTRING data = in.readAll();
+        PGE_FileFormats_misc::RawTextInput dataIn(&data, in.getFilePath());
+
+        // Decode independent lines ahead, they get taken in the file order by the reader
+        Smbx38aWldBatch batch(smbx38aWldRecordType, smbx38aWldDecodeAhead, WLD38A_REC_COUNT);
+        const Smbx38aWldRecord independent[] =
+        {
+            WLD38A_REC_TILE, WLD38A_REC_SCENERY, WLD38A_REC_PATH, WLD38A_REC_LEVEL
+        };
+
+        for(Smbx38aWldRecord type : independent)
+        {
+            if(loadSections & c_smbx38aWldRecordParts[type])
+                batch.setAhead(type);
+        }
+
+        bool decodedAhead = batch.decode(data, threads);
+        return smbx38aReadWldFile(dataIn, FileData, loadSections, decodedAhead ? &batch : nullptr);
+    }
+#endif
+
+    return smbx38aReadWldFile(in, FileData, loadSections, nullptr);
+}
+
 
 
 //*********************************************************
@@ -1006,7 +1303,10 @@ bool FileFormats::WriteSMBX38AWldFileF(const PGESTRING &filePath, WorldData& Fil
         return false;
     }
 
-    return WriteSMBX38AWldFile(file, FileData, format_version);
+    if(!WriteSMBX38AWldFile(file, FileData, format_version))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, FileData.meta.ERROR_info);
 }
 
 bool FileFormats::WriteSMBX38AWldFileRaw(WorldData& FileData, PGESTRING& rawdata, unsigned int format_version)
@@ -1029,13 +1329,13 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
     FileData.meta.RecentFormat = WorldData::SMBX38A;
     FileData.meta.RecentFormatVersion = format_version;
 
-#define layerNotDef(lr) ( ((lr) != "Default") ? PGE_URLENC(lr) : "" )
+#define layerNotDef(lr) PGEUrlEncodedLayer(lr)
 
     out << "SMBXFile" << fromNum(FileData.meta.RecentFormatVersion) << "\n";
 
 
     out << "WS1";
-    out << "|" << PGE_URLENC(FileData.EpisodeTitle);
+    out << "|" << PGEUrlEncoded(FileData.EpisodeTitle);
     out << "|"
         << fromNum((int)FileData.nocharacter1)
         << ","
@@ -1047,9 +1347,9 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
         << ","
         << fromNum((int)FileData.nocharacter5);
 
-    out << "|" << PGE_URLENC(FileData.IntroLevel_file);
+    out << "|" << PGEUrlEncoded(FileData.IntroLevel_file);
     if(format_version >= 67)
-        out << "," << PGE_URLENC(FileData.GameOverLevel_file);
+        out << "," << PGEUrlEncoded(FileData.GameOverLevel_file);
 
     out << "|" << fromNum((int)FileData.restrictSinglePlayer)
         << "," << fromNum((int)FileData.HubStyledWorld)
@@ -1120,7 +1420,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
     }
 
     if(format_version >= 69)
-        out << "|" << PGE_URLENC(FileData.authors_music);
+        out << "|" << PGEUrlEncoded(FileData.authors_music);
 
     out << "\n";
 
@@ -1137,14 +1437,14 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
                 cheatsList += ",";
             cheatsList += cheat;
         }
-        out << PGE_URLENC(cheatsList);
+        out << PGEUrlEncoded(cheatsList);
     }
     out << "\n";
 
 
     out << "WS4"
-        << "|" << PGE_URLENC(FileData.saveLockerEx)
-        << "|" << PGE_URLENC(FileData.saveLockerMsg)
+        << "|" << PGEUrlEncoded(FileData.saveLockerEx)
+        << "|" << PGEUrlEncoded(FileData.saveLockerMsg)
         << "\n";
 
 
@@ -1214,7 +1514,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
         out << "|" << fromNum(mus.id);
         out << "|" << fromNum(mus.x);
         out << "|" << fromNum(mus.y);
-        out << "|" << PGE_URLENC(mus.music_file);
+        out << "|" << PGEUrlEncoded(mus.music_file);
         if(format_version >= 66)
         {
             out << "|" << layerNotDef(mus.layer);
@@ -1229,7 +1529,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
         out << "|" << fromNum(mus.music_id);
         out << "|" << fromNum(mus.x);
         out << "|" << fromNum(mus.y);
-        out << "|" << PGE_URLENC(mus.music_file);
+        out << "|" << PGEUrlEncoded(mus.music_file);
 
         if(format_version >= 66)
         {
@@ -1242,15 +1542,15 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
                 flags &= ~WorldAreaRect::SETUP_AUTO_WALKING;
 
             out << "|" << fromNum(flags);
-            out << "|" << PGE_URLENC(mus.eventTouch)
+            out << "|" << PGEUrlEncoded(mus.eventTouch)
                 << "," << fromNum(mus.eventTouchPolicy);
             if(!IsEmpty(mus.eventBreak) ||
                !IsEmpty(mus.eventWarp) ||
                !IsEmpty(mus.eventAnchor))
             {
-                out << "|" << PGE_URLENC(mus.eventBreak)
-                    << "," << PGE_URLENC(mus.eventWarp)
-                    << "," << PGE_URLENC(mus.eventAnchor);
+                out << "|" << PGEUrlEncoded(mus.eventBreak)
+                    << "," << PGEUrlEncoded(mus.eventWarp)
+                    << "," << PGEUrlEncoded(mus.eventAnchor);
             }
         }
         out << "\n";
@@ -1271,28 +1571,28 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
 
         out << "|" << fromNum(level.x);
         out << "|" << fromNum(level.y);
-        out << "|" << PGE_URLENC(level.lvlfile);
-        out << "|" << PGE_URLENC(level.title);
+        out << "|" << PGEUrlEncoded(level.lvlfile);
+        out << "|" << PGEUrlEncoded(level.title);
 
         out << "|" << fromNum(level.top_exit);
         out << "," << fromNum(level.top_exit_extra.exit_codes.size() > 0 ? level.top_exit_extra.exit_codes[0] : 0);
         out << "," << fromNum(level.top_exit_extra.exit_codes.size() > 1 ? level.top_exit_extra.exit_codes[1] : 0);
-        out << "," << PGE_URLENC(level.top_exit_extra.expression);
+        out << "," << PGEUrlEncoded(level.top_exit_extra.expression);
 
         out << "\\" << fromNum(level.left_exit);
         out << "," << fromNum(level.left_exit_extra.exit_codes.size() > 0 ? level.left_exit_extra.exit_codes[0] : 0);
         out << "," << fromNum(level.left_exit_extra.exit_codes.size() > 1 ? level.left_exit_extra.exit_codes[1] : 0);
-        out << "," << PGE_URLENC(level.left_exit_extra.expression);
+        out << "," << PGEUrlEncoded(level.left_exit_extra.expression);
 
         out << "\\" << fromNum(level.bottom_exit);
         out << "," << fromNum(level.bottom_exit_extra.exit_codes.size() > 0 ? level.bottom_exit_extra.exit_codes[0] : 0);
         out << "," << fromNum(level.bottom_exit_extra.exit_codes.size() > 1 ? level.bottom_exit_extra.exit_codes[1] : 0);
-        out << "," << PGE_URLENC(level.bottom_exit_extra.expression);
+        out << "," << PGEUrlEncoded(level.bottom_exit_extra.expression);
 
         out << "\\" << fromNum(level.right_exit);
         out << "," << fromNum(level.right_exit_extra.exit_codes.size() > 0 ? level.right_exit_extra.exit_codes[0] : 0);
         out << "," << fromNum(level.right_exit_extra.exit_codes.size() > 1 ? level.right_exit_extra.exit_codes[1] : 0);
-        out << "," << PGE_URLENC(level.right_exit_extra.expression);
+        out << "," << PGEUrlEncoded(level.right_exit_extra.expression);
 
         out << "|" << fromNum(level.gotox);
         out << "|" << fromNum(level.gotoy);
@@ -1318,7 +1618,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
             else
                 out << "/";
 
-            out << PGE_URLENC(cond.condition) << "," << PGE_URLENC(cond.levelIndex);
+            out << PGEUrlEncoded(cond.condition) << "," << PGEUrlEncoded(cond.levelIndex);
         }
 
         if(format_version >= 66)
@@ -1355,7 +1655,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
     for(auto &layer : FileData.layers)
     {
         out << "WL";
-        out << "|" << PGE_URLENC(layer.name);
+        out << "|" << PGEUrlEncoded(layer.name);
         out << "|" << fromNum((int)layer.hidden);
         out << "\n";
     }
@@ -1365,7 +1665,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
     for(auto &event : FileData.events38A)
     {
         out << "WE";
-        out << "|" << PGE_URLENC(event.name);
+        out << "|" << PGEUrlEncoded(event.name);
 
         int way = 0;
         way += event.nosmoke ? 1 : 0;
@@ -1383,7 +1683,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
             else
                 out << ",";
 
-            out << PGE_URLENC(layer);
+            out << PGEUrlEncoded(layer);
         }
 
         first = true;
@@ -1396,7 +1696,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
             else
                 out << ",";
 
-            out << PGE_URLENC(layer);
+            out << PGEUrlEncoded(layer);
         }
 
         first = true;
@@ -1409,7 +1709,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
             else
                 out << ",";
 
-            out << PGE_URLENC(layer);
+            out << PGEUrlEncoded(layer);
         }
 
         out << "|";
@@ -1430,7 +1730,7 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
             SMBX38A_Num2Exp_URLEN(mv.param_v, expression_pv);
             SMBX38A_Num2Exp_URLEN(mv.param_extra, expression_pe);
             out << fromNum(mv.type);
-            out << "," << PGE_URLENC(mv.layer);
+            out << "," << PGEUrlEncoded(mv.layer);
             out << "," << expression_ph;
             out << "," << expression_pv;
             out << "," << expression_pe;
@@ -1441,8 +1741,8 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
         out << "," << fromNum((int)event.is_level_enter_exit);
         out << "," << fromNum((int)event.interrupt_on_false);
         out << "," << fromNum((int)event.show_msg_on_interrupt);
-        out << "," << PGE_URLENC(event.autostart_condition);
-        out << "," << PGE_URLENC(event.interrupt_message);
+        out << "," << PGEUrlEncoded(event.autostart_condition);
+        out << "," << PGEUrlEncoded(event.interrupt_message);
 
         out << "|" << fromNum(event.sound_id);
         out << "/";
@@ -1451,10 +1751,10 @@ bool FileFormats::WriteSMBX38AWldFile(PGE_FileFormats_misc::TextOutput& out, Wor
         else
             out << fromNum(event.lock_keyboard_delay);
 
-        out << "/" << PGE_URLENC(event.trigger);
+        out << "/" << PGEUrlEncoded(event.trigger);
         out << "," << fromNum(event.trigger_timer);
-        out << "/" << PGE_URLENC(event.trigger_script);
-        out << "/" << PGE_URLENC(event.msg);
+        out << "/" << PGEUrlEncoded(event.trigger_script);
+        out << "/" << PGEUrlEncoded(event.msg);
         out << "/" << fromNum(event.move_to_x);
         out << "," << fromNum(event.move_to_y);
         out << "," << fromNum(event.level_anchor_id);
@@ -0,0 +1,292 @@
+/*
+ * PGE File Library - a library to process file formats, part of Moondust project
+ *
+ * Copyright (c) 2014-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file smbx38a_parallel.h
+ *
+ * \brief Contains helpers to decode independent lines of SMBX-38A data on worker threads
+ *
+ */
+
+#pragma once
+#ifndef SMBX38A_PARALLEL_H
+#define SMBX38A_PARALLEL_H
+
+#include "pge_file_lib_private.h"
+#include "pge_file_lib_threads.h"
+
+// Lines are split over the raw UTF-8 data of the STL build. Disabled by default:
+// the reader still walks all lines in the calling thread, see PGEFL_SMBX38A_READ_THREADS
+#if defined(PGEFL_ENABLE_THREADS) && defined(PGEFL_SMBX38A_READ_THREADS) && !defined(PGE_FILES_QT)
+#define SMBX38A_PARALLEL_READ
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/*!
+ * \brief Files smaller than this can't have enough lines for two chunks (lines are 16 bytes at least)
+ */
+static const int64_t c_smbx38aAheadMinSize = 128 * 1024;
+
+/*!
+ * \brief Number of threads to decode lines of the file ahead
+ * \param in Input of the whole file, its position is kept
+ * \return Number of threads, or 0 if the file must be read in the calling thread
+ *
+ * Decoding ahead only pays off on multi-core machines, and never for small files.
+ */
+inline unsigned int smbx38aAheadThreads(PGE_FileFormats_misc::TextInput &in)
+{
+    unsigned int threads = std::min(PGE_FileFormats_misc::g_smbx38aReadThreads, std::thread::hardware_concurrency());
+    if(threads < 2)
+        return 0;
+
+    const int64_t pos = in.tell();
+    if(in.seek(0, PGE_FileFormats_misc::TextInput::end) != 0)
+    {
+        in.seek(pos, PGE_FileFormats_misc::TextInput::begin);
+        return 0;
+    }
+
+    const int64_t size = in.tell();
+    in.seek(pos, PGE_FileFormats_misc::TextInput::begin);
+
+    return (size >= c_smbx38aAheadMinSize) ? threads : 0;
+}
+
+/*!
+ * \brief Lines of SMBX-38A data which don't depend on other lines and can be decoded ahead on worker threads
+ *
+ * Lines of such types are split into chunks, every chunk gets the header line of the file and
+ * is decoded by the usual reader into its own fragment of the data structure. Every line produces
+ * exactly one element of the fragment's list of its type. The reader of the whole file then takes
+ * decoded elements in the file order instead of decoding these lines again, and numbers them by
+ * array IDs the same way as when decoding them in order.
+ */
+template<class Data, class Record>
+class SMBX38A_LineBatch
+{
+public:
+    //! Detects type of the line by its identifier
+    typedef Record (*Classifier)(const PGESTRING &identifier);
+    //! Reads the chunk of lines into the fragment of data, returns false on error
+    typedef bool (*Decoder)(PGE_FileFormats_misc::TextInput &in, Data &fragment);
+
+    //! Maximal number of lines decoded by one job
+    static const size_t chunkLines = 4096;
+
+    /*!
+     * \brief Constructor
+     * \param classify Detector of line types
+     * \param decode Decoder of chunks
+     * \param typesCount Number of line types
+     */
+    SMBX38A_LineBatch(Classifier classify, Decoder decode, size_t typesCount) :
+        m_classify(classify),
+        m_decode(decode),
+        m_ahead(typesCount, false),
+        m_cursor(typesCount, 0)
+    {}
+
+    /*!
+     * \brief Marks lines of given type to be decoded ahead
+     * \param type Type of lines
+     */
+    void setAhead(Record type)
+    {
+        m_ahead[static_cast<size_t>(type)] = true;
+    }
+
+    /*!
+     * \brief Checks whether lines of given type are decoded ahead
+     * \param type Type of lines
+     * \return true if lines of this type are decoded ahead
+     */
+    bool isAhead(Record type) const
+    {
+        return m_ahead[static_cast<size_t>(type)];
+    }
+
+    /*!
+     * \brief Splits data into chunks and decodes them on worker threads
+     * \param data Whole file data, the same lines must be read after by the reader of the whole file
+     * \param threads Maximal number of threads
+     * \return true if there are lines decoded ahead, false if there are too few such lines or some chunk has failed
+     *
+     * A failed chunk is left for the reader of the whole file to report the error in order.
+     */
+    bool decode(const PGESTRING &data, unsigned int threads)
+    {
+        m_chunks.clear();
+        m_chunk = 0;
+        m_next = 0;
+
+        const char *begin = data.c_str();
+        const char *end = begin + data.size();
+        const char *headerEnd = reinterpret_cast<const char *>(std::memchr(begin, '\n', data.size()));
+        if(!headerEnd)
+            return false;
+
+        const char *line = headerEnd + 1;
+        long lineNum = 1;
+        PGESTRING identifier;
+
+        // The same lines as read by the TextInput::readLine() at the reader
+        while(line < end)
+        {
+            const char *lineEnd = reinterpret_cast<const char *>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+            const char *next = lineEnd ? lineEnd + 1 : end;
+            if(!lineEnd)
+                lineEnd = end;
+            lineNum++;
+
+            const char *idEnd = reinterpret_cast<const char *>(std::memchr(line, '|', static_cast<size_t>(lineEnd - line)));
+            identifier.assign(line, idEnd ? idEnd : lineEnd);
+            identifier.erase(std::remove(identifier.begin(), identifier.end(), '\r'), identifier.end());
+
+            Record type = m_classify(identifier);
+            if(isAhead(type))
+            {
+                if(m_chunks.empty() || m_chunks.back().lines.size() >= chunkLines)
+                {
+                    m_chunks.push_back(Chunk());
+                    m_chunks.back().data.assign(begin, headerEnd + 1);
+                }
+
+                Chunk &chunk = m_chunks.back();
+                chunk.data.append(line, next);
+                if(next == end && lineEnd == end)
+                    chunk.data.push_back('\n');
+                chunk.lines.push_back(lineNum);
+                chunk.types.push_back(type);
+            }
+
+            line = next;
+        }
+
+        // A single chunk is faster to decode in order
+        if(m_chunks.size() < 2)
+        {
+            m_chunks.clear();
+            return false;
+        }
+
+        Decoder decode = m_decode;
+        PGE_FileFormats_misc::parallelFor(m_chunks.size(), threads, [this, decode](size_t i)
+        {
+            Chunk &chunk = m_chunks[i];
+            PGE_FileFormats_misc::RawTextInput in(&chunk.data);
+            chunk.valid = decode(in, chunk.fragment);
+            PGESTRING().swap(chunk.data);
+        });
+
+        for(const Chunk &chunk : m_chunks)
+        {
+            if(!chunk.valid)
+            {
+                m_chunks.clear();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /*!
+     * \brief Takes the line which was decoded ahead
+     * \param [__in] lineNum Number of the line which is read now
+     * \param [__in] type Type of the line
+     * \param [__out] index Index of the element at the fragment's list of this type
+     * \return Fragment which contains the decoded element, or nullptr if the line must be decoded now
+     *
+     * Lines must be taken in the file order. When lines got out of the order, the rest
+     * of the file is decoded by the reader of the whole file.
+     */
+    Data *take(long lineNum, Record type, size_t &index)
+    {
+        while(m_chunk < m_chunks.size())
+        {
+            Chunk &chunk = m_chunks[m_chunk];
+
+            if(m_next >= chunk.lines.size())
+            {
+                m_chunk++;
+                m_next = 0;
+                std::fill(m_cursor.begin(), m_cursor.end(), 0);
+                continue;
+            }
+
+            if(chunk.lines[m_next] > lineNum)
+                return nullptr; // Not decoded ahead
+
+            if(chunk.lines[m_next] < lineNum || chunk.types[m_next] != type)
+            {
+                m_chunks.clear(); // Out of order, never expected
+                return nullptr;
+            }
+
+            m_next++;
+            index = m_cursor[static_cast<size_t>(type)]++;
+            return &chunk.fragment;
+        }
+
+        return nullptr;
+    }
+
+private:
+    //! Chunk of lines decoded by one job
+    struct Chunk
+    {
+        //! Header line and lines of the chunk, released after decoding
+        PGESTRING data;
+        //! Numbers of lines at the whole file
+        std::vector<long> lines;
+        //! Types of lines
+        std::vector<Record> types;
+        //! Decoded data
+        Data fragment;
+        //! Is chunk successfully decoded
+        bool valid = false;
+    };
+
+    Classifier m_classify;
+    Decoder m_decode;
+    //! Types of lines decoded ahead
+    std::vector<bool> m_ahead;
+    //! Next elements of every type at the current chunk
+    std::vector<size_t> m_cursor;
+    std::vector<Chunk> m_chunks;
+    //! Current chunk
+    size_t m_chunk = 0;
+    //! Next line of the current chunk
+    size_t m_next = 0;
+};
+
+#endif // PGEFL_ENABLE_THREADS && PGEFL_SMBX38A_READ_THREADS && !PGE_FILES_QT
+
+#endif // SMBX38A_PARALLEL_H
@@ -28,7 +28,6 @@
 #include "file_formats.h"
 #include "smbx64.h"
 #include "smbx64_macro.h"
-#include "CSVUtils.h"
 
 
 static int s_smbx64_flags = FileFormats::F_SMBX64_NO_FLAGS;
@@ -91,55 +90,43 @@ bool FileFormats::ReadSMBX64LvlFileHeaderT(PGE_FileFormats_misc::TextInput &inf,
     FileData.meta.RecentFormat = LevelData::SMBX64;
     FileData.meta.RecentFormatVersion = 64;
     inf.seek(0, PGE_FileFormats_misc::TextFileInput::begin);
-    SMBX64_FileBegin();
-#define nextLineH() inf.readCVSLine(line)
+    SMBX64_CursorBegin(inf);
 
-    try
-    {
-        nextLineH();                                    //Read first line
-        SMBX64::ReadUInt(&file_format, line);           //File format number
-        FileData.meta.RecentFormatVersion = file_format;
-
-        if(file_format >= 17)
-        {
-            nextLineH();                                //Read second Line
-            SMBX64::ReadUInt(&FileData.stars, line);    //Number of stars
-        }
-        else
-            FileData.stars = 0;
-
-        if(file_format >= 60)
-        {
-            nextLineH();   //Read third line
-            SMBX64::ReadStr(&FileData.LevelName, line); //LevelTitle
-        }
-        else
-            FileData.LevelName.clear();
+    readField(UInt, &file_format); //File format number
+    FileData.meta.RecentFormatVersion = file_format;
 
-        FileData.CurSection = 0;
-        FileData.playmusic = false;
-        FileData.meta.ReadFileValid = true;
-        return true;
+    if(file_format >= 17)
+    {
+        readField(UInt, &FileData.stars); //Number of stars
     }
-    catch(const std::exception &err)
+    else
+        FileData.stars = 0;
+
+    if(file_format >= 60)
     {
-        if(file_format > 0)
-            FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
-        else
-            FileData.meta.ERROR_info = "It is not an SMBX level file\n";
-
-#ifdef PGE_FILES_QT
-        FileData.meta.ERROR_info += QString::fromStdString(exception_to_pretty_string(err));
-#else
-        FileData.meta.ERROR_info += exception_to_pretty_string(err);
-#endif
-        FileData.meta.ERROR_linenum = inf.getCurrentLineNumber();
-        FileData.meta.ERROR_linedata = std::move(line);
-        FileData.meta.ReadFileValid = false;
-        PGE_CutLength(FileData.meta.ERROR_linedata, 50);
-        PGE_FilterBinary(FileData.meta.ERROR_linedata);
-        return false;
+        readField(Str, &FileData.LevelName); //LevelTitle
     }
+    else
+        FileData.LevelName.clear();
+
+    FileData.CurSection = 0;
+    FileData.playmusic = false;
+    FileData.meta.ReadFileValid = true;
+    return true;
+
+badfile:
+    if(file_format > 0)
+        FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
+    else
+        FileData.meta.ERROR_info = "It is not an SMBX level file\n";
+
+    FileData.meta.ERROR_info += cursor.errorString();
+    FileData.meta.ERROR_linenum = cursor.errorLine();
+    FileData.meta.ERROR_linedata = std::move(line);
+    FileData.meta.ReadFileValid = false;
+    PGE_CutLength(FileData.meta.ERROR_linedata, 50);
+    PGE_FilterBinary(FileData.meta.ERROR_linedata);
+    return false;
 }
 
 
@@ -176,9 +163,78 @@ bool FileFormats::ReadSMBX64LvlFileRaw(PGESTRING &rawdata, const PGESTRING &file
     return ReadSMBX64LvlFile(file, FileData);
 }
 
-bool FileFormats::ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &FileData)
+/*!
+ * \brief Jumps over NPC records without decoding them, only fields affecting the record length are read
+ * \param in File input descriptor
+ * \param cursor Field cursor of the input, the current field is the first field of the first record, receives the "next" separator
+ * \param file_format File format number
+ * \return false if any of read fields is invalid
+ */
+static bool smbx64SkipNpcRecords(PGE_FileFormats_misc::TextInput &in, SMBX64::FieldCursor &cursor, unsigned int file_format)
+{
+    PGESTRING &line = cursor.field();
+    unsigned long id, contents;
+    bool generator;
+
+    while((line != "next") && (!in.eof()))
+    {
+        nextLine(); //y
+        nextLine(); //direction
+        readField(UInt, &id);
+
+        switch(id)
+        {
+        case 76: case 121: case 122: case 123:
+        case 124: case 161: case 176: case 177:
+        case 243: case 244:
+        case 28: case 229: case 230: case 232:
+        case 233: case 234: case 236:
+        case 288: case 289:
+        case 260:
+            if(!(id == 76 && lt(15)) && !(id == 28 && lt(31)))
+                nextLine(); //special option
+            break;
+        case 91: case 96: case 283: case 284:
+            readField(UInt, &contents);
+            if(id == 91 && contents == 288)
+                nextLine(); //special option of contained NPC
+            break;
+        default:
+            break;
+        }
+
+        if(ge(3))
+        {
+            readField(CSVBool, &generator);
+            if(generator)
+                SMBX64::SkipFields(in, line, 3);
+        }
+
+        SMBX64::SkipFields(in, line, (ge(5) ? 1 : 0) + (ge(6) ? 2 : 0) + (ge(9) ? 1 : 0) +
+                                     (ge(10) ? 4 : 0) + (ge(14) ? 1 : 0) + (ge(63) ? 1 : 0));
+        nextLine();
+    }
+
+    return true;
+
+badfile:
+    return false;
+}
+
+bool FileFormats::ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &FileData, uint32_t loadSections)
 {
-    SMBX64_FileBegin();
+    LevelDataLoadCallbacks loader(FileData);
+
+    if(!ReadSMBX64LvlFile(in, FileData, loader, loadSections))
+        return false;
+
+    LevelAddInternalEvents(FileData);
+    return true;
+}
+
+bool FileFormats::ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelData &FileData, LevelLoadCallbacks &callbacks, uint32_t loadSections)
+{
+    SMBX64_CursorBegin(in);
     PGESTRING filePath = in.getFilePath();
     //SMBX64_File( RawData );
     int i;                  //counters
@@ -213,6 +269,8 @@ bool FileFormats::ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelDa
     LevelSMBX64Event events;
     LevelEvent_layers events_layers;
     LevelEvent_Sets events_sets;
+    //Numbers of reported objects, used as element indices
+    unsigned int blocksCount = 0, bgoCount = 0, npcCount = 0, doorsCount = 0, physEnvCount = 0;
 
     //Add path data
     if(!IsEmpty(filePath))
@@ -222,74 +280,69 @@ bool FileFormats::ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelDa
         FileData.meta.path = in_1.dirpath();
     }
 
-    try
+    ///////////////////////////////////////Begin file///////////////////////////////////////
+    readField(UInt, &file_format); //File format number
+    FileData.meta.RecentFormatVersion = file_format;
+
+    if(ge(17))
+    {
+        readField(UInt, &FileData.stars); //Number of stars
+    }
+    else
+        FileData.stars = 0; //-V1048
+
+    if(ge(60))
     {
-        ///////////////////////////////////////Begin file///////////////////////////////////////
-        nextLine();   //Read first line
-        SMBX64::ReadUInt(&file_format, line);//File format number
-        FileData.meta.RecentFormatVersion = file_format;
+        readField(Str, &FileData.LevelName); //LevelTitle
+    }
+
+    //total sections
+    sct = (ge(8) ? 21 : 6);
 
-        if(ge(17))
+    ////////////SECTION Data//////////
+    for(i = 0; i < sct; i++)
+    {
+        section = CreateLvlSection();
+        readField(SIntFromFloat, &section.size_left);
+        readField(SIntFromFloat, &section.size_top);
+        readField(SIntFromFloat, &section.size_bottom); //bottom
+        readField(SIntFromFloat, &section.size_right); //right
+        readField(UInt, &section.music_id); //Music ID
+        readField(UInt, &section.bgcolor); //BG Color
+        readField(CSVBool, &section.wrap_h); //Connect sides of section
+        readField(CSVBool, &section.OffScreenEn); //Offscreen exit
+        readField(UInt, &section.background); //BackGround id
+
+        if(ge(1))
         {
-            nextLine();
-            SMBX64::ReadUInt(&FileData.stars, line); //Number of stars
+            readField(CSVBool, &section.lock_left_scroll); //Don't walk to left (no turn back)
         }
-        else
-            FileData.stars = 0; //-V1048
 
-        if(ge(60))
+        if(ge(30))
         {
-            nextLine();    //LevelTitle
-            SMBX64::ReadStr(&FileData.LevelName, line);
+            readField(CSVBool, &section.underwater); //Underwater
         }
 
-        //total sections
-        sct = (ge(8) ? 21 : 6);
-
-        ////////////SECTION Data//////////
-        for(i = 0; i < sct; i++)
+        if(ge(2))
         {
-            section = CreateLvlSection();
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&section.size_left, line);
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&section.size_top,  line);
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&section.size_bottom, line); //bottom
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&section.size_right, line);  //right
-            nextLine();
-            SMBX64::ReadUInt(&section.music_id, line);    //Music ID
-            nextLine();
-            SMBX64::ReadUInt(&section.bgcolor, line);     //BG Color
-            nextLine();
-            SMBX64::ReadCSVBool(&section.wrap_h, line);     //Connect sides of section
-            nextLine();
-            SMBX64::ReadCSVBool(&section.OffScreenEn, line);//Offscreen exit
-            nextLine();
-            SMBX64::ReadUInt(&section.background, line);  //BackGround id
+            readField(Str, &section.music_file); //Custom Music
+        }
 
-            if(ge(1))
-            {
-                nextLine();    //Don't walk to left (no turn back)
-                SMBX64::ReadCSVBool(&section.lock_left_scroll, line);
-            }
+        //Very important data! I'ts a camera position in the editor!
+        section.PositionX = section.size_left - 10; //left
+        section.PositionY = section.size_top - 10; //top
+        section.id = i;
 
-            if(ge(30))
-            {
-                nextLine();    //Underwater
-                SMBX64::ReadCSVBool(&section.underwater, line);
-            }
-
-            if(ge(2))
-            {
-                nextLine();    //Custom Music
-                SMBX64::ReadStr(&section.music_file, line);
-            }
+        if(i < static_cast<signed>(FileData.sections.size()))
+            FileData.sections[static_cast<pge_size_t>(i)] = section; //Replace if already exists
+        else
+            FileData.sections.push_back(section); //Add Section in main array
+    }
 
-            //Very important data! I'ts a camera position in the editor!
-            section.PositionX = section.size_left - 10; //left
-            section.PositionY = section.size_top - 10; //top
+    if(lt(8))
+        for(; i < 21; i++)
+        {
+            section = CreateLvlSection();
             section.id = i;
 
             if(i < static_cast<signed>(FileData.sections.size()))
@@ -298,606 +351,530 @@ bool FileFormats::ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelDa
                 FileData.sections.push_back(section); //Add Section in main array
         }
 
-        if(lt(8))
-            for(; i < 21; i++)
-            {
-                section = CreateLvlSection();
-                section.id = i;
+    //Player's point config
+    for(i = 0; i < 2; i++)
+    {
+        players = CreateLvlPlayerPoint();
+        readField(SIntFromFloat, &players.x); //Player x
+        readField(SIntFromFloat, &players.y); //Player y
+        readField(UInt, &players.w); //Player w
+        readField(UInt, &players.h); //Player h
+        players.id = static_cast<unsigned int>(i) + 1u;
+
+        if(players.x != 0 && players.y != 0 && players.w != 0 && players.h != 0) //Don't add into array non-exist point
+            FileData.players.push_back(players);    //Add player in array
+    }
 
-                if(i < static_cast<signed>(FileData.sections.size()))
-                    FileData.sections[static_cast<pge_size_t>(i)] = section; //Replace if already exists
-                else
-                    FileData.sections.push_back(section); //Add Section in main array
-            }
+    ////////////Block Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_BLOCKS))
+        SMBX64::SkipRecords(in, line, 7 + (ge(61) ? 1 : 0) + (ge(10) ? 1 : 0) + (ge(14) ? 3 : 0));
 
-        //Player's point config
-        for(i = 0; i < 2; i++)
+    while(line != "next")
+    {
+        blocks = CreateLvlBlock();
+        convField(SIntFromFloat, &blocks.x);
+        readField(SIntFromFloat, &blocks.y);
+        readField(SIntFromFloat, &blocks.h);
+        readField(SIntFromFloat, &blocks.w);
+        readField(UInt, &blocks.id);
+        long xnpcID;
+        readField(UInt, &xnpcID); //Containing NPC id
         {
-            players = CreateLvlPlayerPoint();
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&players.x, line);//Player x
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&players.y, line);//Player y
-            nextLine();
-            SMBX64::ReadUInt(&players.w, line);//Player w
-            nextLine();
-            SMBX64::ReadUInt(&players.h, line);//Player h
-            players.id = static_cast<unsigned int>(i) + 1u;
+            //Convert NPC-ID value from SMBX1/2 to SMBX64
+            if((s_smbx64_flags & F_SMBX64_KEEP_LEGACY_NPC_IN_BLOCK_CODES) == 0)
+            {
+                switch(xnpcID)
+                {
+                case 100:
+                    xnpcID = 1009;
+                    break;//Mushroom
 
-            if(players.x != 0 && players.y != 0 && players.w != 0 && players.h != 0) //Don't add into array non-exist point
-                FileData.players.push_back(players);    //Add player in array
-        }
+                case 101:
+                    xnpcID = 1001;
+                    break;//Goomba
 
-        ////////////Block Data//////////
-        nextLine();
+                case 102:
+                    xnpcID = 1014;
+                    break;//Fire flower
 
-        while(line != "next")
-        {
-            blocks = CreateLvlBlock();
-            SMBX64::ReadSIntFromFloat(&blocks.x, line);
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&blocks.y, line);
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&blocks.h, line);
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&blocks.w, line);
-            nextLine();
-            SMBX64::ReadUInt(&blocks.id, line);
-            long xnpcID;
-            nextLine();
-            SMBX64::ReadUInt(&xnpcID, line); //Containing NPC id
-            {
-                //Convert NPC-ID value from SMBX1/2 to SMBX64
-                if((s_smbx64_flags & F_SMBX64_KEEP_LEGACY_NPC_IN_BLOCK_CODES) == 0)
-                {
-                    switch(xnpcID)
-                    {
-                    case 100:
-                        xnpcID = 1009;
-                        break;//Mushroom
-
-                    case 101:
-                        xnpcID = 1001;
-                        break;//Goomba
-
-                    case 102:
-                        xnpcID = 1014;
-                        break;//Fire flower
-
-                    case 103:
-                        xnpcID = 1034;
-                        break;//Super leaf
-
-                    case 104:
-                        xnpcID = 1035;
-                        break;//Shoe
-
-                    case 105:
-                        xnpcID = 1095;
-                        break;//Green Yoshi
-
-                    case 201:
-                        xnpcID = 1186;
-                        break;//Life mushroom
-
-                    default:
-                        break;
-                    }
-                }
+                case 103:
+                    xnpcID = 1034;
+                    break;//Super leaf
 
-                // Convert NPC-ID value from SMBX64 into Moondust format
-                if(xnpcID != 0)
-                {
-                    if(xnpcID > 1000)
-                        xnpcID = xnpcID - 1000;
-                    else
-                        xnpcID *= -1;
-                }
+                case 104:
+                    xnpcID = 1035;
+                    break;//Shoe
 
-                blocks.npc_id = xnpcID;
-            }
-            nextLine();
-            SMBX64::ReadCSVBool(&blocks.invisible, line);
+                case 105:
+                    xnpcID = 1095;
+                    break;//Green Yoshi
 
-            if(ge(61))
-            {
-                nextLine();
-                SMBX64::ReadCSVBool(&blocks.slippery, line);
-            }
+                case 201:
+                    xnpcID = 1186;
+                    break;//Life mushroom
 
-            if(ge(10))
-            {
-                nextLine();
-                SMBX64::ReadStr(&blocks.layer, line);
+                default:
+                    break;
+                }
             }
 
-            if(ge(14))
+            // Convert NPC-ID value from SMBX64 into Moondust format
+            if(xnpcID != 0)
             {
-                nextLine();
-                SMBX64::ReadStr(&blocks.event_destroy, line);
-                nextLine();
-                SMBX64::ReadStr(&blocks.event_hit, line);
-                nextLine();
-                SMBX64::ReadStr(&blocks.event_emptylayer, line);
+                if(xnpcID > 1000)
+                    xnpcID = xnpcID - 1000;
+                else
+                    xnpcID *= -1;
             }
 
-            blocks.meta.array_id = FileData.blocks_array_id++;
-            blocks.meta.index = static_cast<unsigned int>(FileData.blocks.size()); //Apply element index
-            FileData.blocks.push_back(blocks); //AddBlock into array
-            nextLine();
+            blocks.npc_id = xnpcID;
         }
+        readField(CSVBool, &blocks.invisible);
 
-        ////////////BGO Data//////////
-        nextLine();
+        if(ge(61))
+        {
+            readField(CSVBool, &blocks.slippery);
+        }
 
-        while(line != "next")
+        if(ge(10))
         {
-            bgodata = CreateLvlBgo();
-            SMBX64::ReadSIntFromFloat(&bgodata.x, line);
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&bgodata.y, line);
-            nextLine();
-            SMBX64::ReadUInt(&bgodata.id, line);
+            readField(Str, &blocks.layer);
+        }
 
-            if(ge(10))
-            {
-                nextLine();
-                SMBX64::ReadStr(&bgodata.layer, line);
-            }
+        if(ge(14))
+        {
+            readField(Str, &blocks.event_destroy);
+            readField(Str, &blocks.event_hit);
+            readField(Str, &blocks.event_emptylayer);
+        }
 
-            bgodata.smbx64_sp = -1;
+        blocks.meta.array_id = FileData.blocks_array_id++;
+        blocks.meta.index = blocksCount++; //Apply element index
+        if(!callbacks.onBlock(blocks))
+            goto interrupted;
+        nextLine();
+    }
 
-            if((file_format < 30) && (bgodata.id == 65)) //set foreground for BGO-65 (SMBX 1.0)
-            {
-                bgodata.z_mode = LevelBGO::Foreground1;
-                bgodata.smbx64_sp = 125;
-            }
+    ////////////BGO Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_BGO))
+        SMBX64::SkipRecords(in, line, 3 + (ge(10) ? 1 : 0));
 
-            bgodata.meta.array_id = FileData.bgo_array_id++;
-            bgodata.meta.index = static_cast<unsigned int>(FileData.bgo.size()); //Apply element index
-            FileData.bgo.push_back(bgodata); //Add Background object into array
-            nextLine();
+    while(line != "next")
+    {
+        bgodata = CreateLvlBgo();
+        convField(SIntFromFloat, &bgodata.x);
+        readField(SIntFromFloat, &bgodata.y);
+        readField(UInt, &bgodata.id);
+
+        if(ge(10))
+        {
+            readField(Str, &bgodata.layer);
         }
 
-        ////////////NPC Data//////////
-        nextLine();
+        bgodata.smbx64_sp = -1;
 
-        while(line != "next")
+        if((file_format < 30) && (bgodata.id == 65)) //set foreground for BGO-65 (SMBX 1.0)
         {
-            npcdata = CreateLvlNpc();
-            SMBX64::ReadSIntFromFloat(&npcdata.x, line);
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&npcdata.y, line);
-            nextLine();
-            SMBX64::ReadSInt(&npcdata.direct, line); //NPC direction
-            nextLine();
-            SMBX64::ReadUInt(&npcdata.id, line); //NPC id
-            npcdata.special_data = 0;
-            npcdata.contents     = 0;
-
-            switch(npcdata.id)
-            {
-            //SMBX64 Fixed special options for NPC
-            /*parakoopas*/
-            case 76: case 121: case 122: case 123:
-            case 124: case 161: case 176: case 177:
-            /*Paragoomba*/
-            case 243: case 244:
-            /*Cheep-Cheep*/
-            case 28: case 229: case 230: case 232:
-            case 233: case 234: case 236:
-            /*WarpSelection*/
-            case 288: case 289:
-            /*firebar*/
-            case 260:
-            {
-                if(npcdata.id == 76 && lt(15))
-                {
-                    npcdata.special_data = 0; //-V1048
-                }
-                else if(npcdata.id == 28 && lt(31))
-                {
-                    npcdata.special_data = 2;
-                }
-                else
-                {
-                    nextLine();
-                    SMBX64::ReadSInt(&npcdata.special_data, line); //NPC special option
-                }
+            bgodata.z_mode = LevelBGO::Foreground1;
+            bgodata.smbx64_sp = 125;
+        }
 
-                break;
-            }
-            /*Containers*/
-            case 91: /*buried*/
-            case 96: /*egg*/
-            case 283:/*Bubble*/
-            case 284:/*SMW Lakitu*/
-            {
-                nextLine();
-                SMBX64::ReadSInt(&npcdata.contents, line);
-                if(npcdata.id == 91)
-                {
-                    switch(npcdata.contents)
-                    {
-                    /*WarpSelection*/
-                    case 288: /*case 289:*/ /*firebar*/ /*case 260:*/
-                        nextLine();
-                        SMBX64::ReadSInt(&npcdata.special_data, line);
-                        break;
-                    default:
-                        break;
-                    }
-                }
-                break;
-            }
-            default:
-                break;
-            }
+        bgodata.meta.array_id = FileData.bgo_array_id++;
+        bgodata.meta.index = bgoCount++; //Apply element index
+        if(!callbacks.onBGO(bgodata))
+            goto interrupted;
+        nextLine();
+    }
 
-            if(ge(3))
-            {
-                nextLine();
-                SMBX64::ReadCSVBool(&npcdata.generator, line); //Generator enabled
-                npcdata.generator_direct = 1;
-                npcdata.generator_type = 1;
-                if(npcdata.generator)
-                {
-                    nextLine();
-                    SMBX64::ReadSInt(&npcdata.generator_direct, line); //Generator direction (1, 2, 3, 4)
-                    if(npcdata.generator_direct < 0)
-                        npcdata.generator_direct = 1; //Fix of old accidental mistake causes -1 value
-                    nextLine();
-                    SMBX64::ReadUInt(&npcdata.generator_type, line);   //Generator type [1] Warp, [2] Projectile
-                    nextLine();
-                    SMBX64::ReadUInt(&npcdata.generator_period, line); //Generator period ( sec*10 ) [1-600]
-                }
-            }
+    ////////////NPC Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_NPC))
+    {
+        if(!smbx64SkipNpcRecords(in, cursor, file_format))
+            goto badfile;
+    }
 
-            if(ge(5))
+    while(line != "next")
+    {
+        npcdata = CreateLvlNpc();
+        convField(SIntFromFloat, &npcdata.x);
+        readField(SIntFromFloat, &npcdata.y);
+        readField(SInt, &npcdata.direct); //NPC direction
+        readField(UInt, &npcdata.id); //NPC id
+        npcdata.special_data = 0;
+        npcdata.contents     = 0;
+
+        switch(npcdata.id)
+        {
+        //SMBX64 Fixed special options for NPC
+        /*parakoopas*/
+        case 76: case 121: case 122: case 123:
+        case 124: case 161: case 176: case 177:
+        /*Paragoomba*/
+        case 243: case 244:
+        /*Cheep-Cheep*/
+        case 28: case 229: case 230: case 232:
+        case 233: case 234: case 236:
+        /*WarpSelection*/
+        case 288: case 289:
+        /*firebar*/
+        case 260:
+        {
+            if(npcdata.id == 76 && lt(15))
             {
-                nextLine();
-                //strVarMultiLine(npcdata.msg, line)//Message
-                SMBX64::ReadStr(&npcdata.msg, line);//Message
+                npcdata.special_data = 0; //-V1048
             }
-            if(ge(6))
+            else if(npcdata.id == 28 && lt(31))
             {
-                nextLine();
-                SMBX64::ReadCSVBool(&npcdata.friendly, line);//Friendly NPC
-                nextLine();
-                SMBX64::ReadCSVBool(&npcdata.nomove, line); //Don't move NPC
+                npcdata.special_data = 2;
             }
-            if(ge(9))
+            else
             {
-                nextLine();
-                SMBX64::ReadCSVBool(&npcdata.is_boss, line); //Set as boss flag
+                readField(SInt, &npcdata.special_data); //NPC special option
             }
-            else
+
+            break;
+        }
+        /*Containers*/
+        case 91: /*buried*/
+        case 96: /*egg*/
+        case 283:/*Bubble*/
+        case 284:/*SMW Lakitu*/
+        {
+            readField(SInt, &npcdata.contents);
+            if(npcdata.id == 91)
             {
-                switch(npcdata.id)
+                switch(npcdata.contents)
                 {
-                //set boss flag to TRUE for old file formats automatically
-                case 15:
-                case 39:
-                case 86:
-                    npcdata.is_boss = true;
+                /*WarpSelection*/
+                case 288: /*case 289:*/ /*firebar*/ /*case 260:*/
+                    readField(SInt, &npcdata.special_data);
                     break;
                 default:
                     break;
                 }
             }
+            break;
+        }
+        default:
+            break;
+        }
 
-            if(ge(10))
-            {
-                nextLine();
-                SMBX64::ReadStr(&npcdata.layer, line);
-                nextLine();
-                SMBX64::ReadStr(&npcdata.event_activate, line);
-                nextLine();
-                SMBX64::ReadStr(&npcdata.event_die, line);
-                nextLine();
-                SMBX64::ReadStr(&npcdata.event_talk, line);
-            }
-            if(ge(14))
+        if(ge(3))
+        {
+            readField(CSVBool, &npcdata.generator); //Generator enabled
+            npcdata.generator_direct = 1;
+            npcdata.generator_type = 1;
+            if(npcdata.generator)
             {
-                nextLine();    //No more objects in layer event
-                SMBX64::ReadStr(&npcdata.event_emptylayer, line);
+                readField(SInt, &npcdata.generator_direct); //Generator direction (1, 2, 3, 4)
+                if(npcdata.generator_direct < 0)
+                    npcdata.generator_direct = 1; //Fix of old accidental mistake causes -1 value
+                readField(UInt, &npcdata.generator_type); //Generator type [1] Warp, [2] Projectile
+                readField(UInt, &npcdata.generator_period); //Generator period ( sec*10 ) [1-600]
             }
-            if(ge(63))
+        }
+
+        if(ge(5))
+        {
+            nextLine();
+            //strVarMultiLine(npcdata.msg, line)//Message
+            convField(Str, &npcdata.msg);//Message
+        }
+        if(ge(6))
+        {
+            readField(CSVBool, &npcdata.friendly); //Friendly NPC
+            readField(CSVBool, &npcdata.nomove); //Don't move NPC
+        }
+        if(ge(9))
+        {
+            readField(CSVBool, &npcdata.is_boss); //Set as boss flag
+        }
+        else
+        {
+            switch(npcdata.id)
             {
-                nextLine();    //Layer name to attach
-                SMBX64::ReadStr(&npcdata.attach_layer, line);
+            //set boss flag to TRUE for old file formats automatically
+            case 15:
+            case 39:
+            case 86:
+                npcdata.is_boss = true;
+                break;
+            default:
+                break;
             }
-            npcdata.meta.array_id = FileData.npc_array_id++;
-            npcdata.meta.index = static_cast<unsigned>(FileData.npc.size()); //Apply element index
-            FileData.npc.push_back(npcdata); //Add NPC into array
-            nextLine();
         }
 
-        ////////////Warp and Doors Data//////////
+        if(ge(10))
+        {
+            readField(Str, &npcdata.layer);
+            readField(Str, &npcdata.event_activate);
+            readField(Str, &npcdata.event_die);
+            readField(Str, &npcdata.event_talk);
+        }
+        if(ge(14))
+        {
+            readField(Str, &npcdata.event_emptylayer); //No more objects in layer event
+        }
+        if(ge(63))
+        {
+            readField(Str, &npcdata.attach_layer); //Layer name to attach
+        }
+        npcdata.meta.array_id = FileData.npc_array_id++;
+        npcdata.meta.index = npcCount++; //Apply element index
+        if(!callbacks.onNPC(npcdata))
+            goto interrupted;
         nextLine();
+    }
 
-        while(
-            ((line != "next") && (file_format >= 10))
-            || ((file_format < 10) && (!IsEmpty(line)) && (!in.eof()))
-        )
+    ////////////Warp and Doors Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_DOORS))
+    {
+        if(ge(10))
+            SMBX64::SkipRecords(in, line, 7 + (ge(3) ? 3 : 0) + (ge(4) ? 3 : 0) + (ge(7) ? 1 : 0) +
+                                          (ge(12) ? 2 : 0) + (ge(23) ? 1 : 0) + (ge(25) ? 1 : 0) + (ge(26) ? 1 : 0));
+        else
+            line.clear(); // Doors are the last section of old files, nothing to read after
+    }
+
+    while(
+        ((line != "next") && (file_format >= 10))
+        || ((file_format < 10) && (!IsEmpty(line)) && (!in.eof()))
+    )
+    {
+        doors = CreateLvlWarp();
+        doors.isSetIn = true;
+        doors.isSetOut = true;
+        convField(SIntFromFloat, &doors.ix); //Entrance x
+        readField(SIntFromFloat, &doors.iy); //Entrance y
+        readField(SIntFromFloat, &doors.ox); //Exit x
+        readField(SIntFromFloat, &doors.oy); //Exit y
+        readField(UInt, &doors.idirect); //Entrance direction: [3] down, [1] up, [2] left, [4] right
+        readField(UInt, &doors.odirect); //Exit direction: [1] down [3] up [4] left [2] right
+        readField(UInt, &doors.type); //Door type: [1] pipe, [2] door, [0] instant
+
+        if(ge(3))
         {
-            doors = CreateLvlWarp();
-            doors.isSetIn = true;
-            doors.isSetOut = true;
-            SMBX64::ReadSIntFromFloat(&doors.ix, line); //Entrance x
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&doors.iy, line); //Entrance y
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&doors.ox, line); //Exit x
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&doors.oy, line); //Exit y
-            nextLine();
-            SMBX64::ReadUInt(&doors.idirect, line); //Entrance direction: [3] down, [1] up, [2] left, [4] right
-            nextLine();
-            SMBX64::ReadUInt(&doors.odirect, line); //Exit direction: [1] down [3] up [4] left [2] right
-            nextLine();
-            SMBX64::ReadUInt(&doors.type, line);    //Door type: [1] pipe, [2] door, [0] instant
+            readField(Str, &doors.lname); //Warp to level
+            readField(UInt, &doors.warpto); //Normal entrance or Warp to other door
+            readField(CSVBool, &doors.lvl_i); //Level Entrance (cannot enter)
+            doors.isSetIn = !doors.lvl_i;
+        }
 
-            if(ge(3))
-            {
-                nextLine();
-                SMBX64::ReadStr(&doors.lname, line);   //Warp to level
-                nextLine();
-                SMBX64::ReadUInt(&doors.warpto, line); //Normal entrance or Warp to other door
-                nextLine();
-                SMBX64::ReadCSVBool(&doors.lvl_i, line); //Level Entrance (cannot enter)
-                doors.isSetIn = !doors.lvl_i;
-            }
+        if(ge(4))   //-V112
+        {
+            readField(CSVBool, &doors.lvl_o); //-V112
+            doors.isSetOut = (!doors.lvl_o || (doors.lvl_i));
+            readField(SInt, &doors.world_x); //WarpTo X
+            readField(SInt, &doors.world_y); //WarpTo y
+        }
 
-            if(ge(4))   //-V112
-            {
-                nextLine();
-                SMBX64::ReadCSVBool(&doors.lvl_o, line); //-V112
-                doors.isSetOut = (!doors.lvl_o || (doors.lvl_i));
-                nextLine();
-                SMBX64::ReadSInt(&doors.world_x, line); //WarpTo X
-                nextLine();
-                SMBX64::ReadSInt(&doors.world_y, line); //WarpTo y
-            }
+        if(ge(7))
+        {
+            readField(UInt, &doors.stars); //Need a stars
+        }
 
-            if(ge(7))
-            {
-                nextLine();    //Need a stars
-                SMBX64::ReadUInt(&doors.stars, line);
-            }
+        if(ge(12))
+        {
+            readField(Str, &doors.layer); //Layer
+            readField(CSVBool, &doors.unknown);
+        }    //<unused>, always FALSE
 
-            if(ge(12))
-            {
-                nextLine();
-                SMBX64::ReadStr(&doors.layer, line); //Layer
-                nextLine();
-                SMBX64::ReadCSVBool(&doors.unknown, line);
-            }    //<unused>, always FALSE
+        if(ge(23))
+        {
+            readField(CSVBool, &doors.novehicles); //Deny vehicles
+        }
 
-            if(ge(23))
-            {
-                nextLine();    //Deny vehicles
-                SMBX64::ReadCSVBool(&doors.novehicles, line);
-            }
+        if(ge(25))
+        {
+            readField(CSVBool, &doors.allownpc); //Allow carried items
+        }
 
-            if(ge(25))
-            {
-                nextLine();    //Allow carried items
-                SMBX64::ReadCSVBool(&doors.allownpc, line);
-            }
+        if(ge(26))
+        {
+            readField(CSVBool, &doors.locked); //Locked
+        }
 
-            if(ge(26))
+        doors.meta.array_id = FileData.doors_array_id++;
+        doors.meta.index = doorsCount++; //Apply element index
+        if(!callbacks.onWarp(doors))
+            goto interrupted;
+        nextLine();
+    }
+
+    ////////////Water/QuickSand Data//////////
+    if(file_format >= 29)
+    {
+        nextLine();
+
+        if(!(loadSections & LOAD_PHYSENV))
+            SMBX64::SkipRecords(in, line, 6 + (ge(62) ? 1 : 0));
+
+        while(line != "next")
+        {
+            waters = CreateLvlPhysEnv();
+            convField(SIntFromFloat, &waters.x);
+            readField(SIntFromFloat, &waters.y);
+            readField(UInt, &waters.w);
+            readField(UInt, &waters.h);
+            readField(Float, &waters.buoy);
+
+            if(ge(62))
             {
-                nextLine();    //Locked
-                SMBX64::ReadCSVBool(&doors.locked, line);
+                readField(CSVBool, &waters.env_type);
             }
 
-            doors.meta.array_id = FileData.doors_array_id++;
-            doors.meta.index = static_cast<unsigned>(FileData.doors.size()); //Apply element index
-            FileData.doors.push_back(doors); //Add NPC into array
+            readField(Str, &waters.layer);
+            waters.meta.array_id = FileData.physenv_array_id++;
+            waters.meta.index = physEnvCount++; //Apply element index
+            if(!callbacks.onPhysEnv(waters))
+                goto interrupted;
             nextLine();
         }
+    }
 
-        ////////////Water/QuickSand Data//////////
-        if(file_format >= 29)
-        {
-            nextLine();
+    if(ge(10))
+    {
+        ////////////Layers Data//////////
+        nextLine();
 
-            while(line != "next")
-            {
-                waters = CreateLvlPhysEnv();
-                SMBX64::ReadSIntFromFloat(&waters.x, line);
-                nextLine();
-                SMBX64::ReadSIntFromFloat(&waters.y, line);
-                nextLine();
-                SMBX64::ReadUInt(&waters.w, line);
-                nextLine();
-                SMBX64::ReadUInt(&waters.h, line);
-                nextLine();
-                SMBX64::ReadFloat(&waters.buoy, line);
-
-                if(ge(62))
-                {
-                    nextLine();
-                    SMBX64::ReadCSVBool(&waters.env_type, line);
-                }
+        if(!(loadSections & LOAD_LAYERS))
+            SMBX64::SkipRecords(in, line, 2);
 
-                nextLine();
-                SMBX64::ReadStr(&waters.layer, line);
-                waters.meta.array_id = FileData.physenv_array_id++;
-                waters.meta.index = static_cast<unsigned>(FileData.physez.size()); //Apply element index
-                FileData.physez.push_back(waters); //Add Water area into array
-                nextLine();
-            }
+        while((line != "next") && (!in.eof()) && (!IsEmpty(line)))
+        {
+            convField(Str, &layers.name);     //Layer name
+            readField(CSVBool, &layers.hidden); //hidden layer
+            layers.locked = false;
+            layers.meta.array_id = FileData.layers_array_id++;
+            if(!callbacks.onLayer(layers))
+                goto interrupted;
+            nextLine();
         }
 
-        if(ge(10))
+        ////////////Events Data//////////
+        nextLine();
+
+        // Events are the last section, skipping them is just stopping the read
+        while((loadSections & LOAD_EVENTS) && (!IsEmpty(line)) && (!in.eof()))
         {
-            ////////////Layers Data//////////
-            nextLine();
+            events = CreateLvlEvent();
+            convField(Str, &events.name);//Event name
 
-            while((line != "next") && (!in.eof()) && (!IsEmpty(line)))
+            if(ge(11))
             {
-                SMBX64::ReadStr(&layers.name, line);     //Layer name
-                nextLine();
-                SMBX64::ReadCSVBool(&layers.hidden, line); //hidden layer
-                layers.locked = false;
-                layers.meta.array_id = FileData.layers_array_id++;
-                FileData.layers.push_back(layers); //Add Water area into array
-                nextLine();
+                readField(Str, &events.msg); //Event message
             }
 
-            ////////////Events Data//////////
-            nextLine();
+            if(ge(14))
+            {
+                readField(UInt, &events.sound_id);
+            }
 
-            while((!IsEmpty(line)) && (!in.eof()))
+            if(ge(18))
             {
-                events = CreateLvlEvent();
-                SMBX64::ReadStr(&events.name, line);//Event name
+                readField(UInt, &events.end_game);
+            }
 
-                if(ge(11))
-                {
-                    nextLine();
-                    SMBX64::ReadStr(&events.msg, line);//Event message
-                }
+            PGELIST<LevelEvent_layers > events_layersArr;
+            events_layersArr.clear();
+            events.layers_hide.clear();
+            events.layers_show.clear();
+            events.layers_toggle.clear();
 
-                if(ge(14))
-                {
-                    nextLine();
-                    SMBX64::ReadUInt(&events.sound_id, line);
-                }
+            for(i = 0; i < sct; i++)
+            {
+                readField(Str, &events_layers.hide); //Hide layer
+                readField(Str, &events_layers.show); //Show layer
 
-                if(ge(18))
+                if(ge(14))
                 {
-                    nextLine();
-                    SMBX64::ReadUInt(&events.end_game, line);
+                    readField(Str, &events_layers.toggle); //Toggle layer
                 }
+                else
+                    events_layers.toggle.clear();
 
-                PGELIST<LevelEvent_layers > events_layersArr;
-                events_layersArr.clear();
-                events.layers_hide.clear();
-                events.layers_show.clear();
-                events.layers_toggle.clear();
-
-                for(i = 0; i < sct; i++)
-                {
-                    nextLine();
-                    SMBX64::ReadStr(&events_layers.hide, line); //Hide layer
-                    nextLine();
-                    SMBX64::ReadStr(&events_layers.show, line); //Show layer
-
-                    if(ge(14))
-                    {
-                        nextLine();
-                        SMBX64::ReadStr(&events_layers.toggle, line);//Toggle layer
-                    }
-                    else
-                        events_layers.toggle.clear();
+                if(!IsEmpty(events_layers.hide))
+                    events.layers_hide.push_back(events_layers.hide);
 
-                    if(!IsEmpty(events_layers.hide))
-                        events.layers_hide.push_back(events_layers.hide);
+                if(!IsEmpty(events_layers.show))
+                    events.layers_show.push_back(events_layers.show);
 
-                    if(!IsEmpty(events_layers.show))
-                        events.layers_show.push_back(events_layers.show);
+                if(!IsEmpty(events_layers.toggle))
+                    events.layers_toggle.push_back(events_layers.toggle);
 
-                    if(!IsEmpty(events_layers.toggle))
-                        events.layers_toggle.push_back(events_layers.toggle);
+                events_layersArr.push_back(events_layers);
+            }
 
-                    events_layersArr.push_back(events_layers);
-                }
+            if(ge(13))
+            {
+                events.sets.clear();
 
-                if(ge(13))
+                for(i = 0; i < 21; i++)
                 {
-                    events.sets.clear();
-
-                    for(i = 0; i < 21; i++)
-                    {
-                        events_sets.id = i;
-                        nextLine();
-                        SMBX64::ReadSInt(&events_sets.music_id, line);        //Set Music
-                        nextLine();
-                        SMBX64::ReadSInt(&events_sets.background_id, line);   //Set Background
-                        nextLine();
-                        SMBX64::ReadSInt(&events_sets.position_left, line);   //Set Position to: LEFT
-                        nextLine();
-                        SMBX64::ReadSInt(&events_sets.position_top, line);    //Set Position to: TOP
-                        nextLine();
-                        SMBX64::ReadSInt(&events_sets.position_bottom, line); //Set Position to: BOTTOM
-                        nextLine();
-                        SMBX64::ReadSInt(&events_sets.position_right, line);  //Set Position to: RIGHT
-                        events.sets.push_back(events_sets);
-                    }
+                    events_sets.id = i;
+                    readField(SInt, &events_sets.music_id); //Set Music
+                    readField(SInt, &events_sets.background_id); //Set Background
+                    readField(SInt, &events_sets.position_left); //Set Position to: LEFT
+                    readField(SInt, &events_sets.position_top); //Set Position to: TOP
+                    readField(SInt, &events_sets.position_bottom); //Set Position to: BOTTOM
+                    readField(SInt, &events_sets.position_right); //Set Position to: RIGHT
+                    events.sets.push_back(events_sets);
                 }
+            }
 
-                if(ge(26))
-                {
-                    nextLine();
-                    SMBX64::ReadStr(&events.trigger, line); //Trigger
-                    nextLine();
-                    SMBX64::ReadUInt(&events.trigger_timer, line);
-                } //Start trigger event after x [1/10 sec]. Etc. 153,2 sec
+            if(ge(26))
+            {
+                readField(Str, &events.trigger); //Trigger
+                readField(UInt, &events.trigger_timer);
+            } //Start trigger event after x [1/10 sec]. Etc. 153,2 sec
 
-                if(ge(27))
-                {
-                    nextLine();    //Don't smoke tobacco, let's healthy! :D
-                    SMBX64::ReadCSVBool(&events.nosmoke, line);
-                }
+            if(ge(27))
+            {
+                readField(CSVBool, &events.nosmoke); //Don't smoke tobacco, let's healthy! :D
+            }
 
-                if(ge(28))
-                {
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_altjump, line);//Hold ALT-JUMP player control
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_altrun, line); //ALT-RUN
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_down, line);   //DOWN
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_drop, line);   //DROP
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_jump, line);   //JUMP
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_left, line);   //LEFT
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_right, line);  //RIGHT
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_run, line);    //RUN
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_start, line);  //START
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.ctrl_up, line);  //UP
-                    events.ctrls_enable = events.ctrlKeyPressed();
-                    events.ctrl_lock_keyboard = events.ctrls_enable;
-                }
+            if(ge(28))
+            {
+                readField(CSVBool, &events.ctrl_altjump); //Hold ALT-JUMP player control
+                readField(CSVBool, &events.ctrl_altrun); //ALT-RUN
+                readField(CSVBool, &events.ctrl_down); //DOWN
+                readField(CSVBool, &events.ctrl_drop); //DROP
+                readField(CSVBool, &events.ctrl_jump); //JUMP
+                readField(CSVBool, &events.ctrl_left); //LEFT
+                readField(CSVBool, &events.ctrl_right); //RIGHT
+                readField(CSVBool, &events.ctrl_run); //RUN
+                readField(CSVBool, &events.ctrl_start); //START
+                readField(CSVBool, &events.ctrl_up); //UP
+                events.ctrls_enable = events.ctrlKeyPressed();
+                events.ctrl_lock_keyboard = events.ctrls_enable;
+            }
 
-                if(ge(32))  //-V112
+            if(ge(32))  //-V112
+            {
+                readField(CSVBool, &events.autostart); //Auto start
+                readField(Str, &events.movelayer); //Layer for movement
+                readField(Float, &events.layer_speed_x); //Layer moving speed - horizontal
+                readField(Float, &events.layer_speed_y); //Layer moving speed - vertical
+
+                if(!IsEmpty(events.movelayer))
                 {
-                    nextLine();
-                    SMBX64::ReadCSVBool(&events.autostart, line);  //Auto start
-                    nextLine();
-                    SMBX64::ReadStr(&events.movelayer, line);  //Layer for movement
-                    nextLine();
-                    SMBX64::ReadFloat(&events.layer_speed_x, line); //Layer moving speed - horizontal
-                    nextLine();
-                    SMBX64::ReadFloat(&events.layer_speed_y, line); //Layer moving speed - vertical
-
-                    if(!IsEmpty(events.movelayer))
-                    {
-                        LevelEvent_MoveLayer mvl;
-                        mvl.name = events.movelayer;
-                        mvl.speed_x = events.layer_speed_x;
-                        mvl.speed_y = events.layer_speed_y;
-                        events.moving_layers.push_back(mvl);
-                    }
+                    LevelEvent_MoveLayer mvl;
+                    mvl.name = events.movelayer;
+                    mvl.speed_x = events.layer_speed_x;
+                    mvl.speed_y = events.layer_speed_y;
+                    events.moving_layers.push_back(mvl);
                 }
+            }
 
-                if(ge(33))
-                {
-                    nextLine();
-                    SMBX64::ReadFloat(&events.move_camera_x, line); //Move screen horizontal speed
-                    nextLine();
-                    SMBX64::ReadFloat(&events.move_camera_y, line); //Move screen vertical speed
-                    nextLine();
-                    SMBX64::ReadSInt(&events.scroll_section, line); //Scroll section x, (in file value is x-1)
+            if(ge(33))
+            {
+                readField(Float, &events.move_camera_x); //Move screen horizontal speed
+                readField(Float, &events.move_camera_y); //Move screen vertical speed
+                readField(SInt, &events.scroll_section); //Scroll section x, (in file value is x-1)
 
 // !!!This code intended to convert old autoscroll into new, but, this is a source of the bug, so, don't do that!!!
 //                    if(((events.move_camera_x != 0.0) || (events.move_camera_y != 0.0)) && (events.scroll_section < static_cast<long>(events.sets.size())))
@@ -910,38 +887,39 @@ bool FileFormats::ReadSMBX64LvlFile(PGE_FileFormats_misc::TextInput &in, LevelDa
 //                        set.expression_autoscrool_x = fromNum(events.move_camera_x);
 //                        set.expression_autoscrool_y = fromNum(events.move_camera_y);
 //                    }
-                }
-
-                events.meta.array_id = FileData.events_array_id++;
-                FileData.events.push_back(events);
-                nextLine();
             }
-        }
 
-        LevelAddInternalEvents(FileData);
-        ///////////////////////////////////////EndFile///////////////////////////////////////
-        FileData.meta.ReadFileValid = true;
-        return true;
-    }
-    catch(const std::exception &err)
-    {
-        if(file_format > 0)
-            FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
-        else
-            FileData.meta.ERROR_info = "It is not an SMBX level file\n";
-
-#ifdef PGE_FILES_QT
-        FileData.meta.ERROR_info += QString::fromStdString(exception_to_pretty_string(err));
-#else
-        FileData.meta.ERROR_info += exception_to_pretty_string(err);
-#endif
-        FileData.meta.ERROR_linenum  = in.getCurrentLineNumber();
-        FileData.meta.ERROR_linedata = std::move(line);
-        FileData.meta.ReadFileValid = false;
-        PGE_CutLength(FileData.meta.ERROR_linedata, 50);
-        PGE_FilterBinary(FileData.meta.ERROR_linedata);
-        return false;
+            events.meta.array_id = FileData.events_array_id++;
+            if(!callbacks.onEvent(events))
+                goto interrupted;
+            nextLine();
+        }
     }
+
+    ///////////////////////////////////////EndFile///////////////////////////////////////
+    FileData.meta.ReadFileValid = true;
+    return true;
+
+badfile:
+    if(file_format > 0)
+        FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
+    else
+        FileData.meta.ERROR_info = "It is not an SMBX level file\n";
+
+    FileData.meta.ERROR_info += cursor.errorString();
+    FileData.meta.ERROR_linenum  = cursor.errorLine();
+    FileData.meta.ERROR_linedata = std::move(line);
+    FileData.meta.ReadFileValid = false;
+    PGE_CutLength(FileData.meta.ERROR_linedata, 50);
+    PGE_FilterBinary(FileData.meta.ERROR_linedata);
+    return false;
+
+interrupted:
+    FileData.meta.ERROR_info = "Loading was interrupted by the load callback";
+    FileData.meta.ERROR_linenum  = in.getCurrentLineNumber();
+    FileData.meta.ERROR_linedata.clear();
+    FileData.meta.ReadFileValid = false;
+    return false;
 }
 
 
@@ -966,7 +944,10 @@ bool FileFormats::WriteSMBX64LvlFileF(const PGESTRING &filePath, LevelData &File
         return false;
     }
 
-    return WriteSMBX64LvlFile(file, FileData, file_format);
+    if(!WriteSMBX64LvlFile(file, FileData, file_format))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, FileData.meta.ERROR_info);
 }
 
 bool FileFormats::WriteSMBX64LvlFileRaw(LevelData &FileData, PGESTRING &rawdata, unsigned int file_format)
@@ -342,7 +342,10 @@ bool FileFormats::WriteNPCTxtFileF(const PGESTRING &filePath, NPCConfigFile &Fil
         FileData.errorString = "Failed to open file for write";
         return false;
     }
-    return WriteNPCTxtFile(file, FileData);
+    if(!WriteNPCTxtFile(file, FileData))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, FileData.errorString);
 }
 
 bool FileFormats::WriteNPCTxtFileRaw(NPCConfigFile &FileData, PGESTRING &rawdata)
@@ -36,7 +36,6 @@
 #include "save_filedata.h"
 #include "smbx64.h"
 #include "smbx64_macro.h"
-#include "CSVUtils.h"
 
 //*********************************************************
 //****************READ FILE FORMAT*************************
@@ -74,7 +73,7 @@ bool FileFormats::ReadSMBX64SavFileRaw(PGESTRING &rawdata, const PGESTRING &file
 
 bool FileFormats::ReadSMBX64SavFile(PGE_FileFormats_misc::TextInput &in, GamesaveData &FileData)
 {
-    SMBX64_FileBegin();
+    SMBX64_CursorBegin(in);
     PGESTRING filePath = in.getFilePath();
     FileData.meta.ERROR_info.clear();
     //SMBX64_File( RawData );
@@ -97,153 +96,133 @@ bool FileFormats::ReadSMBX64SavFile(PGE_FileFormats_misc::TextInput &in, Gamesav
     //Enable strict mode for SMBX LVL file format
     FileData.meta.smbx64strict = true;
 
-    try
-    {
-        ///////////////////////////////////////Begin file///////////////////////////////////////
-        nextLine();
-        SMBX64::ReadUInt(&file_format, line);//File format number
-        FileData.meta.RecentFormatVersion = file_format;
-        nextLine();
-        SMBX64::ReadSInt(&FileData.lives, line); //Number of lives
-        nextLine();
-        SMBX64::ReadUInt(&FileData.coins, line); //Number of coins
-        nextLine();
-        SMBX64::ReadSInt(&FileData.worldPosX, line);  //World map pos X
-        nextLine();
-        SMBX64::ReadSInt(&FileData.worldPosY, line);  //World map pos Y
+    ///////////////////////////////////////Begin file///////////////////////////////////////
+    readField(UInt, &file_format); //File format number
+    FileData.meta.RecentFormatVersion = file_format;
+    readField(SInt, &FileData.lives); //Number of lives
+    readField(UInt, &FileData.coins); //Number of coins
+    readField(SInt, &FileData.worldPosX); //World map pos X
+    readField(SInt, &FileData.worldPosY); //World map pos Y
 
-        for(i = 0; i < (ge(56) ? 5 : 2) ; i++)
+    for(i = 0; i < (ge(56) ? 5 : 2) ; i++)
+    {
+        saveCharState charState;
+        charState = CreateSavCharacterState();
+        readField(UInt, &charState.state); //Character's power up state
+        readField(UInt, &charState.itemID); //ID of item in the slot
+        if(ge(10))
         {
-            saveCharState charState;
-            charState = CreateSavCharacterState();
-            nextLine();
-            SMBX64::ReadUInt(&charState.state, line);//Character's power up state
-            nextLine();
-            SMBX64::ReadUInt(&charState.itemID, line); //ID of item in the slot
-            if(ge(10))
-            {
-                nextLine();    //Type of mount
-                SMBX64::ReadUInt(&charState.mountType, line);
-            }
-            nextLine();
-            SMBX64::ReadUInt(&charState.mountID, line); //ID of mount
-            if(lt(10))
-            {
-                if(charState.mountID > 0) charState.mountType = 1;
-            }
-            if(ge(56))
-            {
-                nextLine();    //ID of mount
-                SMBX64::ReadUInt(&charState.health, line);
-            }
-            FileData.characterStates.push_back(charState);
+            readField(UInt, &charState.mountType); //Type of mount
+        }
+        readField(UInt, &charState.mountID); //ID of mount
+        if(lt(10))
+        {
+            if(charState.mountID > 0) charState.mountType = 1;
         }
-
-        nextLine();
-        SMBX64::ReadUInt(&FileData.musicID, line);//ID of music
-        nextLine();
-        if(IsEmpty(line) || in.eof())
-            goto successful;
-
         if(ge(56))
         {
-            SMBX64::ReadCSVBool(&FileData.gameCompleted, line);   //Game was complited
+            readField(UInt, &charState.health); //ID of mount
         }
+        FileData.characterStates.push_back(charState);
+    }
 
-        arrayIdCounter = 1;
+    readField(UInt, &FileData.musicID); //ID of music
+    nextLine();
+    if(IsEmpty(line) || in.eof())
+        goto successful;
 
-        nextLine();
-        while((line != "next") && (!in.eof()))
-        {
-            visibleItem level;
-            level.first = (unsigned int)arrayIdCounter;
-            level.second = false;
-            SMBX64::ReadCSVBool(&level.second, line); //Is level shown
+    if(ge(56))
+    {
+        convField(CSVBool, &FileData.gameCompleted);   //Game was complited
+    }
 
-            FileData.visibleLevels.push_back(level);
-            arrayIdCounter++;
-            nextLine();
-        }
+    arrayIdCounter = 1;
 
-        arrayIdCounter = 1;
+    nextLine();
+    while((line != "next") && (!in.eof()))
+    {
+        visibleItem level;
+        level.first = (unsigned int)arrayIdCounter;
+        level.second = false;
+        convField(CSVBool, &level.second); //Is level shown
+
+        FileData.visibleLevels.push_back(level);
+        arrayIdCounter++;
         nextLine();
-        while((line != "next") && (!in.eof()))
-        {
-            visibleItem level;
-            level.first = (unsigned int)arrayIdCounter;
-            level.second = false;
-            SMBX64::ReadCSVBool(&level.second, line); //Is path shown
+    }
 
-            FileData.visiblePaths.push_back(level);
-            arrayIdCounter++;
-            nextLine();
-        }
+    arrayIdCounter = 1;
+    nextLine();
+    while((line != "next") && (!in.eof()))
+    {
+        visibleItem level;
+        level.first = (unsigned int)arrayIdCounter;
+        level.second = false;
+        convField(CSVBool, &level.second); //Is path shown
 
-        arrayIdCounter = 1;
+        FileData.visiblePaths.push_back(level);
+        arrayIdCounter++;
         nextLine();
-        while((line != "next") && (!in.eof()))
-        {
-            visibleItem level;
-            level.first = (unsigned int)arrayIdCounter;
-            level.second = false;
-            SMBX64::ReadCSVBool(&level.second, line); //Is Scenery shown
+    }
 
-            FileData.visibleScenery.push_back(level);
-            arrayIdCounter++;
-            nextLine();
-        }
+    arrayIdCounter = 1;
+    nextLine();
+    while((line != "next") && (!in.eof()))
+    {
+        visibleItem level;
+        level.first = (unsigned int)arrayIdCounter;
+        level.second = false;
+        convField(CSVBool, &level.second); //Is Scenery shown
 
-        if(ge(7))
+        FileData.visibleScenery.push_back(level);
+        arrayIdCounter++;
+        nextLine();
+    }
+
+    if(ge(7))
+    {
+        nextLine();
+        while((line != "next") && (!IsNULL(line)))
         {
-            nextLine();
-            while((line != "next") && (!IsNULL(line)))
+            starOnLevel gottenStar;
+            gottenStar.first.clear();
+            gottenStar.second = 0;
+
+            convField(Str, &gottenStar.first);//Level file
+            if(ge(16))
             {
-                starOnLevel gottenStar;
-                gottenStar.first.clear();
-                gottenStar.second = 0;
-
-                SMBX64::ReadStr(&gottenStar.first, line);//Level file
-                if(ge(16))
-                {
-                    nextLine();    //Section ID
-                    SMBX64::ReadUInt(&gottenStar.second, line);
-                }
-
-                FileData.gottenStars.push_back(gottenStar);
-                nextLine();
+                readField(UInt, &gottenStar.second); //Section ID
             }
-        }
 
-        if(ge(21))
-        {
+            FileData.gottenStars.push_back(gottenStar);
             nextLine();
-            if(IsEmpty(line) || in.eof())
-                goto successful;
-            SMBX64::ReadUInt(&FileData.totalStars, line);//Total Number of stars
         }
-
-successful:
-        ///////////////////////////////////////EndFile///////////////////////////////////////
-        FileData.meta.ReadFileValid = true;
-        return true;
     }
-    catch(const std::exception &err)
+
+    if(ge(21))
     {
-        if(file_format > 0)
-            FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
-        else
-            FileData.meta.ERROR_info = "It is not an SMBX game save file\n";
-        #ifdef PGE_FILES_QT
-        FileData.meta.ERROR_info += QString::fromStdString(exception_to_pretty_string(err));
-        #else
-        FileData.meta.ERROR_info += exception_to_pretty_string(err);
-        #endif
-        FileData.meta.ERROR_linenum = in.getCurrentLineNumber();
-        FileData.meta.ERROR_linedata = line;
-        FileData.meta.ReadFileValid = false;
-        PGE_CutLength(FileData.meta.ERROR_linedata, 50);
-        PGE_FilterBinary(FileData.meta.ERROR_linedata);
-        return false;
+        nextLine();
+        if(IsEmpty(line) || in.eof())
+            goto successful;
+        convField(UInt, &FileData.totalStars);//Total Number of stars
     }
+
+successful:
+    ///////////////////////////////////////EndFile///////////////////////////////////////
+    FileData.meta.ReadFileValid = true;
+    return true;
+
+badfile:
+    if(file_format > 0)
+        FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
+    else
+        FileData.meta.ERROR_info = "It is not an SMBX game save file\n";
+    FileData.meta.ERROR_info += cursor.errorString();
+    FileData.meta.ERROR_linenum = cursor.errorLine();
+    FileData.meta.ERROR_linedata = line;
+    FileData.meta.ReadFileValid = false;
+    PGE_CutLength(FileData.meta.ERROR_linedata, 50);
+    PGE_FilterBinary(FileData.meta.ERROR_linedata);
+    return false;
 }
 
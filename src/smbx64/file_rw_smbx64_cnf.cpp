@@ -28,7 +28,6 @@
 #include "save_filedata.h"
 #include "smbx64.h"
 #include "smbx64_macro.h"
-#include "CSVUtils.h"
 
 //*********************************************************
 //****************READ FILE FORMAT*************************
@@ -78,97 +77,70 @@ SMBX64_ConfigFile FileFormats::ReadSMBX64ConfigFile(PGESTRING RawData)
 //SMBX64_ConfigFile FileFormats::ReadSMBX64ConfigFile(PGESTRING RawData)
 bool FileFormats::ReadSMBX64ConfigFile(PGE_FileFormats_misc::TextInput &in, SMBX64_ConfigFile &FileData)
 {
-    SMBX64_FileBegin();
+    SMBX64_CursorBegin(in);
     FileData.meta.ERROR_info.clear();
 
-    try
+    ///////////////////////////////////////Begin file///////////////////////////////////////
+    //File format number
+    readField(UInt, &file_format);
+
+    //Full screen mode
+    if(ge(16))
     {
-        ///////////////////////////////////////Begin file///////////////////////////////////////
-        //File format number
-        nextLine();
-        SMBX64::ReadUInt(&file_format, line);
+        readField(CSVBool, &FileData.fullScreen);
+    }
 
-        //Full screen mode
-        if(ge(16))
+    for(unsigned int i = 0; i < 2; i++)
+    {
+        SMBX64_ConfigPlayer plr;
+        readField(UInt, &plr.controllerType);
+        readField(UInt, &plr.k_up);
+        readField(UInt, &plr.k_down);
+        readField(UInt, &plr.k_left);
+        readField(UInt, &plr.k_right);
+        readField(UInt, &plr.k_run);
+        readField(UInt, &plr.k_jump);
+        readField(UInt, &plr.k_drop);
+        readField(UInt, &plr.k_pause);
+
+        if(ge(19))
         {
-            nextLine();
-            SMBX64::ReadCSVBool(&FileData.fullScreen, line);
+            readField(UInt, &plr.k_altjump);
+            readField(UInt, &plr.k_altrun);
         }
 
-        for(unsigned int i = 0; i < 2; i++)
+        readField(UInt, &plr.j_run);
+        readField(UInt, &plr.j_jump);
+        readField(UInt, &plr.j_drop);
+        readField(UInt, &plr.j_pause);
+
+        if(ge(19))
         {
-            SMBX64_ConfigPlayer plr;
-            nextLine();
-            SMBX64::ReadUInt(&plr.controllerType, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.k_up, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.k_down, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.k_left, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.k_right, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.k_run, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.k_jump, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.k_drop, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.k_pause, line);
-
-            if(ge(19))
-            {
-                nextLine();
-                SMBX64::ReadUInt(&plr.k_altjump, line);
-                nextLine();
-                SMBX64::ReadUInt(&plr.k_altrun, line);
-            }
-
-            nextLine();
-            SMBX64::ReadUInt(&plr.j_run, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.j_jump, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.j_drop, line);
-            nextLine();
-            SMBX64::ReadUInt(&plr.j_pause, line);
-
-            if(ge(19))
-            {
-                nextLine();
-                SMBX64::ReadUInt(&plr.j_altjump, line);
-                nextLine();
-                SMBX64::ReadUInt(&plr.j_altrun, line);
-            }
-
-            plr.id = i + 1;
-            FileData.players.push_back(plr);
+            readField(UInt, &plr.j_altjump);
+            readField(UInt, &plr.j_altrun);
         }
 
-        ///////////////////////////////////////EndFile///////////////////////////////////////
-        FileData.meta.ReadFileValid = true;
-        return true;
-    }
-    catch(const std::exception &err)
-    {
-        if(file_format > 0)
-            FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
-        else
-            FileData.meta.ERROR_info = "It is not an SMBX game settings file\n";
-
-#ifdef PGE_FILES_QT
-        FileData.meta.ERROR_info += QString::fromStdString(exception_to_pretty_string(err));
-#else
-        FileData.meta.ERROR_info += exception_to_pretty_string(err);
-#endif
-        FileData.meta.ERROR_linenum = in.getCurrentLineNumber();
-        FileData.meta.ERROR_linedata = std::move(line);
-        FileData.meta.ReadFileValid = false;
-        PGE_CutLength(FileData.meta.ERROR_linedata, 50);
-        PGE_FilterBinary(FileData.meta.ERROR_linedata);
-        return false;
+        plr.id = i + 1;
+        FileData.players.push_back(plr);
     }
+
+    ///////////////////////////////////////EndFile///////////////////////////////////////
+    FileData.meta.ReadFileValid = true;
+    return true;
+
+badfile:
+    if(file_format > 0)
+        FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
+    else
+        FileData.meta.ERROR_info = "It is not an SMBX game settings file\n";
+
+    FileData.meta.ERROR_info += cursor.errorString();
+    FileData.meta.ERROR_linenum = cursor.errorLine();
+    FileData.meta.ERROR_linedata = std::move(line);
+    FileData.meta.ReadFileValid = false;
+    PGE_CutLength(FileData.meta.ERROR_linedata, 50);
+    PGE_FilterBinary(FileData.meta.ERROR_linedata);
+    return false;
 }
 
 //*********************************************************
@@ -185,7 +157,10 @@ bool FileFormats::WriteSMBX64ConfigFileF(const PGESTRING &filePath, SMBX64_Confi
         return false;
     }
 
-    return WriteSMBX64ConfigFile(file, FileData, file_format);
+    if(!WriteSMBX64ConfigFile(file, FileData, file_format))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, FileData.meta.ERROR_info);
 }
 
 bool FileFormats::WriteSMBX64ConfigFileRaw(SMBX64_ConfigFile &FileData, PGESTRING &rawdata, unsigned int file_format)
@@ -29,7 +29,6 @@
 #include "wld_filedata.h"
 #include "smbx64.h"
 #include "smbx64_macro.h"
-#include "CSVUtils.h"
 
 //*********************************************************
 //****************READ FILE FORMAT*************************
@@ -75,8 +74,7 @@ bool FileFormats::ReadSMBX64WldFileHeaderT(PGE_FileFormats_misc::TextInput &inf,
     FileData.meta.filename = in_1.basename();
     FileData.meta.path = in_1.dirpath();
     inf.seek(0, PGE_FileFormats_misc::TextFileInput::begin);
-    SMBX64_FileBegin();
-#define nextLineH() inf.readCVSLine(line)
+    SMBX64_CursorBegin(inf);
     FileData.meta.RecentFormat = WorldData::SMBX64;
     FileData.meta.RecentFormatVersion = 64;
 
@@ -87,97 +85,72 @@ bool FileFormats::ReadSMBX64WldFileHeaderT(PGE_FileFormats_misc::TextInput &inf,
     FileData.meta.smbx64strict = true;
     FileData.nocharacter.clear();
 
-    try
-    {
-        nextLineH();   //Read first Line
-        SMBX64::ReadUInt(&file_format, line); //File format number
-        FileData.meta.RecentFormatVersion = file_format;
-
-        nextLineH();
-        SMBX64::ReadStr(&FileData.EpisodeTitle, line); //Episode name
-
-        if(ge(55))
-        {
-            nextLineH();
-            SMBX64::ReadCSVBool(&FileData.nocharacter1, line);//Edisode without Mario
-            nextLineH();
-            SMBX64::ReadCSVBool(&FileData.nocharacter2, line);//Edisode without Luigi
-            nextLineH();
-            SMBX64::ReadCSVBool(&FileData.nocharacter3, line);//Edisode without Peach
-            nextLineH();
-            SMBX64::ReadCSVBool(&FileData.nocharacter4, line);//Edisode without Toad
-            if(ge(56))
-            {
-                nextLineH();
-                SMBX64::ReadCSVBool(&FileData.nocharacter5, line);//Edisode without Link
-            }
-            //Convert into the bool array
-            FileData.nocharacter.push_back(FileData.nocharacter1);
-            FileData.nocharacter.push_back(FileData.nocharacter2);
-            FileData.nocharacter.push_back(FileData.nocharacter3);
-            FileData.nocharacter.push_back(FileData.nocharacter4);
-            FileData.nocharacter.push_back(FileData.nocharacter5);
-        }
+    readField(UInt, &file_format); //File format number
+    FileData.meta.RecentFormatVersion = file_format;
 
-        if(ge(3))
-        {
-            nextLineH();
-            SMBX64::ReadStr(&FileData.IntroLevel_file, line);//Autostart level
-            nextLineH();
-            SMBX64::ReadCSVBool(&FileData.HubStyledWorld, line); //Don't use world map on this episode
-            nextLineH();
-            SMBX64::ReadCSVBool(&FileData.restartlevel, line);//Restart level on playable character's death
-        }
+    readField(Str, &FileData.EpisodeTitle); //Episode name
 
-        if(ge(20))
+    if(ge(55))
+    {
+        readField(CSVBool, &FileData.nocharacter1); //Edisode without Mario
+        readField(CSVBool, &FileData.nocharacter2); //Edisode without Luigi
+        readField(CSVBool, &FileData.nocharacter3); //Edisode without Peach
+        readField(CSVBool, &FileData.nocharacter4); //Edisode without Toad
+        if(ge(56))
         {
-            nextLineH();
-            SMBX64::ReadUInt(&FileData.stars, line);//Stars number
+            readField(CSVBool, &FileData.nocharacter5); //Edisode without Link
         }
+        //Convert into the bool array
+        FileData.nocharacter.push_back(FileData.nocharacter1);
+        FileData.nocharacter.push_back(FileData.nocharacter2);
+        FileData.nocharacter.push_back(FileData.nocharacter3);
+        FileData.nocharacter.push_back(FileData.nocharacter4);
+        FileData.nocharacter.push_back(FileData.nocharacter5);
+    }
 
-        if(file_format >= 17)
-        {
-            nextLineH();
-            SMBX64::ReadStr(&FileData.author1, line); //Author 1
-            nextLineH();
-            SMBX64::ReadStr(&FileData.author2, line); //Author 2
-            nextLineH();
-            SMBX64::ReadStr(&FileData.author3, line); //Author 3
-            nextLineH();
-            SMBX64::ReadStr(&FileData.author4, line); //Author 4
-            nextLineH();
-            SMBX64::ReadStr(&FileData.author5, line); //Author 5
-
-            FileData.authors.clear();
-            FileData.authors += (IsEmpty(FileData.author1)) ? "" : FileData.author1 + "\n";
-            FileData.authors += (IsEmpty(FileData.author2)) ? "" : FileData.author2 + "\n";
-            FileData.authors += (IsEmpty(FileData.author3)) ? "" : FileData.author3 + "\n";
-            FileData.authors += (IsEmpty(FileData.author4)) ? "" : FileData.author4 + "\n";
-            FileData.authors += (IsEmpty(FileData.author5)) ? "" : FileData.author5;
-        }
+    if(ge(3))
+    {
+        readField(Str, &FileData.IntroLevel_file); //Autostart level
+        readField(CSVBool, &FileData.HubStyledWorld); //Don't use world map on this episode
+        readField(CSVBool, &FileData.restartlevel); //Restart level on playable character's death
+    }
 
-        FileData.meta.ReadFileValid = true;
-        return true;
+    if(ge(20))
+    {
+        readField(UInt, &FileData.stars); //Stars number
     }
-    catch(const std::exception &err)
+
+    if(file_format >= 17)
     {
-        if(file_format > 0)
-            FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
-        else
-            FileData.meta.ERROR_info = "It is not an SMBX world map file\n";
-#ifdef PGE_FILES_QT
-        FileData.meta.ERROR_info += QString::fromStdString(exception_to_pretty_string(err));
-#else
-        FileData.meta.ERROR_info += exception_to_pretty_string(err);
-#endif
-        FileData.meta.ERROR_linenum = inf.getCurrentLineNumber();
-        FileData.meta.ERROR_linedata = std::move(line);
-        FileData.meta.ReadFileValid = false;
-        PGE_CutLength(FileData.meta.ERROR_linedata, 50);
-        PGE_FilterBinary(FileData.meta.ERROR_linedata);
-        return false;
+        readField(Str, &FileData.author1); //Author 1
+        readField(Str, &FileData.author2); //Author 2
+        readField(Str, &FileData.author3); //Author 3
+        readField(Str, &FileData.author4); //Author 4
+        readField(Str, &FileData.author5); //Author 5
+
+        FileData.authors.clear();
+        FileData.authors += (IsEmpty(FileData.author1)) ? "" : FileData.author1 + "\n";
+        FileData.authors += (IsEmpty(FileData.author2)) ? "" : FileData.author2 + "\n";
+        FileData.authors += (IsEmpty(FileData.author3)) ? "" : FileData.author3 + "\n";
+        FileData.authors += (IsEmpty(FileData.author4)) ? "" : FileData.author4 + "\n";
+        FileData.authors += (IsEmpty(FileData.author5)) ? "" : FileData.author5;
     }
-#undef nextLineH
+
+    FileData.meta.ReadFileValid = true;
+    return true;
+
+badfile:
+    if(file_format > 0)
+        FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
+    else
+        FileData.meta.ERROR_info = "It is not an SMBX world map file\n";
+    FileData.meta.ERROR_info += cursor.errorString();
+    FileData.meta.ERROR_linenum = cursor.errorLine();
+    FileData.meta.ERROR_linedata = std::move(line);
+    FileData.meta.ReadFileValid = false;
+    PGE_CutLength(FileData.meta.ERROR_linedata, 50);
+    PGE_FilterBinary(FileData.meta.ERROR_linedata);
+    return false;
 }
 
 
@@ -212,9 +185,9 @@ bool FileFormats::ReadSMBX64WldFileRaw(PGESTRING &rawdata, const PGESTRING &file
     return ReadSMBX64WldFile(file, FileData);
 }
 
-bool FileFormats::ReadSMBX64WldFile(PGE_FileFormats_misc::TextInput &in, WorldData &FileData)
+bool FileFormats::ReadSMBX64WldFile(PGE_FileFormats_misc::TextInput &in, WorldData &FileData, uint32_t loadSections)
 {
-    SMBX64_FileBegin();
+    SMBX64_CursorBegin(in);
     PGESTRING filePath = in.getFilePath();
 
     CreateWorldData(FileData);
@@ -242,239 +215,202 @@ bool FileFormats::ReadSMBX64WldFile(PGE_FileFormats_misc::TextInput &in, WorldDa
     WorldLevelTile lvlitem;
     WorldMusicBox musicbox;
 
-    try
-    {
-        ///////////////////////////////////////Begin file///////////////////////////////////////
-        //File format number
-        nextLine();
-        SMBX64::ReadUInt(&file_format, line);
-        FileData.meta.RecentFormatVersion = file_format;
+    ///////////////////////////////////////Begin file///////////////////////////////////////
+    //File format number
+    readField(UInt, &file_format);
+    FileData.meta.RecentFormatVersion = file_format;
 
-        //Episode title
-        nextLine();
-        SMBX64::ReadStr(&FileData.EpisodeTitle, line);
+    //Episode title
+    readField(Str, &FileData.EpisodeTitle);
 
-        if(ge(55))
+    if(ge(55))
+    {
+        readField(CSVBool, &FileData.nocharacter1); //Edisode without Mario
+        readField(CSVBool, &FileData.nocharacter2); //Edisode without Luigi
+        readField(CSVBool, &FileData.nocharacter3); //Edisode without Peach
+        readField(CSVBool, &FileData.nocharacter4); //Edisode without Toad
+        if(ge(56))
         {
-            nextLine();
-            SMBX64::ReadCSVBool(&FileData.nocharacter1, line);//Edisode without Mario
-            nextLine();
-            SMBX64::ReadCSVBool(&FileData.nocharacter2, line);//Edisode without Luigi
-            nextLine();
-            SMBX64::ReadCSVBool(&FileData.nocharacter3, line);//Edisode without Peach
-            nextLine();
-            SMBX64::ReadCSVBool(&FileData.nocharacter4, line);//Edisode without Toad
-            if(ge(56))
-            {
-                nextLine();
-                SMBX64::ReadCSVBool(&FileData.nocharacter5, line);//Edisode without Link
-            }
-            //Convert into the bool array
-            FileData.nocharacter.push_back(FileData.nocharacter1);
-            FileData.nocharacter.push_back(FileData.nocharacter2);
-            FileData.nocharacter.push_back(FileData.nocharacter3);
-            FileData.nocharacter.push_back(FileData.nocharacter4);
-            FileData.nocharacter.push_back(FileData.nocharacter5);
+            readField(CSVBool, &FileData.nocharacter5); //Edisode without Link
         }
+        //Convert into the bool array
+        FileData.nocharacter.push_back(FileData.nocharacter1);
+        FileData.nocharacter.push_back(FileData.nocharacter2);
+        FileData.nocharacter.push_back(FileData.nocharacter3);
+        FileData.nocharacter.push_back(FileData.nocharacter4);
+        FileData.nocharacter.push_back(FileData.nocharacter5);
+    }
 
-        if(ge(3))
-        {
-            nextLine();
-            SMBX64::ReadStr(&FileData.IntroLevel_file, line);//Autostart level
-            nextLine();
-            SMBX64::ReadCSVBool(&FileData.HubStyledWorld, line); //Don't use world map on this episode
-            nextLine();
-            SMBX64::ReadCSVBool(&FileData.restartlevel, line);//Restart level on playable character's death
-        }
+    if(ge(3))
+    {
+        readField(Str, &FileData.IntroLevel_file); //Autostart level
+        readField(CSVBool, &FileData.HubStyledWorld); //Don't use world map on this episode
+        readField(CSVBool, &FileData.restartlevel); //Restart level on playable character's death
+    }
 
-        if(ge(20))
-        {
-            nextLine();
-            SMBX64::ReadUInt(&FileData.stars, line);//Stars number
-        }
+    if(ge(20))
+    {
+        readField(UInt, &FileData.stars); //Stars number
+    }
 
-        if(file_format >= 17)
-        {
-            nextLine();
-            SMBX64::ReadStr(&FileData.author1, line); //Author 1
-            nextLine();
-            SMBX64::ReadStr(&FileData.author2, line); //Author 2
-            nextLine();
-            SMBX64::ReadStr(&FileData.author3, line); //Author 3
-            nextLine();
-            SMBX64::ReadStr(&FileData.author4, line); //Author 4
-            nextLine();
-            SMBX64::ReadStr(&FileData.author5, line); //Author 5
-
-            FileData.authors.clear();
-            FileData.authors += (IsEmpty(FileData.author1)) ? "" : FileData.author1 + "\n";
-            FileData.authors += (IsEmpty(FileData.author2)) ? "" : FileData.author2 + "\n";
-            FileData.authors += (IsEmpty(FileData.author3)) ? "" : FileData.author3 + "\n";
-            FileData.authors += (IsEmpty(FileData.author4)) ? "" : FileData.author4 + "\n";
-            FileData.authors += (IsEmpty(FileData.author5)) ? "" : FileData.author5;
-        }
+    if(file_format >= 17)
+    {
+        readField(Str, &FileData.author1); //Author 1
+        readField(Str, &FileData.author2); //Author 2
+        readField(Str, &FileData.author3); //Author 3
+        readField(Str, &FileData.author4); //Author 4
+        readField(Str, &FileData.author5); //Author 5
+
+        FileData.authors.clear();
+        FileData.authors += (IsEmpty(FileData.author1)) ? "" : FileData.author1 + "\n";
+        FileData.authors += (IsEmpty(FileData.author2)) ? "" : FileData.author2 + "\n";
+        FileData.authors += (IsEmpty(FileData.author3)) ? "" : FileData.author3 + "\n";
+        FileData.authors += (IsEmpty(FileData.author4)) ? "" : FileData.author4 + "\n";
+        FileData.authors += (IsEmpty(FileData.author5)) ? "" : FileData.author5;
+    }
 
 
-        ////////////Tiles Data//////////
-        nextLine();
-        while((line != "next") && (!in.eof()))
-        {
-            tile = CreateWldTile();
-            SMBX64::ReadSIntFromFloat(&tile.x, line);//Tile x
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&tile.y, line);//Tile y
-            nextLine();
-            SMBX64::ReadUInt(&tile.id, line);//Tile ID
-
-            tile.meta.array_id = FileData.tile_array_id;
-            FileData.tile_array_id++;
-            tile.meta.index = (unsigned int)FileData.tiles.size(); //Apply element index
-
-            FileData.tiles.push_back(tile);
-            nextLine();
-        }
+    ////////////Tiles Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_TILES))
+        SMBX64::SkipRecords(in, line, 3);
+    while((line != "next") && (!in.eof()))
+    {
+        tile = CreateWldTile();
+        convField(SIntFromFloat, &tile.x);//Tile x
+        readField(SIntFromFloat, &tile.y); //Tile y
+        readField(UInt, &tile.id); //Tile ID
+
+        tile.meta.array_id = FileData.tile_array_id;
+        FileData.tile_array_id++;
+        tile.meta.index = (unsigned int)FileData.tiles.size(); //Apply element index
 
-        ////////////Scenery Data//////////
+        FileData.tiles.push_back(tile);
         nextLine();
-        while((line != "next")  && (!in.eof()))
-        {
-            scen = CreateWldScenery();
-            SMBX64::ReadSIntFromFloat(&scen.x, line);//Scenery x
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&scen.y, line);//Scenery y
-            nextLine();
-            SMBX64::ReadUInt(&scen.id, line);//Scenery ID
+    }
 
-            scen.meta.array_id = FileData.scene_array_id;
-            FileData.scene_array_id++;
-            scen.meta.index = (unsigned int)FileData.scenery.size(); //Apply element index
+    ////////////Scenery Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_SCENERY))
+        SMBX64::SkipRecords(in, line, 3);
+    while((line != "next")  && (!in.eof()))
+    {
+        scen = CreateWldScenery();
+        convField(SIntFromFloat, &scen.x);//Scenery x
+        readField(SIntFromFloat, &scen.y); //Scenery y
+        readField(UInt, &scen.id); //Scenery ID
 
-            FileData.scenery.push_back(scen);
+        scen.meta.array_id = FileData.scene_array_id;
+        FileData.scene_array_id++;
+        scen.meta.index = (unsigned int)FileData.scenery.size(); //Apply element index
 
-            nextLine();
-        }
+        FileData.scenery.push_back(scen);
 
-        ////////////Paths Data//////////
         nextLine();
-        while((line != "next") && (!in.eof()))
-        {
-            pathitem = CreateWldPath();
-            SMBX64::ReadSIntFromFloat(&pathitem.x, line);//Path x
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&pathitem.y, line);//Path y
-            nextLine();
-            SMBX64::ReadUInt(&pathitem.id, line); //Path ID
+    }
 
-            pathitem.meta.array_id = FileData.path_array_id;
-            FileData.path_array_id++;
-            pathitem.meta.index = (unsigned int)FileData.paths.size(); //Apply element index
+    ////////////Paths Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_PATHS))
+        SMBX64::SkipRecords(in, line, 3);
+    while((line != "next") && (!in.eof()))
+    {
+        pathitem = CreateWldPath();
+        convField(SIntFromFloat, &pathitem.x);//Path x
+        readField(SIntFromFloat, &pathitem.y); //Path y
+        readField(UInt, &pathitem.id); //Path ID
 
-            FileData.paths.push_back(pathitem);
+        pathitem.meta.array_id = FileData.path_array_id;
+        FileData.path_array_id++;
+        pathitem.meta.index = (unsigned int)FileData.paths.size(); //Apply element index
 
-            nextLine();
-        }
+        FileData.paths.push_back(pathitem);
 
-        ////////////LevelBox Data//////////
         nextLine();
-        while((line != "next")  && (!in.eof()))
+    }
+
+    ////////////LevelBox Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_LEVELS))
+        SMBX64::SkipRecords(in, line, 9 + (ge(4) ? 1 : 0) + (ge(22) ? 6 : 0));
+    while((line != "next")  && (!in.eof()))
+    {
+        lvlitem = CreateWldLevel();
+
+        convField(SIntFromFloat, &lvlitem.x);//Level x
+        readField(SIntFromFloat, &lvlitem.y); //Level y
+        readField(UInt, &lvlitem.id); //Level ID
+        readField(Str, &lvlitem.lvlfile); //Level file
+        readField(Str, &lvlitem.title); //Level title
+        readField(SInt, &lvlitem.top_exit); //Top exit
+        readField(SInt, &lvlitem.left_exit); //Left exit
+        readField(SInt, &lvlitem.bottom_exit); //bottom exit
+        readField(SInt, &lvlitem.right_exit); //right exit
+        if(ge(4))
         {
-            lvlitem = CreateWldLevel();
-
-            SMBX64::ReadSIntFromFloat(&lvlitem.x, line);//Level x
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&lvlitem.y, line);//Level y
-            nextLine();
-            SMBX64::ReadUInt(&lvlitem.id, line);//Level ID
-            nextLine();
-            SMBX64::ReadStr(&lvlitem.lvlfile, line);//Level file
-            nextLine();
-            SMBX64::ReadStr(&lvlitem.title, line);//Level title
-            nextLine();
-            SMBX64::ReadSInt(&lvlitem.top_exit, line);//Top exit
-            nextLine();
-            SMBX64::ReadSInt(&lvlitem.left_exit, line);//Left exit
-            nextLine();
-            SMBX64::ReadSInt(&lvlitem.bottom_exit, line);//bottom exit
-            nextLine();
-            SMBX64::ReadSInt(&lvlitem.right_exit, line);//right exit
-            if(ge(4))
-            {
-                nextLine();    //Enter via Level's warp
-                SMBX64::ReadUInt(&lvlitem.entertowarp, line);
-            }
-
-            if(ge(22))
-            {
-                nextLine();
-                SMBX64::ReadCSVBool(&lvlitem.alwaysVisible, line);//Always Visible
-                nextLine();
-                SMBX64::ReadCSVBool(&lvlitem.pathbg, line);//Path background
-                nextLine();
-                SMBX64::ReadCSVBool(&lvlitem.gamestart, line);//Game start point
-                nextLine();
-                SMBX64::ReadSInt(&lvlitem.gotox, line);//Goto x on World map
-                nextLine();
-                SMBX64::ReadSInt(&lvlitem.gotoy, line);//Goto y on World map
-                nextLine();
-                SMBX64::ReadCSVBool(&lvlitem.bigpathbg, line);//Big Path background
-            }
-            else
-            {
-                if(lvlitem.id == 1)
-                    lvlitem.gamestart = true;
-            }
-
-            lvlitem.meta.array_id = FileData.level_array_id;
-            FileData.level_array_id++;
-            lvlitem.meta.index = (unsigned int)FileData.levels.size(); //Apply element index
-
-            FileData.levels.push_back(lvlitem);
-
-            nextLine();
+            readField(UInt, &lvlitem.entertowarp); //Enter via Level's warp
         }
 
-        ////////////MusicBox Data//////////
-        nextLine();
-        while((line != "next") && (!IsEmpty(line)) && (!in.eof()))
+        if(ge(22))
         {
-            musicbox = CreateWldMusicbox();
-            SMBX64::ReadSIntFromFloat(&musicbox.x, line);//MusicBox x
-            nextLine();
-            SMBX64::ReadSIntFromFloat(&musicbox.y, line);//MusicBox y
-            nextLine();
-            SMBX64::ReadUInt(&musicbox.id, line);//MusicBox ID
+            readField(CSVBool, &lvlitem.alwaysVisible); //Always Visible
+            readField(CSVBool, &lvlitem.pathbg); //Path background
+            readField(CSVBool, &lvlitem.gamestart); //Game start point
+            readField(SInt, &lvlitem.gotox); //Goto x on World map
+            readField(SInt, &lvlitem.gotoy); //Goto y on World map
+            readField(CSVBool, &lvlitem.bigpathbg); //Big Path background
+        }
+        else
+        {
+            if(lvlitem.id == 1)
+                lvlitem.gamestart = true;
+        }
 
-            musicbox.meta.array_id = FileData.musicbox_array_id;
-            FileData.musicbox_array_id++;
-            musicbox.meta.index = (unsigned int)FileData.music.size(); //Apply element index
+        lvlitem.meta.array_id = FileData.level_array_id;
+        FileData.level_array_id++;
+        lvlitem.meta.index = (unsigned int)FileData.levels.size(); //Apply element index
 
-            FileData.music.push_back(musicbox);
+        FileData.levels.push_back(lvlitem);
 
-            nextLine();
-        }
-        nextLine(); // Read last line
-        ///////////////////////////////////////EndFile///////////////////////////////////////
-        FileData.meta.ReadFileValid = true;
-        return true;
+        nextLine();
     }
-    catch(const std::exception &err)
+
+    ////////////MusicBox Data//////////
+    nextLine();
+    if(!(loadSections & LOAD_MUSICBOXES))
+        SMBX64::SkipRecords(in, line, 3);
+    while((line != "next") && (!IsEmpty(line)) && (!in.eof()))
     {
-        if(file_format > 0)
-            FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
-        else
-            FileData.meta.ERROR_info = "It is not an SMBX world map file\n";
-#ifdef PGE_FILES_QT
-        FileData.meta.ERROR_info += QString::fromStdString(exception_to_pretty_string(err));
-#else
-        FileData.meta.ERROR_info += exception_to_pretty_string(err);
-#endif
-        FileData.meta.ERROR_linenum  = in.getCurrentLineNumber();
-        FileData.meta.ERROR_linedata = std::move(line);
-        FileData.meta.ReadFileValid  = false;
-        PGE_CutLength(FileData.meta.ERROR_linedata, 50);
-        PGE_FilterBinary(FileData.meta.ERROR_linedata);
-        return false;
+        musicbox = CreateWldMusicbox();
+        convField(SIntFromFloat, &musicbox.x);//MusicBox x
+        readField(SIntFromFloat, &musicbox.y); //MusicBox y
+        readField(UInt, &musicbox.id); //MusicBox ID
+
+        musicbox.meta.array_id = FileData.musicbox_array_id;
+        FileData.musicbox_array_id++;
+        musicbox.meta.index = (unsigned int)FileData.music.size(); //Apply element index
+
+        FileData.music.push_back(musicbox);
+
+        nextLine();
     }
+    nextLine(); // Read last line
+    ///////////////////////////////////////EndFile///////////////////////////////////////
+    FileData.meta.ReadFileValid = true;
+    return true;
+
+badfile:
+    if(file_format > 0)
+        FileData.meta.ERROR_info = "Detected file format: SMBX-" + fromNum(file_format) + " is invalid\n";
+    else
+        FileData.meta.ERROR_info = "It is not an SMBX world map file\n";
+    FileData.meta.ERROR_info += cursor.errorString();
+    FileData.meta.ERROR_linenum  = cursor.errorLine();
+    FileData.meta.ERROR_linedata = std::move(line);
+    FileData.meta.ReadFileValid  = false;
+    PGE_CutLength(FileData.meta.ERROR_linedata, 50);
+    PGE_FilterBinary(FileData.meta.ERROR_linedata);
+    return false;
 }
 
 
@@ -491,7 +427,10 @@ bool FileFormats::WriteSMBX64WldFileF(const PGESTRING &filePath, WorldData &File
         FileData.meta.ERROR_info = "Failed to open file for write";
         return false;
     }
-    return WriteSMBX64WldFile(file, FileData, file_format);
+    if(!WriteSMBX64WldFile(file, FileData, file_format))
+        return false;
+
+    return PGE_FileFormats_misc::TextFileOutput::closeWritten(file, FileData.meta.ERROR_info);
 }
 
 bool FileFormats::WriteSMBX64WldFileRaw(WorldData &FileData, PGESTRING &rawdata, unsigned int file_format)
@@ -25,6 +25,10 @@
  */
 
 #include "smbx64.h"
+#ifndef PGE_FILES_QT
+#include <cstdlib>
+#include <cerrno>
+#endif
 
 namespace smbx64Format
 {
@@ -207,3 +211,167 @@ bool SMBX64::IsQuotedString(const PGESTRING &in)
 #undef QStrGOOD
 #undef QStrBAD
 }
+
+
+
+// /////////////Non-throwing parsers///////////////
+
+#ifndef PGE_FILES_QT
+/*!
+ * \brief Fast path for plain decimal numbers: optional minus and up to maxDigits digits
+ * \return false if the value has any other syntax, then the C library parser is needed
+ */
+static inline bool parsePlainDecimal(const PGESTRING &in, bool allowMinus, pge_size_t maxDigits, long long &out)
+{
+    const char *s = in.c_str();
+    const char *e = s + in.size();
+    bool neg = false;
+
+    if(allowMinus && (s != e) && (*s == '-'))
+    {
+        neg = true;
+        ++s;
+    }
+
+    if((s == e) || (static_cast<pge_size_t>(e - s) > maxDigits))
+        return false;
+
+    long long v = 0;
+    for(; s != e; ++s)
+    {
+        if((*s < '0') || (*s > '9'))
+            return false;
+        v = (v * 10) + (*s - '0');
+    }
+
+    out = neg ? -v : v;
+    return true;
+}
+#endif
+
+bool SMBX64::ParseUInt(const PGESTRING &in, unsigned long long &out)
+{
+#ifdef PGE_FILES_QT
+    bool ok = true;
+    out = in.toULongLong(&ok);
+    return ok;
+#else
+    long long fast;
+    if(parsePlainDecimal(in, false, 18, fast))
+    {
+        out = static_cast<unsigned long long>(fast);
+        return true;
+    }
+
+    const char *begin = in.c_str();
+    char *end = nullptr;
+    errno = 0;
+    out = std::strtoull(begin, &end, 10);
+    return (end != begin) && (errno != ERANGE);
+#endif
+}
+
+bool SMBX64::ParseSInt(const PGESTRING &in, long long &out)
+{
+#ifdef PGE_FILES_QT
+    bool ok = true;
+    out = in.toLongLong(&ok);
+    return ok;
+#else
+    if(parsePlainDecimal(in, true, 18, out))
+        return true;
+
+    const char *begin = in.c_str();
+    char *end = nullptr;
+    errno = 0;
+    out = std::strtoll(begin, &end, 10);
+    return (end != begin) && (errno != ERANGE);
+#endif
+}
+
+bool SMBX64::ParseSIntFromFloat(const PGESTRING &in, long long &out)
+{
+    double v;
+#ifdef PGE_FILES_QT
+    bool ok = true;
+    v = in.toDouble(&ok);
+    if(!ok)
+        return false;
+#else
+    // Integers up to 15 digits are exact in double, no rounding is needed
+    if(parsePlainDecimal(in, true, 15, out))
+        return true;
+
+    const char *begin = in.c_str();
+    char *end = nullptr;
+    errno = 0;
+    v = std::strtod(begin, &end);
+    if((end == begin) || (errno == ERANGE))
+        return false;
+#endif
+    v = std::round(v);
+    // Also rejects NaN
+    if(!((v >= -9.2e18) && (v <= 9.2e18)))
+        return false;
+    out = static_cast<long long>(v);
+    return true;
+}
+
+bool SMBX64::ParseFloat(const PGESTRING &in, float &out)
+{
+#ifdef PGE_FILES_QT
+    bool ok = true;
+    out = in.toFloat(&ok);
+    return ok;
+#else
+    const char *begin = in.c_str();
+    char *end = nullptr;
+    errno = 0;
+    out = std::strtof(begin, &end);
+    return (end != begin) && (errno != ERANGE);
+#endif
+}
+
+bool SMBX64::ParseFloat(const PGESTRING &in, double &out)
+{
+#ifdef PGE_FILES_QT
+    bool ok = true;
+    out = in.toDouble(&ok);
+    return ok;
+#else
+    const char *begin = in.c_str();
+    char *end = nullptr;
+    errno = 0;
+    out = std::strtod(begin, &end);
+    return (end != begin) && (errno != ERANGE);
+#endif
+}
+
+bool SMBX64::ParseCSVBool(const PGESTRING &in, bool &out)
+{
+    if((in == "#FALSE#") || (in == "false") || (in == "0") || IsEmpty(in))
+        out = false;
+    else if((in == "#TRUE#") || (in == "true") || (in == "!0") || (in == "1"))
+        out = true;
+    else
+        return false;
+    return true;
+}
+
+PGESTRING SMBX64::FieldCursor::errorString() const
+{
+    switch(m_error)
+    {
+    case ERROR_NONE:
+        return "No errors";
+    case ERROR_UINT:
+        return "Invalid unsigned integer value";
+    case ERROR_SINT:
+        return "Invalid or out of range signed integer value";
+    case ERROR_FLOAT:
+        return "Invalid floating point value";
+    case ERROR_CSVBOOL:
+        return "Invalid CSV boolean value (must be #TRUE# or #FALSE#)";
+    }
+    return "Unknown error";
+}
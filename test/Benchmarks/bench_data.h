@@ -0,0 +1,247 @@
+#ifndef PGEFL_BENCH_DATA_H
+#define PGEFL_BENCH_DATA_H
+
+#include "file_formats.h"
+
+#ifndef TEST_WRITEDIR
+#   define TEST_WRITEDIR "."
+#endif
+
+/*
+ * Synthetic multi-megabyte test data used by benchmarks.
+ * Files are generated once per run and kept at the build directory.
+ */
+
+inline LevelData benchMakeLevel(size_t objects)
+{
+    LevelData lvl;
+    FileFormats::CreateLevelData(lvl);
+    lvl.LevelName = "Benchmark, big level";
+
+    for(size_t i = 0; i < objects; ++i)
+    {
+        long x = static_cast<long>(i % 1000) * 32 - 200000;
+        long y = static_cast<long>(i / 1000) * 32 - 200600;
+
+        LevelBlock b = FileFormats::CreateLvlBlock();
+        b.x = x;
+        b.y = y;
+        b.w = 32;
+        b.h = 32;
+        b.id = 1 + (i % 600);
+        b.npc_id = (i % 7 == 0) ? -10 : 0;
+        b.invisible = (i % 13 == 0);
+        b.slippery = (i % 17 == 0);
+        if(i % 11 == 0)
+            b.event_hit = "Block hit, number " + std::to_string(i % 20);
+        b.meta.array_id = lvl.blocks_array_id++;
+        b.meta.index = static_cast<unsigned int>(lvl.blocks.size());
+        lvl.blocks.push_back(b);
+
+        if(i % 3 == 0)
+        {
+            LevelBGO g = FileFormats::CreateLvlBgo();
+            g.x = x;
+            g.y = y - 32;
+            g.id = 1 + (i % 190);
+            g.meta.array_id = lvl.bgo_array_id++;
+            g.meta.index = static_cast<unsigned int>(lvl.bgo.size());
+            lvl.bgo.push_back(g);
+        }
+
+        if(i % 5 == 0)
+        {
+            LevelNPC n = FileFormats::CreateLvlNpc();
+            n.x = x;
+            n.y = y - 64;
+            n.id = 1 + (i % 300);
+            n.direct = (i % 2) ? 1 : -1;
+            n.msg = (i % 25 == 0) ? "Hello, world!" : "";
+            n.meta.array_id = lvl.npc_array_id++;
+            n.meta.index = static_cast<unsigned int>(lvl.npc.size());
+            lvl.npc.push_back(n);
+        }
+    }
+
+    return lvl;
+}
+
+inline LevelData benchMakeEventsLevel(size_t events)
+{
+    LevelData lvl;
+    FileFormats::CreateLevelData(lvl);
+    lvl.LevelName = "Benchmark, event-heavy level";
+
+    for(size_t i = 0; i < events; ++i)
+    {
+        LevelSMBX64Event e = FileFormats::CreateLvlEvent();
+        e.name = "Event " + std::to_string(i);
+        e.msg = (i % 4 == 0) ? "Hello, world!" : "";
+        e.layers_show.push_back("Layer " + std::to_string(i % 50));
+        e.trigger = "Event " + std::to_string((i + 1) % events);
+        e.trigger_timer = 10;
+
+        for(size_t s = 0; s < e.sets.size(); ++s)
+        {
+            LevelEvent_Sets &set = e.sets[s];
+            set.id = static_cast<long>(s);
+            set.music_id = static_cast<long>((i + s) % 60);
+            set.background_id = static_cast<long>((i + s) % 100);
+            if(s % 3 == 0)
+            {
+                set.position_left = -200000 + static_cast<long>(s) * 20000;
+                set.position_top = -200600;
+                set.position_bottom = -200000;
+                set.position_right = -199200 + static_cast<long>(s) * 20000;
+            }
+            set.autoscrol = (s % 7 == 0);
+            set.autoscrol_x = set.autoscrol ? 1.5f : 0.0f;
+        }
+
+        for(size_t m = 0; m < 2; ++m)
+        {
+            LevelEvent_MoveLayer ml;
+            ml.name = "Layer " + std::to_string((i + m) % 50);
+            ml.speed_x = 0.5 * static_cast<double>(m + 1);
+            ml.speed_y = -1.0;
+            e.moving_layers.push_back(ml);
+
+            LevelEvent_SpawnNPC sn;
+            sn.id = static_cast<long>(1 + (i + m) % 300);
+            sn.x = -199000 + static_cast<long>(i % 100) * 32;
+            sn.y = -200400;
+            sn.speed_x = 2.0;
+            e.spawn_npc.push_back(sn);
+        }
+
+        LevelEvent_SpawnEffect se;
+        se.id = static_cast<long>(1 + i % 150);
+        se.x = -199000;
+        se.y = -200400;
+        se.gravity = true;
+        se.fps = 30;
+        e.spawn_effects.push_back(se);
+
+        LevelEvent_UpdateVariable uv;
+        uv.name = "counter" + std::to_string(i % 10);
+        uv.newval = "counter" + std::to_string(i % 10) + "+1";
+        e.update_variable.push_back(uv);
+
+        e.meta.array_id = lvl.events_array_id++;
+        lvl.events.push_back(e);
+    }
+
+    return lvl;
+}
+
+inline WorldData benchMakeWorld(size_t objects)
+{
+    WorldData wld;
+    FileFormats::CreateWorldData(wld);
+    wld.EpisodeTitle = "Benchmark, big world";
+
+    for(size_t i = 0; i < objects; ++i)
+    {
+        long x = static_cast<long>(i % 1000) * 32 - 200000;
+        long y = static_cast<long>(i / 1000) * 32 - 200600;
+
+        WorldTerrainTile t = FileFormats::CreateWldTile();
+        t.x = x;
+        t.y = y;
+        t.id = 1 + (i % 300);
+        t.meta.array_id = wld.tile_array_id++;
+        t.meta.index = static_cast<unsigned int>(wld.tiles.size());
+        wld.tiles.push_back(t);
+
+        if(i % 4 == 0)
+        {
+            WorldScenery s = FileFormats::CreateWldScenery();
+            s.x = x;
+            s.y = y;
+            s.id = 1 + (i % 60);
+            s.meta.array_id = wld.scene_array_id++;
+            s.meta.index = static_cast<unsigned int>(wld.scenery.size());
+            wld.scenery.push_back(s);
+        }
+
+        if(i % 6 == 0)
+        {
+            WorldPathTile p = FileFormats::CreateWldPath();
+            p.x = x;
+            p.y = y;
+            p.id = 1 + (i % 30);
+            p.meta.array_id = wld.path_array_id++;
+            p.meta.index = static_cast<unsigned int>(wld.paths.size());
+            wld.paths.push_back(p);
+        }
+    }
+
+    return wld;
+}
+
+//! Path to the generated multi-megabyte SMBX64 level file
+inline PGESTRING benchBigLvlPath()
+{
+    static PGESTRING path;
+    if(path.empty())
+    {
+        LevelData lvl = benchMakeLevel(150000);
+        path = TEST_WRITEDIR "/bench-big.lvl";
+        FileFormats::WriteSMBX64LvlFileF(path, lvl);
+    }
+    return path;
+}
+
+//! Path to the generated multi-megabyte SMBX64 world file
+inline PGESTRING benchBigWldPath()
+{
+    static PGESTRING path;
+    if(path.empty())
+    {
+        WorldData wld = benchMakeWorld(250000);
+        path = TEST_WRITEDIR "/bench-big.wld";
+        FileFormats::WriteSMBX64WldFileF(path, wld);
+    }
+    return path;
+}
+
+//! Path to the generated multi-megabyte PGE-X level file
+inline PGESTRING benchBigLvlxPath()
+{
+    static PGESTRING path;
+    if(path.empty())
+    {
+        LevelData lvl = benchMakeLevel(150000);
+        path = TEST_WRITEDIR "/bench-big.lvlx";
+        FileFormats::WriteExtendedLvlFileF(path, lvl);
+    }
+    return path;
+}
+
+//! Path to the generated PGE-X level file with thousands of classic events
+inline PGESTRING benchEventsLvlxPath()
+{
+    static PGESTRING path;
+    if(path.empty())
+    {
+        LevelData lvl = benchMakeEventsLevel(3000);
+        path = TEST_WRITEDIR "/bench-events.lvlx";
+        FileFormats::WriteExtendedLvlFileF(path, lvl);
+    }
+    return path;
+}
+
+//! Path to the generated multi-megabyte PGE-X world file
+inline PGESTRING benchBigWldxPath()
+{
+    static PGESTRING path;
+    if(path.empty())
+    {
+        WorldData wld = benchMakeWorld(250000);
+        path = TEST_WRITEDIR "/bench-big.wldx";
+        FileFormats::WriteExtendedWldFileF(path, wld);
+    }
+    return path;
+}
+
+#endif // PGEFL_BENCH_DATA_H
@@ -0,0 +1,568 @@
+#include <catch_amalgamated.hpp>
+#include <cstdio>
+#include <algorithm>
+#include <sstream>
+#include <climits>
+#include <clocale>
+#include "file_formats.h"
+#include "pge_file_lib_private.h"
+#include "bench_data.h"
+
+/*
+ * Reference implementation of the per-character CSV field reader,
+ * used to verify the block-buffered TextFileInput and to compare speed.
+ */
+static bool refReadCVSLine(FILE *stream, std::string &buffer, long &lineNumber)
+{
+    buffer.clear();
+    bool quoteIsOpen = false;
+    int  gc;
+    char cur = 0;
+
+    if(feof(stream))
+        return false;
+
+    do
+    {
+        gc = fgetc(stream);
+        if(gc == EOF)
+            break;
+        cur = static_cast<char>(gc);
+        if(cur == '\"')
+            quoteIsOpen = !quoteIsOpen;
+        else
+        {
+            if((cur != '\r') && (((cur != '\n') && (cur != ',')) || (quoteIsOpen)))
+                buffer.push_back(cur);
+            if(cur == '\n')
+                lineNumber++;
+        }
+    }
+    while((((cur != '\n') && (cur != ',')) || quoteIsOpen));
+
+    return true;
+}
+
+static bool refReadLine(FILE *stream, std::string &out)
+{
+    int C = 0;
+    out.clear();
+    do
+    {
+        C = fgetc(stream);
+        if((C != '\n') && (C != '\r') && (C != EOF))
+            out.push_back(static_cast<char>(C));
+    }
+    while((C != '\n') && (C != EOF));
+    return !feof(stream);
+}
+
+static void writeRaw(const std::string &path, const std::string &data)
+{
+    FILE *f = fopen(path.c_str(), "wb");
+    REQUIRE(f);
+    fwrite(data.data(), 1, data.size(), f);
+    fclose(f);
+}
+
+static std::string makeTrickyCSV()
+{
+    std::string out;
+    // Make sure the data crosses the read buffer boundaries many times
+    for(int i = 0; i < 20000; ++i)
+    {
+        out += std::to_string(i) + "\r\n";
+        out += "\"quoted, with comma\",plain,\"\",\"multi\nline\r\nfield\"\n";
+        out += "#TRUE#,-" + std::to_string(i * 7) + ",\"\"\"\",\r\n";
+        if(i % 97 == 0)
+            out += "\n\n\r\n";
+    }
+    out += "last,field-without-newline";
+    return out;
+}
+
+TEMPLATE_TEST_CASE("[TextInput] File readers match per-character reader", "",
+                   PGE_FileFormats_misc::TextFileInput,
+                   PGE_FileFormats_misc::MappedTextInput)
+{
+    const std::string path = TEST_WRITEDIR "/bench-tricky.csv";
+    const std::string data = makeTrickyCSV();
+    writeRaw(path, data);
+
+    SECTION("readCVSLine")
+    {
+        FILE *ref = fopen(path.c_str(), "rb");
+        REQUIRE(ref);
+        TestType in(path);
+        std::string a, b;
+        long refLine = 0;
+        size_t fields = 0;
+
+        while(refReadCVSLine(ref, a, refLine))
+        {
+            in.readCVSLine(b);
+            REQUIRE(a == b);
+            REQUIRE(refLine == in.getCurrentLineNumber());
+            REQUIRE((feof(ref) != 0) == in.eof());
+            ++fields;
+        }
+
+        in.readCVSLine(b);
+        REQUIRE(b.empty());
+        REQUIRE(in.eof());
+        REQUIRE(fields > 100000);
+        fclose(ref);
+    }
+
+    SECTION("readLine")
+    {
+        FILE *ref = fopen(path.c_str(), "rb");
+        REQUIRE(ref);
+        TestType in(path);
+        std::string a, b;
+        bool more;
+
+        do
+        {
+            more = refReadLine(ref, a);
+            in.readLine(b);
+            REQUIRE(a == b);
+            REQUIRE((feof(ref) != 0) == in.eof());
+        } while(more);
+
+        fclose(ref);
+    }
+
+    SECTION("read, tell and seek")
+    {
+        TestType in(path);
+        std::string head, field;
+
+        in.read(head, 8);
+        REQUIRE(head == data.substr(0, 8));
+        REQUIRE(in.tell() == 8);
+
+        in.seek(0, PGE_FileFormats_misc::TextInput::begin);
+        REQUIRE(in.tell() == 0);
+        in.readCVSLine(field);
+        REQUIRE(field == "0");
+
+        in.seek(200000, PGE_FileFormats_misc::TextInput::begin);
+        REQUIRE(in.tell() == 200000);
+        in.read(head, 100);
+        REQUIRE(head == data.substr(200000, 100));
+
+        in.seek(-10, PGE_FileFormats_misc::TextInput::current);
+        REQUIRE(in.tell() == 200090);
+
+        in.read(head, static_cast<int64_t>(data.size()));
+        REQUIRE(head == data.substr(200090));
+        REQUIRE(in.eof());
+    }
+
+    SECTION("readAll")
+    {
+        TestType in(path);
+        std::string field;
+        in.readCVSLine(field);
+
+        std::string expected;
+        for(char c : data)
+        {
+            if(c != '\r')
+                expected.push_back(c);
+        }
+
+        REQUIRE(in.readAll() == expected);
+        REQUIRE(in.eof());
+    }
+}
+
+TEST_CASE("[TextInput] Small files are read at once")
+{
+    const std::string path = TEST_WRITEDIR "/bench-small.txt";
+    std::string data;
+    for(int i = 0; i < 2000; ++i)
+        data += "line " + std::to_string(i) + "\n";
+    writeRaw(path, data);
+
+    PGE_FileFormats_misc::MappedTextInput in(path);
+    REQUIRE(in.size() == data.size());
+
+    // Saving the file meanwhile truncates it, the opened data must stay readable
+    writeRaw(path, "");
+    REQUIRE(in.readAll() == data);
+    REQUIRE(std::string(in.data(), in.size()) == data);
+}
+
+static std::string readRaw(const std::string &path)
+{
+    std::string out;
+    FILE *f = fopen(path.c_str(), "rb");
+    REQUIRE(f);
+    char buf[4096];
+    size_t got;
+    while((got = fread(buf, 1, sizeof(buf), f)) > 0)
+        out.append(buf, got);
+    fclose(f);
+    return out;
+}
+
+TEST_CASE("[TextOutput] Written data matches the source")
+{
+    const std::string path = TEST_WRITEDIR "/bench-tricky-out.csv";
+    const std::string data = makeTrickyCSV();
+
+    std::string crlf;
+    for(char c : data)
+    {
+        if(c == '\n')
+            crlf += "\r\n";
+        else
+            crlf.push_back(c);
+    }
+
+    SECTION("CRLF expansion by pieces of different sizes")
+    {
+        PGE_FileFormats_misc::TextFileOutput out(path, false, true);
+        size_t pos = 0, piece = 1;
+        int64_t expected = 0;
+
+        while(pos < data.size())
+        {
+            size_t len = std::min(piece, data.size() - pos);
+            int written = out.write(data.data() + pos, len);
+            expected += static_cast<int64_t>(std::count(data.begin() + static_cast<long>(pos),
+                                                        data.begin() + static_cast<long>(pos + len), '\n') + len);
+            REQUIRE(written >= 0);
+            REQUIRE(out.tell() == expected);
+            pos += len;
+            piece = (piece * 7 + 3) % 100000;
+        }
+
+        out << std::string("\nend\n");
+        out.close();
+        REQUIRE(readRaw(path) == crlf + "\r\nend\r\n");
+    }
+
+    SECTION("Plain output")
+    {
+        PGE_FileFormats_misc::TextFileOutput out(path, false, false);
+        out << data;
+        out.close();
+        REQUIRE(readRaw(path) == data);
+    }
+
+    SECTION("Raw output overwrites and appends")
+    {
+        std::string raw = "0123456789";
+        PGE_FileFormats_misc::RawTextOutput out(&raw, PGE_FileFormats_misc::TextOutput::overwrite);
+        out.seek(7, PGE_FileFormats_misc::TextOutput::begin);
+        REQUIRE(out.write("abcdef", 6) == 6);
+        REQUIRE(raw == "0123456abcdef");
+        REQUIRE(out.tell() == 13);
+        out.seek(1, PGE_FileFormats_misc::TextOutput::begin);
+        out << "XY";
+        REQUIRE(raw == "0XY3456abcdef");
+    }
+
+    SECTION("Outputs implementing the string writer only")
+    {
+        struct StringOutput : public PGE_FileFormats_misc::TextOutput
+        {
+            std::string collected;
+            int write(PGESTRING buffer) override
+            {
+                collected += buffer;
+                return static_cast<int>(buffer.size());
+            }
+        } out;
+
+        out << "abc" << std::string("def");
+        REQUIRE(out.collected == "abcdef");
+    }
+}
+
+#ifdef __linux__
+TEST_CASE("[TextOutput] Failed writing of pending data is reported")
+{
+    // Every write into this device fails with "No space left on device"
+    PGE_FileFormats_misc::TextFileOutput out;
+    REQUIRE(out.open("/dev/full", false, true));
+    out.write("Some data\n");
+    REQUIRE(!out.close());
+
+    LevelData lvl = benchMakeLevel(100);
+    REQUIRE(!FileFormats::WriteSMBX64LvlFileF("/dev/full", lvl));
+    REQUIRE(lvl.meta.ERROR_info == "Failed to write file");
+    REQUIRE(!FileFormats::WriteExtendedLvlFileF("/dev/full", lvl));
+    REQUIRE(!FileFormats::WriteSMBX38ALvlFileF("/dev/full", lvl));
+
+    REQUIRE(out.open(TEST_WRITEDIR "/bench-close.txt", false, true));
+    out.write("Some data\n");
+    REQUIRE(out.close());
+}
+#endif
+
+TEST_CASE("[TextOutput] Write of big SMBX64 files", "[.benchmark]")
+{
+    // Keep the level within SMBX64 limits: the writer sorts blocks and BGOs
+    // on every call, and that sort degrades badly on huge sorted arrays
+    LevelData lvl = benchMakeLevel(16000);
+    WorldData wld;
+    REQUIRE(FileFormats::OpenWorldFile(benchBigWldPath(), wld));
+
+    BENCHMARK("LVL: WriteSMBX64LvlFileF")
+    {
+        return FileFormats::WriteSMBX64LvlFileF(TEST_WRITEDIR "/bench-save.lvl", lvl);
+    };
+
+    BENCHMARK("LVL: WriteSMBX64LvlFileRaw")
+    {
+        PGESTRING raw;
+        FileFormats::WriteSMBX64LvlFileRaw(lvl, raw);
+        return raw.size();
+    };
+
+    BENCHMARK("WLD: WriteSMBX64WldFileF")
+    {
+        return FileFormats::WriteSMBX64WldFileF(TEST_WRITEDIR "/bench-save.wld", wld);
+    };
+}
+
+template<typename T>
+static std::string refFromNum(T num)
+{
+    std::ostringstream n;
+    n << num;
+    return n.str();
+}
+
+TEST_CASE("[Numbers] Formatting matches the output stream")
+{
+    const double doubles[] =
+    {
+        0.0, -0.0, 1.0, -1.0, 0.5, -2.25, 999999.0, 1000000.0, -999999.0, 123456.7,
+        1e-5, 3.14159265358979, 1e300, -1e-300, 2147483648.0, 4.0 / 3.0, 0.1, 1e21
+    };
+
+    for(double v : doubles)
+    {
+        REQUIRE(fromNum(v) == refFromNum(v));
+        REQUIRE(fromNum(static_cast<float>(v)) == refFromNum(static_cast<float>(v)));
+    }
+
+    const long long ints[] = {0, 1, -1, 42, -42, INT_MAX, INT_MIN, LLONG_MAX, LLONG_MIN};
+
+    for(long long v : ints)
+    {
+        REQUIRE(fromNum(v) == refFromNum(v));
+        REQUIRE(fromNum(static_cast<int>(v)) == refFromNum(static_cast<int>(v)));
+        REQUIRE(fromNum(static_cast<unsigned int>(v)) == refFromNum(static_cast<unsigned int>(v)));
+        REQUIRE(fromNum(static_cast<unsigned long long>(v)) == refFromNum(static_cast<unsigned long long>(v)));
+        REQUIRE(fromNum(static_cast<short>(v)) == refFromNum(static_cast<short>(v)));
+    }
+
+    REQUIRE(fromNum(true) == refFromNum(true));
+    REQUIRE(fromNum('x') == refFromNum('x'));
+}
+
+TEST_CASE("[Numbers] Formatting ignores the C locale")
+{
+    const char *commaLocales[] = {"de_DE.UTF-8", "de_DE.utf8", "ru_RU.UTF-8", "fr_FR.UTF-8", "de_DE", "German"};
+    std::string oldLocale = std::setlocale(LC_NUMERIC, nullptr);
+    const char *used = nullptr;
+
+    for(const char *name : commaLocales)
+    {
+        if(std::setlocale(LC_NUMERIC, name) && std::localeconv()->decimal_point[0] == ',')
+        {
+            used = name;
+            break;
+        }
+    }
+
+    if(!used)
+    {
+        std::setlocale(LC_NUMERIC, oldLocale.c_str());
+        SKIP("No locale with the comma decimal point is installed");
+    }
+
+    INFO(used);
+    PGESTRING half = fromNum(0.5), small = fromNum(-1.25e-5f), big = fromNum(1234567.5);
+    std::setlocale(LC_NUMERIC, oldLocale.c_str());
+
+    REQUIRE(half == "0.5");
+    REQUIRE(small == "-1.25e-05");
+    REQUIRE(big == "1.23457e+06");
+}
+
+TEST_CASE("[Numbers] Formatting", "[.benchmark]")
+{
+    BENCHMARK("Integers via output stream (reference)")
+    {
+        size_t n = 0;
+        for(long i = -5000; i < 5000; ++i)
+            n += refFromNum(i * 37).size();
+        return n;
+    };
+
+    BENCHMARK("Integers via fromNum")
+    {
+        size_t n = 0;
+        for(long i = -5000; i < 5000; ++i)
+            n += fromNum(i * 37).size();
+        return n;
+    };
+
+    BENCHMARK("Floats via output stream (reference)")
+    {
+        size_t n = 0;
+        for(long i = -5000; i < 5000; ++i)
+            n += refFromNum(static_cast<double>(i) * 0.25).size();
+        return n;
+    };
+
+    BENCHMARK("Floats via fromNum")
+    {
+        size_t n = 0;
+        for(long i = -5000; i < 5000; ++i)
+            n += fromNum(static_cast<double>(i) * 0.25).size();
+        return n;
+    };
+}
+
+TEST_CASE("[SMBX-38A] Save of big files", "[.benchmark]")
+{
+    LevelData lvl = benchMakeLevel(150000);
+    WorldData wld = benchMakeWorld(250000);
+
+    BENCHMARK("LVL: WriteSMBX38ALvlFileRaw")
+    {
+        PGESTRING raw;
+        FileFormats::WriteSMBX38ALvlFileRaw(lvl, raw);
+        return raw.size();
+    };
+
+    BENCHMARK("WLD: WriteSMBX38AWldFileRaw")
+    {
+        PGESTRING raw;
+        FileFormats::WriteSMBX38AWldFileRaw(wld, raw);
+        return raw.size();
+    };
+}
+
+TEST_CASE("[TextInput] Read of big SMBX64 files", "[.benchmark]")
+{
+    const PGESTRING lvlPath = benchBigLvlPath();
+    const PGESTRING wldPath = benchBigWldPath();
+
+    BENCHMARK("LVL: fields via fgetc (reference)")
+    {
+        FILE *f = fopen(lvlPath.c_str(), "rb");
+        std::string field;
+        long line = 0;
+        size_t n = 0;
+        while(refReadCVSLine(f, field, line))
+            n += field.size();
+        fclose(f);
+        return n;
+    };
+
+    BENCHMARK("LVL: fields via TextFileInput")
+    {
+        PGE_FileFormats_misc::TextFileInput in(lvlPath);
+        std::string field;
+        size_t n = 0;
+        while(!in.eof())
+        {
+            in.readCVSLine(field);
+            n += field.size();
+        }
+        return n;
+    };
+
+    BENCHMARK("LVL: fields via MappedTextInput")
+    {
+        PGE_FileFormats_misc::MappedTextInput in(lvlPath);
+        std::string field;
+        size_t n = 0;
+        while(!in.eof())
+        {
+            in.readCVSLine(field);
+            n += field.size();
+        }
+        return n;
+    };
+
+    BENCHMARK("LVL: OpenLevelFile")
+    {
+        LevelData lvl;
+        FileFormats::OpenLevelFile(lvlPath, lvl);
+        return lvl.blocks.size();
+    };
+
+    BENCHMARK("LVL: OpenLevelFile, NPC only")
+    {
+        LevelData lvl;
+        FileFormats::OpenLevelFile(lvlPath, lvl, FileFormats::LOAD_NPC);
+        return lvl.npc.size();
+    };
+
+    BENCHMARK("LVL: OpenLevelFile, counting callbacks")
+    {
+        struct Counter : public LevelLoadCallbacks
+        {
+            size_t blocks = 0;
+            bool onBlock(LevelBlock &) override { ++blocks; return true; }
+        } counter;
+        LevelData head;
+        FileFormats::OpenLevelFile(lvlPath, head, counter);
+        return counter.blocks;
+    };
+
+    BENCHMARK("WLD: fields via fgetc (reference)")
+    {
+        FILE *f = fopen(wldPath.c_str(), "rb");
+        std::string field;
+        long line = 0;
+        size_t n = 0;
+        while(refReadCVSLine(f, field, line))
+            n += field.size();
+        fclose(f);
+        return n;
+    };
+
+    BENCHMARK("WLD: fields via TextFileInput")
+    {
+        PGE_FileFormats_misc::TextFileInput in(wldPath);
+        std::string field;
+        size_t n = 0;
+        while(!in.eof())
+        {
+            in.readCVSLine(field);
+            n += field.size();
+        }
+        return n;
+    };
+
+    BENCHMARK("WLD: fields via MappedTextInput")
+    {
+        PGE_FileFormats_misc::MappedTextInput in(wldPath);
+        std::string field;
+        size_t n = 0;
+        while(!in.eof())
+        {
+            in.readCVSLine(field);
+            n += field.size();
+        }
+        return n;
+    };
+
+    BENCHMARK("WLD: OpenWorldFile")
+    {
+        WorldData wld;
+        FileFormats::OpenWorldFile(wldPath, wld);
+        return wld.tiles.size();
+    };
+}
@@ -0,0 +1,546 @@
+#include <catch_amalgamated.hpp>
+#include "file_formats.h"
+#include "pge_x.h"
+#include "bench_data.h"
+#include <map>
+#include <cstring>
+#include <type_traits>
+
+/*
+ * Reference implementation of the per-character data line splitter,
+ * used to verify the block-at-a-time delimiter scanner and to compare speed.
+ */
+static PGELIST<PGESTRINGList> refSplitDataLine(const PGESTRING &src_data, bool *_valid)
+{
+    PGELIST<PGESTRINGList> entryData;
+    bool valid = true;
+    enum States
+    {
+        STATE_MARKER = 0,
+        STATE_VALUE = 1,
+        STATE_ERROR = 2
+    };
+
+    size_t state = 0;
+    size_t size = strlen(src_data.c_str());
+    size_t tail = size - 1;
+
+    if(src_data.size() > 0 && src_data.back() != ';')
+        state = STATE_ERROR;
+
+    PGESTRING marker;
+    PGESTRING value;
+    int escape = 0;
+
+    for(size_t i = 0; i < size; i++)
+    {
+        if(state == STATE_ERROR)
+        {
+            valid = false;
+            break;
+        }
+
+        char c = src_data[i];
+        if(escape > 0)
+            escape--;
+
+        switch(state)
+        {
+        case STATE_MARKER:
+            if(i == tail)
+            {
+                valid = false;
+                break;
+            }
+            if(c == ';' || c == '\\')
+            {
+                state = STATE_ERROR;
+                continue;
+            }
+            if(c == ':')
+            {
+                state = STATE_VALUE;
+                continue;
+            }
+            marker.push_back(c);
+            break;
+
+        case STATE_VALUE:
+            if((c == '\\') && (escape == 0))
+                escape = 2;
+            if((c == ':') && (escape == 0))
+            {
+                state = STATE_ERROR;
+                continue;
+            }
+            if((c == ';') && (escape == 0))
+            {
+                entryData.push_back({marker, value});
+                marker.clear();
+                value.clear();
+                state = STATE_MARKER;
+                continue;
+            }
+            else if(i == tail)
+            {
+                valid = false;
+                break;
+            }
+            value.push_back(c);
+            break;
+        }
+    }
+
+    if(state == STATE_ERROR)
+        valid = false;
+
+    if(_valid)
+        *_valid = valid;
+
+    return entryData;
+}
+
+TEST_CASE("[PGE-X] Data line splitter matches per-character reference")
+{
+    // Characters which are interesting for the state machine
+    static const char alphabet[] = {'A', 'B', '1', '-', '"', ':', ';', ';', '\\', '\0', ' '};
+    uint32_t seed = 12345;
+    auto rnd = [&seed]() -> uint32_t
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+
+    std::vector<PGESTRING> lines =
+    {
+        "", ";", ":;", "A:1;", "A:1", "A:1;B", PGESTRING("A:1;\0;", 6), PGESTRING("\0;", 2), "A\\:1;", "A;:1;",
+        "A:1\\;;", "A:1\\\\;", "A:1:2;", "A:\\:;", "A:1\\;", "A:\"x\\;y\";B:2;"
+    };
+
+    // Well-formed lines of different lengths to cross the block boundaries
+    for(size_t len = 1; len < 200; ++len)
+    {
+        PGESTRING l;
+        while(l.size() < len)
+            l += "ID:" + std::to_string(rnd() % 100000) + ";S:\"a\\;b\\:c\\\\\";";
+        lines.push_back(l);
+        l[rnd() % l.size()] = ':';
+        lines.push_back(l);
+    }
+
+    // Random garbage made of structural characters
+    for(size_t i = 0; i < 20000; ++i)
+    {
+        PGESTRING l;
+        size_t len = rnd() % 90;
+        for(size_t j = 0; j < len; ++j)
+            l.push_back(alphabet[rnd() % sizeof(alphabet)]);
+        if(rnd() % 2)
+            l.push_back(';');
+        lines.push_back(l);
+    }
+
+    for(const PGESTRING &l : lines)
+    {
+        bool refValid = false, valid = false;
+        PGELIST<PGESTRINGList> ref = refSplitDataLine(l, &refValid);
+        PGELIST<PGESTRINGList> got = PGEFile::splitDataLine(l, &valid);
+        INFO("Line: " << l);
+        REQUIRE(valid == refValid);
+        REQUIRE(got == ref);
+
+        PGEFile::PGEX_Entry tree;
+        PGESTRINGList single = {l};
+        tree = PGEFile::buildTree(single, &valid);
+        REQUIRE(valid == refValid);
+        if(valid)
+        {
+            REQUIRE(tree.data.size() == 1);
+            REQUIRE(tree.data[0].values.size() == ref.size());
+            for(size_t k = 0; k < ref.size(); ++k)
+            {
+                REQUIRE(tree.data[0].values[k].marker == ref[k][0]);
+                REQUIRE(tree.data[0].values[k].value == ref[k][1]);
+            }
+        }
+    }
+}
+
+#ifndef PGE_FILES_QT
+TEST_CASE("[PGE-X] Views are not made from temporary strings")
+{
+    // Views of strings must be asked for explicitly, a temporary string would leave it dangling
+    static_assert(!std::is_convertible<std::string, PGEXStrView>::value, "implicit view of a string");
+    static_assert(!std::is_constructible<PGEXStrView, std::string&&>::value, "view of a temporary string");
+    static_assert(!std::is_assignable<PGEXStrView&, std::string>::value, "assignment of a temporary string");
+    static_assert(std::is_constructible<PGEXStrView, const std::string&>::value, "explicit view of a string");
+
+    PGESTRING s = "Marker";
+    PGEXStrView v(s);
+    REQUIRE(v == s);
+    REQUIRE(s == v);
+    REQUIRE(v == "Marker");
+    REQUIRE(v != "Value");
+    REQUIRE(v.str() == s);
+}
+#endif
+
+static PGESTRING readWhole(const PGESTRING &path)
+{
+    PGE_FileFormats_misc::TextFileInput in(path);
+    return in.readAll();
+}
+
+TEST_CASE("[PGE-X] Split of data lines", "[.benchmark]")
+{
+    PGESTRINGList lines;
+    for(int i = 0; i < 20000; ++i)
+    {
+        lines.push_back("ID:" + std::to_string(i % 600) + ";X:" + std::to_string(i * 32 - 200000) +
+                        ";Y:-200600;W:32;H:32;CN:-10;IV:1;SL:1;LR:\"Default\";EH:\"Block hit\\, number " +
+                        std::to_string(i % 20) + "\";ED:\"Destroyed\";XTRA:\"{\\\"some\\\"\\:\\\"json\\\"}\";");
+    }
+
+    BENCHMARK("Per-character reference")
+    {
+        size_t n = 0;
+        bool valid;
+        for(const PGESTRING &l : lines)
+            n += refSplitDataLine(l, &valid).size();
+        return n;
+    };
+
+    BENCHMARK("PGEFile::splitDataLine")
+    {
+        size_t n = 0;
+        bool valid;
+        for(const PGESTRING &l : lines)
+            n += PGEFile::splitDataLine(l, &valid).size();
+        return n;
+    };
+
+    BENCHMARK("PGEFile::buildTree")
+    {
+        bool valid;
+        return PGEFile::buildTree(lines, &valid).data.size();
+    };
+}
+
+TEST_CASE("[PGE-X] Numeric values", "[.benchmark]")
+{
+    std::vector<PGESTRING> ints, floats;
+    for(int i = 0; i < 100000; ++i)
+    {
+        ints.push_back(std::to_string(i * 37 - 1800000));
+        floats.push_back(std::to_string(i * 0.375 - 10000.0));
+    }
+
+    BENCHMARK("Integers: IsIntS and toLong")
+    {
+        long sum = 0;
+        for(const PGESTRING &s : ints)
+        {
+            if(PGEFile::IsIntS(PGEXSTRING(s)))
+                sum += toLong(s);
+        }
+        return sum;
+    };
+
+    BENCHMARK("Integers: X2IntS")
+    {
+        long sum = 0;
+        for(const PGESTRING &s : ints)
+        {
+            long num;
+            if(PGEFile::X2IntS(PGEXSTRING(s), num))
+                sum += num;
+        }
+        return sum;
+    };
+
+    BENCHMARK("Floats: IsFloat and toDouble")
+    {
+        double sum = 0.0;
+        for(const PGESTRING &s : floats)
+        {
+            if(PGEFile::IsFloat(PGEXSTRING(s)))
+                sum += toDouble(s);
+        }
+        return sum;
+    };
+
+    BENCHMARK("Floats: X2Float")
+    {
+        double sum = 0.0;
+        for(const PGESTRING &s : floats)
+        {
+            double num;
+            if(PGEFile::X2Float(PGEXSTRING(s), num))
+                sum += num;
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("[PGE-X] Load of big PGE-X files", "[.benchmark]")
+{
+    const PGESTRING lvlxPath = benchBigLvlxPath();
+    const PGESTRING wldxPath = benchBigWldxPath();
+    PGESTRING lvlxRaw = readWhole(lvlxPath);
+
+    BENCHMARK("LVLX: build tree")
+    {
+        PGEFile f(lvlxRaw);
+        f.buildTreeFromRaw();
+        return f.dataTree.size();
+    };
+
+    BENCHMARK("LVLX: ReadExtendedLvlFileRaw")
+    {
+        LevelData lvl;
+        FileFormats::ReadExtendedLvlFileRaw(lvlxRaw, lvlxPath, lvl);
+        return lvl.blocks.size();
+    };
+
+    BENCHMARK("LVLX: OpenLevelFile")
+    {
+        LevelData lvl;
+        FileFormats::OpenLevelFile(lvlxPath, lvl);
+        return lvl.blocks.size();
+    };
+
+    BENCHMARK("LVLX: OpenLevelFile, NPC only")
+    {
+        LevelData lvl;
+        FileFormats::OpenLevelFile(lvlxPath, lvl, FileFormats::LOAD_NPC);
+        return lvl.npc.size();
+    };
+
+    BENCHMARK("WLDX: OpenWorldFile")
+    {
+        WorldData wld;
+        FileFormats::OpenWorldFile(wldxPath, wld);
+        return wld.tiles.size();
+    };
+
+    FileFormats::SetPGEXReadThreads(4);
+
+    BENCHMARK("LVLX: ReadExtendedLvlFileRaw, 4 threads")
+    {
+        LevelData lvl;
+        FileFormats::ReadExtendedLvlFileRaw(lvlxRaw, lvlxPath, lvl);
+        return lvl.blocks.size();
+    };
+
+    BENCHMARK("WLDX: OpenWorldFile, 4 threads")
+    {
+        WorldData wld;
+        FileFormats::OpenWorldFile(wldxPath, wld);
+        return wld.tiles.size();
+    };
+
+    FileFormats::SetPGEXReadThreads(0);
+}
+
+TEST_CASE("[PGE-X] Save of big files", "[.benchmark]")
+{
+    LevelData lvl = benchMakeLevel(100000);
+    LevelData eventsLvl = benchMakeEventsLevel(3000);
+    WorldData wld = benchMakeWorld(250000);
+
+    BENCHMARK("LVLX: WriteExtendedLvlFileRaw")
+    {
+        PGESTRING raw;
+        FileFormats::WriteExtendedLvlFileRaw(lvl, raw);
+        return raw.size();
+    };
+
+    BENCHMARK("LVLX: WriteExtendedLvlFileF")
+    {
+        return FileFormats::WriteExtendedLvlFileF(TEST_WRITEDIR "/bench-save.lvlx", lvl);
+    };
+
+    BENCHMARK("LVLX: WriteExtendedLvlFileRaw, classic events")
+    {
+        PGESTRING raw;
+        FileFormats::WriteExtendedLvlFileRaw(eventsLvl, raw);
+        return raw.size();
+    };
+
+    BENCHMARK("WLDX: WriteExtendedWldFileRaw")
+    {
+        PGESTRING raw;
+        FileFormats::WriteExtendedWldFileRaw(wld, raw);
+        return raw.size();
+    };
+
+    FileFormats::SetPGEXWriteThreads(4);
+
+    BENCHMARK("LVLX: WriteExtendedLvlFileRaw, 4 threads")
+    {
+        PGESTRING raw;
+        FileFormats::WriteExtendedLvlFileRaw(lvl, raw);
+        return raw.size();
+    };
+
+    BENCHMARK("LVLX: WriteExtendedLvlFileRaw, classic events, 4 threads")
+    {
+        PGESTRING raw;
+        FileFormats::WriteExtendedLvlFileRaw(eventsLvl, raw);
+        return raw.size();
+    };
+
+    BENCHMARK("WLDX: WriteExtendedWldFileRaw, 4 threads")
+    {
+        PGESTRING raw;
+        FileFormats::WriteExtendedWldFileRaw(wld, raw);
+        return raw.size();
+    };
+
+    FileFormats::SetPGEXWriteThreads(0);
+}
+
+TEST_CASE("[LevelFile] Load of binary level cache", "[.benchmark]")
+{
+    const PGESTRING lvlxPath = benchBigLvlxPath();
+    const PGESTRING cachePath = TEST_WRITEDIR "/bench-big.lvlx.lvlb";
+    LevelData src;
+    REQUIRE(FileFormats::OpenLevelFile(lvlxPath, src));
+    REQUIRE(FileFormats::WriteBinaryLvlFile(cachePath, src, lvlxPath));
+
+    BENCHMARK("LVLX: OpenLevelFile")
+    {
+        LevelData lvl;
+        FileFormats::OpenLevelFile(lvlxPath, lvl);
+        return lvl.blocks.size();
+    };
+
+    BENCHMARK("LVLB: ReadBinaryLvlFile")
+    {
+        LevelData lvl;
+        FileFormats::ReadBinaryLvlFile(cachePath, lvl);
+        return lvl.blocks.size();
+    };
+
+    BENCHMARK("LVLB: OpenLevelFileCached")
+    {
+        LevelData lvl;
+        FileFormats::OpenLevelFileCached(lvlxPath, cachePath, lvl);
+        return lvl.blocks.size();
+    };
+
+    BENCHMARK("LVLB: WriteBinaryLvlFile")
+    {
+        return FileFormats::WriteBinaryLvlFile(cachePath, src, lvlxPath);
+    };
+}
+
+namespace
+{
+//! Counts usage of block and NPC IDs like an asset scanner does
+class AssetScanner : public PGEXEventReader::Handler
+{
+    bool m_npc = false;
+public:
+    std::map<long, size_t> blocks;
+    std::map<long, size_t> npcs;
+
+    bool sectionBegin(const PGESTRING &name) override
+    {
+        m_npc = (name == "NPC");
+        return m_npc || name == "BLOCK";
+    }
+
+    bool value(const PGEXSTRING &marker, const PGEXSTRING &value) override
+    {
+        if(marker == "ID" && PGEFile::IsIntU(value))
+            (m_npc ? npcs : blocks)[toLong(value)]++;
+        return true;
+    }
+};
+}
+
+TEST_CASE("[PGE-X] Load of event-heavy level", "[.benchmark]")
+{
+    PGE_FileFormats_misc::TextFileInput file(benchEventsLvlxPath());
+    PGESTRING raw = file.readAll();
+
+    BENCHMARK("LVLX: ReadExtendedLvlFileRaw")
+    {
+        LevelData lvl;
+        FileFormats::ReadExtendedLvlFileRaw(raw, "bench-events.lvlx", lvl);
+        return lvl.events.size();
+    };
+}
+
+TEST_CASE("[PGE-X] Scan of used assets", "[.benchmark]")
+{
+    const PGESTRING lvlxPath = benchBigLvlxPath();
+
+    BENCHMARK("LVLX: PGEXEventReader, BLOCK and NPC only")
+    {
+        PGE_FileFormats_misc::MappedTextInput in(lvlxPath);
+        PGEXEventReader reader;
+        AssetScanner scanner;
+        reader.parse(in, scanner);
+        return scanner.blocks.size() + scanner.npcs.size();
+    };
+
+    BENCHMARK("LVLX: OpenLevelFile")
+    {
+        LevelData lvl;
+        FileFormats::OpenLevelFile(lvlxPath, lvl);
+        std::map<long, size_t> blocks, npcs;
+        for(const LevelBlock &b : lvl.blocks)
+            blocks[b.id]++;
+        for(const LevelNPC &n : lvl.npc)
+            npcs[n.id]++;
+        return blocks.size() + npcs.size();
+    };
+}
+
+// Markers of the BLOCK section of LVLX, in order of the reader
+#define BENCH_BLOCK_MARKERS(X) \
+    X("ID") X("X") X("Y") X("W") X("H") X("AS") X("GXN") X("GXX") X("GXY") X("CN") X("CS") \
+    X("IV") X("SL") X("MA") X("S1") X("S2") X("LR") X("ED") X("EH") X("EE") X("XTRA")
+
+TEST_CASE("[PGE-X] Marker dispatch", "[.benchmark]")
+{
+#define BENCH_LIST_ENTRY(m) m,
+    static const char *const markers[] = {BENCH_BLOCK_MARKERS(BENCH_LIST_ENTRY) "UNKN"};
+#undef BENCH_LIST_ENTRY
+    const size_t markersCount = sizeof(markers) / sizeof(markers[0]);
+    PGESTRINGList owned;
+    for(size_t i = 0; i < 100000; ++i)
+        owned.push_back(markers[(i * 7) % markersCount]);
+
+    BENCHMARK("String compare chain")
+    {
+        size_t hits = 0;
+        for(const PGESTRING &m : owned)
+        {
+            PGEXSTRING v(m);
+#define BENCH_CHAIN_ENTRY(m) if(v == m) hits += sizeof(m); else
+            BENCH_BLOCK_MARKERS(BENCH_CHAIN_ENTRY) {}
+#undef BENCH_CHAIN_ENTRY
+        }
+        return hits;
+    };
+
+    BENCHMARK("Marker key switch")
+    {
+        size_t hits = 0;
+        for(const PGESTRING &m : owned)
+        {
+            switch(PGEFile::markerKey(PGEXSTRING(m)))
+            {
+#define BENCH_CASE_ENTRY(m) case PGEFile::markerKey(m): hits += sizeof(m); break;
+            BENCH_BLOCK_MARKERS(BENCH_CASE_ENTRY)
+#undef BENCH_CASE_ENTRY
+            default:
+                break;
+            }
+        }
+        return hits;
+    };
+}
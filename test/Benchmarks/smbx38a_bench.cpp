@@ -0,0 +1,325 @@
+#include <catch_amalgamated.hpp>
+#include "file_formats.h"
+#include "CSVReaderPGE.h"
+#include "CSVUtils.h"
+#include "bench_data.h"
+#include <vector>
+
+using namespace CSVReader;
+
+static const PGESTRING c_csvSample =
+    "B|1,12|-32,64.5|!0|hello%2Cworld|a,b,,c|7\n"
+    "B|x,12|-32,64.5|0||a|7\n";
+
+template<class Reader>
+static void readCsvSample(Reader &dataReader,
+                          PGESTRING &type, int &id, long &extra, long &x, double &y,
+                          bool &flag, PGESTRING &text, std::vector<PGESTRING> &list, int &opt)
+{
+    dataReader.ReadDataLine(&type,
+                            MakeCSVSubReader(dataReader, ',', &id, &extra),
+                            MakeCSVSubReader(dataReader, ',', &x, &y),
+                            &flag,
+                            &text,
+                            MakeCSVBatchReader(dataReader, ',', &list),
+                            MakeCSVOptional(&opt, 0),
+                            MakeCSVOptional(&extra, 5));
+}
+
+TEST_CASE("[SMBX-38A] CSV fields are converted in place")
+{
+    PGESTRING type, text;
+    int id = 0, opt = 0;
+    long extra = 0, x = 0;
+    double y = 0.0;
+    bool flag = false;
+    std::vector<PGESTRING> list;
+
+    PGESTRING data = c_csvSample;
+    PGE_FileFormats_misc::RawTextInput in(&data);
+    CSVPGEReader readerBridge(&in);
+    auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
+
+    REQUIRE(dataReader.ReadField<PGESTRING>(5) == "hello%2Cworld");
+    REQUIRE(dataReader.ReadField<long>(7) == 7);
+
+    readCsvSample(dataReader, type, id, extra, x, y, flag, text, list, opt);
+    REQUIRE(type == "B");
+    REQUIRE(id == 1);
+    REQUIRE(x == -32);
+    REQUIRE(y == 64.5);
+    REQUIRE(flag);
+    REQUIRE(text == "hello%2Cworld");
+    REQUIRE(list == std::vector<PGESTRING>{"a", "b", "c"});
+    REQUIRE(opt == 7);
+    REQUIRE(extra == 5);
+
+    // Same line through the owning path of the generic converter
+    {
+        PGESTRING typeS, textS;
+        int idS = 0, optS = 0;
+        long extraS = 0, xS = 0;
+        double yS = 0.0;
+        bool flagS = false;
+        std::vector<PGESTRING> listS;
+        DirectReader<std::string> direct(data.substr(0, data.find('\n')));
+        auto stlReader = MakeCSVReaderFromBasicString(&direct, '|');
+        readCsvSample(stlReader, typeS, idS, extraS, xS, yS, flagS, textS, listS, optS);
+        REQUIRE(typeS == type);
+        REQUIRE(idS == id);
+        REQUIRE(extraS == extra);
+        REQUIRE(xS == x);
+        REQUIRE(yS == y);
+        REQUIRE(flagS == flag);
+        REQUIRE(textS == text);
+        REQUIRE(listS == list);
+        REQUIRE(optS == opt);
+    }
+
+    // Conversion errors are reported for the field of the sub-reader
+    bool failed = false;
+    try
+    {
+        readCsvSample(dataReader, type, id, extra, x, y, flag, text, list, opt);
+    }
+    catch(const parse_error &e)
+    {
+        failed = true;
+        REQUIRE(e.get_line_number() == 2);
+        REQUIRE(e.get_field_number() == 1);
+    }
+    REQUIRE(failed);
+
+    int value = 0;
+    std::string error;
+    PGESTRING big = "99999999999";
+    REQUIRE_FALSE(CSVPGESTRINGConverter::TryConvert(&value, big, 0, big.size(), error));
+    REQUIRE(error == "stoi");
+    REQUIRE_FALSE(CSVPGESTRINGConverter::TryConvert(&value, big, 0, 0, error));
+    REQUIRE(CSVPGESTRINGConverter::TryConvert(&value, big, 3, 4, error));
+    REQUIRE(value == 9999);
+}
+
+TEST_CASE("[SMBX-38A] CSV reading failures are reported by status")
+{
+    PGESTRING type;
+    int id = 0;
+    long extra = 0, x = 0;
+
+    PGESTRING data = c_csvSample + "B|1\n" + "B|1\n";
+    PGE_FileFormats_misc::RawTextInput in(&data);
+    CSVPGEReader readerBridge(&in);
+    auto dataReader = MakeCSVReaderForPGESTRING(&readerBridge, '|');
+
+    REQUIRE(dataReader.TryReadDataLine(CSVDiscard()).ok());
+
+    // The same failure as thrown by ReadDataLine()
+    const parse_status &status = dataReader.TryReadDataLine(&type,
+                                                            MakeCSVSubReader(dataReader, ',', &id, &extra),
+                                                            &x);
+    REQUIRE_FALSE(status);
+    REQUIRE(status.code() == parse_status::conversion_failed);
+    REQUIRE(status.reason() == "stoi");
+    REQUIRE(status.get_line_number() == 2);
+    REQUIRE(status.get_field_number() == 1);
+    REQUIRE(status.nesting().size() == 2);
+    REQUIRE(status.nesting()[0].line == 1);
+    REQUIRE(status.nesting()[0].field == 0);
+
+    std::string thrown;
+    try
+    {
+        status.rethrow();
+    }
+    catch(const std::exception &e)
+    {
+        thrown = exception_to_pretty_string(e);
+    }
+    REQUIRE(thrown == status.pretty_string());
+    REQUIRE(thrown == "exception: Failed to parse field 1 at line 2\n"
+                      " exception: Failed to parse field 0 at line 1\n"
+                      "  exception: stoi\n");
+
+    const parse_status &missing = dataReader.TryReadDataLine(&type, &id, &x);
+    REQUIRE(missing.code() == parse_status::missing_fields);
+    REQUIRE(missing.get_line_number() == 3);
+    REQUIRE(missing.get_field_number() == 2);
+
+    const parse_status &callback = dataReader.TryReadDataLine(&type, MakeCSVPostProcessor(&id, [](int &)
+    {
+        throw std::runtime_error("Rejected by the post-processor");
+    }));
+    REQUIRE(callback.code() == parse_status::callback_failed);
+    REQUIRE(callback.reason() == "Rejected by the post-processor");
+
+    // A broken 38A level is reported with the line number of the broken record
+    LevelData lvl;
+    PGESTRING broken = "SMBXFile67\nA|0|Test||0|,,,\nB|1|x|32|0|0|0|0|0\n";
+    REQUIRE_FALSE(FileFormats::ReadSMBX38ALvlFileRaw(broken, "", lvl));
+    REQUIRE(lvl.meta.ERROR_linenum == 3);
+    REQUIRE(lvl.meta.ERROR_info.find("Failed to parse field 2 at line 3") != PGESTRING::npos);
+}
+
+TEST_CASE("[SMBX-38A] Record types are detected by identifiers")
+{
+    LevelData lvl;
+    PGESTRING raw = "SMBXFile67\n"
+                    "A|0|Test||0|,,,\n"
+                    "P1|10|20\n"
+                    "P2|30|40\n"
+                    "P3|50|60\n"
+                    "BB|1\n"
+                    "su|a|b\n"
+                    "CX|1\n"
+                    "V|v|1\n";
+    REQUIRE(FileFormats::ReadSMBX38ALvlFileRaw(raw, "", lvl));
+    REQUIRE(lvl.players.size() == 2);
+    REQUIRE(lvl.variables.size() == 1);
+    REQUIRE(lvl.unsupported_38a_lines == PGESTRINGList{"P3|50|60", "BB|1", "su|a|b", "CX|1"});
+
+    // Skipped sections are selected by record types
+    PGE_FileFormats_misc::RawTextInput in(&raw);
+    LevelData head;
+    REQUIRE(FileFormats::ReadSMBX38ALvlFile(in, head, FileFormats::LOAD_HEADER));
+    REQUIRE(head.players.empty());
+    REQUIRE(head.variables.empty());
+    REQUIRE(head.unsupported_38a_lines.size() == 4);
+}
+
+TEST_CASE("[SMBX-38A] String fields are percent-encoded")
+{
+    LevelData lvl;
+    FileFormats::CreateLevelData(lvl);
+    lvl.LevelName = "A|b,c%41 \xD0\x96";
+
+    LevelLayer l = FileFormats::CreateLvlLayer();
+    l.name = PGESTRING(700, 'x') + "|%";
+    lvl.layers.push_back(l);
+
+    PGESTRING raw;
+    REQUIRE(FileFormats::WriteSMBX38ALvlFileRaw(lvl, raw));
+    REQUIRE(raw.find("|%41%7C%62%2C%63%25%34%31%20%D0%96|") != PGESTRING::npos);
+
+    LevelData back;
+    REQUIRE(FileFormats::ReadSMBX38ALvlFileRaw(raw, "", back));
+    REQUIRE(back.LevelName == lvl.LevelName);
+    REQUIRE(back.layers.size() >= 1);
+    REQUIRE(back.layers.back().name == l.name);
+
+    // Broken escapes are kept as is
+    PGESTRING broken = "SMBXFile67\nA|0|%4|%zz%41%|0|,,,\n";
+    REQUIRE(FileFormats::ReadSMBX38ALvlFileRaw(broken, "", back));
+    REQUIRE(back.LevelName == "%4");
+    REQUIRE(back.open_level_on_fail == "%zzA%");
+}
+
+TEST_CASE("[SMBX-38A] Validation of broken files", "[.benchmark]")
+{
+    LevelData lvl = benchMakeLevel(300);
+    PGESTRING raw;
+    FileFormats::WriteSMBX38ALvlFileRaw(lvl, raw);
+
+    // Every file is broken at its last line
+    std::vector<PGESTRING> files;
+    for(int i = 0; i < 2000; ++i)
+        files.push_back(raw + "B|" + std::to_string(i) + "|x|32\n");
+
+    BENCHMARK("LVL: ReadSMBX38ALvlFileRaw of 2000 broken files")
+    {
+        size_t invalid = 0;
+        for(PGESTRING &f : files)
+        {
+            LevelData data;
+            if(!FileFormats::ReadSMBX38ALvlFileRaw(f, "", data))
+                invalid++;
+        }
+        return invalid;
+    };
+}
+
+TEST_CASE("[SMBX-38A] Load of big files", "[.benchmark]")
+{
+    LevelData lvl = benchMakeLevel(150000);
+    WorldData wld = benchMakeWorld(250000);
+    PGESTRING lvlRaw, wldRaw;
+    FileFormats::WriteSMBX38ALvlFileRaw(lvl, lvlRaw);
+    FileFormats::WriteSMBX38AWldFileRaw(wld, wldRaw);
+
+    BENCHMARK("LVL: ReadSMBX38ALvlFileRaw")
+    {
+        LevelData data;
+        FileFormats::ReadSMBX38ALvlFileRaw(lvlRaw, "", data);
+        return data.blocks.size();
+    };
+
+    BENCHMARK("WLD: ReadSMBX38AWldFileRaw")
+    {
+        WorldData data;
+        FileFormats::ReadSMBX38AWldFileRaw(wldRaw, "", data);
+        return data.tiles.size();
+    };
+
+    FileFormats::SetSMBX38AReadThreads(4);
+
+    BENCHMARK("LVL: ReadSMBX38ALvlFileRaw, 4 threads")
+    {
+        LevelData data;
+        FileFormats::ReadSMBX38ALvlFileRaw(lvlRaw, "", data);
+        return data.blocks.size();
+    };
+
+    BENCHMARK("WLD: ReadSMBX38AWldFileRaw, 4 threads")
+    {
+        WorldData data;
+        FileFormats::ReadSMBX38AWldFileRaw(wldRaw, "", data);
+        return data.tiles.size();
+    };
+
+    FileFormats::SetSMBX38AReadThreads(0);
+}
+
+TEST_CASE("[SMBX-38A] Dispatch of record types", "[.benchmark]")
+{
+    // Blocks, BGO and NPC with a sprinkle of other records
+    LevelData lvl = benchMakeLevel(30000);
+    for(size_t i = 0; i < 300; ++i)
+    {
+        LevelDoor d = FileFormats::CreateLvlWarp();
+        d.ix = static_cast<long>(i) * 64;
+        d.ox = d.ix + 32;
+        d.meta.array_id = lvl.doors_array_id++;
+        lvl.doors.push_back(d);
+
+        LevelPhysEnv w = FileFormats::CreateLvlPhysEnv();
+        w.x = static_cast<long>(i) * 64;
+        w.meta.array_id = lvl.physenv_array_id++;
+        lvl.physez.push_back(w);
+
+        LevelLayer l = FileFormats::CreateLvlLayer();
+        l.name = "Layer " + std::to_string(i);
+        l.meta.array_id = lvl.layers_array_id++;
+        lvl.layers.push_back(l);
+
+        LevelVariable v = FileFormats::CreateLvlVariable("var" + std::to_string(i));
+        lvl.variables.push_back(v);
+    }
+
+    PGESTRING raw;
+    FileFormats::WriteSMBX38ALvlFileRaw(lvl, raw);
+
+    BENCHMARK("LVL: Classify and skip all records")
+    {
+        PGE_FileFormats_misc::RawTextInput in(&raw);
+        LevelData data;
+        FileFormats::ReadSMBX38ALvlFile(in, data, FileFormats::LOAD_HEADER);
+        return data.unsupported_38a_lines.size();
+    };
+
+    BENCHMARK("LVL: Read all records")
+    {
+        PGE_FileFormats_misc::RawTextInput in(&raw);
+        LevelData data;
+        FileFormats::ReadSMBX38ALvlFile(in, data);
+        return data.blocks.size();
+    };
+}
@@ -1,5 +1,10 @@
 #include <catch_amalgamated.hpp>
 #include "file_formats.h"
+#include "pge_x.h"
+#include "smbx64.h"
+#include <climits>
+#include <clocale>
+#include <algorithm>
 
 #ifndef TEST_WORKDIR
 #   define TEST_WORKDIR "."
@@ -16,3 +21,1157 @@ TEST_CASE("[LevelFile] Load")
     REQUIRE(res);
     REQUIRE(lvl.meta.ReadFileValid);
 }
+
+TEST_CASE("[LevelFile] Load LVLX")
+{
+    LevelData lvl;
+
+    bool res = FileFormats::OpenLevelFile(TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/pgex/Extra Toadhouse.lvlx", lvl);
+
+    REQUIRE(res);
+    REQUIRE(lvl.meta.ReadFileValid);
+    REQUIRE(!lvl.blocks.empty());
+
+    // Saved data must be loaded back into the same
+    PGESTRING raw1, raw2;
+    LevelData lvl2;
+    REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl, raw1));
+    REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw1, "sample.lvlx", lvl2));
+    REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl2, raw2));
+    REQUIRE(raw1 == raw2);
+    REQUIRE(lvl2.blocks.size() == lvl.blocks.size());
+}
+
+TEST_CASE("[PGE-X] Build tree")
+{
+    PGEFile file("HEAD\n"
+                 "TL:\"Title \\\"quoted\\\"\\;\";SZ:10;\n"
+                 "\n"
+                 "HEAD_END\n"
+                 "BROKEN\n"
+                 "A:1;\n"
+                 "not a value\n"
+                 "BROKEN_END\n");
+
+    REQUIRE(file.buildTreeFromRaw());
+    REQUIRE(file.dataTree.size() == 2);
+
+    const PGEFile::PGEX_Entry &head = file.dataTree[0];
+    REQUIRE(head.name == "HEAD");
+    REQUIRE(head.type == PGEFile::PGEX_Struct);
+    REQUIRE(head.data.size() == 1);
+    REQUIRE(head.data[0].values.size() == 2);
+    REQUIRE(head.data[0].values[0].marker == "TL");
+    REQUIRE(head.data[0].values[0].value == "\"Title \\\"quoted\\\"\\;\"");
+    REQUIRE(PGEFile::X2STRING(head.data[0].values[0].value) == "Title \"quoted\";");
+    REQUIRE(head.data[0].values[1].marker == "SZ");
+    REQUIRE(head.data[0].values[1].value == "10");
+
+    const PGEFile::PGEX_Entry &broken = file.dataTree[1];
+    REQUIRE(broken.name == "BROKEN");
+    REQUIRE(broken.type == PGEFile::PGEX_PlainText);
+    REQUIRE(broken.data.size() == 1);
+    REQUIRE(broken.data[0].values[0].value == "A:1;\nnot a value\n");
+
+    PGEFile unclosed("HEAD\nTL:\"x\";\n");
+    REQUIRE(!unclosed.buildTreeFromRaw());
+}
+
+TEST_CASE("[PGE-X] Marker keys")
+{
+    static_assert(PGEFile::markerKey("SZ") != PGEFile::markerKey("SZ\0"), "Length must be a part of the key");
+
+    REQUIRE(PGEFile::markerKey(PGEXSTRING("TL")) == PGEFile::markerKey("TL"));
+    REQUIRE(PGEFile::markerKey(PGEXSTRING("SNPC")) == PGEFile::markerKey("SNPC"));
+    REQUIRE(PGEFile::markerKey(PGEXSTRING("XTRA")) != PGEFile::markerKey("XTR"));
+    REQUIRE(PGEFile::markerKey(PGEXSTRING("T")) != PGEFile::markerKey("TL"));
+
+    // Unknown markers must never match any known key
+    REQUIRE(PGEFile::markerKey(PGEXSTRING("")) == 0);
+    REQUIRE(PGEFile::markerKey(PGEXSTRING("TOOLONGMARKER")) == 0);
+}
+
+TEST_CASE("[PGE-X] Numeric values")
+{
+    int i = 42;
+    REQUIRE(PGEFile::X2IntU(PGEXSTRING("2147483647"), i));
+    REQUIRE(i == 2147483647);
+    REQUIRE(!PGEFile::X2IntU(PGEXSTRING("2147483648"), i));
+    REQUIRE(!PGEFile::X2IntU(PGEXSTRING(""), i));
+    REQUIRE(!PGEFile::X2IntU(PGEXSTRING("-1"), i));
+    REQUIRE(!PGEFile::X2IntU(PGEXSTRING("+1"), i));
+    REQUIRE(!PGEFile::X2IntU(PGEXSTRING("1a"), i));
+    // Invalid values must not change the target
+    REQUIRE(i == 2147483647);
+
+    REQUIRE(PGEFile::X2IntS(PGEXSTRING("-2147483648"), i));
+    REQUIRE(i == INT_MIN);
+    REQUIRE(PGEFile::X2IntS(PGEXSTRING("-0"), i));
+    REQUIRE(i == 0);
+    REQUIRE(!PGEFile::X2IntS(PGEXSTRING("-2147483649"), i));
+    REQUIRE(!PGEFile::X2IntS(PGEXSTRING("-"), i));
+    REQUIRE(!PGEFile::X2IntS(PGEXSTRING("1-"), i));
+
+    long long ll = 0;
+    REQUIRE(PGEFile::X2IntS(PGEXSTRING("-9223372036854775808"), ll));
+    REQUIRE(ll == LLONG_MIN);
+    REQUIRE(PGEFile::X2IntS(PGEXSTRING("9223372036854775807"), ll));
+    REQUIRE(ll == LLONG_MAX);
+    REQUIRE(!PGEFile::X2IntS(PGEXSTRING("9223372036854775808"), ll));
+
+    unsigned long long ull = 0;
+    REQUIRE(PGEFile::X2IntU(PGEXSTRING("18446744073709551615"), ull));
+    REQUIRE(ull == ULLONG_MAX);
+    REQUIRE(!PGEFile::X2IntU(PGEXSTRING("18446744073709551616"), ull));
+
+    double d = 0.0;
+    REQUIRE(PGEFile::X2Float(PGEXSTRING("-1.5e+3"), d));
+    REQUIRE(d == -1500.0);
+    REQUIRE(PGEFile::X2Float(PGEXSTRING("1."), d));
+    REQUIRE(d == 1.0);
+    REQUIRE(PGEFile::X2Float(PGEXSTRING(".5"), d));
+    REQUIRE(d == 0.5);
+    REQUIRE(PGEFile::X2Float(PGEXSTRING("25e-1"), d));
+    REQUIRE(d == 2.5);
+
+    const char *const badFloats[] =
+    {
+        "", ".", "-", "-.", "+1", "1,2", "1E2", "1e", "1e+", "1e-", "e5", "1e5.", "1.2.3", "1ee5", "1e12345", "1e999", "1 "
+    };
+    for(const char *bad : badFloats)
+    {
+        INFO("Value: " << bad);
+        REQUIRE(!PGEFile::X2Float(PGEXSTRING(bad), d));
+    }
+    REQUIRE(d == 2.5);
+
+    float f = 0.0f;
+    REQUIRE(PGEFile::X2Float(PGEXSTRING("1e38"), f));
+    REQUIRE(!PGEFile::X2Float(PGEXSTRING("1e39"), f));
+    REQUIRE(PGEFile::X2Float(PGEXSTRING("1e39"), d));
+
+    bool b = false;
+    REQUIRE(PGEFile::X2Bool(PGEXSTRING("1"), b));
+    REQUIRE(b);
+    REQUIRE(!PGEFile::X2Bool(PGEXSTRING("2"), b));
+    REQUIRE(!PGEFile::X2Bool(PGEXSTRING("01"), b));
+    REQUIRE(!PGEFile::X2Bool(PGEXSTRING(""), b));
+    REQUIRE(b);
+
+    // Out of range values are reported as the syntax errors of the value
+    PGESTRING raw = "BLOCK\nID:1;X:0;Y:99999999999999999999;\nBLOCK_END\n";
+    LevelData lvl;
+    REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(raw, "range.lvlx", lvl));
+    REQUIRE(lvl.meta.ERROR_info == "Wrong value syntax\nSection [BLOCK]\nData line 0\nMarker Y\nValue 99999999999999999999");
+}
+
+TEST_CASE("[PGE-X] Writer builder")
+{
+    PGESTRINGList strings;
+    strings.push_back("plain");
+    strings.push_back("esc;:\"[],%\\\n\r");
+    strings.push_back("");
+    PGELIST<long> ints;
+    ints.push_back(LONG_MIN);
+    ints.push_back(0);
+    ints.push_back(1234);
+    PGELIST<bool> flags;
+    flags.push_back(true);
+    flags.push_back(false);
+
+    PGEXWriter w;
+    w.beginSection("SECT");
+    w.writeInt("I", INT_MIN);
+    w.writeInt("U", ULLONG_MAX);
+    w.writeInt("B", true);
+    w.writeFloat("F0", -0.0);
+    w.writeFloat("F1", 0.1f);
+    w.writeFloat("F2", -1234567.0);
+    w.writeFloat("F3", 1e-20);
+    w.writeBool("BL", false);
+    w.writeStr("S", strings[1]);
+    w.writeStrArr("SA", strings);
+    w.writeStrArr("SE", PGESTRINGList());
+    w.writeIntArr("IA", ints);
+    w.writeIntArr("IE", PGELIST<int>());
+    w.writeBoolArr("BA", flags);
+    w.writeBoolArr("BE", PGELIST<bool>());
+    w.beginStrArr("NE");
+    w.endStrArr();
+    w.endLine();
+    w.endSection("SECT");
+
+    PGESTRING expected = "SECT\n";
+    expected += PGEFile::value("I", PGEFile::WriteInt(INT_MIN));
+    expected += PGEFile::value("U", PGEFile::WriteInt(ULLONG_MAX));
+    expected += PGEFile::value("B", PGEFile::WriteInt(true));
+    expected += PGEFile::value("F0", PGEFile::WriteFloat(-0.0));
+    expected += PGEFile::value("F1", PGEFile::WriteFloat(0.1f));
+    expected += PGEFile::value("F2", PGEFile::WriteFloat(-1234567.0));
+    expected += PGEFile::value("F3", PGEFile::WriteFloat(1e-20));
+    expected += PGEFile::value("BL", PGEFile::WriteBool(false));
+    expected += PGEFile::value("S", PGEFile::WriteStr(strings[1]));
+    expected += PGEFile::value("SA", PGEFile::WriteStrArr(strings));
+    expected += PGEFile::value("IA", PGEFile::WriteIntArr(ints));
+    expected += PGEFile::value("BA", PGEFile::WriteBoolArr(flags));
+    expected += "\nSECT_END\n";
+
+    REQUIRE(w.data() == expected);
+
+    // Data is written into the output at the ends of lines once the buffer is full
+    PGESTRING raw;
+    PGE_FileFormats_misc::RawTextOutput out(&raw);
+    PGEXWriter wo(out, 16);
+    wo.writeStr("S", "0123456789");
+    REQUIRE(raw.empty());
+    wo.endLine();
+    REQUIRE(raw == "S:\"0123456789\";\n");
+    REQUIRE(wo.empty());
+    wo.writeInt("X", 1);
+    wo.flush();
+    REQUIRE(raw == "S:\"0123456789\";\nX:1;");
+}
+
+TEST_CASE("[PGE-X] Writer ignores the C locale")
+{
+    const char *commaLocales[] = {"de_DE.UTF-8", "de_DE.utf8", "ru_RU.UTF-8", "fr_FR.UTF-8", "de_DE", "German"};
+    std::string oldLocale = std::setlocale(LC_NUMERIC, nullptr);
+    const char *used = nullptr;
+
+    for(const char *name : commaLocales)
+    {
+        if(std::setlocale(LC_NUMERIC, name) && std::localeconv()->decimal_point[0] == ',')
+        {
+            used = name;
+            break;
+        }
+    }
+
+    if(!used)
+    {
+        std::setlocale(LC_NUMERIC, oldLocale.c_str());
+        SKIP("No locale with the comma decimal point is installed");
+    }
+
+    INFO(used);
+    PGEXWriter w;
+    w.writeFloat("F", 1.5);
+    w.writeFloat("E", -2.5e-7f);
+
+    LevelData lvl;
+    FileFormats::CreateLevelData(lvl);
+    LevelBGO b = FileFormats::CreateLvlBgo();
+    b.z_offset = 0.25;
+    lvl.bgo.push_back(b);
+    PGESTRING raw;
+    bool written = FileFormats::WriteExtendedLvlFileRaw(lvl, raw);
+    std::setlocale(LC_NUMERIC, oldLocale.c_str());
+
+    REQUIRE(w.data() == "F:1.5;E:-2.5e-07;");
+    REQUIRE(written);
+    REQUIRE(raw.find("ZO:0.25;") != PGESTRING::npos);
+
+    LevelData back;
+    REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw, "locale.lvlx", back));
+    REQUIRE(back.bgo.size() == 1);
+    REQUIRE(back.bgo[0].z_offset == 0.25);
+}
+
+TEST_CASE("[PGE-X] Event sub-structure arrays")
+{
+    SECTION("Saved data must be loaded back into the same")
+    {
+        LevelData lvl;
+        FileFormats::CreateLevelData(lvl);
+
+        LevelSMBX64Event e = FileFormats::CreateLvlEvent();
+        e.name = "Event";
+        e.sets[3].music_id = 5;
+        e.sets[3].music_file = "a;b:\"c\",[d]\\e";
+        e.sets[3].position_left = -200000;
+        e.sets[3].position_right = -199000;
+        e.sets[3].autoscroll_path.push_back({10, 20, 1, 2});
+
+        LevelEvent_MoveLayer ml;
+        ml.name = "Layer, \"quoted\"";
+        ml.speed_x = -1.5;
+        e.moving_layers.push_back(ml);
+        ml.name = "Second";
+        e.moving_layers.push_back(ml);
+
+        LevelEvent_SpawnNPC sn;
+        sn.id = 89;
+        sn.expression_x = "x+1;";
+        e.spawn_npc.push_back(sn);
+
+        LevelEvent_SpawnEffect se;
+        se.id = 10;
+        se.gravity = true;
+        se.fps = 30;
+        e.spawn_effects.push_back(se);
+
+        LevelEvent_UpdateVariable uv;
+        uv.name = "v";
+        uv.newval = "[1,2]";
+        e.update_variable.push_back(uv);
+
+        lvl.events.push_back(e);
+
+        PGESTRING raw1, raw2;
+        LevelData lvl2;
+        REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl, raw1));
+        REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw1, "events.lvlx", lvl2));
+        REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl2, raw2));
+        REQUIRE(raw1 == raw2);
+
+        REQUIRE(lvl2.events.size() == lvl.events.size());
+        const LevelSMBX64Event &e2 = lvl2.events.back();
+        REQUIRE(e2.name == "Event");
+        REQUIRE(e2.sets[3].music_id == 5);
+        REQUIRE(e2.sets[3].music_file == e.sets[3].music_file);
+        REQUIRE(e2.sets[3].autoscroll_path.size() == 1);
+        REQUIRE(e2.moving_layers.size() == 2);
+        REQUIRE(e2.moving_layers[0].name == "Layer, \"quoted\"");
+        REQUIRE(e2.moving_layers[0].speed_x == -1.5);
+        REQUIRE(e2.spawn_npc.size() == 1);
+        REQUIRE(e2.spawn_npc[0].expression_x == "x+1;");
+        REQUIRE(e2.spawn_effects.size() == 1);
+        REQUIRE(e2.spawn_effects[0].fps == 30);
+        REQUIRE(e2.update_variable.size() == 1);
+        REQUIRE(e2.update_variable[0].newval == "[1,2]");
+    }
+
+    SECTION("Only the last of duplicated fields is kept")
+    {
+        PGESTRING raw = "EVENTS_CLASSIC\n"
+                        "ET:\"E\";MLA:[\"LN\\:\\\"A\\\"\\;\"];MLA:[\"LN\\:\\\"B\\\"\\;\",\"LN\\:\\\"C\\\"\\;\"];\n"
+                        "EVENTS_CLASSIC_END\n";
+        LevelData lvl;
+        REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw, "events.lvlx", lvl));
+        REQUIRE(lvl.events.back().name == "E");
+        REQUIRE(lvl.events.back().moving_layers.size() == 2);
+        REQUIRE(lvl.events.back().moving_layers[0].name == "B");
+        REQUIRE(lvl.events.back().moving_layers[1].name == "C");
+    }
+
+    SECTION("Broken entries")
+    {
+        // Even the overridden field must be valid
+        PGESTRING raw = "EVENTS_CLASSIC\n"
+                        "ET:\"E\";MLA:[\"LN\\\"A\\\"\\;\"];MLA:[\"LN\\:\\\"B\\\"\\;\"];\n"
+                        "EVENTS_CLASSIC_END\n";
+        LevelData lvl;
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(raw, "events.lvlx", lvl));
+        REQUIRE(lvl.meta.ERROR_info == "Wrong Move layer event encoded sub-entry");
+
+        raw = "EVENTS_CLASSIC\n"
+              "ET:\"E\";SSS:[\"ID\\:1\\;MI\\:x\\;\"];\n"
+              "EVENTS_CLASSIC_END\n";
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(raw, "events.lvlx", lvl));
+        REQUIRE(lvl.meta.ERROR_info == "Invalid Section music ID value type");
+
+        raw = "EVENTS_CLASSIC\n"
+              "ET:\"E\";SNPC:[\"ID\\:1\\;\";\n"
+              "EVENTS_CLASSIC_END\n";
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(raw, "events.lvlx", lvl));
+        REQUIRE(lvl.meta.ERROR_info.find("Wrong value syntax") == 0);
+    }
+}
+
+namespace
+{
+//! Collects events of the PGE-X event reader into a data tree
+class TreeCollector : public PGEXEventReader::Handler
+{
+public:
+    PGELIST<PGEFile::PGEX_Entry> tree;
+    PGESTRINGList values;
+    PGESTRING skip;
+    size_t invalidLines = 0;
+
+    bool sectionBegin(const PGESTRING &name) override
+    {
+        if(name == skip)
+            return false;
+        tree.push_back(PGEFile::PGEX_Entry());
+        tree.back().name = name;
+        return true;
+    }
+
+    bool itemBegin(pge_size_t index) override
+    {
+        REQUIRE(index == tree.back().data.size());
+        tree.back().data.push_back(PGEFile::PGEX_Item());
+        return true;
+    }
+
+    bool value(const PGEXSTRING &marker, const PGEXSTRING &value) override
+    {
+        values.push_back(PGESTRING(marker) + ":" + PGESTRING(value));
+        return true;
+    }
+
+    bool invalidItem(pge_size_t, const PGESTRING &) override
+    {
+        invalidLines++;
+        return true;
+    }
+};
+}
+
+TEST_CASE("[PGE-X] Event reader")
+{
+    const PGESTRING path = TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/pgex/Extra Toadhouse.lvlx";
+
+    PGE_FileFormats_misc::TextFileInput file(path);
+    PGEFile pgeX(file.readAll());
+    REQUIRE(pgeX.buildTreeFromRaw());
+
+    SECTION("Events match the data tree")
+    {
+        PGE_FileFormats_misc::TextFileInput in(path);
+        PGEXEventReader reader;
+        TreeCollector collector;
+        REQUIRE(reader.parse(in, collector));
+        REQUIRE(collector.invalidLines == 0);
+        REQUIRE(collector.tree.size() == pgeX.dataTree.size());
+
+        size_t value = 0;
+        for(size_t s = 0; s < pgeX.dataTree.size(); s++)
+        {
+            const PGEFile::PGEX_Entry &expected = pgeX.dataTree[s];
+            REQUIRE(collector.tree[s].name == expected.name);
+            REQUIRE(collector.tree[s].data.size() == expected.data.size());
+            for(const PGEFile::PGEX_Item &item : expected.data)
+            {
+                for(const PGEFile::PGEX_Val &v : item.values)
+                    REQUIRE(collector.values[value++] == PGESTRING(v.marker) + ":" + PGESTRING(v.value));
+            }
+        }
+        REQUIRE(value == collector.values.size());
+    }
+
+    SECTION("Skipped sections are not reported")
+    {
+        PGE_FileFormats_misc::TextFileInput in(path);
+        PGEXEventReader reader;
+        TreeCollector collector;
+        collector.skip = "BLOCK";
+        REQUIRE(reader.parse(in, collector));
+        for(const PGEFile::PGEX_Entry &e : collector.tree)
+            REQUIRE(e.name != "BLOCK");
+        REQUIRE(collector.tree.size() == pgeX.dataTree.size() - 1);
+    }
+
+    SECTION("Malformed data")
+    {
+        PGESTRING raw = "HEAD\nTL:\"x\";\nnot a value\nHEAD_END\n";
+        PGE_FileFormats_misc::RawTextInput in(&raw);
+        PGEXEventReader reader;
+        TreeCollector collector;
+        REQUIRE(reader.parse(in, collector));
+        REQUIRE(collector.invalidLines == 1);
+        REQUIRE(collector.values.size() == 1);
+
+        PGEXEventReader::Handler strict;
+        in.seek(0, PGE_FileFormats_misc::TextInput::begin);
+        REQUIRE(!reader.parse(in, strict));
+
+        PGESTRING unclosed = "HEAD\nTL:\"x\";\n";
+        PGE_FileFormats_misc::RawTextInput in2(&unclosed);
+        REQUIRE(!reader.parse(in2, strict));
+        REQUIRE(reader.lastError() == "Section [HEAD] is not closed");
+    }
+}
+
+namespace
+{
+template<class T>
+void requireSameNumbering(const PGELIST<T> &a, const PGELIST<T> &b)
+{
+    REQUIRE(a.size() == b.size());
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+        REQUIRE(a[i].meta.array_id == b[i].meta.array_id);
+        REQUIRE(a[i].meta.index == b[i].meta.index);
+    }
+}
+}
+
+TEST_CASE("[PGE-X] Parallel section decoding")
+{
+    SECTION("Level")
+    {
+        LevelData lvl;
+        REQUIRE(FileFormats::OpenLevelFile(TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/pgex/Extra Toadhouse.lvlx", lvl));
+
+        PGESTRING raw;
+        REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl, raw));
+        // Sections of one kind must be merged in the file order
+        raw += "BLOCK\nID:5;X:32;Y:64;\nID:6;X:0;Y:0;\nBLOCK_END\n"
+               "NPC\nID:89;X:10;Y:20;\nNPC_END\n"
+               "BLOCK\nID:7;X:-32;Y:0;\nBLOCK_END\n";
+
+        LevelData serial, parallel;
+        PGESTRING raw1, raw2;
+
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw, "sample.lvlx", serial));
+        FileFormats::SetPGEXReadThreads(4);
+        REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw, "sample.lvlx", parallel));
+
+        REQUIRE(serial.blocks.size() == lvl.blocks.size() + 3);
+        REQUIRE(parallel.blocks.back().id == 7);
+        requireSameNumbering(serial.blocks, parallel.blocks);
+        requireSameNumbering(serial.bgo, parallel.bgo);
+        requireSameNumbering(serial.npc, parallel.npc);
+        requireSameNumbering(serial.doors, parallel.doors);
+        requireSameNumbering(serial.physez, parallel.physez);
+        REQUIRE(serial.blocks_array_id == parallel.blocks_array_id);
+        REQUIRE(serial.npc_array_id == parallel.npc_array_id);
+
+        REQUIRE(FileFormats::WriteExtendedLvlFileRaw(serial, raw1));
+        REQUIRE(FileFormats::WriteExtendedLvlFileRaw(parallel, raw2));
+        REQUIRE(raw1 == raw2);
+
+        // The first error in the file order must be reported
+        PGESTRING broken = "BLOCK\nID:1;X:0;Y:0;\nBLOCK_END\n"
+                           "LAYERS\nLR:\"A\";HD:maybe;\nLAYERS_END\n"
+                           "NPC\nID:1;X:zero;\nNPC_END\n";
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(broken, "broken.lvlx", serial));
+        FileFormats::SetPGEXReadThreads(4);
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(broken, "broken.lvlx", parallel));
+        REQUIRE(serial.meta.ERROR_info.find("Section [LAYERS]") != PGESTRING::npos);
+        REQUIRE(parallel.meta.ERROR_info == serial.meta.ERROR_info);
+
+        broken = "BLOCK\nID:1;X:0;Y:0;\nBLOCK_END\n"
+                 "BGO\nID:1;X:0;Y:0;\nID:1;X:0;Y:\"0\";\nBGO_END\n"
+                 "BLOCK\nID:1;X:0;Y:0;\nID:-1;\nBLOCK_END\n";
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(broken, "broken.lvlx", serial));
+        FileFormats::SetPGEXReadThreads(4);
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(broken, "broken.lvlx", parallel));
+        REQUIRE(serial.meta.ERROR_info.find("Section [BGO]") != PGESTRING::npos);
+        REQUIRE(parallel.meta.ERROR_info == serial.meta.ERROR_info);
+    }
+
+    SECTION("World map")
+    {
+        WorldData wld;
+        FileFormats::CreateWorldData(wld);
+        for(long i = 0; i < 100; ++i)
+        {
+            WorldTerrainTile t = FileFormats::CreateWldTile();
+            t.id = 1 + i % 10;
+            t.x = i * 32;
+            wld.tiles.push_back(t);
+            WorldScenery s = FileFormats::CreateWldScenery();
+            s.id = 1 + i % 5;
+            s.y = i * 16;
+            wld.scenery.push_back(s);
+        }
+        WorldLevelTile l = FileFormats::CreateWldLevel();
+        l.lvlfile = "level.lvlx";
+        wld.levels.push_back(l);
+
+        PGESTRING raw;
+        REQUIRE(FileFormats::WriteExtendedWldFileRaw(wld, raw));
+        raw += "TILES\nID:3;X:0;Y:0;\nTILES_END\n"
+               "PATHS\nID:1;X:0;Y:0;\nPATHS_END\n";
+
+        WorldData serial, parallel;
+        PGESTRING raw1, raw2;
+
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(FileFormats::ReadExtendedWldFileRaw(raw, "sample.wldx", serial));
+        FileFormats::SetPGEXReadThreads(4);
+        REQUIRE(FileFormats::ReadExtendedWldFileRaw(raw, "sample.wldx", parallel));
+
+        REQUIRE(parallel.tiles.size() == 101);
+        requireSameNumbering(serial.tiles, parallel.tiles);
+        requireSameNumbering(serial.scenery, parallel.scenery);
+        requireSameNumbering(serial.paths, parallel.paths);
+        requireSameNumbering(serial.levels, parallel.levels);
+
+        REQUIRE(FileFormats::WriteExtendedWldFileRaw(serial, raw1));
+        REQUIRE(FileFormats::WriteExtendedWldFileRaw(parallel, raw2));
+        REQUIRE(raw1 == raw2);
+
+        // Line numbers of errors are counted the same way
+        raw += "SCENERY\nID:1;X:0;Y:0;\nID:1;X:0.5;Y:0;\nSCENERY_END\n";
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(!FileFormats::ReadExtendedWldFileRaw(raw, "broken.wldx", serial));
+        FileFormats::SetPGEXReadThreads(4);
+        REQUIRE(!FileFormats::ReadExtendedWldFileRaw(raw, "broken.wldx", parallel));
+        REQUIRE(parallel.meta.ERROR_info == serial.meta.ERROR_info);
+        REQUIRE(parallel.meta.ERROR_linenum == serial.meta.ERROR_linenum);
+    }
+
+    SECTION("Big sections are decoded by chunks")
+    {
+        LevelData lvl;
+        FileFormats::CreateLevelData(lvl);
+        for(long i = 0; i < 20000; ++i)
+        {
+            LevelBlock b = FileFormats::CreateLvlBlock();
+            b.id = 1 + i % 600;
+            b.x = (i % 100) * 32;
+            b.y = (i / 100) * 32;
+            if(i % 7 == 0)
+                b.event_hit = "Hit " + std::to_string(i);
+            lvl.blocks.push_back(b);
+
+            if(i % 2 == 0)
+            {
+                LevelBGO g = FileFormats::CreateLvlBgo();
+                g.id = 1 + i % 100;
+                g.x = b.x;
+                g.z_offset = 0.5;
+                lvl.bgo.push_back(g);
+            }
+        }
+
+        PGESTRING raw, raw1, raw2;
+        REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl, raw));
+
+        LevelData serial, parallel;
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw, "big.lvlx", serial));
+        FileFormats::SetPGEXReadThreads(3);
+        REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw, "big.lvlx", parallel));
+
+        REQUIRE(parallel.blocks.size() == 20000);
+        requireSameNumbering(serial.blocks, parallel.blocks);
+        requireSameNumbering(serial.bgo, parallel.bgo);
+        REQUIRE(FileFormats::WriteExtendedLvlFileRaw(serial, raw1));
+        REQUIRE(FileFormats::WriteExtendedLvlFileRaw(parallel, raw2));
+        REQUIRE(raw1 == raw);
+        REQUIRE(raw2 == raw);
+
+        // An error in a later chunk is reported with the line of the whole section
+        PGESTRING broken = "BLOCK\n";
+        for(int i = 0; i < 9000; ++i)
+            broken += (i == 8500) ? "ID:1;X:0;Y:zero;\n" : "ID:1;X:0;Y:0;\n";
+        broken += "BLOCK_END\n";
+
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(broken, "broken.lvlx", serial));
+        FileFormats::SetPGEXReadThreads(3);
+        REQUIRE(!FileFormats::ReadExtendedLvlFileRaw(broken, "broken.lvlx", parallel));
+        REQUIRE(serial.meta.ERROR_info.find("Data line 8500") != PGESTRING::npos);
+        REQUIRE(parallel.meta.ERROR_info == serial.meta.ERROR_info);
+
+        WorldData wld, wldSerial, wldParallel;
+        FileFormats::CreateWorldData(wld);
+        for(long i = 0; i < 10000; ++i)
+        {
+            WorldTerrainTile t = FileFormats::CreateWldTile();
+            t.id = 1 + i % 300;
+            t.x = (i % 100) * 32;
+            t.y = (i / 100) * 32;
+            wld.tiles.push_back(t);
+        }
+
+        REQUIRE(FileFormats::WriteExtendedWldFileRaw(wld, raw));
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(FileFormats::ReadExtendedWldFileRaw(raw, "big.wldx", wldSerial));
+        FileFormats::SetPGEXReadThreads(3);
+        REQUIRE(FileFormats::ReadExtendedWldFileRaw(raw, "big.wldx", wldParallel));
+        requireSameNumbering(wldSerial.tiles, wldParallel.tiles);
+        REQUIRE(FileFormats::WriteExtendedWldFileRaw(wldParallel, raw2));
+        REQUIRE(raw2 == raw);
+
+        raw += "TILES\n";
+        for(int i = 0; i < 9000; ++i)
+            raw += (i == 4200) ? "ID:1;X:0.5;Y:0;\n" : "ID:1;X:0;Y:0;\n";
+        raw += "TILES_END\n";
+
+        FileFormats::SetPGEXReadThreads(0);
+        REQUIRE(!FileFormats::ReadExtendedWldFileRaw(raw, "broken.wldx", wldSerial));
+        FileFormats::SetPGEXReadThreads(3);
+        REQUIRE(!FileFormats::ReadExtendedWldFileRaw(raw, "broken.wldx", wldParallel));
+        REQUIRE(wldSerial.meta.ERROR_info.find("Data line 4200") != PGESTRING::npos);
+        REQUIRE(wldParallel.meta.ERROR_info == wldSerial.meta.ERROR_info);
+        REQUIRE(wldParallel.meta.ERROR_linenum == wldSerial.meta.ERROR_linenum);
+    }
+
+    FileFormats::SetPGEXReadThreads(0);
+}
+
+TEST_CASE("[PGE-X] Parallel section encoding")
+{
+    SECTION("Level")
+    {
+        const char *files[] =
+        {
+            TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/pgex/Extra Toadhouse.lvlx",
+            TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx64/Level 1-1.lvl",
+            TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx38a/1-1.lvl"
+        };
+
+        for(const char *path : files)
+        {
+            INFO(path);
+            LevelData lvl;
+            REQUIRE(FileFormats::OpenLevelFile(path, lvl));
+
+            // Make sections bigger than the output buffer
+            for(int i = 0; i < 5000; i++)
+            {
+                LevelBlock b = FileFormats::CreateLvlBlock();
+                b.id = 1 + i % 600;
+                b.x = i * 32;
+                b.event_hit = (i % 3 == 0) ? "Hit;\"event\"" : "";
+                b.meta.array_id = lvl.blocks_array_id++;
+                lvl.blocks.push_back(b);
+            }
+
+            PGESTRING serial, parallel;
+            FileFormats::SetPGEXWriteThreads(0);
+            REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl, serial));
+            FileFormats::SetPGEXWriteThreads(4);
+            REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl, parallel));
+            REQUIRE(serial == parallel);
+        }
+    }
+
+    SECTION("World map")
+    {
+        WorldData wld;
+        REQUIRE(FileFormats::OpenWorldFile(TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx38a_wld/Best sausidge.wld", wld));
+        REQUIRE(!wld.tiles.empty());
+
+        PGESTRING serial, parallel;
+        FileFormats::SetPGEXWriteThreads(0);
+        REQUIRE(FileFormats::WriteExtendedWldFileRaw(wld, serial));
+        FileFormats::SetPGEXWriteThreads(4);
+        REQUIRE(FileFormats::WriteExtendedWldFileRaw(wld, parallel));
+        REQUIRE(serial == parallel);
+    }
+
+    FileFormats::SetPGEXWriteThreads(0);
+}
+
+TEST_CASE("[SMBX-38A] Parallel line decoding")
+{
+    SECTION("Level")
+    {
+        LevelData lvl;
+        REQUIRE(FileFormats::OpenLevelFile(TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx38a/1-1.lvl", lvl));
+
+        // Make more lines than one chunk has, mixed with lines read in order
+        for(long i = 0; i < 9000; ++i)
+        {
+            LevelBlock b = FileFormats::CreateLvlBlock();
+            b.id = 1 + i % 600;
+            b.x = i * 32;
+            b.layer = (i % 5 == 0) ? "Layer " + std::to_string(i % 3) : "Default";
+            b.meta.array_id = lvl.blocks_array_id++;
+            lvl.blocks.push_back(b);
+
+            LevelNPC n = FileFormats::CreateLvlNpc();
+            n.id = 1 + i % 300;
+            n.x = i * 16;
+            n.meta.array_id = lvl.npc_array_id++;
+            lvl.npc.push_back(n);
+
+            if(i % 100 == 0)
+            {
+                LevelLayer l = FileFormats::CreateLvlLayer();
+                l.name = "Extra " + std::to_string(i);
+                l.meta.array_id = lvl.layers_array_id++;
+                lvl.layers.push_back(l);
+            }
+        }
+
+        PGESTRING raw, raw1, raw2;
+        REQUIRE(FileFormats::WriteSMBX38ALvlFileRaw(lvl, raw));
+
+        LevelData serial, parallel;
+        FileFormats::SetSMBX38AReadThreads(0);
+        REQUIRE(FileFormats::ReadSMBX38ALvlFileRaw(raw, "big.lvl", serial));
+        FileFormats::SetSMBX38AReadThreads(4);
+        REQUIRE(FileFormats::ReadSMBX38ALvlFileRaw(raw, "big.lvl", parallel));
+
+        REQUIRE(parallel.blocks.size() == lvl.blocks.size());
+        requireSameNumbering(serial.blocks, parallel.blocks);
+        requireSameNumbering(serial.bgo, parallel.bgo);
+        requireSameNumbering(serial.npc, parallel.npc);
+        requireSameNumbering(serial.doors, parallel.doors);
+        requireSameNumbering(serial.physez, parallel.physez);
+        requireSameNumbering(serial.layers, parallel.layers);
+        REQUIRE(serial.events.size() == parallel.events.size());
+        REQUIRE(serial.blocks_array_id == parallel.blocks_array_id);
+
+        REQUIRE(FileFormats::WriteSMBX38ALvlFileRaw(serial, raw1));
+        REQUIRE(FileFormats::WriteSMBX38ALvlFileRaw(parallel, raw2));
+        REQUIRE(raw1 == raw2);
+
+        // Only selected sections are loaded
+        PGE_FileFormats_misc::RawTextInput in(&raw);
+        LevelData npcOnly;
+        REQUIRE(FileFormats::ReadSMBX38ALvlFile(in, npcOnly, FileFormats::LOAD_NPC));
+        REQUIRE(npcOnly.blocks.empty());
+        requireSameNumbering(serial.npc, npcOnly.npc);
+
+        // The first error in the file order must be reported
+        PGESTRING broken = raw;
+        size_t line = broken.rfind("\nB|");
+        REQUIRE(line != PGESTRING::npos);
+        broken.insert(line + 1, "B|zero|x|32\n");
+        broken += "N|x|0|0\n";
+
+        FileFormats::SetSMBX38AReadThreads(0);
+        REQUIRE(!FileFormats::ReadSMBX38ALvlFileRaw(broken, "broken.lvl", serial));
+        FileFormats::SetSMBX38AReadThreads(4);
+        REQUIRE(!FileFormats::ReadSMBX38ALvlFileRaw(broken, "broken.lvl", parallel));
+        REQUIRE(parallel.meta.ERROR_info == serial.meta.ERROR_info);
+        REQUIRE(parallel.meta.ERROR_linenum == serial.meta.ERROR_linenum);
+        REQUIRE(serial.meta.ERROR_info.find("Failed to parse field 2") != PGESTRING::npos);
+        REQUIRE(serial.meta.ERROR_linenum < static_cast<long>(std::count(broken.begin(), broken.end(), '\n')));
+    }
+
+    SECTION("World map")
+    {
+        WorldData wld;
+        REQUIRE(FileFormats::OpenWorldFile(TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx38a_wld/Best sausidge.wld", wld));
+
+        for(long i = 0; i < 9000; ++i)
+        {
+            WorldTerrainTile t = FileFormats::CreateWldTile();
+            t.id = 1 + i % 300;
+            t.x = (i % 100) * 32;
+            t.y = (i / 100) * 32;
+            t.meta.array_id = wld.tile_array_id++;
+            wld.tiles.push_back(t);
+
+            if(i % 3 == 0)
+            {
+                WorldScenery s = FileFormats::CreateWldScenery();
+                s.id = 1 + i % 50;
+                s.x = t.x;
+                s.meta.array_id = wld.scene_array_id++;
+                wld.scenery.push_back(s);
+            }
+        }
+
+        PGESTRING raw, raw1, raw2;
+        REQUIRE(FileFormats::WriteSMBX38AWldFileRaw(wld, raw));
+
+        WorldData serial, parallel;
+        FileFormats::SetSMBX38AReadThreads(0);
+        REQUIRE(FileFormats::ReadSMBX38AWldFileRaw(raw, "big.wld", serial));
+        FileFormats::SetSMBX38AReadThreads(3);
+        REQUIRE(FileFormats::ReadSMBX38AWldFileRaw(raw, "big.wld", parallel));
+
+        REQUIRE(parallel.tiles.size() == wld.tiles.size());
+        requireSameNumbering(serial.tiles, parallel.tiles);
+        requireSameNumbering(serial.scenery, parallel.scenery);
+        requireSameNumbering(serial.paths, parallel.paths);
+        requireSameNumbering(serial.levels, parallel.levels);
+        REQUIRE(serial.music.size() == parallel.music.size());
+
+        REQUIRE(FileFormats::WriteSMBX38AWldFileRaw(serial, raw1));
+        REQUIRE(FileFormats::WriteSMBX38AWldFileRaw(parallel, raw2));
+        REQUIRE(raw1 == raw2);
+
+        raw += "T|1|x|0\n";
+        FileFormats::SetSMBX38AReadThreads(0);
+        REQUIRE(!FileFormats::ReadSMBX38AWldFileRaw(raw, "broken.wld", serial));
+        FileFormats::SetSMBX38AReadThreads(3);
+        REQUIRE(!FileFormats::ReadSMBX38AWldFileRaw(raw, "broken.wld", parallel));
+        REQUIRE(parallel.meta.ERROR_info == serial.meta.ERROR_info);
+        REQUIRE(parallel.meta.ERROR_linenum == serial.meta.ERROR_linenum);
+    }
+
+    FileFormats::SetSMBX38AReadThreads(0);
+}
+
+template<class T>
+static void requireSamePlacement(const PGELIST<T> &a, const PGELIST<T> &b)
+{
+    REQUIRE(a.size() == b.size());
+    for(pge_size_t i = 0; i < a.size(); ++i)
+    {
+        REQUIRE(a[i].id == b[i].id);
+        REQUIRE(a[i].x == b[i].x);
+        REQUIRE(a[i].y == b[i].y);
+        REQUIRE(a[i].meta.array_id == b[i].meta.array_id);
+    }
+}
+
+static bool isInternalEvent(const LevelSMBX64Event &e)
+{
+    return e.name == "Level - Start" || e.name == "P Switch - Start" || e.name == "P Switch - End";
+}
+
+TEST_CASE("[LevelFile] Selective section loading")
+{
+    const char *files[] =
+    {
+        TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/pgex/Level 1-1.lvlx",
+        TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx64/Level 1-1.lvl",
+        TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx38a/1-1.lvl",
+        TEST_WORKDIR "/sample.lvl"
+    };
+
+    for(const char *path : files)
+    {
+        INFO(path);
+        LevelData full, thumb, validator;
+        REQUIRE(FileFormats::OpenLevelFile(path, full));
+        REQUIRE(!full.blocks.empty());
+
+        REQUIRE(FileFormats::OpenLevelFile(path, thumb, FileFormats::LOAD_SECTIONS |
+                                                        FileFormats::LOAD_BLOCKS |
+                                                        FileFormats::LOAD_BGO));
+        REQUIRE(thumb.meta.ReadFileValid);
+        requireSamePlacement(full.blocks, thumb.blocks);
+        requireSamePlacement(full.bgo, thumb.bgo);
+        REQUIRE(thumb.sections.size() == full.sections.size());
+        for(pge_size_t i = 0; i < full.sections.size(); ++i)
+        {
+            REQUIRE(thumb.sections[i].size_left == full.sections[i].size_left);
+            REQUIRE(thumb.sections[i].size_bottom == full.sections[i].size_bottom);
+        }
+        REQUIRE(thumb.npc.empty());
+        REQUIRE(thumb.doors.empty());
+        REQUIRE(thumb.physez.empty());
+        for(const LevelSMBX64Event &e : thumb.events)
+            REQUIRE(isInternalEvent(e));
+
+        REQUIRE(FileFormats::OpenLevelFile(path, validator, FileFormats::LOAD_LAYERS |
+                                                            FileFormats::LOAD_EVENTS));
+        REQUIRE(validator.meta.ReadFileValid);
+        REQUIRE(validator.blocks.empty());
+        REQUIRE(validator.bgo.empty());
+        REQUIRE(validator.npc.empty());
+        REQUIRE(validator.layers.size() == full.layers.size());
+        REQUIRE(validator.events.size() == full.events.size());
+        for(pge_size_t i = 0; i < full.events.size(); ++i)
+        {
+            REQUIRE(validator.events[i].name == full.events[i].name);
+            REQUIRE(validator.events[i].layers_show == full.events[i].layers_show);
+            REQUIRE(validator.events[i].trigger == full.events[i].trigger);
+        }
+    }
+
+    // Skipped PGE-X sections must not appear in the data tree, but must still be closed
+    PGEFile tree("HEAD\nTL:\"Title\";\nHEAD_END\n"
+                 "BLOCK\nID:1;X:0;Y:0;\nBLOCK_END\n"
+                 "NPC\nID:1;X:0;Y:0;\nNPC_END\n");
+    PGESTRINGList skipped;
+    skipped.push_back("BLOCK");
+    tree.setSkippedSections(skipped);
+    REQUIRE(tree.buildTreeFromRaw());
+    REQUIRE(tree.dataTree.size() == 2);
+    REQUIRE(tree.dataTree[0].name == "HEAD");
+    REQUIRE(tree.dataTree[1].name == "NPC");
+
+    PGEFile unclosed("BLOCK\nID:1;X:0;Y:0;\nNPC\n");
+    unclosed.setSkippedSections(skipped);
+    REQUIRE(!unclosed.buildTreeFromRaw());
+}
+
+TEST_CASE("[WorldFile] Selective section loading")
+{
+    const char *files[] =
+    {
+        TEST_WORKDIR "/../old_deep_tests/PGEFilelib_STL_test/test.wldx",
+        TEST_WORKDIR "/../old_deep_tests/PGEFilelib_QT_test/test.wld",
+        TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx38a_wld/Best sausidge.wld"
+    };
+
+    for(const char *path : files)
+    {
+        INFO(path);
+        WorldData full, tiles;
+        REQUIRE(FileFormats::OpenWorldFile(path, full));
+        REQUIRE(!full.tiles.empty());
+
+        REQUIRE(FileFormats::OpenWorldFile(path, tiles, FileFormats::LOAD_TILES | FileFormats::LOAD_LEVELS));
+        REQUIRE(tiles.meta.ReadFileValid);
+        requireSamePlacement(full.tiles, tiles.tiles);
+        requireSamePlacement(full.levels, tiles.levels);
+        REQUIRE(tiles.scenery.empty());
+        REQUIRE(tiles.paths.empty());
+        REQUIRE(tiles.music.empty());
+        REQUIRE(tiles.arearects.empty());
+    }
+}
+
+struct CountingCallbacks : public LevelLoadCallbacks
+{
+    size_t blocks = 0, bgo = 0, npc = 0, warps = 0, layers = 0;
+    PGELIST<PGESTRING> layerNames;
+    PGELIST<unsigned int> layerIds;
+    long maxBlocks = -1;
+
+    bool onBlock(LevelBlock &) override
+    {
+        if(maxBlocks >= 0 && static_cast<long>(blocks) >= maxBlocks)
+            return false;
+        ++blocks;
+        return true;
+    }
+    bool onBGO(LevelBGO &) override { ++bgo; return true; }
+    bool onNPC(LevelNPC &) override { ++npc; return true; }
+    bool onWarp(LevelDoor &) override { ++warps; return true; }
+    bool onLayer(LevelLayer &l) override
+    {
+        ++layers;
+        layerNames.push_back(l.name);
+        layerIds.push_back(l.meta.array_id);
+        return true;
+    }
+};
+
+TEST_CASE("[LevelFile] Load callbacks")
+{
+    const char *files[] =
+    {
+        TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/pgex/Level 1-1.lvlx",
+        TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx64/Level 1-1.lvl",
+        TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/smbx38a/1-1.lvl",
+        TEST_WORKDIR "/sample.lvl"
+    };
+
+    for(const char *path : files)
+    {
+        INFO(path);
+        LevelData full, head;
+        CountingCallbacks counter;
+        REQUIRE(FileFormats::OpenLevelFile(path, full));
+        REQUIRE(FileFormats::OpenLevelFile(path, head, counter));
+        REQUIRE(head.meta.ReadFileValid);
+        REQUIRE(head.blocks.empty());
+        REQUIRE(head.npc.empty());
+        REQUIRE(head.sections.size() == full.sections.size());
+        REQUIRE(head.LevelName == full.LevelName);
+        REQUIRE(counter.blocks == full.blocks.size());
+        REQUIRE(counter.bgo == full.bgo.size());
+        REQUIRE(counter.npc == full.npc.size());
+        REQUIRE(counter.warps == full.doors.size());
+
+        LevelData cut;
+        CountingCallbacks limited;
+        limited.maxBlocks = 1;
+        REQUIRE(!FileFormats::OpenLevelFile(path, cut, limited));
+        REQUIRE(!cut.meta.ReadFileValid);
+        REQUIRE(!cut.meta.ERROR_info.empty());
+        REQUIRE(limited.blocks == 1);
+    }
+
+    // Layer of the same name replaces the previous one and keeps its array ID
+    PGESTRING raw = "LAYERS\nLR:\"Default\";HD:1;\nLR:\"Custom\";\nLR:\"Default\";\nLAYERS_END\n";
+    PGE_FileFormats_misc::RawTextInput in(&raw, "test.lvlx");
+    LevelData head;
+    CountingCallbacks counter;
+    REQUIRE(FileFormats::ReadExtendedLvlFile(in, head, counter));
+    REQUIRE(counter.layers == 3);
+    REQUIRE(counter.layerNames[2] == "Default");
+    REQUIRE(counter.layerIds[2] == counter.layerIds[0]);
+
+    LevelData lvl;
+    REQUIRE(FileFormats::OpenLevelRaw(raw, "test.lvlx", lvl));
+    pge_size_t defaults = 0;
+    for(const LevelLayer &l : lvl.layers)
+    {
+        if(l.name == "Default")
+        {
+            ++defaults;
+            REQUIRE(!l.hidden);
+        }
+    }
+    REQUIRE(defaults == 1);
+    REQUIRE(lvl.layers.size() == 4); // Three default layers and "Custom"
+}
+
+TEST_CASE("[LevelFile] Load LVLX scripts")
+{
+    LevelData lvl;
+    FileFormats::CreateLevelData(lvl);
+    lvl.variables.push_back(FileFormats::CreateLvlVariable("counter"));
+
+    LevelScript lua = FileFormats::CreateLvlScript("main", LevelScript::LANG_LUA);
+    lua.script = "print(\"Hello\")";
+    lvl.scripts.push_back(lua);
+    LevelScript tea = FileFormats::CreateLvlScript("extra", LevelScript::LANG_TEASCRIPT);
+    tea.script = "x = 1;";
+    lvl.scripts.push_back(tea);
+
+    PGESTRING raw;
+    REQUIRE(FileFormats::WriteExtendedLvlFileRaw(lvl, raw));
+
+    LevelData back;
+    REQUIRE(FileFormats::ReadExtendedLvlFileRaw(raw, "scripts.lvlx", back));
+    REQUIRE(back.variables.size() == 1);
+    REQUIRE(back.scripts.size() == 2);
+    REQUIRE(back.scripts[0].name == "main");
+    REQUIRE(back.scripts[0].script == lua.script);
+    REQUIRE(back.scripts[0].language == LevelScript::LANG_LUA);
+    REQUIRE(back.scripts[1].name == "extra");
+    REQUIRE(back.scripts[1].script == tea.script);
+    REQUIRE(back.scripts[1].language == LevelScript::LANG_TEASCRIPT);
+}
+
+TEST_CASE("[SMBX64] Field cursor")
+{
+    PGESTRING raw = "64\n-12\n3.6\n-200000\n#TRUE#\n\"Title\"\n99999999999\nabc\n";
+    PGE_FileFormats_misc::RawTextInput in(&raw, "test.lvl");
+    SMBX64::FieldCursor cursor(in);
+    unsigned int u = 0;
+    int s = 0;
+    long f = 0, f2 = 0;
+    bool b = false;
+    PGESTRING str;
+
+    REQUIRE(cursor.readUInt(&u));
+    REQUIRE(u == 64);
+    REQUIRE(cursor.readSInt(&s));
+    REQUIRE(s == -12);
+    REQUIRE(cursor.readSIntFromFloat(&f));
+    REQUIRE(f == 4);
+    REQUIRE(cursor.readSIntFromFloat(&f2));
+    REQUIRE(f2 == -200000);
+    REQUIRE(cursor.readCSVBool(&b));
+    REQUIRE(b);
+    REQUIRE(cursor.readStr(&str));
+    REQUIRE(str == "Title");
+    REQUIRE(cursor.error() == SMBX64::FieldCursor::ERROR_NONE);
+
+    // Out of the int range
+    REQUIRE(!cursor.readSInt(&s));
+    REQUIRE(s == -12);
+    REQUIRE(cursor.error() == SMBX64::FieldCursor::ERROR_SINT);
+    REQUIRE(cursor.errorLine() == 7);
+
+    // The first failure is kept
+    REQUIRE(!cursor.readCSVBool(&b));
+    REQUIRE(cursor.error() == SMBX64::FieldCursor::ERROR_SINT);
+    REQUIRE(cursor.errorLine() == 7);
+
+    SECTION("Invalid field of a level file")
+    {
+        LevelData lvl;
+        FileFormats::CreateLevelData(lvl);
+        LevelBlock block = FileFormats::CreateLvlBlock();
+        block.x = 12345;
+        lvl.blocks.push_back(block);
+
+        PGESTRING file;
+        REQUIRE(FileFormats::WriteSMBX64LvlFileRaw(lvl, file, 64));
+        pge_size_t pos = file.find("12345\n");
+        REQUIRE(pos != PGESTRING::npos);
+        file[pos] = 'x';
+        long line = 1 + static_cast<long>(std::count(file.begin(), file.begin() + static_cast<long>(pos), '\n'));
+
+        LevelData broken;
+        REQUIRE(!FileFormats::ReadSMBX64LvlFileRaw(file, "broken.lvl", broken));
+        REQUIRE(!broken.meta.ReadFileValid);
+        REQUIRE(broken.meta.ERROR_linenum == line);
+        REQUIRE(broken.meta.ERROR_linedata == "x2345");
+        REQUIRE(broken.meta.ERROR_info.find("Invalid floating point value") != PGESTRING::npos);
+    }
+}
@@ -1,5 +1,9 @@
 #include <catch_amalgamated.hpp>
 #include "file_formats.h"
+#include "pge_file_lib_globs.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #ifndef TEST_WORKDIR
 #   define TEST_WORKDIR "."
@@ -413,3 +417,150 @@ TEST_CASE("[38A 1.4.5 World] Read/Write/Read test 2")
     REQUIRE(data.layers.size() == 4);
     REQUIRE(data.events38A.size() == 1);
 }
+
+TEST_CASE("[Binary Level Cache] Read/Write/Read test")
+{
+    LevelData data, cached;
+    PGESTRING path = TEST_WORKDIR "/../old_deep_tests/PGEFileLib_test_files/pgex/Airship W3.lvlx";
+    PGESTRING cachePath = TEST_WRITEDIR "/airship-w3.lvlb";
+
+    REQUIRE(FileFormats::OpenLevelFile(path, data));
+    REQUIRE(FileFormats::WriteBinaryLvlFile(cachePath, data, path));
+
+    bool res = FileFormats::ReadBinaryLvlFile(cachePath, cached, path);
+    INFO("Error: " + cached.meta.ERROR_info);
+    REQUIRE(res);
+    REQUIRE(cached.meta.ReadFileValid);
+    REQUIRE(cached.meta.RecentFormat == LevelData::PGEX);
+    REQUIRE(cached.meta.filename == data.meta.filename);
+    REQUIRE(cached.stars == data.stars);
+
+    REQUIRE(cached.blocks.size() == data.blocks.size());
+    REQUIRE(cached.bgo.size() == data.bgo.size());
+    REQUIRE(cached.npc.size() == data.npc.size());
+    REQUIRE(cached.doors.size() == data.doors.size());
+    REQUIRE(cached.blocks_array_id == data.blocks_array_id);
+    REQUIRE(cached.doors_array_id == data.doors_array_id);
+    REQUIRE(cached.blocks.back().meta.array_id == data.blocks.back().meta.array_id);
+    REQUIRE(cached.npc.back().meta.index == data.npc.back().meta.index);
+
+    PGESTRING raw1, raw2;
+    REQUIRE(FileFormats::WriteExtendedLvlFileRaw(data, raw1));
+    REQUIRE(FileFormats::WriteExtendedLvlFileRaw(cached, raw2));
+    REQUIRE(raw1 == raw2);
+
+    // Fields not kept by PGE-X
+    LevelData custom;
+    FileFormats::CreateLevelData(custom);
+    LevelBlock block = FileFormats::CreateLvlBlock();
+    block.x = -2147483647L;
+    block.event_on_screen = "On screen";
+    block.meta.array_id = 5;
+    custom.blocks.push_back(block);
+    custom.blocks_array_id = 6;
+    LevelNPC npc = FileFormats::CreateLvlNpc();
+    npc.id = 4000000000ull;
+    npc.generator_period_orig_unit = PGE_FileLibrary::TimeUnit::FrameOneOf65sec;
+    npc.generator_custom_angle = 12.375;
+    npc.msg = "Hello, world!";
+    custom.npc.push_back(npc);
+    LevelDoor door = FileFormats::CreateLvlWarp();
+    door.cannon_exit_speed = 0.1;
+    door.event_enter = "On screen";
+    custom.doors.push_back(door);
+    custom.meta.RecentFormat = LevelData::SMBX64;
+    custom.meta.RecentFormatVersion = 64;
+
+    cachePath = TEST_WRITEDIR "/custom.lvlb";
+    REQUIRE(FileFormats::WriteBinaryLvlFile(cachePath, custom));
+    REQUIRE(custom.meta.RecentFormat == LevelData::SMBX64);
+    REQUIRE(custom.blocks.size() == 1);
+    REQUIRE(FileFormats::ReadBinaryLvlFile(cachePath, cached));
+    REQUIRE(!FileFormats::ReadBinaryLvlFile(cachePath, cached, path)); // No source stamp
+    REQUIRE(FileFormats::ReadBinaryLvlFile(cachePath, cached));
+    REQUIRE(cached.meta.RecentFormat == LevelData::SMBX64);
+    REQUIRE(cached.meta.RecentFormatVersion == 64);
+    REQUIRE(cached.blocks.size() == 1);
+    REQUIRE(cached.blocks[0].x == -2147483647L);
+    REQUIRE(cached.blocks[0].event_on_screen == "On screen");
+    REQUIRE(cached.blocks[0].meta.array_id == 5);
+    REQUIRE(cached.blocks_array_id == 6);
+    REQUIRE(cached.npc[0].id == 4000000000ull);
+    REQUIRE(cached.npc[0].generator_period_orig_unit == PGE_FileLibrary::TimeUnit::FrameOneOf65sec);
+    REQUIRE(cached.npc[0].generator_custom_angle == 12.375);
+    REQUIRE(cached.npc[0].msg == "Hello, world!");
+    REQUIRE(cached.doors[0].cannon_exit_speed == 0.1);
+    REQUIRE(cached.doors[0].event_enter == "On screen");
+}
+
+TEST_CASE("[Binary Level Cache] Invalidation")
+{
+    LevelData data;
+    PGESTRING path = TEST_WRITEDIR "/cached-source.lvlx";
+    PGESTRING cachePath = TEST_WRITEDIR "/cached-source.lvlx.lvlb";
+
+    REQUIRE(FileFormats::OpenLevelFile(TEST_WORKDIR "/test-files/SMBX-38A/test-145.lvl", data));
+    REQUIRE(FileFormats::WriteExtendedLvlFileF(path, data));
+    PGE_FileFormats_misc::writeFileReplace(cachePath, "", 0);
+
+    // Broken cache gets rebuilt
+    REQUIRE(!FileFormats::ReadBinaryLvlFile(cachePath, data, path));
+    REQUIRE(FileFormats::OpenLevelFileCached(path, cachePath, data));
+    REQUIRE(data.blocks.size() == 1);
+    REQUIRE(FileFormats::ReadBinaryLvlFile(cachePath, data, path));
+    REQUIRE(data.blocks.size() == 1);
+    REQUIRE(data.meta.RecentFormat == LevelData::PGEX);
+
+    // Changed source outdates the cache
+    LevelBlock block = FileFormats::CreateLvlBlock();
+    block.id = 2;
+    data.blocks.push_back(block);
+    REQUIRE(FileFormats::WriteExtendedLvlFileF(path, data));
+
+    REQUIRE(!FileFormats::ReadBinaryLvlFile(cachePath, data, path));
+    REQUIRE(data.meta.ERROR_info == "Binary level cache is out of date");
+    REQUIRE(FileFormats::OpenLevelFileCached(path, cachePath, data));
+    REQUIRE(data.blocks.size() == 2);
+    REQUIRE(FileFormats::ReadBinaryLvlFile(cachePath, data, path));
+    REQUIRE(data.blocks.size() == 2);
+    REQUIRE(data.blocks[1].id == 2);
+
+    // Change of the same size made immediately after building the cache
+    REQUIRE(FileFormats::OpenLevelFileCached(path, cachePath, data));
+    PGESTRING raw;
+    REQUIRE(FileFormats::WriteExtendedLvlFileRaw(data, raw));
+    size_t id = raw.find("ID:2;");
+    REQUIRE(id != PGESTRING::npos);
+    raw[id + 3] = '3';
+    REQUIRE(PGE_FileFormats_misc::writeFileReplace(path, raw.data(), raw.size()));
+    REQUIRE(!FileFormats::ReadBinaryLvlFile(cachePath, data, path));
+    REQUIRE(data.meta.ERROR_info == "Binary level cache is out of date");
+    REQUIRE(FileFormats::OpenLevelFileCached(path, cachePath, data));
+    REQUIRE(data.blocks[1].id == 3);
+
+    // Concurrent rebuilds of the same cache
+    std::vector<std::thread> writers;
+    std::atomic<int> failures(0);
+    for(int i = 0; i < 4; ++i)
+    {
+        writers.emplace_back([&failures, &path, &cachePath]()
+        {
+            for(int j = 0; j < 10; ++j)
+            {
+                LevelData copy;
+                if(!FileFormats::OpenLevelFile(path, copy) || !FileFormats::WriteBinaryLvlFile(cachePath, copy, path))
+                    failures++;
+            }
+        });
+    }
+    for(std::thread &t : writers)
+        t.join();
+    REQUIRE(failures == 0);
+    REQUIRE(FileFormats::ReadBinaryLvlFile(cachePath, data, path));
+    REQUIRE(data.blocks.size() == 2);
+    REQUIRE(data.blocks[1].id == 3);
+
+    // Not a cache
+    REQUIRE(!FileFormats::ReadBinaryLvlFile(path, data));
+    REQUIRE(data.meta.ERROR_info == "Invalid file format");
+}